@@ -0,0 +1,209 @@
+#include "src/include/clwe/allocation_profiler.hpp"
+#include "src/include/clwe/benchmark.hpp"
+#include "src/include/clwe/keygen.hpp"
+#include "src/include/clwe/parameters.hpp"
+#include "src/include/clwe/performance_metrics.hpp"
+#include "src/include/clwe/security_utils.hpp"
+#include "src/include/clwe/sign.hpp"
+#include "src/include/clwe/verify.hpp"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Heap allocations per keygen, sign and verify at every security level: allocation count,
+// requested bytes and peak live bytes of each operation, the same split by stage, and the
+// growth of the resident set over the run. Operations run on one thread after a warm-up, so
+// one-time allocations (caches, thread-local state) are excluded; the signer's audit log is capped
+// at a few entries so that it reaches its steady state (slots reused) during the warm-up instead of
+// showing up as occasional growth spikes. Linked with the allocation
+// hooks, which count operator new; allocations made with malloc inside OpenSSL are not seen.
+//
+// Usage: benchmark_allocations [--quick] [--iterations=<n>] [--json=<path>]
+
+namespace {
+
+const size_t MESSAGE_SIZE = 1024;
+const int WARMUP_OPERATIONS = 5;
+const size_t AUDIT_LOG_SIZE = 8;
+
+std::unique_ptr<clwe::SecurityMonitor> small_audit_log_monitor() {
+    auto monitor = std::make_unique<clwe::DefaultSecurityMonitor>();
+    monitor->set_max_log_size(AUDIT_LOG_SIZE);
+    return monitor;
+}
+
+struct OperationProfile {
+    std::string name;
+    uint32_t level = 0;
+    uint64_t iterations = 0;
+    double allocations = 0.0;         // Per operation
+    double allocated_bytes = 0.0;     // Per operation
+    uint64_t peak_live_bytes = 0;     // Largest over all operations
+    int64_t rss_delta_bytes = 0;      // Resident set growth over the measured operations
+    std::vector<clwe::StageStats> stages;
+};
+
+OperationProfile profile(const std::string& name, uint32_t level, uint64_t iterations,
+                         const std::function<void()>& operation) {
+    for (int i = 0; i < WARMUP_OPERATIONS; ++i) {
+        operation();
+    }
+
+    OperationProfile result;
+    result.name = name;
+    result.level = level;
+    result.iterations = iterations;
+
+    clwe::StageProfiler::reset();
+    clwe::StageProfiler::enable(true);
+    size_t rss_before = clwe::PerformanceMetrics::get_memory_usage().current_memory;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        clwe::AllocationScope scope;
+        operation();
+        clwe::AllocationStats stats = scope.stats();
+        allocations += stats.allocations;
+        allocated_bytes += stats.allocated_bytes;
+        result.peak_live_bytes = std::max(result.peak_live_bytes, stats.peak_live_bytes);
+    }
+    size_t rss_after = clwe::PerformanceMetrics::get_memory_usage().current_memory;
+    clwe::StageProfiler::enable(false);
+
+    result.allocations = static_cast<double>(allocations) / iterations;
+    result.allocated_bytes = static_cast<double>(allocated_bytes) / iterations;
+    result.rss_delta_bytes = static_cast<int64_t>(rss_after) - static_cast<int64_t>(rss_before);
+    for (const clwe::StageStats& stage : clwe::StageProfiler::breakdown()) {
+        if (stage.calls > 0) {
+            result.stages.push_back(stage);
+        }
+    }
+    return result;
+}
+
+void print_profiles(std::ostream& out, const std::vector<OperationProfile>& profiles) {
+    out << std::left << std::setw(28) << "Operation" << std::right << std::setw(7) << "Level"
+        << std::setw(14) << "Allocs/op" << std::setw(14) << "Bytes/op" << std::setw(14) << "Peak live"
+        << std::setw(14) << "RSS delta" << "\n";
+    out << std::string(91, '-') << "\n";
+    out << std::fixed << std::setprecision(1);
+    for (const OperationProfile& p : profiles) {
+        out << std::left << std::setw(28) << p.name << std::right << std::setw(7) << p.level
+            << std::setw(14) << p.allocations << std::setw(14) << p.allocated_bytes
+            << std::setw(14) << p.peak_live_bytes << std::setw(14) << p.rss_delta_bytes << "\n";
+        for (const clwe::StageStats& stage : p.stages) {
+            double calls = static_cast<double>(p.iterations);
+            out << std::left << std::setw(28) << ("  " + std::string(clwe::perf_stage_name(stage.stage)))
+                << std::right << std::setw(7) << "" << std::setw(14) << stage.allocations / calls
+                << std::setw(14) << stage.allocated_bytes / calls << "\n";
+        }
+    }
+    out << "Stages are inclusive; peak live and RSS delta are in bytes." << std::endl;
+}
+
+std::string to_json(const std::vector<OperationProfile>& profiles) {
+    std::ostringstream out;
+    out << "{\n  \"suite\": \"colorsign_allocations\",\n  \"results\": [";
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        const OperationProfile& p = profiles[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << clwe::json::escape(p.name) << "\", \"level\": " << p.level
+            << ", \"iterations\": " << p.iterations
+            << ", \"allocations_per_op\": " << clwe::json::number(p.allocations)
+            << ", \"bytes_per_op\": " << clwe::json::number(p.allocated_bytes)
+            << ", \"peak_live_bytes\": " << p.peak_live_bytes
+            << ", \"rss_delta_bytes\": " << p.rss_delta_bytes << ", \"stages\": {";
+        for (size_t s = 0; s < p.stages.size(); ++s) {
+            const clwe::StageStats& stage = p.stages[s];
+            out << (s ? ", " : "") << "\"" << clwe::perf_stage_name(stage.stage) << "\": {\"allocations_per_op\": "
+                << clwe::json::number(static_cast<double>(stage.allocations) / p.iterations)
+                << ", \"bytes_per_op\": "
+                << clwe::json::number(static_cast<double>(stage.allocated_bytes) / p.iterations) << "}";
+        }
+        out << "}}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        uint64_t iterations = 50;
+        std::string json_path;
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (argument == "--quick") {
+                iterations = 5;
+            } else if (argument.rfind("--iterations=", 0) == 0) {
+                iterations = std::stoull(argument.substr(13));
+            } else if (argument.rfind("--json=", 0) == 0) {
+                json_path = argument.substr(7);
+            } else {
+                throw std::invalid_argument("Unknown argument: " + argument);
+            }
+        }
+        if (iterations == 0) {
+            throw std::invalid_argument("--iterations must be positive");
+        }
+        if (!clwe::AllocationProfiler::hooks_installed()) {
+            throw std::runtime_error("Allocation hooks are not linked into this executable");
+        }
+
+        std::vector<OperationProfile> profiles;
+        for (uint32_t level : {44u, 65u, 87u}) {
+            clwe::CLWEParameters params(level);
+            clwe::ColorSignKeyGen keygen(params);
+            clwe::ColorSign signer(params, small_audit_log_monitor());
+            clwe::ColorSignVerify verifier(params);
+            clwe::SignWorkspace sign_workspace(params);
+            clwe::VerifyWorkspace verify_workspace(params);
+
+            clwe::ColorSignPublicKey public_key;
+            clwe::ColorSignPrivateKey private_key;
+            std::tie(public_key, private_key) = keygen.generate_keypair();
+            std::vector<uint8_t> message(MESSAGE_SIZE, 0xAA);
+            clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+            clwe::ColorSignature reused_signature = signature;
+
+            profiles.push_back(profile("generate_keypair", level, iterations, [&]() {
+                keygen.generate_keypair();
+            }));
+            profiles.push_back(profile("sign_message", level, iterations, [&]() {
+                signer.sign_message(message, private_key, public_key);
+            }));
+            profiles.push_back(profile("sign_message/workspace", level, iterations, [&]() {
+                signer.sign_message(message, private_key, public_key, sign_workspace, reused_signature);
+            }));
+            profiles.push_back(profile("verify_signature", level, iterations, [&]() {
+                verifier.verify_signature(public_key, signature, message);
+            }));
+            profiles.push_back(profile("verify_signature/workspace", level, iterations, [&]() {
+                verifier.verify_signature(public_key, signature, message, verify_workspace);
+            }));
+        }
+
+        print_profiles(std::cout, profiles);
+        if (!json_path.empty()) {
+            std::ofstream file(json_path);
+            file << to_json(profiles);
+            if (!file) {
+                throw std::runtime_error("Cannot write " + json_path);
+            }
+            std::cout << "Results written to " << json_path << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,68 +1,141 @@
+#include "src/include/clwe/benchmark.hpp"
 #include "src/include/clwe/keygen.hpp"
 #include "src/include/clwe/parameters.hpp"
 #include "src/include/clwe/sign.hpp"
 #include "src/include/clwe/verify.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
-#include <chrono>
-#include <random>
-#include <iomanip>
 
-int main() {
-    try {
-        std::cout << "ColorSign Benchmark - Timing Test" << std::endl;
-        std::cout << "=================================" << std::endl;
+// End-to-end benchmarks of keygen, sign and verify for every security level, message sizes
+// from 32 B to 1 MiB, with and without a context string. Each signed message differs from the
+// previous one, so the sign statistics cover the spread of rejection sampling.
+//
+// Usage: benchmark_color_sign_timing [--quick] [--min-time=<s>] [--filter=<substring>] [--json=<path>]
+
+namespace {
 
-        // Test with different parameter sets
-        std::vector<int> parameter_sets = {44, 65, 87};  // ML-DSA-44, ML-DSA-65, ML-DSA-87
+const size_t MESSAGE_SIZES[] = {32, 1024, 64 * 1024, 1024 * 1024};
 
-        for (int param_set : parameter_sets) {
-            std::cout << "\nTesting ML-DSA-" << param_set << " parameters:" << std::endl;
+struct Variant {
+    std::vector<uint8_t> message;        // Verified message
+    std::vector<uint8_t> sign_message;   // Signed message, changed before every signature
+    std::vector<uint8_t> context;
+    clwe::ColorSignature signature;      // Signature of `message`
+};
 
-            clwe::CLWEParameters params(param_set);
-            clwe::ColorSignKeyGen keygen(params);
+struct LevelFixture {
+    clwe::CLWEParameters params;
+    clwe::ColorSignKeyGen keygen;
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    clwe::ColorSign signer;
+    clwe::ColorSignVerify verifier;
+    clwe::SignWorkspace sign_workspace;
+    clwe::VerifyWorkspace verify_workspace;
+    clwe::ColorSignature signature;
+    std::vector<std::unique_ptr<Variant>> variants;
+    uint64_t message_counter = 0;
+
+    explicit LevelFixture(uint32_t level)
+        : params(level), keygen(params), signer(params), verifier(params),
+          sign_workspace(params), verify_workspace(params) {
+        std::tie(public_key, private_key) = keygen.generate_keypair();
+    }
 
-            // Key generation timing
-            auto start = std::chrono::high_resolution_clock::now();
-            auto [public_key, private_key] = keygen.generate_keypair();
-            auto end = std::chrono::high_resolution_clock::now();
-            auto keygen_time_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    // Vary the first bytes so every signature starts a fresh rejection sampling run
+    void next_message(std::vector<uint8_t>& message) {
+        ++message_counter;
+        std::memcpy(message.data(), &message_counter, std::min(message.size(), sizeof(message_counter)));
+    }
+};
 
-            std::cout << "  Key generation: " << keygen_time_us << " μs" << std::endl;
+} // namespace
 
-            // Create a test message
-            std::vector<uint8_t> message(1024); // 1KB message
-            std::fill(message.begin(), message.end(), 0xAA);
+int main(int argc, char** argv) {
+    try {
+        clwe::BenchmarkOptions options = clwe::BenchmarkOptions::from_args(argc, argv);
+        clwe::BenchmarkSuite suite("colorsign_end_to_end");
+        std::vector<std::unique_ptr<LevelFixture>> fixtures;
 
-            // Signing timing
-            clwe::ColorSign signer(params);
-            start = std::chrono::high_resolution_clock::now();
-            auto signature = signer.sign_message(message, private_key, public_key);
-            end = std::chrono::high_resolution_clock::now();
-            auto sign_time_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        for (uint32_t level : {44u, 65u, 87u}) {
+            fixtures.push_back(std::make_unique<LevelFixture>(level));
+            LevelFixture& fixture = *fixtures.back();
+            std::string level_label = std::to_string(level);
 
-            std::cout << "  Signing: " << sign_time_us << " μs" << std::endl;
+            suite.add("keygen", {{"level", level_label}}, [&fixture]() {
+                fixture.keygen.generate_keypair();
+            });
 
-            // Verification timing
-            clwe::ColorSignVerify verifier(params);
-            start = std::chrono::high_resolution_clock::now();
-            bool is_valid = verifier.verify_signature(public_key, signature, message);
-            end = std::chrono::high_resolution_clock::now();
-            auto verify_time_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            for (size_t size : MESSAGE_SIZES) {
+                for (bool with_context : {false, true}) {
+                    fixture.variants.push_back(std::make_unique<Variant>());
+                    Variant& variant = *fixture.variants.back();
+                    variant.message.assign(size, 0xAA);
+                    variant.sign_message = variant.message;
+                    if (with_context) {
+                        variant.context.assign(32, 0x5C);
+                    }
+                    variant.signature = fixture.signer.sign_message(variant.message, fixture.private_key,
+                                                                   fixture.public_key, variant.context);
 
-            std::cout << "  Verification: " << verify_time_us << " μs" << std::endl;
-            std::cout << "  Verification result: " << (is_valid ? "SUCCESS" : "FAILED") << std::endl;
+                    clwe::MetricLabels labels = {{"level", level_label},
+                                                 {"message_bytes", std::to_string(size)},
+                                                 {"context", with_context ? "32" : "none"}};
+                    suite.add("sign", labels, [&fixture, &variant]() {
+                        fixture.next_message(variant.sign_message);
+                        fixture.signer.sign_message(variant.sign_message.data(), variant.sign_message.size(),
+                                                    fixture.private_key, fixture.public_key,
+                                                    fixture.sign_workspace, fixture.signature,
+                                                    variant.context.data(), variant.context.size());
+                    }, size);
+                    suite.add("verify", labels, [&fixture, &variant]() {
+                        fixture.verifier.verify_signature(clwe::PublicKeyView(fixture.public_key),
+                                                          clwe::SignatureView(variant.signature),
+                                                          variant.message.data(), variant.message.size(),
+                                                          fixture.verify_workspace,
+                                                          variant.context.data(), variant.context.size());
+                    }, size);
+                }
+            }
+        }
 
-            // Signature size
-            auto serialized_sig = signature.serialize();
-            std::cout << "  Signature size: " << serialized_sig.size() << " bytes" << std::endl;
+        // Signing cost at each instrumentation level (ML-DSA-44, 1 KiB)
+        LevelFixture& base = *fixtures.front();
+        std::vector<std::unique_ptr<clwe::ColorSign>> instrumented_signers;
+        std::vector<uint8_t> instrumented_message(1024, 0xAA);
+        const std::pair<clwe::InstrumentationLevel, const char*> levels[] = {
+            {clwe::InstrumentationLevel::OFF, "off"},
+            {clwe::InstrumentationLevel::COUNTERS, "counters"},
+            {clwe::InstrumentationLevel::SAMPLED, "sampled"},
+            {clwe::InstrumentationLevel::FULL, "full"},
+        };
+        for (const auto& [level, name] : levels) {
+            instrumented_signers.push_back(std::make_unique<clwe::ColorSign>(base.params));
+            clwe::ColorSign& signer = *instrumented_signers.back();
+            signer.set_instrumentation_level(level);
+            suite.add("sign_instrumentation", {{"level", "44"}, {"instrumentation", name}},
+                      [&base, &signer, &instrumented_message]() {
+                base.next_message(instrumented_message);
+                signer.sign_message(instrumented_message, base.private_key, base.public_key,
+                                    base.sign_workspace, base.signature);
+            }, instrumented_message.size());
         }
 
-        std::cout << "\nBenchmark completed successfully!" << std::endl;
+        std::vector<clwe::BenchmarkResult> results = suite.run(options, &std::cerr);
+        clwe::BenchmarkSuite::print_results(std::cout, results);
+        if (!options.json_path.empty()) {
+            suite.write_json(options.json_path, results);
+            std::cout << "Results written to " << options.json_path << std::endl;
+        }
         return 0;
 
     } catch (const std::exception& e) {
         std::cerr << "Benchmark error: " << e.what() << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
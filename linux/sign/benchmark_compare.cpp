@@ -0,0 +1,117 @@
+#include "src/include/clwe/benchmark_baseline.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compares benchmark reports (the --json output of benchmark_color_sign_timing and
+// benchmark_primitives) with the stored baseline of the same environment, and fails when a
+// case regresses beyond the budget. Without a stored baseline, or with --update, the reports
+// become the baseline.
+//
+// Usage: benchmark_compare [--baseline-dir=<dir>] [--update] [--max-slowdown=<fraction>]
+//                          [--alpha=<p>] [--min-effect=<r>] <report.json>...
+//
+// Exit status: 0 = no regression, 1 = error, 2 = regression beyond the budget
+
+namespace {
+
+double parse_fraction(const std::string& argument, const std::string& value) {
+    try {
+        size_t used = 0;
+        double number = std::stod(value, &used);
+        if (used == value.size() && number >= 0) {
+            return number;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Invalid value for " + argument + ": " + value);
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open benchmark report: " + path);
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        std::string baseline_dir = "benchmarks/baselines";
+        bool update = false;
+        clwe::RegressionBudget budget;
+        std::vector<std::string> reports;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            size_t equals = argument.find('=');
+            std::string key = argument.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+            if (key == "--baseline-dir" && !value.empty()) {
+                baseline_dir = value;
+            } else if (argument == "--update") {
+                update = true;
+            } else if (key == "--max-slowdown" && !value.empty()) {
+                budget.max_slowdown = parse_fraction(key, value);
+            } else if (key == "--alpha" && !value.empty()) {
+                budget.alpha = parse_fraction(key, value);
+            } else if (key == "--min-effect" && !value.empty()) {
+                budget.min_effect_size = parse_fraction(key, value);
+            } else if (argument.compare(0, 2, "--") == 0) {
+                throw std::invalid_argument("Unknown argument: " + argument);
+            } else {
+                reports.push_back(argument);
+            }
+        }
+        if (reports.empty()) {
+            throw std::invalid_argument("No benchmark reports given");
+        }
+
+        clwe::BenchmarkBaseline candidate;
+        for (const std::string& path : reports) {
+            candidate.merge(clwe::BenchmarkBaseline::from_report_json(read_file(path)));
+        }
+
+        clwe::BaselineStore store(baseline_dir);
+        clwe::BenchmarkBaseline baseline;
+        bool found = store.load(candidate.environment_key, baseline);
+        std::cout << "Environment: " << candidate.environment_key << std::endl;
+
+        if (!found || update) {
+            if (found) {
+                baseline.merge(candidate);
+            } else {
+                baseline = candidate;
+            }
+            store.save(baseline);
+            std::cout << (found ? "Baseline updated: " : "No baseline for this environment; recorded ")
+                      << store.path_for(baseline.environment_key) << std::endl;
+            return 0;
+        }
+
+        std::vector<clwe::BenchmarkComparison> comparisons = clwe::compare_benchmarks(baseline, candidate, budget);
+        std::cout << "Baseline: " << store.path_for(baseline.environment_key) << " (" << baseline.created
+                  << ", library " << baseline.library_version << ")" << std::endl;
+        clwe::print_comparisons(std::cout, comparisons);
+
+        if (clwe::has_regressions(comparisons)) {
+            std::cout << "\nPerformance regression beyond budget (slowdown > " << budget.max_slowdown * 100.0
+                      << "%, p < " << budget.alpha << ", effect >= " << budget.min_effect_size << ")" << std::endl;
+            return 2;
+        }
+        std::cout << "\nNo regressions beyond budget" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark comparison error: " << e.what() << std::endl;
+        return 1;
+    }
+}
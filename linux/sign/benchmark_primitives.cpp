@@ -0,0 +1,266 @@
+#include "src/include/clwe/benchmark.hpp"
+#include "src/include/clwe/color_integration.hpp"
+#include "src/include/clwe/cose.hpp"
+#include "src/include/clwe/keygen.hpp"
+#include "src/include/clwe/ntt_engine.hpp"
+#include "src/include/clwe/parameters.hpp"
+#include "src/include/clwe/polyvec.hpp"
+#include "src/include/clwe/sign.hpp"
+#include "src/include/clwe/utils.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Microbenchmarks of the primitives behind keygen, sign and verify: Keccak and SHAKE, the
+// samplers, high bits, ML-DSA packing, NTT multiply, the color encoders and COSE_Sign1 CBOR.
+// Each case reports cycles per byte or per coefficient so that an optimization of one
+// primitive can be measured in isolation.
+//
+// Usage: benchmark_primitives [--quick] [--min-time=<s>] [--filter=<substring>] [--json=<path>]
+
+namespace {
+
+const size_t SHAKE_INPUT_SIZES[] = {32, 136, 1024, 64 * 1024};
+const size_t COSE_PAYLOAD_SIZES[] = {32, 1024, 64 * 1024};
+const uint32_t PACKING_WIDTHS[] = {10, 13, 18, 20};   // ML-DSA widths with dedicated kernels
+
+// Random coefficients in [0, modulus)
+void fill_random(clwe::PolyVec& poly_vector, uint32_t modulus, std::mt19937& rng) {
+    std::uniform_int_distribution<uint32_t> coefficient(0, modulus - 1);
+    for (size_t i = 0; i < poly_vector.coeff_count(); ++i) {
+        poly_vector.data()[i] = coefficient(rng);
+    }
+}
+
+// Coefficients in (-bound, bound), stored mod `modulus`
+void fill_bounded(clwe::PolyVec& poly_vector, uint32_t bound, uint32_t modulus, std::mt19937& rng) {
+    std::uniform_int_distribution<int32_t> coefficient(-static_cast<int32_t>(bound) + 1, static_cast<int32_t>(bound) - 1);
+    for (size_t i = 0; i < poly_vector.coeff_count(); ++i) {
+        int32_t value = coefficient(rng);
+        poly_vector.data()[i] = value < 0 ? static_cast<uint32_t>(value + static_cast<int32_t>(modulus))
+                                          : static_cast<uint32_t>(value);
+    }
+}
+
+// Inputs and outputs shared by the cases of one security level
+struct LevelFixture {
+    clwe::CLWEParameters params;
+    std::string level_label;
+    clwe::PolyVec w;                          // k polynomials, full range
+    clwe::PolyVec z;                          // l polynomials, |z| < gamma1
+    clwe::PolyVec s;                          // l polynomials, |s| <= eta
+    clwe::PolyVec unpacked;
+    std::vector<uint32_t> w1;
+    std::vector<uint32_t> poly;
+    std::vector<uint32_t> challenge;
+    std::vector<uint32_t> positions;
+    std::vector<uint8_t> seed;
+    std::vector<std::vector<uint8_t>> packed_ml_dsa;   // Per PACKING_WIDTHS entry: w below 16 bits, z above
+    std::vector<uint8_t> packed_gamma1;                // z as in FIPS 204 signatures
+    std::vector<uint8_t> packed_t1;                    // t1 of w, as in Power2Round public keys
+    std::vector<uint8_t> packed_eta;                   // s as in packed-secret private keys
+    std::vector<uint8_t> packed;
+    std::vector<uint8_t> colors;
+    std::vector<uint8_t> colors_compressed;
+    std::unique_ptr<clwe::NTTEngine> ntt;
+    std::vector<uint32_t> ntt_a, ntt_b, ntt_result;
+
+    LevelFixture(uint32_t level, std::mt19937& rng)
+        : params(level), level_label(std::to_string(level)),
+          w(params.module_rank, params.degree), z(params.repetitions, params.degree),
+          s(params.repetitions, params.degree), unpacked(params.module_rank, params.degree),
+          w1(params.module_rank * params.degree), poly(params.degree), challenge(params.degree), seed(32, 0x3C),
+          ntt(clwe::create_optimal_ntt_engine(params.modulus, params.degree)),
+          ntt_a(params.degree), ntt_b(params.degree), ntt_result(params.degree) {
+        fill_random(w, params.modulus, rng);
+        fill_bounded(z, params.gamma1, params.modulus, rng);
+        fill_bounded(s, params.eta + 1, params.modulus, rng);
+        std::uniform_int_distribution<uint32_t> coefficient(0, params.modulus - 1);
+        for (uint32_t i = 0; i < params.degree; ++i) {
+            ntt_a[i] = coefficient(rng);
+            ntt_b[i] = coefficient(rng);
+        }
+        for (uint32_t d : PACKING_WIDTHS) {
+            packed_ml_dsa.push_back(clwe::pack_polynomial_vector_ml_dsa(d < 16 ? w : z, params.modulus, d));
+            packed.resize(std::max(packed.size(), packed_ml_dsa.back().size()));
+        }
+        packed_gamma1.resize(clwe::gamma1_packed_size(z.size(), z.degree(), params.gamma1));
+        clwe::pack_polynomial_vector_gamma1(z, params.modulus, params.gamma1, packed_gamma1.data());
+        packed.resize(std::max(packed.size(), packed_gamma1.size()));
+        clwe::PolyVec t1(w.size(), w.degree());
+        clwe::PolyVec t0(w.size(), w.degree());
+        clwe::power2round(w, params.modulus, t1, t0);
+        packed_t1.resize(clwe::t1_packed_size(t1.size(), t1.degree()));
+        clwe::pack_polynomial_vector_t1(t1, packed_t1.data());
+        packed_eta.resize(clwe::eta_packed_size(s.size(), s.degree(), params.eta));
+        clwe::pack_polynomial_vector_eta(s, params.modulus, params.eta, packed_eta.data());
+        colors = clwe::encode_polynomial_vector_as_colors(w, params.modulus);
+        colors_compressed = clwe::encode_polynomial_vector_as_colors_compressed(s, params.modulus);
+    }
+};
+
+void add_keccak_cases(clwe::BenchmarkSuite& suite, std::vector<std::unique_ptr<std::vector<uint8_t>>>& inputs) {
+    static uint64_t state[25] = {0};
+    // One permutation processes one SHAKE256 rate block of 136 bytes
+    suite.add("keccak_f1600", {}, []() { clwe::keccak_f1600(state); }, 136);
+
+    for (size_t size : SHAKE_INPUT_SIZES) {
+        inputs.push_back(std::make_unique<std::vector<uint8_t>>(size, 0xA5));
+        const std::vector<uint8_t>& input = *inputs.back();
+        suite.add("shake256", {{"input_bytes", std::to_string(size)}, {"output_bytes", "64"}},
+                  [&input]() { clwe::shake256(input, 64); }, size);
+    }
+    inputs.push_back(std::make_unique<std::vector<uint8_t>>(32, 0x5A));
+    const std::vector<uint8_t>& seed = *inputs.back();
+    suite.add("shake256", {{"input_bytes", "32"}, {"output_bytes", "4096"}},
+              [&seed]() { clwe::shake256(seed, 4096); }, 4096);
+}
+
+void add_level_cases(clwe::BenchmarkSuite& suite, LevelFixture& f) {
+    const clwe::CLWEParameters& p = f.params;
+    const clwe::MetricLabels level = {{"level", f.level_label}};
+    const uint64_t n = p.degree;
+
+    // Matrix expansion: one polynomial of uniform coefficients from a fresh SHAKE128 stream
+    suite.add("shake128_sample_uniform", level, [&f, &p]() {
+        clwe::SHAKE128Sampler sampler;
+        sampler.init(f.seed.data(), f.seed.size());
+        for (uint32_t i = 0; i < p.degree; ++i) {
+            f.poly[i] = sampler.sample_uniform(p.modulus);
+        }
+    }, n, "coeff");
+
+    suite.add("sample_polynomial_binomial", {{"level", f.level_label}, {"eta", std::to_string(p.eta)}}, [&f, &p]() {
+        clwe::SHAKE256Sampler sampler;
+        sampler.init(f.seed.data(), f.seed.size());
+        sampler.sample_polynomial_binomial(f.poly.data(), p.degree, p.eta, p.modulus);
+    }, n, "coeff");
+
+    suite.add("sample_challenge", {{"level", f.level_label}, {"tau", std::to_string(p.tau)}}, [&f, &p]() {
+        ++f.seed[0];
+        clwe::sample_challenge(f.challenge, f.seed.data(), f.seed.size(), p.tau, p.degree, p.modulus, f.positions);
+    }, n, "coeff");
+
+    suite.add("compute_high_bits", level, [&f]() {
+        clwe::compute_high_bits(f.w.data(), f.w1.data(), f.w.coeff_count(), 13);
+    }, f.w.coeff_count(), "coeff");
+
+    for (size_t i = 0; i < std::size(PACKING_WIDTHS); ++i) {
+        uint32_t d = PACKING_WIDTHS[i];
+        clwe::PolyVec& source = d < 16 ? f.w : f.z;
+        clwe::PolyVec& target = d < 16 ? f.unpacked : f.z;
+        const std::vector<uint8_t>& packed = f.packed_ml_dsa[i];
+        const clwe::MetricLabels labels = {{"level", f.level_label}, {"d", std::to_string(d)}};
+        suite.add("pack_ml_dsa", labels, [&f, &p, &source, d]() {
+            clwe::pack_polynomial_vector_ml_dsa(source, p.modulus, d, f.packed.data());
+        }, source.coeff_count(), "coeff");
+        suite.add("unpack_ml_dsa", labels, [&p, &packed, &target, d]() {
+            clwe::unpack_polynomial_vector_ml_dsa(packed.data(), packed.size(), p.modulus, d, target);
+        }, target.coeff_count(), "coeff");
+    }
+    suite.add("pack_gamma1", level, [&f, &p]() {
+        clwe::pack_polynomial_vector_gamma1(f.z, p.modulus, p.gamma1, f.packed.data());
+    }, f.z.coeff_count(), "coeff");
+    suite.add("unpack_gamma1", level, [&f, &p]() {
+        clwe::unpack_polynomial_vector_gamma1(f.packed_gamma1.data(), f.packed_gamma1.size(), p.modulus, p.gamma1, f.z);
+    }, f.z.coeff_count(), "coeff");
+    suite.add("unpack_t1", level, [&f]() {
+        clwe::unpack_polynomial_vector_t1(f.packed_t1.data(), f.packed_t1.size(), f.unpacked);
+    }, f.unpacked.coeff_count(), "coeff");
+    suite.add("unpack_eta", level, [&f, &p]() {
+        clwe::unpack_polynomial_vector_eta(f.packed_eta.data(), f.packed_eta.size(), p.modulus, p.eta, f.s);
+    }, f.s.coeff_count(), "coeff");
+
+    suite.add("ntt_multiply", level, [&f]() {
+        f.ntt->multiply(f.ntt_a.data(), f.ntt_b.data(), f.ntt_result.data());
+    }, n, "coeff");
+
+    suite.add("encode_colors", level, [&f, &p]() {
+        clwe::encode_polynomial_vector_as_colors(f.w, p.modulus);
+    }, f.w.coeff_count(), "coeff");
+    suite.add("decode_colors", level, [&f, &p]() {
+        clwe::decode_colors_to_polynomial_vector(f.colors.data(), f.colors.size(), p.modulus, f.unpacked);
+    }, f.w.coeff_count(), "coeff");
+    // The compressed color format targets small coefficients such as the secret vectors
+    suite.add("encode_colors_compressed", level, [&f, &p]() {
+        clwe::encode_polynomial_vector_as_colors_compressed(f.s, p.modulus);
+    }, f.s.coeff_count(), "coeff");
+    suite.add("decode_colors_compressed", level, [&f, &p]() {
+        clwe::decode_colors_to_polynomial_vector_compressed(f.colors_compressed, p.modulus, f.s);
+    }, f.s.coeff_count(), "coeff");
+}
+
+struct CoseFixture {
+    clwe::COSE_Sign1 message;
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> frame;   // Preallocated output for encode_into
+};
+
+void add_cose_cases(clwe::BenchmarkSuite& suite, std::vector<std::unique_ptr<CoseFixture>>& fixtures) {
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    clwe::ColorSign signer(params);
+    auto [public_key, private_key] = keygen.generate_keypair();
+
+    for (size_t size : COSE_PAYLOAD_SIZES) {
+        fixtures.push_back(std::make_unique<CoseFixture>());
+        CoseFixture& fixture = *fixtures.back();
+        std::vector<uint8_t> payload(size, 0xC5);
+        fixture.message = signer.sign_message_cose(payload, private_key, public_key);
+        fixture.encoded = clwe::encode_cose_sign1(fixture.message);
+        fixture.frame.resize(fixture.encoded.size());
+
+        const clwe::MetricLabels labels = {{"level", "44"}, {"payload_bytes", std::to_string(size)}};
+        suite.add("encode_cose_sign1", labels, [&fixture]() {
+            clwe::encode_cose_sign1(fixture.message);
+        }, fixture.encoded.size());
+        suite.add("encode_cose_sign1/into", labels, [&fixture]() {
+            clwe::COSE_Sign1View(fixture.message).encode_into(fixture.frame.data(), fixture.frame.size());
+        }, fixture.encoded.size());
+        suite.add("decode_cose_sign1", labels, [&fixture]() {
+            clwe::decode_cose_sign1(fixture.encoded.data(), fixture.encoded.size());
+        }, fixture.encoded.size());
+        suite.add("decode_cose_sign1/view", labels, [&fixture]() {
+            clwe::COSE_Sign1View::parse(fixture.encoded.data(), fixture.encoded.size());
+        }, fixture.encoded.size());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        clwe::BenchmarkOptions options = clwe::BenchmarkOptions::from_args(argc, argv);
+        clwe::BenchmarkSuite suite("colorsign_primitives");
+        std::mt19937 rng(20240601);
+
+        std::vector<std::unique_ptr<std::vector<uint8_t>>> shake_inputs;
+        add_keccak_cases(suite, shake_inputs);
+
+        std::vector<std::unique_ptr<LevelFixture>> fixtures;
+        for (uint32_t level : {44u, 65u, 87u}) {
+            fixtures.push_back(std::make_unique<LevelFixture>(level, rng));
+            add_level_cases(suite, *fixtures.back());
+        }
+
+        std::vector<std::unique_ptr<CoseFixture>> cose_fixtures;
+        add_cose_cases(suite, cose_fixtures);
+
+        std::vector<clwe::BenchmarkResult> results = suite.run(options, &std::cerr);
+        clwe::BenchmarkSuite::print_results(std::cout, results);
+        if (!options.json_path.empty()) {
+            suite.write_json(options.json_path, results);
+            std::cout << "Results written to " << options.json_path << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+#include "src/include/clwe/benchmark.hpp"
+#include "src/include/clwe/keygen.hpp"
+#include "src/include/clwe/parameters.hpp"
+#include "src/include/clwe/sign.hpp"
+#include "src/include/clwe/verify.hpp"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Multi-threaded throughput of sign-only, verify-only and mixed (alternating sign and verify)
+// workloads at increasing thread counts. Every worker owns its signer, verifier and workspaces
+// and shares only the key pair, so the loss of efficiency as threads are added comes from the
+// library's shared state (metrics, security monitor, allocator) and from shared caches.
+//
+// Usage: benchmark_throughput [--quick] [--threads=1,2,4] [--duration=<s>] [--filter=<substring>]
+//                             [--no-pin] [--csv=<path>] [--json=<path>]
+
+namespace {
+
+const size_t MESSAGE_SIZE = 1024;
+
+struct LevelKeys {
+    clwe::CLWEParameters params;
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    std::vector<uint8_t> message;
+    clwe::ColorSignature signature;   // Signature of `message`
+
+    explicit LevelKeys(uint32_t level) : params(level), message(MESSAGE_SIZE, 0xAA) {
+        clwe::ColorSignKeyGen keygen(params);
+        std::tie(public_key, private_key) = keygen.generate_keypair();
+        signature = clwe::ColorSign(params).sign_message(message, private_key, public_key);
+    }
+};
+
+// Per-thread state, created on the worker thread
+struct Worker {
+    const LevelKeys& keys;
+    clwe::ColorSign signer;
+    clwe::ColorSignVerify verifier;
+    clwe::SignWorkspace sign_workspace;
+    clwe::VerifyWorkspace verify_workspace;
+    clwe::ColorSignature signature;
+    std::vector<uint8_t> message;
+    uint64_t counter;
+    bool sign_next = true;
+
+    Worker(const LevelKeys& level_keys, size_t thread_index)
+        : keys(level_keys), signer(keys.params), verifier(keys.params), sign_workspace(keys.params),
+          verify_workspace(keys.params), message(keys.message), counter(uint64_t(thread_index) << 40) {
+    }
+
+    // Each thread signs its own sequence of distinct messages
+    void sign() {
+        ++counter;
+        std::memcpy(message.data(), &counter, sizeof(counter));
+        signer.sign_message(message.data(), message.size(), keys.private_key, keys.public_key,
+                            sign_workspace, signature);
+    }
+
+    void verify() {
+        verifier.verify_signature(clwe::PublicKeyView(keys.public_key), clwe::SignatureView(keys.signature),
+                                  keys.message.data(), keys.message.size(), verify_workspace);
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        clwe::ThroughputOptions options = clwe::ThroughputOptions::from_args(argc, argv);
+        clwe::ThroughputBenchmark benchmark("colorsign_throughput");
+        std::vector<std::unique_ptr<LevelKeys>> levels;
+
+        for (uint32_t level : {44u, 65u, 87u}) {
+            levels.push_back(std::make_unique<LevelKeys>(level));
+            const LevelKeys& keys = *levels.back();
+            std::string suffix = "/level=" + std::to_string(level);
+
+            benchmark.add("sign" + suffix, [&keys](size_t thread_index) {
+                auto worker = std::make_shared<Worker>(keys, thread_index);
+                return [worker]() { worker->sign(); };
+            });
+            benchmark.add("verify" + suffix, [&keys](size_t thread_index) {
+                auto worker = std::make_shared<Worker>(keys, thread_index);
+                return [worker]() { worker->verify(); };
+            });
+            benchmark.add("mixed" + suffix, [&keys](size_t thread_index) {
+                auto worker = std::make_shared<Worker>(keys, thread_index);
+                return [worker]() {
+                    worker->sign_next ? worker->sign() : worker->verify();
+                    worker->sign_next = !worker->sign_next;
+                };
+            });
+        }
+
+        std::vector<clwe::ThroughputResult> results = benchmark.run(options, &std::cerr);
+        clwe::ThroughputBenchmark::print_results(std::cout, results);
+        if (!options.csv_path.empty()) {
+            clwe::ThroughputBenchmark::write_csv(options.csv_path, results);
+            std::cout << "Results written to " << options.csv_path << std::endl;
+        }
+        if (!options.json_path.empty()) {
+            benchmark.write_json(options.json_path, results);
+            std::cout << "Results written to " << options.json_path << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,128 @@
+#include "../include/clwe/allocation_profiler.hpp"
+#include <cstdlib>
+#include <new>
+
+// Replacement global operator new/delete that count every allocation through
+// AllocationProfiler and forward to malloc. Built as the colorsign_allocation_hooks object
+// library and linked only into profiling executables and the allocation budget test, so the
+// library itself never replaces the application's allocator.
+//
+// Each block carries a header holding the requested size, so deallocations are counted exactly
+// even through the unsized operator delete. The header is HEADER_SIZE bytes for ordinary
+// allocations and max(alignment, HEADER_SIZE) for over-aligned ones; the size always sits in
+// the 8 bytes just before the returned pointer.
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 16;   // Keeps the malloc alignment of 16 on x86-64 and AArch64
+
+size_t header_for(size_t alignment) {
+    return alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+}
+
+void* allocate(size_t size, size_t alignment) noexcept {
+    size_t header = header_for(alignment);
+    if (size > static_cast<size_t>(-1) - header) {
+        return nullptr;
+    }
+    void* block;
+    if (alignment > HEADER_SIZE) {
+        // aligned_alloc requires the size to be a multiple of the alignment
+        size_t total = (size + header + alignment - 1) / alignment * alignment;
+        block = std::aligned_alloc(alignment, total);
+    } else {
+        block = std::malloc(size + header);
+    }
+    if (block == nullptr) {
+        return nullptr;
+    }
+    unsigned char* user = static_cast<unsigned char*>(block) + header;
+    reinterpret_cast<size_t*>(user)[-1] = size;
+    clwe::AllocationProfiler::record_allocation(size);
+    return user;
+}
+
+void deallocate(void* pointer, size_t alignment) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    unsigned char* user = static_cast<unsigned char*>(pointer);
+    clwe::AllocationProfiler::record_deallocation(reinterpret_cast<size_t*>(user)[-1]);
+    std::free(user - header_for(alignment));
+}
+
+void* allocate_or_throw(size_t size, size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* pointer = allocate(size, alignment)) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocate_nothrow(size_t size, size_t alignment) noexcept {
+    try {
+        return allocate_or_throw(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+struct HooksInstaller {
+    HooksInstaller() { clwe::AllocationProfiler::mark_hooks_installed(); }
+};
+
+HooksInstaller installer;
+
+} // namespace
+
+void* operator new(size_t size) { return allocate_or_throw(size, 0); }
+void* operator new[](size_t size) { return allocate_or_throw(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, 0); }
+
+void operator delete(void* pointer) noexcept { deallocate(pointer, 0); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer, 0); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer, 0); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer, 0); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer, 0); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer, 0); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(pointer, static_cast<size_t>(alignment));
+}
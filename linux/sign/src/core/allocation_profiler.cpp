@@ -0,0 +1,89 @@
+#include "../include/clwe/allocation_profiler.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace clwe {
+
+namespace {
+
+// Plain thread_local PODs: the hooks run inside operator new, so touching the counters must
+// neither allocate nor run a TLS constructor
+struct ThreadAllocations {
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t allocated_bytes;
+    uint64_t freed_bytes;
+    int64_t live_bytes;
+    int64_t peak_live_bytes;
+};
+
+thread_local ThreadAllocations thread_allocations = {};
+
+std::atomic<bool> hooks_installed_flag{false};
+
+} // namespace
+
+bool AllocationProfiler::hooks_installed() {
+    return hooks_installed_flag.load(std::memory_order_relaxed);
+}
+
+AllocationStats AllocationProfiler::thread_totals() {
+    const ThreadAllocations& thread = thread_allocations;
+    AllocationStats stats;
+    stats.allocations = thread.allocations;
+    stats.deallocations = thread.deallocations;
+    stats.allocated_bytes = thread.allocated_bytes;
+    stats.freed_bytes = thread.freed_bytes;
+    stats.peak_live_bytes = static_cast<uint64_t>(std::max<int64_t>(thread.peak_live_bytes, 0));
+    return stats;
+}
+
+void AllocationProfiler::record_allocation(size_t bytes) noexcept {
+    ThreadAllocations& thread = thread_allocations;
+    thread.allocations++;
+    thread.allocated_bytes += bytes;
+    thread.live_bytes += static_cast<int64_t>(bytes);
+    if (thread.live_bytes > thread.peak_live_bytes) {
+        thread.peak_live_bytes = thread.live_bytes;
+    }
+}
+
+void AllocationProfiler::record_deallocation(size_t bytes) noexcept {
+    ThreadAllocations& thread = thread_allocations;
+    thread.deallocations++;
+    thread.freed_bytes += bytes;
+    thread.live_bytes -= static_cast<int64_t>(bytes);
+}
+
+void AllocationProfiler::mark_hooks_installed() noexcept {
+    hooks_installed_flag.store(true, std::memory_order_relaxed);
+}
+
+// The thread peak is lowered to the current live level for the lifetime of the scope, so the
+// peak reached inside it is measured from its own start; the destructor restores the larger of
+// the two peaks for any enclosing scope.
+AllocationScope::AllocationScope() {
+    ThreadAllocations& thread = thread_allocations;
+    start_ = AllocationProfiler::thread_totals();
+    start_live_ = thread.live_bytes;
+    outer_peak_ = thread.peak_live_bytes;
+    thread.peak_live_bytes = thread.live_bytes;
+}
+
+AllocationScope::~AllocationScope() {
+    ThreadAllocations& thread = thread_allocations;
+    thread.peak_live_bytes = std::max(thread.peak_live_bytes, outer_peak_);
+}
+
+AllocationStats AllocationScope::stats() const {
+    const ThreadAllocations& thread = thread_allocations;
+    AllocationStats stats;
+    stats.allocations = thread.allocations - start_.allocations;
+    stats.deallocations = thread.deallocations - start_.deallocations;
+    stats.allocated_bytes = thread.allocated_bytes - start_.allocated_bytes;
+    stats.freed_bytes = thread.freed_bytes - start_.freed_bytes;
+    stats.peak_live_bytes = static_cast<uint64_t>(std::max<int64_t>(thread.peak_live_bytes - start_live_, 0));
+    return stats;
+}
+
+} // namespace clwe
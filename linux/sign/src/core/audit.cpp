@@ -0,0 +1,375 @@
+#include "../include/clwe/audit.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clwe {
+
+namespace {
+
+constexpr char AUDIT_FILE_MAGIC[8] = {'C', 'L', 'W', 'E', 'A', 'U', 'D', 'T'};
+constexpr uint32_t AUDIT_FILE_VERSION = 1;
+constexpr size_t AUDIT_HEADER_BYTES = 64;
+constexpr size_t AUDIT_GROWTH_RECORDS = 16384;  // File grows ~1.1 MiB at a time
+constexpr size_t DRAIN_BATCH = 256;
+
+uint32_t current_thread_number() {
+    static std::atomic<uint32_t> next_thread{1};
+    thread_local uint32_t number = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return number;
+}
+
+uint64_t wall_clock_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+struct AuditRing::Cell {
+    std::atomic<uint64_t> sequence;
+    AuditRecord record;
+};
+
+AuditRing::AuditRing(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    cells_ = std::make_unique<Cell[]>(rounded);
+    mask_ = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AuditRing::~AuditRing() = default;
+
+// Bounded queue after D. Vyukov: each cell's sequence says whether it is free for the
+// producer at `pos` (sequence == pos) or holds the record for the consumer (pos + 1)
+bool AuditRing::try_push(AuditRecord& record) noexcept {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells_[pos & mask_];
+        uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    record.sequence = pos;
+    cell->record = record;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AuditRing::try_pop(AuditRecord& record) noexcept {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells_[pos & mask_];
+        uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Empty
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    record = cell->record;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+size_t AuditRing::size_approx() const noexcept {
+    uint64_t head = dequeue_pos_.load(std::memory_order_relaxed);
+    uint64_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
+
+bool AuditQuery::matches(const AuditRecord& record) const {
+    if (event && record.event != static_cast<uint16_t>(*event)) return false;
+    if (error_code && record.error_code != *error_code) return false;
+    return record.timestamp_ns >= from_ns && record.timestamp_ns <= to_ns;
+}
+
+struct AuditLogFile::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+    uint8_t reserved[AUDIT_HEADER_BYTES - 24];
+};
+
+AuditLogFile::AuditLogFile(const std::string& path, bool read_only)
+    : path_(path), read_only_(read_only) {
+    static_assert(sizeof(Header) == AUDIT_HEADER_BYTES, "Audit file header is 64 bytes");
+    fd_ = ::open(path.c_str(), read_only ? O_RDONLY | O_CLOEXEC : O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open audit file: " + path);
+    }
+
+    try {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            throw std::runtime_error("Failed to stat audit file: " + path);
+        }
+        size_t file_bytes = static_cast<size_t>(st.st_size);
+
+        if (file_bytes == 0 && !read_only_) {
+            Header fresh{};
+            std::memcpy(fresh.magic, AUDIT_FILE_MAGIC, sizeof(fresh.magic));
+            fresh.version = AUDIT_FILE_VERSION;
+            fresh.record_size = sizeof(AuditRecord);
+            file_bytes = AUDIT_HEADER_BYTES + AUDIT_GROWTH_RECORDS * sizeof(AuditRecord);
+            if (::ftruncate(fd_, static_cast<off_t>(file_bytes)) != 0 ||
+                ::pwrite(fd_, &fresh, sizeof(fresh), 0) != static_cast<ssize_t>(sizeof(fresh))) {
+                throw std::runtime_error("Failed to initialize audit file: " + path);
+            }
+        }
+        if (file_bytes < AUDIT_HEADER_BYTES) {
+            throw std::runtime_error("Not an audit file: " + path);
+        }
+
+        map(file_bytes);
+        const Header* h = header();
+        if (std::memcmp(h->magic, AUDIT_FILE_MAGIC, sizeof(h->magic)) != 0 ||
+            h->version != AUDIT_FILE_VERSION || h->record_size != sizeof(AuditRecord) ||
+            h->record_count > (mapped_bytes_ - AUDIT_HEADER_BYTES) / sizeof(AuditRecord)) {
+            throw std::runtime_error("Not an audit file: " + path);
+        }
+    } catch (...) {
+        if (mapping_) {
+            ::munmap(mapping_, mapped_bytes_);
+        }
+        ::close(fd_);
+        throw;
+    }
+}
+
+AuditLogFile::~AuditLogFile() {
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+    }
+    ::close(fd_);
+}
+
+void AuditLogFile::map(size_t bytes) {
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+        mapping_ = nullptr;
+    }
+    int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* region = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+    if (region == MAP_FAILED) {
+        throw std::runtime_error("Failed to map audit file: " + path_);
+    }
+    mapping_ = static_cast<uint8_t*>(region);
+    mapped_bytes_ = bytes;
+}
+
+AuditLogFile::Header* AuditLogFile::header() const {
+    return reinterpret_cast<Header*>(mapping_);
+}
+
+size_t AuditLogFile::size() const {
+    return static_cast<size_t>(header()->record_count);
+}
+
+const AuditRecord* AuditLogFile::begin() const {
+    return reinterpret_cast<const AuditRecord*>(mapping_ + AUDIT_HEADER_BYTES);
+}
+
+void AuditLogFile::append(const AuditRecord* records, size_t count) {
+    if (read_only_) {
+        throw std::logic_error("Append to read-only audit file");
+    }
+    if (count == 0) {
+        return;
+    }
+
+    size_t used = size();
+    size_t needed = AUDIT_HEADER_BYTES + (used + count) * sizeof(AuditRecord);
+    if (needed > mapped_bytes_) {
+        size_t grown = std::max(needed, mapped_bytes_ + AUDIT_GROWTH_RECORDS * sizeof(AuditRecord));
+        if (::ftruncate(fd_, static_cast<off_t>(grown)) != 0) {
+            throw std::runtime_error("Failed to grow audit file: " + path_);
+        }
+        map(grown);
+    }
+
+    std::memcpy(mapping_ + AUDIT_HEADER_BYTES + used * sizeof(AuditRecord), records, count * sizeof(AuditRecord));
+    // Publish the records only once they are fully written
+    std::atomic_thread_fence(std::memory_order_release);
+    header()->record_count = used + count;
+}
+
+void AuditLogFile::sync() {
+    if (mapping_ && !read_only_) {
+        ::msync(mapping_, mapped_bytes_, MS_SYNC);
+    }
+}
+
+std::vector<AuditRecord> AuditLogFile::query(const AuditQuery& query) const {
+    std::vector<AuditRecord> result;
+    for (const AuditRecord* record = begin(); record != end(); ++record) {
+        if (query.matches(*record)) {
+            result.push_back(*record);
+        }
+    }
+    return result;
+}
+
+size_t AuditLogFile::count(const AuditQuery& query) const {
+    return static_cast<size_t>(std::count_if(begin(), end(),
+                                             [&](const AuditRecord& record) { return query.matches(record); }));
+}
+
+AuditPipeline::AuditPipeline(const AuditPipelineConfig& config)
+    : ring_(config.ring_capacity),
+      file_(config.path),
+      flush_interval_(config.flush_interval),
+      flusher_(&AuditPipeline::flusher_loop, this) {
+}
+
+AuditPipeline::~AuditPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    flusher_.join();
+    drain();
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    file_.sync();
+}
+
+bool AuditPipeline::record(AuditEvent event, uint32_t error_code, uint64_t value,
+                           const char* detail, size_t detail_len) noexcept {
+    return record(event, error_code, value, detail, detail_len, wall_clock_ns());
+}
+
+bool AuditPipeline::record(AuditEvent event, uint32_t error_code, uint64_t value,
+                           const char* detail, size_t detail_len, uint64_t timestamp_ns) noexcept {
+    AuditRecord entry;
+    entry.timestamp_ns = timestamp_ns;
+    entry.event = static_cast<uint16_t>(event);
+    entry.detail_len = static_cast<uint16_t>(std::min(detail_len, AuditRecord::DETAIL_CAPACITY));
+    entry.error_code = error_code;
+    entry.thread_id = current_thread_number();
+    entry.reserved = 0;
+    entry.value = value;
+    if (entry.detail_len > 0) {
+        std::memcpy(entry.detail, detail, entry.detail_len);
+    }
+    std::memset(entry.detail + entry.detail_len, 0, AuditRecord::DETAIL_CAPACITY - entry.detail_len);
+
+    if (!ring_.try_push(entry)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        wake_.notify_one();
+        return false;
+    }
+    if (ring_.size_approx() >= ring_.capacity() / 2 &&
+        !wake_requested_.exchange(true, std::memory_order_relaxed)) {
+        wake_.notify_one();
+    }
+    return true;
+}
+
+void AuditPipeline::drain() {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    AuditRecord batch[DRAIN_BATCH];
+    while (true) {
+        size_t n = 0;
+        while (n < DRAIN_BATCH && ring_.try_pop(batch[n])) {
+            ++n;
+        }
+        if (n == 0) {
+            return;
+        }
+        file_.append(batch, n);
+        flushed_.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
+void AuditPipeline::flusher_loop() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, flush_interval_, [this] {
+            return stopping_ || wake_requested_.load(std::memory_order_relaxed);
+        });
+        wake_requested_.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        try {
+            drain();
+        } catch (const std::exception&) {
+            // Records stay in the ring (or are dropped once it fills); retry next period
+        }
+        lock.lock();
+    }
+}
+
+void AuditPipeline::flush() {
+    drain();
+}
+
+std::vector<AuditRecord> AuditPipeline::query(const AuditQuery& query) const {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    return file_.query(query);
+}
+
+size_t AuditPipeline::count(const AuditQuery& query) const {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    return file_.count(query);
+}
+
+AuditPipelineStats AuditPipeline::stats() const {
+    AuditPipelineStats stats;
+    stats.recorded = ring_.pushed();
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.flushed = flushed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+BinaryAuditMonitor::BinaryAuditMonitor(AuditPipeline& pipeline) : pipeline_(pipeline) {
+    timing_.set_max_log_size(0);
+}
+
+void BinaryAuditMonitor::log_event(const AuditEntry& entry) {
+    uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        entry.timestamp.time_since_epoch()).count());
+    pipeline_.record(entry.event_type, entry.error_code, 0, entry.details.data(), entry.details.size(),
+                     timestamp != 0 ? timestamp : wall_clock_ns());
+}
+
+void BinaryAuditMonitor::report_security_violation(SecurityError error, const std::string& details) {
+    pipeline_.record(AuditEvent::SECURITY_VIOLATION, static_cast<uint32_t>(error), 0,
+                     details.data(), details.size());
+}
+
+bool BinaryAuditMonitor::detect_timing_anomaly(const std::string& operation_name, uint64_t operation_time_ns) {
+    if (!timing_.detect_timing_anomaly(operation_name, operation_time_ns)) {
+        return false;
+    }
+    pipeline_.record(AuditEvent::TIMING_ANOMALY, static_cast<uint32_t>(SecurityError::TIMING_ATTACK_DETECTED),
+                     operation_time_ns, operation_name.data(), operation_name.size());
+    return true;
+}
+
+} // namespace clwe
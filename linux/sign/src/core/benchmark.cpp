@@ -0,0 +1,674 @@
+#include "../include/clwe/benchmark.hpp"
+#include "../include/clwe/metrics.hpp"
+#include "../include/clwe/performance_metrics.hpp"
+#include "../include/clwe/cpu_features.hpp"
+#include "../include/clwe/timing.hpp"
+#include "../include/clwe/version.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace clwe {
+
+namespace {
+
+constexpr size_t MAX_ITERATIONS_PER_SAMPLE = size_t(1) << 24;
+
+std::string host_name() {
+#ifdef __linux__
+    char name[256] = {0};
+    if (gethostname(name, sizeof(name) - 1) == 0) {
+        return name;
+    }
+#endif
+    return "unknown";
+}
+
+std::string utc_timestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return text;
+}
+
+std::string cpu_model_name() {
+#ifdef __linux__
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos && colon + 2 <= line.size()) {
+                return line.substr(colon + 2);
+            }
+        }
+    }
+#endif
+    return "unknown";
+}
+
+std::string compiler_name() {
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string library_build_flags() {
+    std::string flags;
+#if defined(__OPTIMIZE__)
+    flags += "optimized";
+#else
+    flags += "unoptimized";
+#endif
+#if defined(__AVX512F__)
+    flags += " avx512f";
+#endif
+#if defined(__AVX2__)
+    flags += " avx2";
+#endif
+#if defined(__ARM_NEON)
+    flags += " neon";
+#endif
+#if defined(__FAST_MATH__)
+    flags += " fast-math";
+#endif
+    flags += INSTRUMENTATION_ENABLED ? " instrumentation" : " no-instrumentation";
+    return flags;
+}
+
+// Shared "context" object of the JSON reports, followed by a comma
+void write_json_context(std::ostream& out, const std::string& suite) {
+    PerfEventGroup counters;
+    BenchmarkEnvironment environment = BenchmarkEnvironment::current();
+    out << "  \"context\": {\n"
+        << "    \"suite\": \"" << json::escape(suite) << "\",\n"
+        << "    \"library_version\": \"" << COLORSIGN_VERSION_STRING << "\",\n"
+        << "    \"date\": \"" << utc_timestamp() << "\",\n"
+        << "    \"host\": \"" << json::escape(host_name()) << "\",\n"
+        << "    \"cpu_model\": \"" << json::escape(environment.cpu_model) << "\",\n"
+        << "    \"cpu_features\": \"" << json::escape(environment.cpu_features) << "\",\n"
+        << "    \"compiler\": \"" << json::escape(environment.compiler) << "\",\n"
+        << "    \"build_flags\": \"" << json::escape(environment.build_flags) << "\",\n"
+        << "    \"build_info\": \"" << json::escape(environment.build_info) << "\",\n"
+        << "    \"environment_key\": \"" << json::escape(environment.key()) << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"cycle_source\": \"" << (counters.hardware() ? "perf_event" : "timestamp_counter") << "\",\n"
+        << "    \"instrumentation\": " << (INSTRUMENTATION_ENABLED ? "true" : "false") << "\n"
+        << "  },\n";
+}
+
+void write_text_file(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(contents.data(), static_cast<std::streamsize>(contents.size())) || !file.flush()) {
+        throw std::runtime_error("Failed to write benchmark results: " + path);
+    }
+}
+
+std::string csv_field(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (char ch : value) {
+        quoted += ch == '"' ? std::string("\"\"") : std::string(1, ch);
+    }
+    return quoted + "\"";
+}
+
+size_t cpu_count() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Best effort; an affinity failure (e.g. a restricted cpuset) leaves the thread unpinned
+void pin_current_thread(size_t cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Time `iterations` calls of `operation` in nanoseconds
+uint64_t time_batch(const BenchmarkSuite::Operation& operation, size_t iterations) {
+    uint64_t start = TimestampCounter::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        operation();
+    }
+    return TimestampCounter::to_ns(TimestampCounter::now() - start);
+}
+
+double parse_number(const std::string& argument, const std::string& value) {
+    try {
+        size_t used = 0;
+        double number = std::stod(value, &used);
+        if (used == value.size() && number >= 0) {
+            return number;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Invalid value for " + argument + ": " + value);
+}
+
+} // namespace
+
+namespace json {
+
+std::string escape(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size() + 2);
+    for (char ch : value) {
+        switch (ch) {
+            case '\\': escaped += "\\\\"; break;
+            case '"': escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", ch);
+                    escaped += code;
+                } else {
+                    escaped += ch;
+                }
+        }
+    }
+    return escaped;
+}
+
+std::string number(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+} // namespace json
+
+BenchmarkEnvironment BenchmarkEnvironment::current() {
+    BenchmarkEnvironment environment;
+    environment.cpu_model = cpu_model_name();
+    environment.cpu_features = CPUFeatureDetector::detect().to_string();
+    environment.compiler = compiler_name();
+    environment.build_flags = library_build_flags();
+    environment.build_info = get_build_info();
+    return environment;
+}
+
+std::string BenchmarkEnvironment::key() const {
+    return cpu_model + " | " + cpu_features + " | " + compiler + " | " + build_flags;
+}
+
+BenchmarkOptions BenchmarkOptions::from_args(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+        if (key == "--quick") {
+            options.min_time_s = 0.01;
+            options.min_samples = 5;
+            options.warmup_samples = 1;
+        } else if (key == "--min-time" && !value.empty()) {
+            options.min_time_s = parse_number(key, value);
+        } else if (key == "--min-samples" && !value.empty()) {
+            options.min_samples = std::max<size_t>(1, static_cast<size_t>(parse_number(key, value)));
+        } else if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--json" && !value.empty()) {
+            options.json_path = value;
+        } else {
+            throw std::invalid_argument("Unknown benchmark argument: " + argument);
+        }
+    }
+    return options;
+}
+
+std::string BenchmarkResult::full_name() const {
+    std::string full = name;
+    for (const auto& [key, value] : labels) {
+        full += "/" + key + "=" + value;
+    }
+    return full;
+}
+
+void summarize_benchmark(BenchmarkResult& result) {
+    const std::vector<double>& samples = result.samples_ns;
+    if (samples.empty()) {
+        return;
+    }
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+
+    result.mean_ns = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(n);
+    result.median_ns = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    result.p99_ns = sorted[std::min(n - 1, static_cast<size_t>(std::ceil(0.99 * static_cast<double>(n))) - 1)];
+    result.min_ns = sorted.front();
+    result.max_ns = sorted.back();
+
+    double variance = 0.0;
+    for (double sample : sorted) {
+        variance += (sample - result.mean_ns) * (sample - result.mean_ns);
+    }
+    result.stddev_ns = n > 1 ? std::sqrt(variance / static_cast<double>(n - 1)) : 0.0;
+    result.ops_per_sec = result.mean_ns > 0.0 ? 1e9 / result.mean_ns : 0.0;
+}
+
+BenchmarkSuite::BenchmarkSuite(std::string name) : name_(std::move(name)) {
+}
+
+void BenchmarkSuite::add(const std::string& name, const MetricLabels& labels, Operation operation,
+                         uint64_t units_per_op, const std::string& unit) {
+    cases_.push_back({name, labels, std::move(operation), units_per_op, unit});
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::run(const BenchmarkOptions& options, std::ostream* progress) const {
+    PerfEventGroup counters;
+    std::vector<BenchmarkResult> results;
+
+    for (const Case& benchmark : cases_) {
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.labels = benchmark.labels;
+        result.units_per_op = benchmark.units_per_op;
+        result.unit = benchmark.unit;
+        if (!options.filter.empty() && result.full_name().find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (progress) {
+            *progress << "Running " << result.full_name() << "..." << std::endl;
+        }
+
+        // Warm up and grow the batch until one sample is long enough to time reliably
+        size_t iterations = 1;
+        while (time_batch(benchmark.operation, iterations) < options.min_sample_ns &&
+               iterations < MAX_ITERATIONS_PER_SAMPLE) {
+            iterations *= 2;
+        }
+        for (size_t i = 0; i < options.warmup_samples; ++i) {
+            time_batch(benchmark.operation, iterations);
+        }
+        result.iterations_per_sample = iterations;
+
+        uint64_t budget_ns = static_cast<uint64_t>(options.min_time_s * 1e9);
+        uint64_t measured_ns = 0;
+        HardwareCounters start = counters.read();
+        while ((measured_ns < budget_ns || result.samples_ns.size() < options.min_samples) &&
+               result.samples_ns.size() < options.max_samples) {
+            uint64_t sample_ns = time_batch(benchmark.operation, iterations);
+            measured_ns += sample_ns;
+            result.samples_ns.push_back(static_cast<double>(sample_ns) / static_cast<double>(iterations));
+        }
+        HardwareCounters total = counters.read() - start;
+
+        summarize_benchmark(result);
+        result.cycles_per_op = static_cast<double>(total.cycles) /
+                               static_cast<double>(result.samples_ns.size() * iterations);
+        if (result.units_per_op > 0) {
+            result.cycles_per_unit = result.cycles_per_op / static_cast<double>(result.units_per_op);
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+void BenchmarkSuite::print_results(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    size_t name_width = 9;
+    for (const BenchmarkResult& result : results) {
+        name_width = std::max(name_width, result.full_name().size());
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::left << std::setw(static_cast<int>(name_width)) << "Benchmark" << std::right
+        << std::setw(9) << "Samples" << std::setw(13) << "Mean (us)" << std::setw(13) << "Median (us)"
+        << std::setw(13) << "p99 (us)" << std::setw(12) << "Ops/s" << std::setw(14) << "Cycles/op" << std::setw(16) << "Cycles/unit" << '\n';
+    out << std::fixed;
+    for (const BenchmarkResult& result : results) {
+        out << std::left << std::setw(static_cast<int>(name_width)) << result.full_name() << std::right
+            << std::setw(9) << result.samples_ns.size()
+            << std::setprecision(2)
+            << std::setw(13) << result.mean_ns / 1000.0
+            << std::setw(13) << result.median_ns / 1000.0
+            << std::setw(13) << result.p99_ns / 1000.0
+            << std::setprecision(1)
+            << std::setw(12) << result.ops_per_sec
+            << std::setprecision(0)
+            << std::setw(14) << result.cycles_per_op;
+        if (result.units_per_op > 0) {
+            std::ostringstream per_unit;
+            per_unit << std::fixed << std::setprecision(2) << result.cycles_per_unit << '/' << result.unit;
+            out << std::setw(16) << per_unit.str();
+        }
+        out << '\n';
+    }
+    out.flags(flags);
+}
+
+std::string BenchmarkSuite::to_json(const std::vector<BenchmarkResult>& results) const {
+    std::ostringstream out;
+    out << "{\n";
+    write_json_context(out, name_);
+    out << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\n"
+            << "      \"name\": \"" << json::escape(result.full_name()) << "\",\n"
+            << "      \"operation\": \"" << json::escape(result.name) << "\",\n"
+            << "      \"labels\": {";
+        for (size_t j = 0; j < result.labels.size(); ++j) {
+            out << (j ? ", " : "") << '"' << json::escape(result.labels[j].first) << "\": \""
+                << json::escape(result.labels[j].second) << '"';
+        }
+        out << "},\n"
+            << "      \"iterations_per_sample\": " << result.iterations_per_sample << ",\n"
+            << "      \"units_per_op\": " << result.units_per_op << ",\n"
+            << "      \"unit\": \"" << json::escape(result.unit) << "\",\n"
+            << "      \"samples\": " << result.samples_ns.size() << ",\n"
+            << "      \"mean_ns\": " << json::number(result.mean_ns) << ",\n"
+            << "      \"median_ns\": " << json::number(result.median_ns) << ",\n"
+            << "      \"p99_ns\": " << json::number(result.p99_ns) << ",\n"
+            << "      \"stddev_ns\": " << json::number(result.stddev_ns) << ",\n"
+            << "      \"min_ns\": " << json::number(result.min_ns) << ",\n"
+            << "      \"max_ns\": " << json::number(result.max_ns) << ",\n"
+            << "      \"ops_per_sec\": " << json::number(result.ops_per_sec) << ",\n"
+            << "      \"cycles_per_op\": " << json::number(result.cycles_per_op) << ",\n"
+            << "      \"cycles_per_unit\": " << json::number(result.cycles_per_unit) << ",\n"
+            << "      \"samples_ns\": [";
+        for (size_t j = 0; j < result.samples_ns.size(); ++j) {
+            out << (j ? "," : "") << json::number(result.samples_ns[j]);
+        }
+        out << "]\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+void BenchmarkSuite::write_json(const std::string& path, const std::vector<BenchmarkResult>& results) const {
+    write_text_file(path, to_json(results));
+}
+
+ThroughputOptions ThroughputOptions::from_args(int argc, char** argv) {
+    ThroughputOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+        if (key == "--quick") {
+            options.duration_s = 0.05;
+            options.warmup_s = 0.01;
+        } else if (key == "--threads" && !value.empty()) {
+            options.thread_counts.clear();
+            std::istringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                double threads = parse_number(key, item);
+                if (threads < 1 || threads != std::floor(threads)) {
+                    throw std::invalid_argument("Invalid value for --threads: " + value);
+                }
+                options.thread_counts.push_back(static_cast<size_t>(threads));
+            }
+        } else if (key == "--duration" && !value.empty()) {
+            options.duration_s = parse_number(key, value);
+        } else if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--no-pin" && equals == std::string::npos) {
+            options.pin_threads = false;
+        } else if (key == "--csv" && !value.empty()) {
+            options.csv_path = value;
+        } else if (key == "--json" && !value.empty()) {
+            options.json_path = value;
+        } else {
+            throw std::invalid_argument("Unknown benchmark argument: " + argument);
+        }
+    }
+    return options;
+}
+
+std::vector<size_t> ThroughputOptions::resolved_thread_counts() const {
+    std::vector<size_t> counts = thread_counts;
+    if (counts.empty()) {
+        size_t cpus = cpu_count();
+        for (size_t threads = 1; threads < cpus; threads *= 2) {
+            counts.push_back(threads);
+        }
+        counts.push_back(cpus);
+    }
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    return counts;
+}
+
+ThroughputBenchmark::ThroughputBenchmark(std::string name) : name_(std::move(name)) {
+}
+
+void ThroughputBenchmark::add(const std::string& workload, WorkerFactory factory) {
+    workloads_.push_back({workload, std::move(factory)});
+}
+
+std::vector<ThroughputResult> ThroughputBenchmark::run(const ThroughputOptions& options, std::ostream* progress) const {
+    std::vector<size_t> thread_counts = options.resolved_thread_counts();
+    std::vector<ThroughputResult> results;
+
+    for (const Workload& workload : workloads_) {
+        if (!options.filter.empty() && workload.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        size_t first = results.size();
+        for (size_t threads : thread_counts) {
+            if (progress) {
+                *progress << "Running " << workload.name << " with " << threads << " thread"
+                          << (threads == 1 ? "" : "s") << "..." << std::endl;
+            }
+            results.push_back(measure(workload, threads, options));
+        }
+
+        // Efficiency is relative to the per-thread rate at the smallest thread count
+        const ThroughputResult& base = results[first];
+        double base_rate = base.ops_per_sec / static_cast<double>(base.threads);
+        for (size_t i = first; i < results.size(); ++i) {
+            double rate = results[i].ops_per_sec / static_cast<double>(results[i].threads);
+            results[i].efficiency = base_rate > 0.0 ? rate / base_rate : 0.0;
+        }
+    }
+    return results;
+}
+
+ThroughputResult ThroughputBenchmark::measure(const Workload& workload, size_t threads,
+                                              const ThroughputOptions& options) const {
+    enum Phase : int { SETUP, WARMUP, MEASURE, STOP };
+    std::atomic<int> phase{SETUP};
+    std::atomic<size_t> ready{0};
+    LatencyHistogram latencies;
+    std::vector<uint64_t> operations(threads, 0);
+    std::vector<std::exception_ptr> errors(threads);
+    size_t cpus = cpu_count();
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            bool started = false;
+            try {
+                if (options.pin_threads) {
+                    pin_current_thread(t % cpus);
+                }
+                BenchmarkSuite::Operation operation = workload.factory(t);
+                started = true;
+                ready.fetch_add(1, std::memory_order_release);
+                while (phase.load(std::memory_order_acquire) == SETUP) {
+                    std::this_thread::yield();
+                }
+
+                // Only operations started inside the measuring window are counted
+                uint64_t count = 0;
+                int current;
+                while ((current = phase.load(std::memory_order_relaxed)) != STOP) {
+                    uint64_t start = TimestampCounter::now();
+                    operation();
+                    if (current == MEASURE) {
+                        latencies.record(TimestampCounter::to_ns(TimestampCounter::now() - start));
+                        ++count;
+                    }
+                }
+                operations[t] = count;
+            } catch (...) {
+                errors[t] = std::current_exception();
+                phase.store(STOP, std::memory_order_release);
+                if (!started) {
+                    ready.fetch_add(1, std::memory_order_release);
+                }
+            }
+        });
+    }
+
+    while (ready.load(std::memory_order_acquire) < threads) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Phase changes never move backwards, so a failed worker's STOP is kept
+    auto advance = [&phase](int from, int to) { phase.compare_exchange_strong(from, to); };
+    advance(SETUP, WARMUP);
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.warmup_s));
+    advance(WARMUP, MEASURE);
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.duration_s));
+    advance(MEASURE, STOP);
+    auto end = std::chrono::steady_clock::now();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    ThroughputResult result;
+    result.workload = workload.name;
+    result.threads = threads;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.operations = std::accumulate(operations.begin(), operations.end(), uint64_t(0));
+    result.ops_per_sec = static_cast<double>(result.operations) / result.seconds;
+    auto [min_ops, max_ops] = std::minmax_element(operations.begin(), operations.end());
+    result.min_thread_ops_per_sec = static_cast<double>(*min_ops) / result.seconds;
+    result.max_thread_ops_per_sec = static_cast<double>(*max_ops) / result.seconds;
+
+    LatencyHistogram::Snapshot snapshot = latencies.snapshot();
+    result.p50_ns = snapshot.percentile(0.50);
+    result.p99_ns = snapshot.percentile(0.99);
+    result.p999_ns = snapshot.percentile(0.999);
+    result.max_ns = snapshot.max_ns;
+    return result;
+}
+
+void ThroughputBenchmark::print_results(std::ostream& out, const std::vector<ThroughputResult>& results) {
+    size_t name_width = 8;
+    for (const ThroughputResult& result : results) {
+        name_width = std::max(name_width, result.workload.size());
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::left << std::setw(static_cast<int>(name_width)) << "Workload" << std::right
+        << std::setw(9) << "Threads" << std::setw(13) << "Ops/s" << std::setw(12) << "Efficiency"
+        << std::setw(13) << "p50 (us)" << std::setw(13) << "p99 (us)" << std::setw(13) << "p99.9 (us)"
+        << std::setw(13) << "Max (us)" << '\n';
+    out << std::fixed;
+    for (const ThroughputResult& result : results) {
+        out << std::left << std::setw(static_cast<int>(name_width)) << result.workload << std::right
+            << std::setw(9) << result.threads
+            << std::setprecision(1) << std::setw(13) << result.ops_per_sec
+            << std::setprecision(2) << std::setw(12) << result.efficiency
+            << std::setw(13) << static_cast<double>(result.p50_ns) / 1000.0
+            << std::setw(13) << static_cast<double>(result.p99_ns) / 1000.0
+            << std::setw(13) << static_cast<double>(result.p999_ns) / 1000.0
+            << std::setw(13) << static_cast<double>(result.max_ns) / 1000.0 << '\n';
+    }
+    out.flags(flags);
+}
+
+std::string ThroughputBenchmark::to_csv(const std::vector<ThroughputResult>& results) {
+    std::ostringstream out;
+    out << "workload,threads,operations,seconds,ops_per_sec,efficiency,min_thread_ops_per_sec,"
+           "max_thread_ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns\n";
+    for (const ThroughputResult& result : results) {
+        out << csv_field(result.workload) << ',' << result.threads << ',' << result.operations << ','
+            << json::number(result.seconds) << ',' << json::number(result.ops_per_sec) << ','
+            << json::number(result.efficiency) << ',' << json::number(result.min_thread_ops_per_sec) << ','
+            << json::number(result.max_thread_ops_per_sec) << ',' << result.p50_ns << ',' << result.p99_ns << ','
+            << result.p999_ns << ',' << result.max_ns << '\n';
+    }
+    return out.str();
+}
+
+std::string ThroughputBenchmark::to_json(const std::vector<ThroughputResult>& results) const {
+    std::ostringstream out;
+    out << "{\n";
+    write_json_context(out, name_);
+    out << "  \"throughput\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ThroughputResult& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {"
+            << "\"workload\": \"" << json::escape(result.workload) << "\", "
+            << "\"threads\": " << result.threads << ", "
+            << "\"operations\": " << result.operations << ", "
+            << "\"seconds\": " << json::number(result.seconds) << ", "
+            << "\"ops_per_sec\": " << json::number(result.ops_per_sec) << ", "
+            << "\"efficiency\": " << json::number(result.efficiency) << ", "
+            << "\"min_thread_ops_per_sec\": " << json::number(result.min_thread_ops_per_sec) << ", "
+            << "\"max_thread_ops_per_sec\": " << json::number(result.max_thread_ops_per_sec) << ", "
+            << "\"p50_ns\": " << result.p50_ns << ", "
+            << "\"p99_ns\": " << result.p99_ns << ", "
+            << "\"p999_ns\": " << result.p999_ns << ", "
+            << "\"max_ns\": " << result.max_ns << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+void ThroughputBenchmark::write_csv(const std::string& path, const std::vector<ThroughputResult>& results) {
+    write_text_file(path, to_csv(results));
+}
+
+void ThroughputBenchmark::write_json(const std::string& path, const std::vector<ThroughputResult>& results) const {
+    write_text_file(path, to_json(results));
+}
+
+} // namespace clwe
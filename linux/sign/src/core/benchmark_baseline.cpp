@@ -0,0 +1,580 @@
+#include "../include/clwe/benchmark_baseline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace clwe {
+
+namespace {
+
+// Minimal JSON document model, enough for the benchmark reports and baselines
+struct JsonValue {
+    enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& [name, value] : members) {
+            if (name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+
+    const JsonValue& at(const std::string& key, Type expected) const {
+        const JsonValue* value = find(key);
+        if (!value || value->type != expected) {
+            throw std::invalid_argument("JSON: missing or mistyped member \"" + key + "\"");
+        }
+        return *value;
+    }
+
+    std::string string_or(const std::string& key, const std::string& fallback) const {
+        const JsonValue* value = find(key);
+        return value && value->type == Type::STRING ? value->string : fallback;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text_(text) {
+    }
+
+    JsonValue parse() {
+        JsonValue value = parse_value(0);
+        skip_whitespace();
+        if (pos_ != text_.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    static constexpr size_t MAX_DEPTH = 32;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::invalid_argument("JSON: " + what + " at offset " + std::to_string(pos_));
+    }
+
+    void skip_whitespace() {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\n' ||
+                                       text_[pos_] == '\r' || text_[pos_] == '\t')) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char expected) {
+        skip_whitespace();
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char expected) {
+        if (!consume(expected)) {
+            fail(std::string("expected '") + expected + "'");
+        }
+    }
+
+    bool consume_literal(const char* literal) {
+        size_t length = std::char_traits<char>::length(literal);
+        if (text_.compare(pos_, length, literal) == 0) {
+            pos_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parse_value(size_t depth) {
+        if (depth > MAX_DEPTH) {
+            fail("nesting too deep");
+        }
+        skip_whitespace();
+        if (pos_ >= text_.size()) {
+            fail("unexpected end of input");
+        }
+
+        JsonValue value;
+        char ch = text_[pos_];
+        if (ch == '{') {
+            ++pos_;
+            value.type = JsonValue::Type::OBJECT;
+            if (!consume('}')) {
+                do {
+                    skip_whitespace();
+                    std::string key = parse_string();
+                    expect(':');
+                    value.members.emplace_back(std::move(key), parse_value(depth + 1));
+                } while (consume(','));
+                expect('}');
+            }
+        } else if (ch == '[') {
+            ++pos_;
+            value.type = JsonValue::Type::ARRAY;
+            if (!consume(']')) {
+                do {
+                    value.items.push_back(parse_value(depth + 1));
+                } while (consume(','));
+                expect(']');
+            }
+        } else if (ch == '"') {
+            value.type = JsonValue::Type::STRING;
+            value.string = parse_string();
+        } else if (consume_literal("true")) {
+            value.type = JsonValue::Type::BOOLEAN;
+            value.boolean = true;
+        } else if (consume_literal("false")) {
+            value.type = JsonValue::Type::BOOLEAN;
+        } else if (consume_literal("null")) {
+            value.type = JsonValue::Type::NUL;
+        } else {
+            const char* start = text_.c_str() + pos_;
+            char* end = nullptr;
+            value.number = std::strtod(start, &end);
+            if (end == start) {
+                fail("invalid value");
+            }
+            value.type = JsonValue::Type::NUMBER;
+            pos_ += static_cast<size_t>(end - start);
+        }
+        return value;
+    }
+
+    std::string parse_string() {
+        if (pos_ >= text_.size() || text_[pos_] != '"') {
+            fail("expected string");
+        }
+        ++pos_;
+        std::string result;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char ch = text_[pos_++];
+            if (ch != '\\') {
+                result += ch;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                break;
+            }
+            char escape = text_[pos_++];
+            switch (escape) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': {
+                    // The writers only escape control characters, so code points stay below 0x80
+                    if (pos_ + 4 > text_.size()) {
+                        fail("truncated escape");
+                    }
+                    unsigned long code = std::strtoul(text_.substr(pos_, 4).c_str(), nullptr, 16);
+                    if (code >= 0x80) {
+                        fail("unsupported escape");
+                    }
+                    result += static_cast<char>(code);
+                    pos_ += 4;
+                    break;
+                }
+                default:
+                    fail("invalid escape");
+            }
+        }
+        if (pos_ >= text_.size()) {
+            fail("unterminated string");
+        }
+        ++pos_;
+        return result;
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+double median_of(const std::vector<double>& samples) {
+    BenchmarkResult result;
+    result.samples_ns = samples;
+    summarize_benchmark(result);
+    return result.median_ns;
+}
+
+// Standard normal upper tail
+double normal_sf(double z) {
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char ch : text) {
+        hash ^= ch;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::vector<BenchmarkResult> parse_benchmarks(const JsonValue& array) {
+    std::vector<BenchmarkResult> results;
+    for (const JsonValue& entry : array.items) {
+        BenchmarkResult result;
+        result.name = entry.at("name", JsonValue::Type::STRING).string;
+        for (const JsonValue& sample : entry.at("samples_ns", JsonValue::Type::ARRAY).items) {
+            if (sample.type != JsonValue::Type::NUMBER) {
+                throw std::invalid_argument("JSON: non-numeric sample in \"" + result.name + "\"");
+            }
+            result.samples_ns.push_back(sample.number);
+        }
+        summarize_benchmark(result);
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+BenchmarkEnvironment parse_environment(const JsonValue& object) {
+    BenchmarkEnvironment environment;
+    environment.cpu_model = object.string_or("cpu_model", "unknown");
+    environment.cpu_features = object.string_or("cpu_features", "unknown");
+    environment.compiler = object.string_or("compiler", "unknown");
+    environment.build_flags = object.string_or("build_flags", "unknown");
+    environment.build_info = object.string_or("build_info", "");
+    return environment;
+}
+
+} // namespace
+
+MannWhitneyResult mann_whitney_u(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+    MannWhitneyResult result;
+    size_t n1 = baseline.size();
+    size_t n2 = candidate.size();
+    if (n1 == 0 || n2 == 0) {
+        return result;
+    }
+
+    // Rank the pooled samples, giving tied values their average rank
+    std::vector<std::pair<double, bool>> pooled;   // (value, from candidate)
+    pooled.reserve(n1 + n2);
+    for (double value : baseline) {
+        pooled.emplace_back(value, false);
+    }
+    for (double value : candidate) {
+        pooled.emplace_back(value, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double candidate_rank_sum = 0.0;
+    double tie_term = 0.0;   // Sum of t^3 - t over tie groups
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            ++j;
+        }
+        double rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2.0;
+        for (size_t k = i; k < j; ++k) {
+            if (pooled[k].second) {
+                candidate_rank_sum += rank;
+            }
+        }
+        double t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double a = static_cast<double>(n1);
+    double b = static_cast<double>(n2);
+    double n = a + b;
+    result.u = candidate_rank_sum - b * (b + 1.0) / 2.0;
+    result.effect_size = 2.0 * result.u / (a * b) - 1.0;
+
+    double mean = a * b / 2.0;
+    double variance = a * b / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return result;   // Every sample identical
+    }
+    double deviation = result.u - mean;
+    double continuity = deviation > 0 ? -0.5 : (deviation < 0 ? 0.5 : 0.0);
+    result.z = (deviation + continuity) / std::sqrt(variance);
+    result.p_value = std::min(1.0, 2.0 * normal_sf(std::fabs(result.z)));
+    return result;
+}
+
+const char* comparison_verdict_name(ComparisonVerdict verdict) {
+    switch (verdict) {
+        case ComparisonVerdict::UNCHANGED: return "unchanged";
+        case ComparisonVerdict::IMPROVED: return "improved";
+        case ComparisonVerdict::REGRESSED: return "REGRESSED";
+        case ComparisonVerdict::NEW: return "new";
+        case ComparisonVerdict::MISSING: return "missing";
+    }
+    return "unknown";
+}
+
+const BenchmarkBaseline::Suite* BenchmarkBaseline::find_suite(const std::string& name) const {
+    for (const Suite& suite : suites) {
+        if (suite.name == name) {
+            return &suite;
+        }
+    }
+    return nullptr;
+}
+
+std::string BenchmarkBaseline::to_json() const {
+    std::ostringstream out;
+    out << "{\n"
+        << "  \"format_version\": " << FORMAT_VERSION << ",\n"
+        << "  \"environment_key\": \"" << json::escape(environment_key) << "\",\n"
+        << "  \"environment\": {\n"
+        << "    \"cpu_model\": \"" << json::escape(environment.cpu_model) << "\",\n"
+        << "    \"cpu_features\": \"" << json::escape(environment.cpu_features) << "\",\n"
+        << "    \"compiler\": \"" << json::escape(environment.compiler) << "\",\n"
+        << "    \"build_flags\": \"" << json::escape(environment.build_flags) << "\",\n"
+        << "    \"build_info\": \"" << json::escape(environment.build_info) << "\"\n"
+        << "  },\n"
+        << "  \"library_version\": \"" << json::escape(library_version) << "\",\n"
+        << "  \"created\": \"" << json::escape(created) << "\",\n"
+        << "  \"suites\": [";
+    for (size_t i = 0; i < suites.size(); ++i) {
+        out << (i ? ",\n" : "\n") << "    {\n"
+            << "      \"name\": \"" << json::escape(suites[i].name) << "\",\n"
+            << "      \"benchmarks\": [";
+        const std::vector<BenchmarkResult>& results = suites[i].results;
+        for (size_t j = 0; j < results.size(); ++j) {
+            out << (j ? ",\n" : "\n") << "        {\"name\": \"" << json::escape(results[j].full_name())
+                << "\", \"samples_ns\": [";
+            for (size_t k = 0; k < results[j].samples_ns.size(); ++k) {
+                out << (k ? "," : "") << json::number(results[j].samples_ns[k]);
+            }
+            out << "]}";
+        }
+        out << "\n      ]\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+BenchmarkBaseline BenchmarkBaseline::from_json(const std::string& text) {
+    JsonValue root = JsonParser(text).parse();
+    if (root.type != JsonValue::Type::OBJECT) {
+        throw std::invalid_argument("JSON: baseline is not an object");
+    }
+    double version = root.at("format_version", JsonValue::Type::NUMBER).number;
+    if (version != FORMAT_VERSION) {
+        throw std::invalid_argument("Unsupported benchmark baseline format_version " + json::number(version));
+    }
+
+    BenchmarkBaseline baseline;
+    baseline.environment_key = root.at("environment_key", JsonValue::Type::STRING).string;
+    baseline.environment = parse_environment(root.at("environment", JsonValue::Type::OBJECT));
+    baseline.library_version = root.string_or("library_version", "");
+    baseline.created = root.string_or("created", "");
+    for (const JsonValue& suite : root.at("suites", JsonValue::Type::ARRAY).items) {
+        baseline.suites.push_back({suite.at("name", JsonValue::Type::STRING).string,
+                                   parse_benchmarks(suite.at("benchmarks", JsonValue::Type::ARRAY))});
+    }
+    return baseline;
+}
+
+BenchmarkBaseline BenchmarkBaseline::from_report_json(const std::string& text) {
+    JsonValue root = JsonParser(text).parse();
+    if (root.type != JsonValue::Type::OBJECT) {
+        throw std::invalid_argument("JSON: benchmark report is not an object");
+    }
+    const JsonValue& context = root.at("context", JsonValue::Type::OBJECT);
+
+    BenchmarkBaseline baseline;
+    baseline.environment = parse_environment(context);
+    baseline.environment_key = context.string_or("environment_key", baseline.environment.key());
+    baseline.library_version = context.string_or("library_version", "");
+    baseline.created = context.string_or("date", "");
+    baseline.suites.push_back({context.at("suite", JsonValue::Type::STRING).string,
+                               parse_benchmarks(root.at("benchmarks", JsonValue::Type::ARRAY))});
+    return baseline;
+}
+
+void BenchmarkBaseline::merge(const BenchmarkBaseline& other) {
+    if (environment_key.empty()) {
+        environment_key = other.environment_key;
+        environment = other.environment;
+    } else if (environment_key != other.environment_key) {
+        throw std::invalid_argument("Cannot merge benchmark results from different environments: \"" +
+                                    environment_key + "\" and \"" + other.environment_key + "\"");
+    }
+    library_version = other.library_version;
+    created = std::max(created, other.created);
+    for (const Suite& suite : other.suites) {
+        auto existing = std::find_if(suites.begin(), suites.end(),
+                                     [&suite](const Suite& s) { return s.name == suite.name; });
+        if (existing != suites.end()) {
+            *existing = suite;
+        } else {
+            suites.push_back(suite);
+        }
+    }
+}
+
+BaselineStore::BaselineStore(std::string directory) : directory_(std::move(directory)) {
+}
+
+std::string BaselineStore::path_for(const std::string& environment_key) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "baseline-%016llx.json",
+                  static_cast<unsigned long long>(fnv1a(environment_key)));
+    return directory_.empty() ? std::string(name) : directory_ + "/" + name;
+}
+
+bool BaselineStore::load(const std::string& environment_key, BenchmarkBaseline& baseline) const {
+    std::string path = path_for(environment_key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    if (file.bad()) {
+        throw std::runtime_error("Failed to read benchmark baseline: " + path);
+    }
+    try {
+        baseline = BenchmarkBaseline::from_json(contents.str());
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error("Invalid benchmark baseline " + path + ": " + e.what());
+    }
+    if (baseline.environment_key != environment_key) {
+        throw std::runtime_error("Benchmark baseline " + path + " belongs to another environment: " +
+                                 baseline.environment_key);
+    }
+    return true;
+}
+
+void BaselineStore::save(const BenchmarkBaseline& baseline) const {
+    std::string path = path_for(baseline.environment_key);
+    std::string temporary = path + ".tmp";
+    std::string json = baseline.to_json();
+    std::error_code error;
+    if (!directory_.empty()) {
+        std::filesystem::create_directories(directory_, error);
+    }
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(json.data(), static_cast<std::streamsize>(json.size())) || !file.flush()) {
+            throw std::runtime_error("Failed to write benchmark baseline: " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to replace benchmark baseline: " + path);
+    }
+}
+
+std::vector<BenchmarkComparison> compare_benchmarks(const BenchmarkBaseline& baseline,
+                                                    const BenchmarkBaseline& candidate,
+                                                    const RegressionBudget& budget) {
+    std::vector<BenchmarkComparison> comparisons;
+    for (const BenchmarkBaseline::Suite& suite : candidate.suites) {
+        const BenchmarkBaseline::Suite* reference = baseline.find_suite(suite.name);
+        std::map<std::string, const BenchmarkResult*> previous;
+        if (reference) {
+            for (const BenchmarkResult& result : reference->results) {
+                previous[result.full_name()] = &result;
+            }
+        }
+
+        for (const BenchmarkResult& result : suite.results) {
+            BenchmarkComparison comparison;
+            comparison.suite = suite.name;
+            comparison.name = result.full_name();
+            comparison.candidate_median_ns = median_of(result.samples_ns);
+
+            auto match = previous.find(comparison.name);
+            if (match == previous.end()) {
+                comparison.verdict = ComparisonVerdict::NEW;
+                comparisons.push_back(comparison);
+                continue;
+            }
+            const BenchmarkResult& old = *match->second;
+            previous.erase(match);
+
+            comparison.baseline_median_ns = median_of(old.samples_ns);
+            comparison.change = comparison.baseline_median_ns > 0.0
+                                    ? comparison.candidate_median_ns / comparison.baseline_median_ns - 1.0
+                                    : 0.0;
+            comparison.test = mann_whitney_u(old.samples_ns, result.samples_ns);
+
+            bool significant = comparison.test.p_value < budget.alpha;
+            if (significant && comparison.test.effect_size >= budget.min_effect_size &&
+                comparison.change > budget.max_slowdown) {
+                comparison.verdict = ComparisonVerdict::REGRESSED;
+            } else if (significant && comparison.test.effect_size <= -budget.min_effect_size &&
+                       comparison.change < -budget.max_slowdown) {
+                comparison.verdict = ComparisonVerdict::IMPROVED;
+            }
+            comparisons.push_back(comparison);
+        }
+
+        // Cases that exist only in the baseline, in baseline order
+        if (reference) {
+            for (const BenchmarkResult& result : reference->results) {
+                if (previous.count(result.full_name())) {
+                    BenchmarkComparison comparison;
+                    comparison.suite = suite.name;
+                    comparison.name = result.full_name();
+                    comparison.verdict = ComparisonVerdict::MISSING;
+                    comparison.baseline_median_ns = median_of(result.samples_ns);
+                    comparisons.push_back(comparison);
+                }
+            }
+        }
+    }
+    return comparisons;
+}
+
+bool has_regressions(const std::vector<BenchmarkComparison>& comparisons) {
+    return std::any_of(comparisons.begin(), comparisons.end(), [](const BenchmarkComparison& comparison) {
+        return comparison.verdict == ComparisonVerdict::REGRESSED;
+    });
+}
+
+void print_comparisons(std::ostream& out, const std::vector<BenchmarkComparison>& comparisons) {
+    size_t name_width = 9;
+    for (const BenchmarkComparison& comparison : comparisons) {
+        name_width = std::max(name_width, comparison.name.size());
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::string suite;
+    out << std::fixed;
+    for (const BenchmarkComparison& comparison : comparisons) {
+        if (comparison.suite != suite) {
+            suite = comparison.suite;
+            out << '\n' << suite << '\n'
+                << std::left << std::setw(static_cast<int>(name_width)) << "Benchmark" << std::right
+                << std::setw(15) << "Baseline (us)" << std::setw(15) << "Current (us)" << std::setw(10)
+                << "Change" << std::setw(10) << "p-value" << std::setw(9) << "Effect" << "  Verdict\n";
+        }
+        out << std::left << std::setw(static_cast<int>(name_width)) << comparison.name << std::right
+            << std::setprecision(2)
+            << std::setw(15) << comparison.baseline_median_ns / 1000.0
+            << std::setw(15) << comparison.candidate_median_ns / 1000.0
+            << std::setprecision(1) << std::setw(9) << comparison.change * 100.0 << '%'
+            << std::setprecision(4) << std::setw(10) << comparison.test.p_value
+            << std::setprecision(2) << std::setw(9) << comparison.test.effect_size
+            << "  " << comparison_verdict_name(comparison.verdict) << '\n';
+    }
+    out.flags(flags);
+}
+
+} // namespace clwe
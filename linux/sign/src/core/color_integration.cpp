@@ -35,41 +35,50 @@ std::vector<uint32_t> decode_colors_to_polynomial(const std::vector<uint8_t>& co
 }
 
 std::vector<uint8_t> encode_polynomial_vector_as_colors(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
-    std::vector<uint8_t> color_data;
+    return encode_polynomial_vector_as_colors(PolyVec::from_vectors(poly_vector), modulus);
+}
 
-    for (const auto& poly : poly_vector) {
-        auto poly_colors = encode_polynomial_as_colors(poly, modulus);
-        color_data.insert(color_data.end(), poly_colors.begin(), poly_colors.end());
+std::vector<uint8_t> encode_polynomial_vector_as_colors(const PolyVec& poly_vector, uint32_t modulus) {
+    const uint32_t* coeffs = poly_vector.data();
+    std::vector<uint8_t> color_data(poly_vector.coeff_count());
+
+    for (size_t i = 0; i < color_data.size(); ++i) {
+        // Pack coefficient into RGB format (take lower 8 bits)
+        color_data[i] = (coeffs[i] % modulus) & 0xFF;
     }
 
     return color_data;
 }
 
 std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data, uint32_t k, uint32_t n, uint32_t modulus) {
-    size_t total_coeffs = k * n;
-    if (color_data.size() != total_coeffs) {
-        throw std::invalid_argument("Color data size does not match expected dimensions");
-    }
+    PolyVec poly_vector(k, n);
+    decode_colors_to_polynomial_vector(color_data, modulus, poly_vector);
+    return poly_vector.to_vectors();
+}
 
-    std::vector<std::vector<uint32_t>> poly_vector(k, std::vector<uint32_t>(n));
+void decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data, uint32_t modulus, PolyVec& out) {
+    decode_colors_to_polynomial_vector(color_data.data(), color_data.size(), modulus, out);
+}
 
-    size_t coeff_idx = 0;
-    // Unpack from RGB format where each pixel contains up to 3 coefficients
-    for (size_t pixel_start = 0; pixel_start < color_data.size() && coeff_idx < total_coeffs; pixel_start += 3) {
-        size_t end = std::min(pixel_start + 3, color_data.size());
-        for (size_t b = pixel_start; b < end && coeff_idx < total_coeffs; ++b) {
-            size_t i = coeff_idx / n;
-            size_t j = coeff_idx % n;
-            poly_vector[i][j] = static_cast<uint32_t>(color_data[b]) % modulus;
-            ++coeff_idx;
-        }
+void decode_colors_to_polynomial_vector(const uint8_t* color_data, size_t size, uint32_t modulus, PolyVec& out) {
+    size_t total_coeffs = out.coeff_count();
+    if (size != total_coeffs) {
+        throw std::invalid_argument("Color data size does not match expected dimensions");
     }
 
-    return poly_vector;
+    // Each byte holds one coefficient; pixels group them three at a time (R, G, B)
+    uint32_t* coeffs = out.data();
+    for (size_t i = 0; i < total_coeffs; ++i) {
+        coeffs[i] = static_cast<uint32_t>(color_data[i]) % modulus;
+    }
 }
 
 // Compressed color encoding with variable-length encoding
 std::vector<uint8_t> encode_polynomial_vector_as_colors_compressed(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
+    return encode_polynomial_vector_as_colors_compressed(PolyVec::from_vectors(poly_vector), modulus);
+}
+
+std::vector<uint8_t> encode_polynomial_vector_as_colors_compressed(const PolyVec& poly_vector, uint32_t modulus) {
     // Use the compressed packing format but maintain color compatibility
     // The compressed format is still compatible with color visualization since we can decode it back
 
@@ -82,7 +91,7 @@ std::vector<uint8_t> encode_polynomial_vector_as_colors_compressed(const std::ve
 
     // Store number of polynomials and degree
     uint32_t k = poly_vector.size();
-    uint32_t n = k > 0 ? poly_vector[0].size() : 0;
+    uint32_t n = poly_vector.degree();
 
     compressed.push_back(static_cast<uint8_t>(k));
     compressed.push_back(static_cast<uint8_t>(n >> 8));
@@ -121,6 +130,15 @@ std::vector<uint8_t> encode_polynomial_vector_as_colors_compressed(const std::ve
 
 // Decode color-compatible compressed data back to polynomial vector
 std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector_compressed(const std::vector<uint8_t>& color_data, uint32_t k, uint32_t n, uint32_t modulus) {
+    PolyVec poly_vector(k, n);
+    decode_colors_to_polynomial_vector_compressed(color_data, modulus, poly_vector);
+    return poly_vector.to_vectors();
+}
+
+void decode_colors_to_polynomial_vector_compressed(const std::vector<uint8_t>& color_data, uint32_t modulus, PolyVec& poly_vector) {
+    uint32_t k = poly_vector.size();
+    uint32_t n = poly_vector.degree();
+
     if (color_data.size() < 5) {
         throw std::invalid_argument("Compressed color data too small");
     }
@@ -144,8 +162,6 @@ std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector_compressed
         throw std::invalid_argument("Dimension mismatch in compressed color data");
     }
 
-    std::vector<std::vector<uint32_t>> poly_vector(k, std::vector<uint32_t>(n, 0));
-
     // Decode color-compatible compressed data
     for (uint32_t i = 0; i < k; ++i) {
         for (uint32_t j = 0; j < n; ++j) {
@@ -178,14 +194,13 @@ std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector_compressed
             poly_vector[i][j] = coeff % modulus;
         }
     }
-
-    return poly_vector;
 }
 
 // Convert compressed polynomial data to standard color format for visualization
 std::vector<uint8_t> convert_compressed_to_color_format(const std::vector<uint8_t>& compressed_data, uint32_t k, uint32_t n, uint32_t modulus) {
     // First decode the compressed data
-    auto poly_vector = decode_colors_to_polynomial_vector_compressed(compressed_data, k, n, modulus);
+    PolyVec poly_vector(k, n);
+    decode_colors_to_polynomial_vector_compressed(compressed_data, modulus, poly_vector);
 
     // Then encode as standard color format
     return encode_polynomial_vector_as_colors(poly_vector, modulus);
@@ -193,6 +208,10 @@ std::vector<uint8_t> convert_compressed_to_color_format(const std::vector<uint8_
 
 // Auto-select best compression method for color integration
 std::vector<uint8_t> encode_polynomial_vector_as_colors_auto(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
+    return encode_polynomial_vector_as_colors_auto(PolyVec::from_vectors(poly_vector), modulus);
+}
+
+std::vector<uint8_t> encode_polynomial_vector_as_colors_auto(const PolyVec& poly_vector, uint32_t modulus) {
     // Count non-zero coefficients to determine sparsity
     size_t total_coeffs = 0;
     size_t non_zero_coeffs = 0;
@@ -261,7 +280,8 @@ std::vector<uint8_t> encode_polynomial_vector_as_colors_huffman(const std::vecto
 // On-demand color generation from compressed data
 std::vector<uint8_t> generate_color_representation_from_compressed(const std::vector<uint8_t>& compressed_data, uint32_t k, uint32_t n, uint32_t modulus) {
     // First decode the compressed data to polynomial vector
-    auto poly_vector = unpack_polynomial_vector_compressed(compressed_data, k, n, modulus);
+    PolyVec poly_vector(k, n);
+    unpack_polynomial_vector_compressed(compressed_data, modulus, poly_vector);
 
     // Then convert to standard color format for visualization
     return encode_polynomial_vector_as_colors(poly_vector, modulus);
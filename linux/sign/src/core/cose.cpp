@@ -8,141 +8,134 @@ namespace clwe {
 // CBOR encoding utilities implementation
 namespace cbor {
 
-std::vector<uint8_t> encode_uint(uint64_t value) {
-    std::vector<uint8_t> result;
-    if (value < 24) {
-        result.push_back(static_cast<uint8_t>(UNSIGNED_INT << 5) | static_cast<uint8_t>(value));
-    } else if (value <= 0xFF) {
-        result.push_back(static_cast<uint8_t>(UNSIGNED_INT << 5) | 24);
-        result.push_back(static_cast<uint8_t>(value));
-    } else if (value <= 0xFFFF) {
-        result.push_back(static_cast<uint8_t>(UNSIGNED_INT << 5) | 25);
-        result.push_back(static_cast<uint8_t>(value >> 8));
-        result.push_back(static_cast<uint8_t>(value & 0xFF));
-    } else if (value <= 0xFFFFFFFF) {
-        result.push_back(static_cast<uint8_t>(UNSIGNED_INT << 5) | 26);
-        for (int i = 24; i >= 0; i -= 8) {
-            result.push_back(static_cast<uint8_t>((value >> i) & 0xFF));
-        }
-    } else {
-        result.push_back(static_cast<uint8_t>(UNSIGNED_INT << 5) | 27);
-        for (int i = 56; i >= 0; i -= 8) {
-            result.push_back(static_cast<uint8_t>((value >> i) & 0xFF));
-        }
+size_t head_size(uint64_t argument) {
+    if (argument < 24) return 1;
+    if (argument <= 0xFF) return 2;
+    if (argument <= 0xFFFF) return 3;
+    if (argument <= 0xFFFFFFFF) return 5;
+    return 9;
+}
+
+size_t encode_head(MajorType major, uint64_t argument, uint8_t* out) {
+    size_t size = head_size(argument);
+    uint8_t type = static_cast<uint8_t>(major << 5);
+    if (size == 1) {
+        out[0] = type | static_cast<uint8_t>(argument);
+        return 1;
+    }
+
+    // Additional information 24..27 selects a 1, 2, 4 or 8-byte big-endian argument
+    static const uint8_t additional[] = {0, 24, 25, 0, 26, 0, 0, 0, 27};
+    out[0] = type | additional[size - 1];
+    for (size_t i = 1; i < size; ++i) {
+        out[i] = static_cast<uint8_t>(argument >> (8 * (size - 1 - i)));
     }
+    return size;
+}
+
+uint64_t decode_head(const uint8_t* data, size_t size, size_t& offset, MajorType expected) {
+    if (offset >= size) throw std::invalid_argument("CBOR decode: out of bounds");
+    uint8_t initial = data[offset++];
+    if ((initial >> 5) != expected) throw std::invalid_argument("CBOR decode: unexpected major type");
+    uint8_t minor = initial & 0x1F;
+    if (minor < 24) return minor;
+    if (minor > 27) throw std::invalid_argument("CBOR decode: indefinite or reserved length not supported");
+
+    size_t bytes = size_t(1) << (minor - 24);
+    if (bytes > size - offset) throw std::invalid_argument("CBOR decode: incomplete head");
+    uint64_t argument = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        argument = (argument << 8) | data[offset++];
+    }
+    return argument;
+}
+
+size_t bstr_size(size_t len) {
+    return head_size(len) + len;
+}
+
+size_t encode_bstr(const uint8_t* data, size_t len, uint8_t* out) {
+    size_t head = encode_head(BYTE_STRING, len, out);
+    std::copy(data, data + len, out + head);
+    return head + len;
+}
+
+ByteSpan decode_bstr_view(const uint8_t* data, size_t size, size_t& offset) {
+    uint64_t len = decode_head(data, size, offset, BYTE_STRING);
+    if (len > size - offset) throw std::invalid_argument("CBOR decode: bstr data incomplete");
+    ByteSpan contents(data + offset, static_cast<size_t>(len));
+    offset += static_cast<size_t>(len);
+    return contents;
+}
+
+std::vector<uint8_t> encode_uint(uint64_t value) {
+    std::vector<uint8_t> result(head_size(value));
+    encode_head(UNSIGNED_INT, value, result.data());
     return result;
 }
 
 std::vector<uint8_t> encode_bstr(const std::vector<uint8_t>& data) {
-    std::vector<uint8_t> result;
-    size_t len = data.size();
-    if (len < 24) {
-        result.push_back(static_cast<uint8_t>(BYTE_STRING << 5) | static_cast<uint8_t>(len));
-    } else if (len <= 0xFF) {
-        result.push_back(static_cast<uint8_t>(BYTE_STRING << 5) | 24);
-        result.push_back(static_cast<uint8_t>(len));
-    } else if (len <= 0xFFFF) {
-        result.push_back(static_cast<uint8_t>(BYTE_STRING << 5) | 25);
-        result.push_back(static_cast<uint8_t>(len >> 8));
-        result.push_back(static_cast<uint8_t>(len & 0xFF));
-    } else {
-        // For simplicity, assume len <= 0xFFFFFFFF
-        result.push_back(static_cast<uint8_t>(BYTE_STRING << 5) | 26);
-        for (int i = 24; i >= 0; i -= 8) {
-            result.push_back(static_cast<uint8_t>((len >> i) & 0xFF));
-        }
-    }
-    result.insert(result.end(), data.begin(), data.end());
+    std::vector<uint8_t> result(bstr_size(data.size()));
+    encode_bstr(data.data(), data.size(), result.data());
     return result;
 }
 
 std::vector<uint8_t> encode_array(const std::vector<std::vector<uint8_t>>& items) {
-    std::vector<uint8_t> result;
-    size_t len = items.size();
-    if (len < 24) {
-        result.push_back(static_cast<uint8_t>(ARRAY << 5) | static_cast<uint8_t>(len));
-    } else {
-        // For simplicity, assume small arrays
-        result.push_back(static_cast<uint8_t>(ARRAY << 5) | 24);
-        result.push_back(static_cast<uint8_t>(len));
+    size_t size = head_size(items.size());
+    for (const auto& item : items) {
+        size += item.size();
     }
+    std::vector<uint8_t> result(size);
+    uint8_t* out = result.data() + encode_head(ARRAY, items.size(), result.data());
     for (const auto& item : items) {
-        result.insert(result.end(), item.begin(), item.end());
+        out = std::copy(item.begin(), item.end(), out);
     }
     return result;
 }
 
 std::vector<uint8_t> encode_map(const std::vector<std::pair<int, std::vector<uint8_t>>>& pairs) {
-    std::vector<uint8_t> result;
-    size_t len = pairs.size();
-    if (len < 24) {
-        result.push_back(static_cast<uint8_t>(MAP << 5) | static_cast<uint8_t>(len));
-    } else {
-        // Assume small maps
-        result.push_back(static_cast<uint8_t>(MAP << 5) | 24);
-        result.push_back(static_cast<uint8_t>(len));
+    size_t size = head_size(pairs.size());
+    for (const auto& pair : pairs) {
+        size += head_size(static_cast<uint64_t>(pair.first)) + pair.second.size();
     }
+    std::vector<uint8_t> result(size);
+    uint8_t* out = result.data() + encode_head(MAP, pairs.size(), result.data());
     for (const auto& pair : pairs) {
-        auto key_encoded = encode_uint(pair.first);
-        result.insert(result.end(), key_encoded.begin(), key_encoded.end());
-        result.insert(result.end(), pair.second.begin(), pair.second.end());
+        out += encode_head(UNSIGNED_INT, static_cast<uint64_t>(pair.first), out);
+        out = std::copy(pair.second.begin(), pair.second.end(), out);
     }
     return result;
 }
 
-// Basic decode functions (simplified)
 uint64_t decode_uint(const std::vector<uint8_t>& data, size_t& offset) {
-    if (offset >= data.size()) throw std::invalid_argument("CBOR decode: out of bounds");
-    uint8_t initial = data[offset++];
-    uint8_t major = initial >> 5;
-    uint8_t minor = initial & 0x1F;
-    if (major != UNSIGNED_INT) throw std::invalid_argument("CBOR decode: not unsigned int");
-    if (minor < 24) return minor;
-    if (minor == 24) {
-        if (offset >= data.size()) throw std::invalid_argument("CBOR decode: incomplete uint");
-        return data[offset++];
-    }
-    // Simplified, assume no larger
-    throw std::invalid_argument("CBOR decode: large uint not supported");
+    return decode_uint(data.data(), data.size(), offset);
 }
 
 std::vector<uint8_t> decode_bstr(const std::vector<uint8_t>& data, size_t& offset) {
-    if (offset >= data.size()) throw std::invalid_argument("CBOR decode: out of bounds");
-    uint8_t initial = data[offset++];
-    uint8_t major = initial >> 5;
-    uint8_t minor = initial & 0x1F;
-    if (major != BYTE_STRING) throw std::invalid_argument("CBOR decode: not byte string");
-    size_t len;
-    if (minor < 24) len = minor;
-    else if (minor == 24) {
-        if (offset >= data.size()) throw std::invalid_argument("CBOR decode: incomplete bstr len");
-        len = data[offset++];
-    } else {
-        throw std::invalid_argument("CBOR decode: large bstr not supported");
-    }
-    if (offset + len > data.size()) throw std::invalid_argument("CBOR decode: bstr data incomplete");
-    std::vector<uint8_t> result(data.begin() + offset, data.begin() + offset + len);
-    offset += len;
-    return result;
+    return decode_bstr(data.data(), data.size(), offset);
 }
 
 std::vector<std::vector<uint8_t>> decode_array(const std::vector<uint8_t>& data, size_t& offset) {
-    if (offset >= data.size()) throw std::invalid_argument("CBOR decode: out of bounds");
-    uint8_t initial = data[offset++];
-    uint8_t major = initial >> 5;
-    uint8_t minor = initial & 0x1F;
-    if (major != ARRAY) throw std::invalid_argument("CBOR decode: not array");
-    size_t len;
-    if (minor < 24) len = minor;
-    else if (minor == 24) {
-        if (offset >= data.size()) throw std::invalid_argument("CBOR decode: incomplete array len");
-        len = data[offset++];
-    } else {
-        throw std::invalid_argument("CBOR decode: large array not supported");
-    }
+    return decode_array(data.data(), data.size(), offset);
+}
+
+uint64_t decode_uint(const uint8_t* data, size_t size, size_t& offset) {
+    return decode_head(data, size, offset, UNSIGNED_INT);
+}
+
+std::vector<uint8_t> decode_bstr(const uint8_t* data, size_t size, size_t& offset) {
+    ByteSpan contents = decode_bstr_view(data, size, offset);
+    return std::vector<uint8_t>(contents.begin(), contents.end());
+}
+
+std::vector<std::vector<uint8_t>> decode_array(const uint8_t* data, size_t size, size_t& offset) {
+    uint64_t len = decode_head(data, size, offset, ARRAY);
+    // Every item takes at least one byte, which bounds the reservation by the input
+    if (len > size - offset) throw std::invalid_argument("CBOR decode: array data incomplete");
     std::vector<std::vector<uint8_t>> result;
-    for (size_t i = 0; i < len; ++i) {
-        result.push_back(decode_bstr(data, offset));  // Assume all bstr for COSE_Sign1
+    result.reserve(static_cast<size_t>(len));
+    for (uint64_t i = 0; i < len; ++i) {
+        result.push_back(decode_bstr(data, size, offset));  // Assume all bstr for COSE_Sign1
     }
     return result;
 }
@@ -173,38 +166,87 @@ COSE_Header decode_cose_header(const std::vector<uint8_t>& cbor_data) {
     return header;
 }
 
+COSE_Sign1View::COSE_Sign1View(const COSE_Sign1& cose_msg)
+    : protected_header(cose_msg.protected_header.data(), cose_msg.protected_header.size()),
+      unprotected_header(cose_msg.unprotected_header.data(), cose_msg.unprotected_header.size()),
+      payload(cose_msg.payload.data(), cose_msg.payload.size()),
+      signature(cose_msg.signature.data(), cose_msg.signature.size()) {
+}
+
+COSE_Sign1View COSE_Sign1View::parse(const uint8_t* data, size_t size) {
+    size_t offset = 0;
+    if (cbor::decode_head(data, size, offset, cbor::ARRAY) != 4) {
+        throw std::invalid_argument("COSE_Sign1 must have 4 elements");
+    }
+    COSE_Sign1View view;
+    view.protected_header = cbor::decode_bstr_view(data, size, offset);
+    view.unprotected_header = cbor::decode_bstr_view(data, size, offset);
+    view.payload = cbor::decode_bstr_view(data, size, offset);
+    view.signature = cbor::decode_bstr_view(data, size, offset);
+    if (offset != size) {
+        throw std::invalid_argument("COSE_Sign1 followed by trailing data");
+    }
+    return view;
+}
+
+size_t COSE_Sign1View::encoded_size() const {
+    return cbor::head_size(4) + cbor::bstr_size(protected_header.size()) + cbor::bstr_size(unprotected_header.size()) +
+           cbor::bstr_size(payload.size()) + cbor::bstr_size(signature.size());
+}
+
+size_t COSE_Sign1View::encode_into(uint8_t* out, size_t capacity) const {
+    if (capacity < encoded_size()) {
+        throw std::invalid_argument("COSE_Sign1 output buffer too small");
+    }
+    uint8_t* start = out;
+    out += cbor::encode_head(cbor::ARRAY, 4, out);
+    for (const ByteSpan& item : {protected_header, unprotected_header, payload, signature}) {
+        out += cbor::encode_bstr(item.data(), item.size(), out);
+    }
+    return static_cast<size_t>(out - start);
+}
+
+COSE_Sign1 COSE_Sign1View::to_cose_sign1() const {
+    COSE_Sign1 cose;
+    cose.protected_header.assign(protected_header.begin(), protected_header.end());
+    cose.unprotected_header.assign(unprotected_header.begin(), unprotected_header.end());
+    cose.payload.assign(payload.begin(), payload.end());
+    cose.signature.assign(signature.begin(), signature.end());
+    return cose;
+}
+
 // Encode COSE_Sign1 to CBOR
 std::vector<uint8_t> encode_cose_sign1(const COSE_Sign1& cose_msg) {
-    std::vector<std::vector<uint8_t>> items;
-    items.push_back(cbor::encode_bstr(cose_msg.protected_header));
-    items.push_back(cbor::encode_bstr(cose_msg.unprotected_header));
-    items.push_back(cbor::encode_bstr(cose_msg.payload));
-    items.push_back(cbor::encode_bstr(cose_msg.signature));
-    return cbor::encode_array(items);
+    COSE_Sign1View view(cose_msg);
+    std::vector<uint8_t> encoded(view.encoded_size());
+    view.encode_into(encoded.data(), encoded.size());
+    return encoded;
 }
 
 // Decode COSE_Sign1 from CBOR
 COSE_Sign1 decode_cose_sign1(const std::vector<uint8_t>& cbor_data) {
-    size_t offset = 0;
-    auto items = cbor::decode_array(cbor_data, offset);
-    if (items.size() != 4) throw std::invalid_argument("COSE_Sign1 must have 4 elements");
-    COSE_Sign1 cose;
-    cose.protected_header = items[0];
-    cose.unprotected_header = items[1];
-    cose.payload = items[2];
-    cose.signature = items[3];
-    return cose;
+    return decode_cose_sign1(cbor_data.data(), cbor_data.size());
+}
+
+COSE_Sign1 decode_cose_sign1(const uint8_t* cbor_data, size_t size) {
+    return COSE_Sign1View::parse(cbor_data, size).to_cose_sign1();
 }
 
 // Create COSE_Sign1 from ColorSignature and message
 COSE_Sign1 create_cose_sign1_from_colorsign(const std::vector<uint8_t>& message,
                                            const ColorSignature& signature,
                                            int alg) {
+    return create_cose_sign1_from_colorsign(message.data(), message.size(), signature, alg);
+}
+
+COSE_Sign1 create_cose_sign1_from_colorsign(const uint8_t* message, size_t message_len,
+                                           const ColorSignature& signature,
+                                           int alg) {
     COSE_Header header;
     header.alg = alg;
     std::vector<uint8_t> protected_cbor = encode_cose_header(header);
     std::vector<uint8_t> unprotected_cbor = cbor::encode_map({});  // Empty map
-    std::vector<uint8_t> payload = message;
+    std::vector<uint8_t> payload(message, message + message_len);
     std::vector<uint8_t> sig_bytes = signature.serialize();
     return COSE_Sign1(protected_cbor, unprotected_cbor, payload, sig_bytes);
 }
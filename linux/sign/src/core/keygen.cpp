@@ -2,6 +2,9 @@
 #include "../include/clwe/color_integration.hpp"
 #include "../include/clwe/utils.hpp"
 #include "../include/clwe/ntt_engine.hpp"
+#include "../include/clwe/metrics.hpp"
+#include "../include/clwe/performance_metrics.hpp"
+#include "../include/clwe/security_utils.hpp"
 #include <random>
 #include <cstring>
 #include <algorithm>
@@ -9,11 +12,51 @@
 #include <array>
 #include <iostream>
 #include <iomanip>
+#include <optional>
 
 namespace clwe {
 
+namespace {
+
+// Power2Round key material (KEY_FORMAT_POWER2ROUND): the public data is t1 packed at 10 bits,
+// tr = SHAKE256(rho || t1 packed) and t0 is appended to the packed s1 || s2 in `secret_data`
+void split_power2round_key(const PolyVec& t, const std::array<uint8_t, 32>& rho, uint32_t modulus,
+                           std::vector<uint8_t>& public_data, std::array<uint8_t, 64>& tr,
+                           std::vector<uint8_t>& secret_data) {
+    PolyVec t1(t.size(), t.degree());
+    PolyVec t0(t.size(), t.degree());
+    power2round(t, modulus, t1, t0);
+
+    public_data.resize(t1_packed_size(t.size(), t.degree()));
+    pack_polynomial_vector_t1(t1, public_data.data());
+
+    size_t secret_size = secret_data.size();
+    secret_data.resize(secret_size + gamma1_packed_size(t.size(), t.degree(), 1u << (POWER2ROUND_D - 1)));
+    pack_polynomial_vector_gamma1(t0, modulus, 1u << (POWER2ROUND_D - 1), secret_data.data() + secret_size);
+
+    SHAKE256Sampler hash;
+    hash.reset();
+    hash.absorb(rho.data(), rho.size());
+    hash.absorb(public_data.data(), public_data.size());
+    hash.pad_and_absorb();
+    hash.squeeze(tr.data(), tr.size());
+}
+
+// s1 || s2 of KEY_FORMAT_PACKED_SECRET keys: each vector packed exactly as eta - s, so that the
+// signer unpacks the halves in place
+std::vector<uint8_t> pack_secret_exact(const PolyVec& s1, const PolyVec& s2, uint32_t modulus, uint32_t eta) {
+    size_t half = eta_packed_size(s1.size(), s1.degree(), eta);
+    std::vector<uint8_t> packed(2 * half);
+    pack_polynomial_vector_eta(s1, modulus, eta, packed.data());
+    pack_polynomial_vector_eta(s2, modulus, eta, packed.data() + half);
+    return packed;
+}
+
+} // namespace
+
 ColorSignKeyGen::ColorSignKeyGen(const CLWEParameters& params)
-    : params_(params) {
+    : params_(params), fixed_level_(standard_parameter_set(params)),
+      metrics_(&SchemeMetrics::for_level(params.security_level)) {
     // Validate parameters
     if (params_.degree == 0 || params_.module_rank == 0) {
         throw std::invalid_argument("Invalid parameters: degree and module_rank must be positive");
@@ -22,13 +65,20 @@ ColorSignKeyGen::ColorSignKeyGen(const CLWEParameters& params)
 
 ColorSignKeyGen::~ColorSignKeyGen() = default;
 
+void ColorSignKeyGen::set_key_format_version(uint8_t version) {
+    if (version != KEY_FORMAT_ORIGINAL && !key_format_has_t1(version)) {
+        throw std::invalid_argument("Unsupported key format version: " + std::to_string(version));
+    }
+    key_format_version_ = version;
+}
+
 // Generate matrix A from rho using SHAKE128 with domain separation
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::generate_matrix_A(const std::array<uint8_t, 32>& rho) const {
+PolyMat ColorSignKeyGen::generate_matrix_A(const std::array<uint8_t, 32>& rho) const {
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    std::vector<std::vector<uint32_t>> matrix(k * k, std::vector<uint32_t>(n));
+    PolyMat matrix(k, k, n);
 
     for (uint32_t i = 0; i < k; ++i) {
         for (uint32_t j = 0; j < k; ++j) {
@@ -42,7 +92,7 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::generate_matrix_A(const std:
             sampler.init(domain_sep.data(), domain_sep.size());
 
             // Sample coefficients uniformly from [0, q)
-            uint32_t* coeffs = matrix[i * k + j].data();
+            uint32_t* coeffs = matrix(i, j).data();
             for (uint32_t l = 0; l < n; ++l) {
                 coeffs[l] = sampler.sample_uniform(q);
             }
@@ -53,32 +103,40 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::generate_matrix_A(const std:
 }
 
 // Sample s1 using SHAKE256 with K || 0
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::sample_s1(const std::array<uint8_t, 32>& K) const {
+PolyVec ColorSignKeyGen::sample_s1(const std::array<uint8_t, 32>& K, bool centered) const {
     std::vector<uint8_t> seed = std::vector<uint8_t>(K.begin(), K.end());
     seed.push_back(0);  // Domain separation for s1
 
     SHAKE256Sampler sampler;
     sampler.init(seed.data(), seed.size());
 
-    std::vector<std::vector<uint32_t>> s1(params_.module_rank, std::vector<uint32_t>(params_.degree));
-    for (auto& poly : s1) {
-        sampler.sample_polynomial_binomial(poly.data(), params_.degree, params_.eta, params_.modulus);
+    PolyVec s1(params_.module_rank, params_.degree);
+    for (auto poly : s1) {
+        if (centered) {
+            sampler.sample_polynomial_centered(poly.data(), params_.degree, params_.eta, params_.modulus);
+        } else {
+            sampler.sample_polynomial_binomial(poly.data(), params_.degree, params_.eta, params_.modulus);
+        }
     }
 
     return s1;
 }
 
 // Sample s2 using SHAKE256 with K || 1
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::sample_s2(const std::array<uint8_t, 32>& K) const {
+PolyVec ColorSignKeyGen::sample_s2(const std::array<uint8_t, 32>& K, bool centered) const {
     std::vector<uint8_t> seed = std::vector<uint8_t>(K.begin(), K.end());
     seed.push_back(1);  // Domain separation for s2
 
     SHAKE256Sampler sampler;
     sampler.init(seed.data(), seed.size());
 
-    std::vector<std::vector<uint32_t>> s2(params_.module_rank, std::vector<uint32_t>(params_.degree));
-    for (auto& poly : s2) {
-        sampler.sample_polynomial_binomial(poly.data(), params_.degree, params_.eta, params_.modulus);
+    PolyVec s2(params_.module_rank, params_.degree);
+    for (auto poly : s2) {
+        if (centered) {
+            sampler.sample_polynomial_centered(poly.data(), params_.degree, params_.eta, params_.modulus);
+        } else {
+            sampler.sample_polynomial_binomial(poly.data(), params_.degree, params_.eta, params_.modulus);
+        }
     }
 
     return s2;
@@ -87,11 +145,7 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::sample_s2(const std::array<u
 
 
 // Compute t = A * s1 + s2 mod q
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::compute_t(
-    const std::vector<std::vector<uint32_t>>& matrix_A,
-    const std::vector<std::vector<uint32_t>>& s1,
-    const std::vector<std::vector<uint32_t>>& s2) const {
-
+PolyVec ColorSignKeyGen::compute_t(const PolyMat& matrix_A, const PolyVec& s1, const PolyVec& s2) const {
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
@@ -99,19 +153,18 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::compute_t(
     // Create NTT engine
     auto ntt_engine = create_optimal_ntt_engine(q, n);
 
-    std::vector<std::vector<uint32_t>> public_key(k, std::vector<uint32_t>(n, 0));
+    PolyVec public_key(k, n);
+    std::vector<uint32_t> product(n);
 
     // First compute A * s1 using NTT
     for (uint32_t i = 0; i < k; ++i) {
-        std::vector<uint32_t> temp(n, 0);
+        PolySpan t_i = public_key[i];
         for (uint32_t m = 0; m < k; ++m) {
-            std::vector<uint32_t> product(n);
-            ntt_engine->multiply(matrix_A[i * k + m].data(), s1[m].data(), product.data());
+            ntt_engine->multiply(matrix_A(i, m).data(), s1[m].data(), product.data());
             for (uint32_t j = 0; j < n; ++j) {
-                temp[j] = (static_cast<uint64_t>(temp[j]) + product[j]) % q;
+                t_i[j] = (static_cast<uint64_t>(t_i[j]) + product[j]) % q;
             }
         }
-        public_key[i] = temp;
     }
 
     // Add s2: t = (A * s1) + s2 mod q
@@ -125,7 +178,7 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::compute_t(
 }
 
 // Compute tr = SHAKE256(pk) where pk = rho || pack(t)
-std::array<uint8_t, 64> ColorSignKeyGen::compute_tr(const std::vector<std::vector<uint32_t>>& t,
+std::array<uint8_t, 64> ColorSignKeyGen::compute_tr(const PolyVec& t,
                                                     const std::array<uint8_t, 32>& rho,
                                                     const std::array<uint8_t, 32>&) const {
     std::vector<uint8_t> packed_t = pack_polynomial_vector(t);
@@ -139,17 +192,19 @@ std::array<uint8_t, 64> ColorSignKeyGen::compute_tr(const std::vector<std::vecto
 }
 
 // Basic color encoding: use centralized color integration
-std::vector<uint8_t> ColorSignKeyGen::encode_polynomial_vector_as_colors(const std::vector<std::vector<uint32_t>>& poly_vector) const {
+std::vector<uint8_t> ColorSignKeyGen::encode_polynomial_vector_as_colors(const PolyVec& poly_vector) const {
     return clwe::encode_polynomial_vector_as_colors(poly_vector, params_.modulus);
 }
 
 // Basic color decoding: use centralized color integration
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data) const {
-    return clwe::decode_colors_to_polynomial_vector(color_data, params_.module_rank, params_.degree, params_.modulus);
+PolyVec ColorSignKeyGen::decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data) const {
+    PolyVec poly_vector(params_.module_rank, params_.degree);
+    clwe::decode_colors_to_polynomial_vector(color_data, params_.modulus, poly_vector);
+    return poly_vector;
 }
 
 // Helper method to unpack polynomial data (supports color, compressed, and standard formats)
-std::vector<std::vector<uint32_t>> ColorSignKeyGen::unpack_polynomial_data(const std::vector<uint8_t>& data, uint32_t k, uint32_t n) const {
+PolyVec ColorSignKeyGen::unpack_polynomial_data(const std::vector<uint8_t>& data, uint32_t k, uint32_t n) const {
     if (data.empty()) return {};
 
     // Check if this is 8-bit grayscale color data
@@ -157,21 +212,32 @@ std::vector<std::vector<uint32_t>> ColorSignKeyGen::unpack_polynomial_data(const
         // Color format - decode 8-bit grayscale pixels to polynomials
         return decode_colors_to_polynomial_vector(data);
     }
+
+    PolyVec poly_vector(k, n);
     // Check if this is compressed data
-    else if (data.size() >= 5 && data[0] == 0x01 && (data[1] == 0x01 || data[1] == 0x02 || data[1] == 0x03)) {
+    if (data.size() >= 5 && data[0] == 0x01 && (data[1] == 0x01 || data[1] == 0x02 || data[1] == 0x03)) {
         // Compressed format - use compressed unpacking
-        return unpack_polynomial_vector_compressed(data, k, n, params_.modulus);
+        unpack_polynomial_vector_compressed(data, params_.modulus, poly_vector);
     } else {
         // Standard ML-DSA format - use regular unpacking
-        return unpack_polynomial_vector(data, k, n);
+        unpack_polynomial_vector(data, poly_vector);
     }
+    return poly_vector;
 }
 
 // Helper method to pack polynomial data with auto-compression
-std::vector<uint8_t> ColorSignKeyGen::pack_polynomial_data(const std::vector<std::vector<uint32_t>>& poly_vector) const {
+std::vector<uint8_t> ColorSignKeyGen::pack_polynomial_data(const PolyVec& poly_vector) const {
     return pack_polynomial_vector_auto(poly_vector, params_.modulus);
 }
 
+// Pack s1 || s2 with ML-DSA compression for internal storage
+std::vector<uint8_t> ColorSignKeyGen::pack_secret_data(const PolyVec& s1, const PolyVec& s2) const {
+    PolyVec secret_polys(s1.size() + s2.size(), params_.degree);
+    std::copy(s1.data(), s1.data() + s1.coeff_count(), secret_polys.data());
+    std::copy(s2.data(), s2.data() + s2.coeff_count(), secret_polys.data() + s1.coeff_count());
+    return pack_polynomial_vector_ml_dsa(secret_polys, params_.modulus, 10);
+}
+
 // Generate keypair
 std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_keypair() {
     // Generate random rho and K
@@ -180,30 +246,7 @@ std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_key
     std::array<uint8_t, 32> K;
     secure_random_bytes(K.data(), K.size());
 
-    // Generate matrix A
-    auto matrix_A = generate_matrix_A(rho);
-
-    // Sample secret keys s1 and s2
-    auto s1 = sample_s1(K);
-    auto s2 = sample_s2(K);
-
-    // Compute t = A * s1 + s2
-    auto t = compute_t(matrix_A, s1, s2);
-
-    // Compute tr
-    auto tr = compute_tr(t, rho, K);
-
-    // Use ML-DSA compression for internal storage
-    auto public_data = pack_polynomial_data(t);
-    std::vector<std::vector<uint32_t>> secret_polys = s1;
-    secret_polys.insert(secret_polys.end(), s2.begin(), s2.end());
-    std::vector<uint8_t> secret_data = pack_polynomial_vector_ml_dsa(secret_polys, params_.modulus, 10);
-
-    // Create keys with compression
-    ColorSignPublicKey public_key_struct{rho, K, tr, public_data, params_, true};
-    ColorSignPrivateKey private_key_struct{rho, K, tr, secret_data, params_, true};
-
-    return {public_key_struct, private_key_struct};
+    return derive_keypair(rho, K);
 }
 
 // Deterministic key generation for testing (FIPS 204 Algorithm 5)
@@ -212,6 +255,7 @@ std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_key
     std::vector<uint8_t> rho_input(zeta.begin(), zeta.end());
     rho_input.push_back(0);
     std::vector<uint8_t> rho_vec = shake256(rho_input, 32);
+    SecureMemory::secure_wipe(rho_input.data(), rho_input.size());
     std::array<uint8_t, 32> rho;
     std::copy(rho_vec.begin(), rho_vec.end(), rho.begin());
 
@@ -219,23 +263,86 @@ std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_key
     std::vector<uint8_t> K_input(zeta.begin(), zeta.end());
     K_input.push_back(1);
     std::vector<uint8_t> K_vec = shake256(K_input, 32);
+    SecureMemory::secure_wipe(K_input.data(), K_input.size());
     std::array<uint8_t, 32> K;
     std::copy(K_vec.begin(), K_vec.end(), K.begin());
+    SecureMemory::secure_wipe(K_vec.data(), K_vec.size());
+
+    auto keypair = derive_keypair(rho, K);
+    SecureMemory::secure_wipe(K.data(), K.size());
+    return keypair;
+}
+
+std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_seed_keypair() {
+    std::array<uint8_t, 32> zeta;
+    secure_random_bytes(zeta.data(), zeta.size());
+    auto keypair = generate_keypair_deterministic(zeta);
+    ColorSignPrivateKey seed_key = ColorSignPrivateKey::from_seed(zeta, keypair.first);
+    SecureMemory::secure_wipe(zeta.data(), zeta.size());
+    return {std::move(keypair.first), std::move(seed_key)};
+}
+
+// Derive the key pair from rho and K, recording the keygen latency
+std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::derive_keypair(const std::array<uint8_t, 32>& rho,
+                                                                                   const std::array<uint8_t, 32>& K) const {
+    TraceSpan span("generate_keypair");
+    uint64_t start = INSTRUMENTATION_ENABLED ? TimestampCounter::now() : 0;
+    auto keypair = expand_keypair(rho, K);
+    if (INSTRUMENTATION_ENABLED) {
+        metrics_->keygen_latency.record(TimestampCounter::to_ns(TimestampCounter::now() - start));
+        metrics_->keypairs.add();
+    }
+    return keypair;
+}
 
+// Expand rho and K into the key pair (standard parameter sets use the fixed-dimension kernels)
+std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::expand_keypair(const std::array<uint8_t, 32>& rho,
+                                                                                   const std::array<uint8_t, 32>& K) const {
+    switch (fixed_level_) {
+        case 44: return KeyGenT<44>::generate_keypair(rho, K, key_format_version_);
+        case 65: return KeyGenT<65>::generate_keypair(rho, K, key_format_version_);
+        case 87: return KeyGenT<87>::generate_keypair(rho, K, key_format_version_);
+        default: break;
+    }
+
+    // Generate matrix A (one stage probe at a time, replaced as keygen moves on)
+    std::optional<ScopedStage> probe(std::in_place, PerfStage::MATRIX_EXPANSION);
     auto matrix_A = generate_matrix_A(rho);
 
-    // Sample s1 and s2 deterministically from K
-    auto s1 = sample_s1(K);
-    auto s2 = sample_s2(K);
+    // Sample secret keys s1 and s2
+    probe.emplace(PerfStage::SAMPLING);
+    bool centered = key_format_version_ == KEY_FORMAT_PACKED_SECRET;
+    auto s1 = sample_s1(K, centered);
+    auto s2 = sample_s2(K, centered);
 
+    // Compute t = A * s1 + s2
+    probe.emplace(PerfStage::NTT);
     auto t = compute_t(matrix_A, s1, s2);
 
+    if (key_format_has_t1(key_format_version_)) {
+        probe.emplace(PerfStage::PACKING);
+        std::vector<uint8_t> public_data;
+        std::array<uint8_t, 64> tr;
+        std::vector<uint8_t> secret_data = key_format_version_ == KEY_FORMAT_PACKED_SECRET
+                                               ? pack_secret_exact(s1, s2, params_.modulus, params_.eta)
+                                               : pack_secret_data(s1, s2);
+        split_power2round_key(t, rho, params_.modulus, public_data, tr, secret_data);
+
+        ColorSignPublicKey public_key_struct{rho, K, tr, public_data, params_, true};
+        ColorSignPrivateKey private_key_struct{rho, K, tr, secret_data, params_, true};
+        public_key_struct.format_version = key_format_version_;
+        private_key_struct.format_version = key_format_version_;
+        return {public_key_struct, private_key_struct};
+    }
+
+    // Compute tr
+    probe.emplace(PerfStage::HASHING);
     auto tr = compute_tr(t, rho, K);
 
+    // Use ML-DSA compression for internal storage
+    probe.emplace(PerfStage::PACKING);
     auto public_data = pack_polynomial_data(t);
-    std::vector<std::vector<uint32_t>> secret_polys = s1;
-    secret_polys.insert(secret_polys.end(), s2.begin(), s2.end());
-    std::vector<uint8_t> secret_data = pack_polynomial_vector_ml_dsa(secret_polys, params_.modulus, 10);
+    std::vector<uint8_t> secret_data = pack_secret_data(s1, s2);
 
     // Create keys with compression
     ColorSignPublicKey public_key_struct{rho, K, tr, public_data, params_, true};
@@ -244,62 +351,311 @@ std::pair<ColorSignPublicKey, ColorSignPrivateKey> ColorSignKeyGen::generate_key
     return {public_key_struct, private_key_struct};
 }
 
+// Expand A from rho (same sampling as ColorSignKeyGen::generate_matrix_A)
+template<uint32_t Level>
+void KeyGenT<Level>::generate_matrix_A(const std::array<uint8_t, 32>& rho, uint32_t* matrix) {
+    for (uint32_t i = 0; i < Params::K; ++i) {
+        for (uint32_t j = 0; j < Params::K; ++j) {
+            // Domain separation: rho || i || j || 0
+            std::array<uint8_t, 35> domain_sep;
+            std::copy(rho.begin(), rho.end(), domain_sep.begin());
+            domain_sep[32] = static_cast<uint8_t>(i);
+            domain_sep[33] = static_cast<uint8_t>(j);
+            domain_sep[34] = 0;
+
+            SHAKE128Sampler sampler;
+            sampler.init(domain_sep.data(), domain_sep.size());
+
+            uint32_t* coeffs = matrix + (i * Params::K + j) * Params::N;
+            for (uint32_t l = 0; l < Params::N; ++l) {
+                coeffs[l] = sampler.sample_uniform(Params::Q);
+            }
+        }
+    }
+}
+
+// Sample s1 from K || 0 and s2 from K || 1
+template<uint32_t Level>
+void KeyGenT<Level>::sample_secret(const std::array<uint8_t, 32>& seed_K, uint32_t* secret, bool centered) {
+    std::array<uint8_t, 33> seed;
+    std::copy(seed_K.begin(), seed_K.end(), seed.begin());
+
+    for (uint8_t half = 0; half < 2; ++half) {
+        seed[32] = half;
+        SHAKE256Sampler sampler;
+        sampler.init(seed.data(), seed.size());
+
+        uint32_t* polys = secret + half * Params::VECTOR_COEFFS;
+        for (uint32_t i = 0; i < Params::K; ++i) {
+            if (centered) {
+                sampler.sample_polynomial_centered(polys + i * Params::N, Params::N, Params::ETA, Params::Q);
+            } else {
+                sampler.sample_polynomial_binomial(polys + i * Params::N, Params::N, Params::ETA, Params::Q);
+            }
+        }
+    }
+}
+
+// Compute t = A * s1 + s2 mod q
+template<uint32_t Level>
+void KeyGenT<Level>::compute_t(const NTTEngine& ntt_engine, const uint32_t* matrix, const uint32_t* secret,
+                               uint32_t* t, uint32_t* product) {
+    constexpr uint32_t K = Params::K;
+    constexpr uint32_t N = Params::N;
+    constexpr uint32_t Q = Params::Q;
+    const uint32_t* s1 = secret;
+    const uint32_t* s2 = secret + Params::VECTOR_COEFFS;
+
+    std::fill(t, t + Params::VECTOR_COEFFS, 0);
+    for (uint32_t i = 0; i < K; ++i) {
+        uint32_t* t_i = t + i * N;
+        for (uint32_t m = 0; m < K; ++m) {
+            ntt_engine.multiply(matrix + (i * K + m) * N, s1 + m * N, product);
+            for (uint32_t j = 0; j < N; ++j) {
+                t_i[j] = (static_cast<uint64_t>(t_i[j]) + product[j]) % Q;
+            }
+        }
+        for (uint32_t j = 0; j < N; ++j) {
+            t_i[j] = (t_i[j] + s2[i * N + j]) % Q;
+        }
+    }
+}
+
+// Compute tr = SHAKE256(rho || pack(t)), absorbing t one polynomial at a time
+template<uint32_t Level>
+std::array<uint8_t, 64> KeyGenT<Level>::compute_tr(const uint32_t* t, const std::array<uint8_t, 32>& rho) {
+    SHAKE256Sampler hash;
+    hash.reset();
+    hash.absorb(rho.data(), rho.size());
+
+    std::array<uint8_t, 4 * Params::N> packed;
+    for (uint32_t i = 0; i < Params::K; ++i) {
+        const uint32_t* poly = t + i * Params::N;
+        for (uint32_t j = 0; j < Params::N; ++j) {
+            packed[4 * j] = poly[j] & 0xFF;
+            packed[4 * j + 1] = (poly[j] >> 8) & 0xFF;
+            packed[4 * j + 2] = (poly[j] >> 16) & 0xFF;
+            packed[4 * j + 3] = (poly[j] >> 24) & 0xFF;
+        }
+        hash.absorb(packed.data(), packed.size());
+    }
+    hash.pad_and_absorb();
+
+    std::array<uint8_t, 64> tr;
+    hash.squeeze(tr.data(), tr.size());
+    return tr;
+}
+
+template<uint32_t Level>
+void KeyGenT<Level>::pack_secret(const PolyVec& secret, SecretKeyData& out) {
+    pack_polynomial_vector_ml_dsa(secret, Params::Q, 10, out.data());
+}
+
+template<uint32_t Level>
+std::pair<ColorSignPublicKey, ColorSignPrivateKey> KeyGenT<Level>::generate_keypair(const std::array<uint8_t, 32>& rho,
+                                                                                   const std::array<uint8_t, 32>& seed_K,
+                                                                                   uint8_t format_version) {
+    // One stage probe at a time, replaced as keygen moves on
+    std::optional<ScopedStage> probe(std::in_place, PerfStage::MATRIX_EXPANSION);
+    PolyMat matrix_A(Params::K, Params::K, Params::N);
+    generate_matrix_A(rho, matrix_A.data());
+
+    probe.emplace(PerfStage::SAMPLING);
+    PolyVec secret(2 * Params::K, Params::N);  // s1 || s2
+    sample_secret(seed_K, secret.data(), format_version == KEY_FORMAT_PACKED_SECRET);
+
+    probe.emplace(PerfStage::NTT);
+    auto ntt_engine = create_optimal_ntt_engine(Params::Q, Params::N);
+    PolyVec t(Params::K, Params::N);
+    std::array<uint32_t, Params::N> product;
+    compute_t(*ntt_engine, matrix_A.data(), secret.data(), t.data(), product.data());
+
+    CLWEParameters params(Level);
+    if (key_format_has_t1(format_version)) {
+        probe.emplace(PerfStage::PACKING);
+        std::vector<uint8_t> secret_data;
+        if (format_version == KEY_FORMAT_PACKED_SECRET) {
+            // s1 and s2 end on a byte boundary, so packing them together matches pack_secret_exact
+            static_assert(Params::VECTOR_COEFFS * Params::ETA_BITS % 8 == 0, "s1 packs to whole bytes");
+            secret_data.resize(Params::PACKED_SECRET_BYTES);
+            pack_polynomial_vector_eta(secret, Params::Q, Params::ETA, secret_data.data());
+        } else {
+            SecretKeyData s1s2;
+            pack_secret(secret, s1s2);
+            secret_data.assign(s1s2.begin(), s1s2.end());
+        }
+        std::vector<uint8_t> public_data;
+        std::array<uint8_t, 64> tr;
+        split_power2round_key(t, rho, Params::Q, public_data, tr, secret_data);
+
+        ColorSignPublicKey public_key{rho, seed_K, tr, public_data, params, true};
+        ColorSignPrivateKey private_key{rho, seed_K, tr, secret_data, params, true};
+        public_key.format_version = format_version;
+        private_key.format_version = format_version;
+        return {public_key, private_key};
+    }
+
+    probe.emplace(PerfStage::HASHING);
+    std::array<uint8_t, 64> tr = compute_tr(t.data(), rho);
+
+    probe.emplace(PerfStage::PACKING);
+    SecretKeyData secret_data;
+    pack_secret(secret, secret_data);
+
+    ColorSignPublicKey public_key{rho, seed_K, tr, pack_polynomial_vector_auto(t, Params::Q), params, true};
+    ColorSignPrivateKey private_key{rho, seed_K, tr, std::vector<uint8_t>(secret_data.begin(), secret_data.end()), params, true};
+
+    return {public_key, private_key};
+}
+
+template class KeyGenT<44>;
+template class KeyGenT<65>;
+template class KeyGenT<87>;
+
 // Serialization implementations
 std::vector<uint8_t> ColorSignPublicKey::serialize() const {
-    std::vector<uint8_t> data;
+    std::vector<uint8_t> data(serialized_size());
+    serialize_into(data.data(), data.size());
+    return data;
+}
 
-    // Add format version and compression flag
-    data.push_back(format_version);
-    data.push_back(use_compression ? 0x01 : 0x00);
+size_t ColorSignPublicKey::serialize_into(uint8_t* out, size_t capacity) const {
+    if (capacity < serialized_size()) {
+        throw std::invalid_argument("Public key output buffer too small");
+    }
 
-    data.insert(data.end(), seed_rho.begin(), seed_rho.end());
-    data.insert(data.end(), seed_K.begin(), seed_K.end());
-    data.insert(data.end(), hash_tr.begin(), hash_tr.end());
-    data.insert(data.end(), public_data.begin(), public_data.end());
-    return data;
+    // Format version and compression flag, then the seeds, tr and t
+    uint8_t* start = out;
+    *out++ = format_version;
+    *out++ = use_compression ? 0x01 : 0x00;
+    out = std::copy(seed_rho.begin(), seed_rho.end(), out);
+    out = std::copy(seed_K.begin(), seed_K.end(), out);
+    out = std::copy(hash_tr.begin(), hash_tr.end(), out);
+    out = std::copy(public_data.begin(), public_data.end(), out);
+    return static_cast<size_t>(out - start);
+}
+
+size_t ColorSignPublicKey::serialized_size(const CLWEParameters& params, uint8_t format_version) {
+    if (!key_format_has_t1(format_version)) {
+        throw std::invalid_argument("Public key format has no fixed size");
+    }
+    return KEY_HEADER_BYTES + t1_packed_size(params.module_rank, params.degree);
 }
 
 ColorSignPublicKey ColorSignPublicKey::deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params) {
-    if (data.size() < 32 + 32 + 64 + 2) { // +2 for version and compression flags
+    return deserialize(data.data(), data.size(), params);
+}
+
+ColorSignPublicKey ColorSignPublicKey::deserialize(const uint8_t* data, size_t size, const CLWEParameters& params) {
+    return PublicKeyView::parse(data, size, params).to_public_key();
+}
+
+PublicKeyView::PublicKeyView(const ColorSignPublicKey& public_key)
+    : seed_rho(public_key.seed_rho.data()),
+      seed_K(public_key.seed_K.data()),
+      hash_tr(public_key.hash_tr.data()),
+      public_data(public_key.public_data.data(), public_key.public_data.size()),
+      params(public_key.params),
+      format_version(public_key.format_version),
+      use_compression(public_key.use_compression) {
+}
+
+PublicKeyView PublicKeyView::parse(const uint8_t* data, size_t size, const CLWEParameters& params) {
+    if (size < KEY_HEADER_BYTES) {
         throw std::invalid_argument("Public key data too small");
     }
 
-    ColorSignPublicKey key;
+    PublicKeyView view;
     size_t offset = 0;
 
     // Read format version and compression flag
-    key.format_version = data[offset++];
-    bool compressed = data[offset++] == 0x01;
+    view.format_version = data[offset++];
+    view.use_compression = data[offset++] == 0x01;
 
-    std::copy(data.begin() + offset, data.begin() + offset + 32, key.seed_rho.begin());
+    view.seed_rho = data + offset;
     offset += 32;
-    std::copy(data.begin() + offset, data.begin() + offset + 32, key.seed_K.begin());
+    view.seed_K = data + offset;
     offset += 32;
-    std::copy(data.begin() + offset, data.begin() + offset + 64, key.hash_tr.begin());
+    view.hash_tr = data + offset;
     offset += 64;
-    key.public_data.assign(data.begin() + offset, data.end());
-    key.params = params;
-    key.use_compression = compressed;
+    view.public_data = ByteSpan(data + offset, size - offset);
+    view.params = params;
 
+    return view;
+}
+
+ColorSignPublicKey PublicKeyView::to_public_key() const {
+    ColorSignPublicKey key;
+    key.format_version = format_version;
+    key.use_compression = use_compression;
+    std::copy(seed_rho, seed_rho + 32, key.seed_rho.begin());
+    std::copy(seed_K, seed_K + 32, key.seed_K.begin());
+    std::copy(hash_tr, hash_tr + 64, key.hash_tr.begin());
+    key.public_data.assign(public_data.begin(), public_data.end());
+    key.params = params;
     return key;
 }
 
 std::vector<uint8_t> ColorSignPrivateKey::serialize() const {
-    std::vector<uint8_t> data;
+    std::vector<uint8_t> data(serialized_size());
+    serialize_into(data.data(), data.size());
+    return data;
+}
+
+size_t ColorSignPrivateKey::serialize_into(uint8_t* out, size_t capacity) const {
+    if (capacity < serialized_size()) {
+        throw std::invalid_argument("Private key output buffer too small");
+    }
 
-    // Add format version and compression flag
-    data.push_back(format_version);
-    data.push_back(use_compression ? 0x01 : 0x00);
+    uint8_t* start = out;
+    *out++ = format_version;
 
-    data.insert(data.end(), seed_rho.begin(), seed_rho.end());
-    data.insert(data.end(), seed_K.begin(), seed_K.end());
-    data.insert(data.end(), hash_tr.begin(), hash_tr.end());
-    data.insert(data.end(), secret_data.begin(), secret_data.end());
-    return data;
+    // Seed-only keys: version || expanded format || zeta || tr
+    if (is_seed_only()) {
+        out = std::copy(secret_data.begin(), secret_data.end(), out);
+        out = std::copy(hash_tr.begin(), hash_tr.end(), out);
+        return static_cast<size_t>(out - start);
+    }
+
+    *out++ = use_compression ? 0x01 : 0x00;
+    out = std::copy(seed_rho.begin(), seed_rho.end(), out);
+    out = std::copy(seed_K.begin(), seed_K.end(), out);
+    out = std::copy(hash_tr.begin(), hash_tr.end(), out);
+    out = std::copy(secret_data.begin(), secret_data.end(), out);
+    return static_cast<size_t>(out - start);
+}
+
+size_t ColorSignPrivateKey::serialized_size(const CLWEParameters& params, uint8_t format_version) {
+    size_t k = params.module_rank;
+    size_t t0_bytes = gamma1_packed_size(params.module_rank, params.degree, 1u << (POWER2ROUND_D - 1));
+    switch (format_version) {
+        case KEY_FORMAT_ORIGINAL:
+            return KEY_HEADER_BYTES + ml_dsa_packed_size(2 * k, params.degree, 10);
+        case KEY_FORMAT_POWER2ROUND:
+            return KEY_HEADER_BYTES + ml_dsa_packed_size(2 * k, params.degree, 10) + t0_bytes;
+        case KEY_FORMAT_PACKED_SECRET:
+            return KEY_HEADER_BYTES + 2 * eta_packed_size(params.module_rank, params.degree, params.eta) + t0_bytes;
+        case KEY_FORMAT_SEED:
+            return SEED_KEY_SERIALIZED_BYTES;
+        default:
+            throw std::invalid_argument("Private key format has no fixed size");
+    }
 }
 
 ColorSignPrivateKey ColorSignPrivateKey::deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params) {
-    if (data.size() < 32 + 32 + 64 + 2) { // +2 for version and compression flags
+    if (!data.empty() && data[0] == KEY_FORMAT_SEED) {
+        if (data.size() != SEED_KEY_SERIALIZED_BYTES) {
+            throw std::invalid_argument("Seed-only private key data has the wrong size");
+        }
+        ColorSignPrivateKey key{};
+        key.format_version = KEY_FORMAT_SEED;
+        key.secret_data.assign(data.begin() + 1, data.begin() + 1 + 1 + 32);
+        std::copy(data.begin() + 1 + 1 + 32, data.end(), key.hash_tr.begin());
+        key.params = params;
+        return key;
+    }
+
+    if (data.size() < KEY_HEADER_BYTES) {
         throw std::invalid_argument("Private key data too small");
     }
 
@@ -320,9 +676,285 @@ ColorSignPrivateKey ColorSignPrivateKey::deserialize(const std::vector<uint8_t>&
     key.params = params;
     key.use_compression = compressed;
 
+    // The t1 formats have an exact size: s1 || s2 followed by t0
+    if (key_format_has_t1(key.format_version) &&
+        data.size() != serialized_size(params, key.format_version)) {
+        throw std::invalid_argument("Private key secret data size does not match the packed key format");
+    }
+
+    return key;
+}
+
+ColorSignPrivateKey ColorSignPrivateKey::from_seed(const std::array<uint8_t, 32>& zeta,
+                                                   const ColorSignPublicKey& public_key) {
+    if (public_key.format_version != KEY_FORMAT_ORIGINAL && !key_format_has_t1(public_key.format_version)) {
+        throw std::invalid_argument("Unsupported key format version for a seed-only key: " +
+                                    std::to_string(public_key.format_version));
+    }
+    ColorSignPrivateKey key{};
+    key.format_version = KEY_FORMAT_SEED;
+    key.secret_data.reserve(1 + zeta.size());
+    key.secret_data.push_back(public_key.format_version);
+    key.secret_data.insert(key.secret_data.end(), zeta.begin(), zeta.end());
+    key.hash_tr = public_key.hash_tr;
+    key.params = public_key.params;
+    return key;
+}
+
+ColorSignPrivateKey ColorSignPrivateKey::expand() const {
+    if (!is_seed_only()) {
+        return *this;
+    }
+    if (secret_data.size() != 1 + 32) {
+        throw std::invalid_argument("Malformed seed-only private key");
+    }
+
+    std::array<uint8_t, 32> zeta;
+    std::copy(secret_data.begin() + 1, secret_data.end(), zeta.begin());
+    ColorSignKeyGen keygen(params);
+    keygen.set_key_format_version(secret_data[0]);
+    ColorSignPrivateKey expanded = keygen.generate_keypair_deterministic(zeta).second;
+    SecureMemory::secure_wipe(zeta.data(), zeta.size());
+
+    if (!ConstantTime::compare(expanded.hash_tr.data(), hash_tr.data(), hash_tr.size())) {
+        throw std::invalid_argument("Seed-only private key does not match its public key hash");
+    }
+    return expanded;
+}
+
+template<uint32_t Level>
+std::array<uint8_t, FixedPublicKey<Level>::SERIALIZED_BYTES> FixedPublicKey<Level>::serialize() const {
+    std::array<uint8_t, SERIALIZED_BYTES> data;
+    auto out = data.begin();
+    *out++ = format_version;
+    *out++ = use_compression ? 0x01 : 0x00;
+    out = std::copy(seed_rho.begin(), seed_rho.end(), out);
+    out = std::copy(seed_K.begin(), seed_K.end(), out);
+    out = std::copy(hash_tr.begin(), hash_tr.end(), out);
+    std::copy(t1_data.begin(), t1_data.end(), out);
+    return data;
+}
+
+template<uint32_t Level>
+FixedPublicKey<Level> FixedPublicKey<Level>::deserialize(const uint8_t* data, size_t size) {
+    if (size != SERIALIZED_BYTES) {
+        throw std::invalid_argument("Public key data size mismatch");
+    }
+    if (!key_format_has_t1(data[0])) {
+        throw std::invalid_argument("Fixed public keys hold the t1 formats only");
+    }
+
+    FixedPublicKey key;
+    key.format_version = *data++;
+    key.use_compression = *data++ == 0x01;
+    std::copy(data, data + 32, key.seed_rho.begin());
+    data += 32;
+    std::copy(data, data + 32, key.seed_K.begin());
+    data += 32;
+    std::copy(data, data + 64, key.hash_tr.begin());
+    data += 64;
+    std::copy(data, data + Params::T1_BYTES, key.t1_data.begin());
+    return key;
+}
+
+template<uint32_t Level>
+FixedPublicKey<Level> FixedPublicKey<Level>::from_public_key(const ColorSignPublicKey& public_key) {
+    if (!key_format_has_t1(public_key.format_version)) {
+        throw std::invalid_argument("Fixed public keys hold the t1 formats only");
+    }
+    if (public_key.public_data.size() != Params::T1_BYTES) {
+        throw std::invalid_argument("Public key size does not match parameter set");
+    }
+
+    FixedPublicKey key;
+    key.seed_rho = public_key.seed_rho;
+    key.seed_K = public_key.seed_K;
+    key.hash_tr = public_key.hash_tr;
+    std::copy(public_key.public_data.begin(), public_key.public_data.end(), key.t1_data.begin());
+    key.format_version = public_key.format_version;
+    key.use_compression = public_key.use_compression;
+    return key;
+}
+
+template<uint32_t Level>
+ColorSignPublicKey FixedPublicKey<Level>::to_public_key() const {
+    ColorSignPublicKey key(seed_rho, seed_K, hash_tr, std::vector<uint8_t>(t1_data.begin(), t1_data.end()),
+                           CLWEParameters(Level), use_compression);
+    key.format_version = format_version;
+    return key;
+}
+
+template<uint32_t Level>
+FixedPrivateKey<Level>::~FixedPrivateKey() {
+    SecureMemory::secure_wipe(seed_K.data(), seed_K.size());
+    SecureMemory::secure_wipe(secret_data.data(), secret_data.size());
+}
+
+template<uint32_t Level>
+std::array<uint8_t, FixedPrivateKey<Level>::SERIALIZED_BYTES> FixedPrivateKey<Level>::serialize() const {
+    std::array<uint8_t, SERIALIZED_BYTES> data;
+    auto out = data.begin();
+    *out++ = KEY_FORMAT_PACKED_SECRET;
+    *out++ = use_compression ? 0x01 : 0x00;
+    out = std::copy(seed_rho.begin(), seed_rho.end(), out);
+    out = std::copy(seed_K.begin(), seed_K.end(), out);
+    out = std::copy(hash_tr.begin(), hash_tr.end(), out);
+    std::copy(secret_data.begin(), secret_data.end(), out);
+    return data;
+}
+
+template<uint32_t Level>
+FixedPrivateKey<Level> FixedPrivateKey<Level>::deserialize(const uint8_t* data, size_t size) {
+    if (size != SERIALIZED_BYTES) {
+        throw std::invalid_argument("Private key data size mismatch");
+    }
+    if (data[0] != KEY_FORMAT_PACKED_SECRET) {
+        throw std::invalid_argument("Fixed private keys hold the packed secret format only");
+    }
+
+    FixedPrivateKey key;
+    ++data;
+    key.use_compression = *data++ == 0x01;
+    std::copy(data, data + 32, key.seed_rho.begin());
+    data += 32;
+    std::copy(data, data + 32, key.seed_K.begin());
+    data += 32;
+    std::copy(data, data + 64, key.hash_tr.begin());
+    data += 64;
+    std::copy(data, data + SECRET_BYTES, key.secret_data.begin());
     return key;
 }
 
+template<uint32_t Level>
+FixedPrivateKey<Level> FixedPrivateKey<Level>::from_private_key(const ColorSignPrivateKey& private_key) {
+    if (private_key.format_version != KEY_FORMAT_PACKED_SECRET) {
+        throw std::invalid_argument("Fixed private keys hold the packed secret format only");
+    }
+    if (private_key.secret_data.size() != SECRET_BYTES) {
+        throw std::invalid_argument("Private key size does not match parameter set");
+    }
+
+    FixedPrivateKey key;
+    key.seed_rho = private_key.seed_rho;
+    key.seed_K = private_key.seed_K;
+    key.hash_tr = private_key.hash_tr;
+    std::copy(private_key.secret_data.begin(), private_key.secret_data.end(), key.secret_data.begin());
+    key.use_compression = private_key.use_compression;
+    return key;
+}
+
+template<uint32_t Level>
+ColorSignPrivateKey FixedPrivateKey<Level>::to_private_key() const {
+    ColorSignPrivateKey key(seed_rho, seed_K, hash_tr, std::vector<uint8_t>(secret_data.begin(), secret_data.end()),
+                            CLWEParameters(Level), use_compression);
+    key.format_version = KEY_FORMAT_PACKED_SECRET;
+    return key;
+}
+
+template struct FixedPublicKey<44>;
+template struct FixedPublicKey<65>;
+template struct FixedPublicKey<87>;
+template struct FixedPrivateKey<44>;
+template struct FixedPrivateKey<65>;
+template struct FixedPrivateKey<87>;
+
+namespace {
+
+// Deleter of cached expanded keys: the secret parts are wiped before the memory is released
+void wipe_and_delete(const ColorSignPrivateKey* key) {
+    ColorSignPrivateKey* owned = const_cast<ColorSignPrivateKey*>(key);
+    SecureMemory::secure_wipe(owned->seed_K.data(), owned->seed_K.size());
+    SecureMemory::secure_wipe(owned->secret_data.data(), owned->secret_data.size());
+    delete owned;
+}
+
+} // namespace
+
+ExpandedKeyCache::ExpandedKeyCache(size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Expanded key cache capacity must be positive");
+    }
+    secure_random_bytes(id_key_.data(), id_key_.size());
+}
+
+ExpandedKeyCache::~ExpandedKeyCache() {
+    SecureMemory::secure_wipe(id_key_.data(), id_key_.size());
+}
+
+// Keyed hash of the seed key, so the index holds no seed material and a forged seed key that
+// only copies another key's tr never finds that key's entry
+std::string ExpandedKeyCache::entry_id(const ColorSignPrivateKey& private_key) const {
+    uint32_t level = private_key.params.security_level;
+    SHAKE256Sampler hash;
+    hash.reset();
+    hash.absorb(id_key_.data(), id_key_.size());
+    hash.absorb(private_key.secret_data.data(), private_key.secret_data.size());
+    hash.absorb(private_key.hash_tr.data(), private_key.hash_tr.size());
+    hash.absorb(reinterpret_cast<const uint8_t*>(&level), sizeof(level));
+    hash.pad_and_absorb();
+    std::string id(32, '\0');
+    hash.squeeze(reinterpret_cast<uint8_t*>(&id[0]), id.size());
+    hash.reset();  // Drop seed-dependent state
+    return id;
+}
+
+std::shared_ptr<const ColorSignPrivateKey> ExpandedKeyCache::expand(const ColorSignPrivateKey& private_key) {
+    if (!private_key.is_seed_only()) {
+        return std::make_shared<const ColorSignPrivateKey>(private_key);
+    }
+
+    std::string id = entry_id(private_key);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = index_.find(id);
+        if (found != index_.end()) {
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, found->second);
+            return found->second->second;
+        }
+        ++misses_;
+    }
+
+    // Expand outside the lock; a concurrent miss on the same key keeps the first insertion
+    ColorSignPrivateKey full = private_key.expand();
+    std::shared_ptr<const ColorSignPrivateKey> expanded(new ColorSignPrivateKey(std::move(full)), &wipe_and_delete);
+    SecureMemory::secure_wipe(full.seed_K.data(), full.seed_K.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(id);
+    if (found != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->second;
+    }
+    entries_.emplace_front(id, expanded);
+    index_.emplace(std::move(id), entries_.begin());
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return expanded;
+}
+
+size_t ExpandedKeyCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t ExpandedKeyCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t ExpandedKeyCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void ExpandedKeyCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+}
+
 // Error message utility
 std::string get_colorsign_error_message(ColorSignError error) {
     switch (error) {
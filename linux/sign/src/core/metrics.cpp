@@ -0,0 +1,401 @@
+#include "../include/clwe/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace clwe {
+
+namespace {
+
+// Prometheus histogram boundaries in nanoseconds: 1-2.5-5 steps from 1 us to 10 s
+constexpr uint64_t EXPORT_BOUNDS_NS[] = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000, 250000000, 500000000,
+    1000000000, 2500000000, 5000000000, 10000000000};
+
+constexpr double EXPORT_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+int count_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int n = 0;
+    for (uint64_t bit = uint64_t(1) << 63; !(value & bit); bit >>= 1) ++n;
+    return n;
+#endif
+}
+
+std::string escape_label_value(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char ch : value) {
+        switch (ch) {
+            case '\\': escaped += "\\\\"; break;
+            case '"': escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += ch; break;
+        }
+    }
+    return escaped;
+}
+
+// {a="x",b="y"} with an optional extra label appended; empty when there are no labels
+std::string format_labels(const MetricLabels& labels, const char* extra_name = nullptr,
+                          const std::string& extra_value = {}) {
+    if (labels.empty() && !extra_name) {
+        return {};
+    }
+    std::string out = "{";
+    bool first = true;
+    for (const auto& [name, value] : labels) {
+        if (!first) out += ',';
+        out += name + "=\"" + escape_label_value(value) + "\"";
+        first = false;
+    }
+    if (extra_name) {
+        if (!first) out += ',';
+        out += std::string(extra_name) + "=\"" + escape_label_value(extra_value) + "\"";
+    }
+    out += '}';
+    return out;
+}
+
+std::string format_seconds(double seconds) {
+    std::ostringstream out;
+    out << std::setprecision(9) << seconds;
+    return out.str();
+}
+
+} // namespace
+
+size_t metric_shard() {
+    static std::atomic<size_t> next_thread{0};
+    thread_local size_t shard = next_thread.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+uint64_t Counter::value() const noexcept {
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Counter::reset() noexcept {
+    for (Shard& shard : shards_) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct LatencyHistogram::Shard {
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& shard : shards_) {
+        shard.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::~LatencyHistogram() {
+    for (auto& shard : shards_) {
+        delete shard.load(std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucket_index(uint64_t ns) noexcept {
+    if (ns < SUB_BUCKETS) {
+        return static_cast<size_t>(ns);
+    }
+    uint32_t exponent = 63 - static_cast<uint32_t>(count_leading_zeros(ns));
+    if (exponent > MAX_EXPONENT) {
+        return BUCKETS - 1;
+    }
+    uint32_t shift = exponent - SUB_BUCKET_BITS;
+    size_t sub_bucket = static_cast<size_t>((ns >> shift) & (SUB_BUCKETS - 1));
+    return SUB_BUCKETS + static_cast<size_t>(shift) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    uint32_t shift = static_cast<uint32_t>((index - SUB_BUCKETS) / SUB_BUCKETS);
+    uint64_t sub_bucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    uint64_t lower = (SUB_BUCKETS + sub_bucket) << shift;
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+LatencyHistogram::Shard& LatencyHistogram::shard() {
+    std::atomic<Shard*>& slot = shards_[metric_shard()];
+    Shard* shard = slot.load(std::memory_order_acquire);
+    if (!shard) {
+        Shard* fresh = new Shard();
+        if (slot.compare_exchange_strong(shard, fresh, std::memory_order_acq_rel)) {
+            shard = fresh;
+        } else {
+            delete fresh;  // Another thread on this shard won the race
+        }
+    }
+    return *shard;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    Shard& target = shard();
+    target.buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    target.count.fetch_add(1, std::memory_order_relaxed);
+    target.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t max = target.max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !target.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot merged;
+    merged.buckets.assign(BUCKETS, 0);
+    for (const auto& slot : shards_) {
+        const Shard* shard = slot.load(std::memory_order_acquire);
+        if (!shard) continue;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            merged.buckets[i] += shard->buckets[i].load(std::memory_order_relaxed);
+        }
+        merged.count += shard->count.load(std::memory_order_relaxed);
+        merged.sum_ns += shard->sum_ns.load(std::memory_order_relaxed);
+        merged.max_ns = std::max(merged.max_ns, shard->max_ns.load(std::memory_order_relaxed));
+    }
+    return merged;
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& slot : shards_) {
+        Shard* shard = slot.load(std::memory_order_acquire);
+        if (!shard) continue;
+        for (auto& bucket : shard->buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard->count.store(0, std::memory_order_relaxed);
+        shard->sum_ns.store(0, std::memory_order_relaxed);
+        shard->max_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double q) const {
+    uint64_t total = 0;
+    for (uint64_t bucket : buckets) total += bucket;  // Buckets and count may race by a few
+    if (total == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+uint64_t LatencyHistogram::Snapshot::count_at_or_below(uint64_t ns) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < buckets.size() && bucket_upper_bound(i) <= ns; ++i) {
+        total += buckets[i];
+    }
+    return total;
+}
+
+MetricsRegistry::MetricsRegistry() = default;
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry::Series& MetricsRegistry::series(const std::string& name, const std::string& help,
+                                                 Type type, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = families_.try_emplace(name, Family{type, help, {}});
+    Family& family = it->second;
+    if (!inserted && family.type != type) {
+        throw std::invalid_argument("Metric " + name + " is already registered with another type");
+    }
+    for (Series& existing : family.series) {
+        if (existing.labels == labels) {
+            return existing;
+        }
+    }
+
+    Series fresh;
+    fresh.labels = labels;
+    switch (type) {
+        case Type::COUNTER: fresh.counter = std::make_unique<Counter>(); break;
+        case Type::GAUGE: fresh.gauge = std::make_unique<Gauge>(); break;
+        case Type::HISTOGRAM: fresh.histogram = std::make_unique<LatencyHistogram>(); break;
+    }
+    family.series.push_back(std::move(fresh));
+    return family.series.back();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    return *series(name, help, Type::COUNTER, labels).counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    return *series(name, help, Type::GAUGE, labels).gauge;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                             const MetricLabels& labels) {
+    return *series(name, help, Type::HISTOGRAM, labels).histogram;
+}
+
+std::string MetricsRegistry::prometheus_text() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    for (const auto& [name, family] : families_) {
+        switch (family.type) {
+            case Type::COUNTER:
+                out << "# HELP " << name << ' ' << family.help << '\n' << "# TYPE " << name << " counter\n";
+                for (const Series& s : family.series) {
+                    out << name << format_labels(s.labels) << ' ' << s.counter->value() << '\n';
+                }
+                break;
+
+            case Type::GAUGE:
+                out << "# HELP " << name << ' ' << family.help << '\n' << "# TYPE " << name << " gauge\n";
+                for (const Series& s : family.series) {
+                    out << name << format_labels(s.labels) << ' ' << s.gauge->value() << '\n';
+                }
+                break;
+
+            case Type::HISTOGRAM: {
+                std::vector<LatencyHistogram::Snapshot> snapshots;
+                snapshots.reserve(family.series.size());
+                for (const Series& s : family.series) {
+                    snapshots.push_back(s.histogram->snapshot());
+                }
+
+                out << "# HELP " << name << ' ' << family.help << '\n' << "# TYPE " << name << " histogram\n";
+                for (size_t i = 0; i < family.series.size(); ++i) {
+                    const MetricLabels& labels = family.series[i].labels;
+                    const LatencyHistogram::Snapshot& snapshot = snapshots[i];
+                    for (uint64_t bound : EXPORT_BOUNDS_NS) {
+                        out << name << "_bucket" << format_labels(labels, "le", format_seconds(bound * 1e-9))
+                            << ' ' << snapshot.count_at_or_below(bound) << '\n';
+                    }
+                    out << name << "_bucket" << format_labels(labels, "le", "+Inf") << ' ' << snapshot.count << '\n';
+                    out << name << "_sum" << format_labels(labels) << ' ' << format_seconds(snapshot.sum_ns * 1e-9) << '\n';
+                    out << name << "_count" << format_labels(labels) << ' ' << snapshot.count << '\n';
+                }
+
+                std::string quantile_name = name + "_quantile";
+                out << "# HELP " << quantile_name << " HDR quantiles of " << name << '\n'
+                    << "# TYPE " << quantile_name << " gauge\n";
+                for (size_t i = 0; i < family.series.size(); ++i) {
+                    for (double q : EXPORT_QUANTILES) {
+                        std::ostringstream q_label;
+                        q_label << q;
+                        out << quantile_name << format_labels(family.series[i].labels, "quantile", q_label.str())
+                            << ' ' << format_seconds(snapshots[i].percentile(q) * 1e-9) << '\n';
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return out.str();
+}
+
+void MetricsRegistry::write_prometheus(const std::string& path) const {
+    std::string text = prometheus_text();
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size())) || !file.flush()) {
+            std::remove(temp_path.c_str());
+            throw std::runtime_error("Failed to write metrics file: " + temp_path);
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Failed to replace metrics file: " + path);
+    }
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [name, family] : families_) {
+        for (Series& s : family.series) {
+            if (s.counter) s.counter->reset();
+            if (s.histogram) s.histogram->reset();
+        }
+    }
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+SchemeMetrics& SchemeMetrics::for_level(uint32_t security_level) {
+    static std::mutex mutex;
+    static std::map<uint32_t, std::unique_ptr<SchemeMetrics>> by_level;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<SchemeMetrics>& metrics = by_level[security_level];
+    if (!metrics) {
+        MetricsRegistry& registry = MetricsRegistry::global();
+        std::string level = std::to_string(security_level);
+        const std::string duration = "colorsign_operation_duration_seconds";
+        const std::string duration_help = "Latency of ColorSign operations and signing stages";
+        const std::string operations = "colorsign_operations_total";
+        const std::string operations_help = "Completed ColorSign operations";
+        const std::string cache = "colorsign_matrix_cache_total";
+        const std::string cache_help = "Lookups of the expanded matrix A cached in sign and verify workspaces";
+        const std::string hashed = "colorsign_bytes_hashed_total";
+        const std::string hashed_help = "Message bytes absorbed into mu";
+
+        metrics.reset(new SchemeMetrics{
+            registry.histogram(duration, duration_help, {{"operation", "keygen"}, {"stage", "total"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "sign"}, {"stage", "total"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "sign"}, {"stage", "prepare"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "sign"}, {"stage", "setup"}, {"level", level}}),
+            registry.histogram(duration, duration_help,
+                               {{"operation", "sign"}, {"stage", "rejection_sampling"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "verify"}, {"stage", "total"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "verify"}, {"stage", "prepare"}, {"level", level}}),
+            registry.histogram(duration, duration_help, {{"operation", "verify"}, {"stage", "check"}, {"level", level}}),
+            registry.counter(operations, operations_help, {{"operation", "keygen"}, {"level", level}}),
+            registry.counter(operations, operations_help, {{"operation", "sign"}, {"level", level}}),
+            registry.counter(operations, operations_help, {{"operation", "verify"}, {"level", level}}),
+            registry.counter("colorsign_sign_rejections_total", "Signing attempts rejected and restarted",
+                             {{"level", level}}),
+            registry.counter(cache, cache_help, {{"result", "hit"}, {"level", level}}),
+            registry.counter(cache, cache_help, {{"result", "miss"}, {"level", level}}),
+            registry.counter(hashed, hashed_help, {{"operation", "sign"}, {"level", level}}),
+            registry.counter(hashed, hashed_help, {{"operation", "verify"}, {"level", level}}),
+        });
+    }
+    return *metrics;
+}
+
+Gauge& secure_memory_locked_gauge() {
+    static Gauge& gauge = MetricsRegistry::global().gauge(
+        "colorsign_secure_arena_locked_bytes", "Memory pinned in RAM by live secure arenas");
+    return gauge;
+}
+
+Counter& secure_memory_lock_failures() {
+    static Counter& counter = MetricsRegistry::global().counter(
+        "colorsign_secure_arena_lock_failures_total", "Secure arenas left unlocked because locking was refused");
+    return counter;
+}
+
+} // namespace clwe
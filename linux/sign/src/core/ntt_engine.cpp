@@ -321,13 +321,14 @@ void ScalarNTTEngine::ntt_inverse(uint32_t* poly) const {
 }
 
 void ScalarNTTEngine::multiply(const uint32_t* a, const uint32_t* b, uint32_t* result) const {
-    std::vector<uint32_t> a_ntt(n_);
-    std::vector<uint32_t> b_ntt(n_);
-    std::copy(a, a + n_, a_ntt.begin());
-    std::copy(b, b + n_, b_ntt.begin());
+    // n_ == 256 is enforced at construction, so the transforms live on the stack
+    alignas(64) uint32_t a_ntt[256];
+    alignas(64) uint32_t b_ntt[256];
+    std::copy(a, a + n_, a_ntt);
+    std::copy(b, b + n_, b_ntt);
 
-    ntt_forward(a_ntt.data());
-    ntt_forward(b_ntt.data());
+    ntt_forward(a_ntt);
+    ntt_forward(b_ntt);
 
     for (uint32_t i = 0; i < n_; ++i) {
         result[i] = montgomery_reduce((int64_t)a_ntt[i] * b_ntt[i]);
@@ -487,13 +488,14 @@ void AVX2NTTEngine::ntt_inverse(uint32_t* poly) const {
 }
 
 void AVX2NTTEngine::multiply(const uint32_t* a, const uint32_t* b, uint32_t* result) const {
-    std::vector<uint32_t> a_ntt(n_);
-    std::vector<uint32_t> b_ntt(n_);
-    std::copy(a, a + n_, a_ntt.begin());
-    std::copy(b, b + n_, b_ntt.begin());
+    // n_ == 256 is enforced at construction, so the transforms live on the stack
+    alignas(64) uint32_t a_ntt[256];
+    alignas(64) uint32_t b_ntt[256];
+    std::copy(a, a + n_, a_ntt);
+    std::copy(b, b + n_, b_ntt);
 
-    ntt_forward(a_ntt.data());
-    ntt_forward(b_ntt.data());
+    ntt_forward(a_ntt);
+    ntt_forward(b_ntt);
 
     for (uint32_t i = 0; i < n_; i += 8) {
         if (i + 7 < n_) {
@@ -746,13 +748,14 @@ void AVX512NTTEngine::ntt_inverse(uint32_t* poly) const {
 }
 
 void AVX512NTTEngine::multiply(const uint32_t* a, const uint32_t* b, uint32_t* result) const {
-    std::vector<uint32_t> a_ntt(n_);
-    std::vector<uint32_t> b_ntt(n_);
-    std::copy(a, a + n_, a_ntt.begin());
-    std::copy(b, b + n_, b_ntt.begin());
-
-    ntt_forward(a_ntt.data());
-    ntt_forward(b_ntt.data());
+    // n_ == 256 is enforced at construction, so the transforms live on the stack
+    alignas(64) uint32_t a_ntt[256];
+    alignas(64) uint32_t b_ntt[256];
+    std::copy(a, a + n_, a_ntt);
+    std::copy(b, b + n_, b_ntt);
+
+    ntt_forward(a_ntt);
+    ntt_forward(b_ntt);
 
     for (uint32_t i = 0; i < n_; i += 16) {
         if (i + 15 < n_) {
@@ -0,0 +1,410 @@
+#include "../include/clwe/performance_metrics.hpp"
+#include "../include/clwe/allocation_profiler.hpp"
+#include "../include/clwe/timing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace clwe {
+
+namespace {
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(PerfStage::COUNT);
+
+#ifdef __linux__
+int open_perf_event(uint64_t config, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd < 0 ? 1 : 0;  // The leader starts the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+void check_iterations(int iterations) {
+    if (iterations <= 0) {
+        throw std::invalid_argument("Iteration count must be positive");
+    }
+}
+
+double elapsed_us(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+TimingStats summarize_times(const std::vector<double>& times) {
+    double total_time = std::accumulate(times.begin(), times.end(), 0.0);
+    double avg_time = total_time / static_cast<double>(times.size());
+    double min_time = *std::min_element(times.begin(), times.end());
+    double max_time = *std::max_element(times.begin(), times.end());
+    double throughput = avg_time > 0.0 ? 1000000.0 / avg_time : 0.0;  // operations per second
+    return {total_time, avg_time, min_time, max_time, throughput};
+}
+
+// Per-thread stage accumulators; only the owning thread writes them
+struct StageAccumulator {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> time_ns{0};
+    std::atomic<uint64_t> cycles{0};
+    std::atomic<uint64_t> instructions{0};
+    std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> branch_misses{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+
+    void add_to(StageStats& stats) const {
+        stats.calls += calls.load(std::memory_order_relaxed);
+        stats.time_ns += time_ns.load(std::memory_order_relaxed);
+        stats.counters.cycles += cycles.load(std::memory_order_relaxed);
+        stats.counters.instructions += instructions.load(std::memory_order_relaxed);
+        stats.counters.cache_misses += cache_misses.load(std::memory_order_relaxed);
+        stats.counters.branch_misses += branch_misses.load(std::memory_order_relaxed);
+        stats.allocations += allocations.load(std::memory_order_relaxed);
+        stats.allocated_bytes += allocated_bytes.load(std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto* value : {&calls, &time_ns, &cycles, &instructions, &cache_misses, &branch_misses,
+                            &allocations, &allocated_bytes}) {
+            value->store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+using StageTable = std::array<StageAccumulator, STAGE_COUNT>;
+
+struct ThreadStages;
+
+struct StageRegistry {
+    std::mutex mutex;
+    std::vector<ThreadStages*> threads;
+    std::array<StageStats, STAGE_COUNT> retired{};   // Totals of exited threads
+};
+
+// Never destroyed, so thread_local destructors running at exit can still fold into it
+StageRegistry& stage_registry() {
+    static StageRegistry* registry = new StageRegistry();
+    return *registry;
+}
+
+struct ThreadStages {
+    PerfEventGroup counters;
+    StageTable stages;
+
+    ThreadStages() {
+        StageRegistry& registry = stage_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(this);
+    }
+
+    ~ThreadStages() {
+        StageRegistry& registry = stage_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            stages[i].add_to(registry.retired[i]);
+        }
+        registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), this),
+                               registry.threads.end());
+    }
+};
+
+ThreadStages& thread_stages() {
+    thread_local ThreadStages stages;
+    return stages;
+}
+
+} // namespace
+
+HardwareCounters& HardwareCounters::operator+=(const HardwareCounters& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+}
+
+HardwareCounters HardwareCounters::operator-(const HardwareCounters& other) const {
+    return {cycles - other.cycles, instructions - other.instructions,
+            cache_misses - other.cache_misses, branch_misses - other.branch_misses};
+}
+
+PerfEventGroup::PerfEventGroup() {
+    fds_.fill(-1);
+    slots_.fill(-1);
+
+#ifdef __linux__
+    leader_fd_ = open_perf_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_fd_ < 0) {
+        return;  // TimestampCounter fallback
+    }
+    fds_[CYCLES] = leader_fd_;
+    slots_[CYCLES] = 0;
+    opened_ = 1;
+
+    const std::array<std::pair<Event, uint64_t>, 3> members = {{
+        {INSTRUCTIONS, PERF_COUNT_HW_INSTRUCTIONS},
+        {CACHE_MISSES, PERF_COUNT_HW_CACHE_MISSES},
+        {BRANCH_MISSES, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+    for (const auto& [event, config] : members) {
+        int fd = open_perf_event(config, leader_fd_);
+        if (fd >= 0) {
+            fds_[event] = fd;
+            slots_[event] = static_cast<int>(opened_++);
+        }
+    }
+
+    ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfEventGroup::~PerfEventGroup() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+HardwareCounters PerfEventGroup::read() const {
+    HardwareCounters counters;
+#ifdef __linux__
+    if (leader_fd_ >= 0) {
+        // PERF_FORMAT_GROUP layout: nr, then one value per member in opening order
+        std::array<uint64_t, 1 + EVENT_COUNT> values{};
+        if (::read(leader_fd_, values.data(), sizeof(values)) > 0) {
+            auto value = [&](Event event) { return slots_[event] >= 0 ? values[1 + slots_[event]] : 0; };
+            counters.cycles = value(CYCLES);
+            counters.instructions = value(INSTRUCTIONS);
+            counters.cache_misses = value(CACHE_MISSES);
+            counters.branch_misses = value(BRANCH_MISSES);
+            return counters;
+        }
+    }
+#endif
+    counters.cycles = TimestampCounter::now();
+    return counters;
+}
+
+std::atomic<bool> StageProfiler::enabled_{false};
+
+void StageProfiler::enable(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<StageStats> StageProfiler::breakdown() {
+    StageRegistry& registry = stage_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::vector<StageStats> stats(registry.retired.begin(), registry.retired.end());
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        stats[i].stage = static_cast<PerfStage>(i);
+        for (const ThreadStages* thread : registry.threads) {
+            thread->stages[i].add_to(stats[i]);
+        }
+    }
+    return stats;
+}
+
+void StageProfiler::reset() {
+    StageRegistry& registry = stage_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retired = {};
+    for (ThreadStages* thread : registry.threads) {
+        for (StageAccumulator& stage : thread->stages) {
+            stage.clear();
+        }
+    }
+}
+
+bool StageProfiler::hardware_counters() {
+    return thread_stages().counters.hardware();
+}
+
+void ScopedStage::begin() {
+    start_counters_ = thread_stages().counters.read();
+    AllocationStats allocations = AllocationProfiler::thread_totals();
+    start_allocations_ = allocations.allocations;
+    start_allocated_bytes_ = allocations.allocated_bytes;
+    start_ticks_ = TimestampCounter::now();
+}
+
+void ScopedStage::end() {
+    uint64_t end_ticks = TimestampCounter::now();
+    ThreadStages& thread = thread_stages();
+    HardwareCounters delta = thread.counters.read() - start_counters_;
+    AllocationStats allocations = AllocationProfiler::thread_totals();
+
+    StageAccumulator& stage = thread.stages[static_cast<size_t>(stage_)];
+    stage.calls.fetch_add(1, std::memory_order_relaxed);
+    stage.time_ns.fetch_add(TimestampCounter::to_ns(end_ticks - start_ticks_), std::memory_order_relaxed);
+    stage.cycles.fetch_add(delta.cycles, std::memory_order_relaxed);
+    stage.instructions.fetch_add(delta.instructions, std::memory_order_relaxed);
+    stage.cache_misses.fetch_add(delta.cache_misses, std::memory_order_relaxed);
+    stage.branch_misses.fetch_add(delta.branch_misses, std::memory_order_relaxed);
+    stage.allocations.fetch_add(allocations.allocations - start_allocations_, std::memory_order_relaxed);
+    stage.allocated_bytes.fetch_add(allocations.allocated_bytes - start_allocated_bytes_,
+                                    std::memory_order_relaxed);
+}
+
+// Resident set from /proc/self/statm, peak from getrusage
+MemoryStats PerformanceMetrics::get_memory_usage_impl() {
+    size_t resident = 0;
+    size_t peak = 0;
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        resident = resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        peak = static_cast<size_t>(usage.ru_maxrss) * 1024;  // Reported in KiB
+    }
+#endif
+    peak = std::max(peak, resident);
+    return {resident, peak, resident};
+}
+
+uint64_t PerformanceMetrics::get_cpu_cycles_impl() {
+    return thread_stages().counters.read().cycles;
+}
+
+// Get current memory usage
+MemoryStats PerformanceMetrics::get_memory_usage() {
+    return get_memory_usage_impl();
+}
+
+// Time operation with memory tracking
+TimingStats PerformanceMetrics::time_operation_with_memory(
+    const std::function<void()>& operation,
+    MemoryStats& memory_stats,
+    int iterations
+) {
+    check_iterations(iterations);
+    std::vector<double> times;
+    times.reserve(iterations);
+
+    size_t peak_memory = 0;
+    size_t total_memory = 0;
+    size_t current_memory = 0;
+
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(elapsed_us(start, end));
+
+        // Get memory usage after operation
+        MemoryStats current_mem = get_memory_usage();
+        current_memory = current_mem.current_memory;
+        peak_memory = std::max(peak_memory, current_mem.peak_memory);
+        total_memory += current_mem.current_memory;
+    }
+
+    memory_stats.current_memory = current_memory;
+    memory_stats.peak_memory = peak_memory;
+    memory_stats.average_memory = total_memory / iterations;
+
+    return summarize_times(times);
+}
+
+// Time operation with CPU cycle counting
+CycleStats PerformanceMetrics::time_operation_cycles(
+    const std::function<void()>& operation,
+    int iterations
+) {
+    check_iterations(iterations);
+    std::vector<uint64_t> cycles;
+    cycles.reserve(iterations);
+
+    for (int i = 0; i < iterations; ++i) {
+        uint64_t start_cycles = get_cpu_cycles_impl();
+        operation();
+        uint64_t end_cycles = get_cpu_cycles_impl();
+        cycles.push_back(end_cycles - start_cycles);
+    }
+
+    uint64_t total_cycles = std::accumulate(cycles.begin(), cycles.end(), uint64_t(0));
+    uint64_t avg_cycles = total_cycles / iterations;
+    uint64_t min_cycles = *std::min_element(cycles.begin(), cycles.end());
+    uint64_t max_cycles = *std::max_element(cycles.begin(), cycles.end());
+
+    return {total_cycles, avg_cycles, min_cycles, max_cycles};
+}
+
+// High-precision timing only
+TimingStats PerformanceMetrics::time_operation(
+    const std::function<void()>& operation,
+    int iterations
+) {
+    check_iterations(iterations);
+    std::vector<double> times;
+    times.reserve(iterations);
+
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(elapsed_us(start, end));
+    }
+
+    return summarize_times(times);
+}
+
+// Hardware counters per operation
+HardwareCounters PerformanceMetrics::count_operation(
+    const std::function<void()>& operation,
+    int iterations
+) {
+    check_iterations(iterations);
+    const PerfEventGroup& counters = thread_stages().counters;
+
+    HardwareCounters start = counters.read();
+    for (int i = 0; i < iterations; ++i) {
+        operation();
+    }
+    HardwareCounters total = counters.read() - start;
+
+    return {total.cycles / iterations, total.instructions / iterations,
+            total.cache_misses / iterations, total.branch_misses / iterations};
+}
+
+// Combined measurement
+PerformanceMetrics::CombinedStats PerformanceMetrics::measure_operation(
+    const std::function<void()>& operation,
+    int iterations
+) {
+    CombinedStats result;
+
+    // Measure timing and memory together
+    result.timing = time_operation_with_memory(operation, result.memory, iterations);
+
+    // Measure cycles and the other hardware events separately
+    result.cycles = time_operation_cycles(operation, iterations);
+    result.hardware = count_operation(operation, iterations);
+
+    return result;
+}
+
+} // namespace clwe
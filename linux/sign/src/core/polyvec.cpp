@@ -0,0 +1,108 @@
+#include "../include/clwe/polyvec.hpp"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace clwe {
+
+PolyVec::PolyVec(uint32_t k, uint32_t n)
+    : PolyVec(k, n, nullptr) {
+}
+
+PolyVec::PolyVec(uint32_t k, uint32_t n, std::pmr::memory_resource* resource)
+    : k_(k), n_(n), resource_(resource) {
+    size_t count = coeff_count();
+    if (count > 0) {
+        size_t bytes = count * sizeof(uint32_t);
+        void* storage = resource_ ? resource_->allocate(bytes, POLY_ALIGNMENT)
+                                  : ::operator new(bytes, std::align_val_t(POLY_ALIGNMENT));
+        coeffs_ = static_cast<uint32_t*>(storage);
+        std::fill(coeffs_, coeffs_ + count, 0);
+    }
+}
+
+PolyVec::~PolyVec() {
+    release();
+}
+
+PolyVec::PolyVec(PolyVec&& other) noexcept
+    : coeffs_(std::exchange(other.coeffs_, nullptr)),
+      k_(std::exchange(other.k_, 0)),
+      n_(std::exchange(other.n_, 0)),
+      resource_(std::exchange(other.resource_, nullptr)) {
+}
+
+PolyVec& PolyVec::operator=(PolyVec&& other) noexcept {
+    if (this != &other) {
+        release();
+        coeffs_ = std::exchange(other.coeffs_, nullptr);
+        k_ = std::exchange(other.k_, 0);
+        n_ = std::exchange(other.n_, 0);
+        resource_ = std::exchange(other.resource_, nullptr);
+    }
+    return *this;
+}
+
+void PolyVec::release() {
+    if (!coeffs_) {
+        return;
+    }
+    if (resource_) {
+        resource_->deallocate(coeffs_, coeff_count() * sizeof(uint32_t), POLY_ALIGNMENT);
+    } else {
+        ::operator delete(coeffs_, std::align_val_t(POLY_ALIGNMENT));
+    }
+    coeffs_ = nullptr;
+}
+
+void PolyVec::fill(uint32_t value) {
+    std::fill(coeffs_, coeffs_ + coeff_count(), value);
+}
+
+PolyVec PolyVec::clone() const {
+    PolyVec copy(k_, n_, resource_);
+    std::copy(coeffs_, coeffs_ + coeff_count(), copy.coeffs_);
+    return copy;
+}
+
+PolyVec PolyVec::from_vectors(const std::vector<std::vector<uint32_t>>& poly_vector) {
+    uint32_t k = static_cast<uint32_t>(poly_vector.size());
+    uint32_t n = k > 0 ? static_cast<uint32_t>(poly_vector[0].size()) : 0;
+
+    PolyVec result(k, n);
+    for (uint32_t i = 0; i < k; ++i) {
+        if (poly_vector[i].size() != n) {
+            throw std::invalid_argument("All polynomials in a vector must have the same degree");
+        }
+        std::copy(poly_vector[i].begin(), poly_vector[i].end(), result[i].begin());
+    }
+    return result;
+}
+
+std::vector<std::vector<uint32_t>> PolyVec::to_vectors() const {
+    std::vector<std::vector<uint32_t>> poly_vector(k_);
+    for (uint32_t i = 0; i < k_; ++i) {
+        ConstPolySpan poly = (*this)[i];
+        poly_vector[i].assign(poly.begin(), poly.end());
+    }
+    return poly_vector;
+}
+
+PolyMat::PolyMat(uint32_t rows, uint32_t cols, uint32_t n)
+    : polys_(rows * cols, n), rows_(rows), cols_(cols) {
+}
+
+PolyMat PolyMat::from_vectors(const std::vector<std::vector<uint32_t>>& matrix, uint32_t rows, uint32_t cols) {
+    if (matrix.size() != static_cast<size_t>(rows) * cols) {
+        throw std::invalid_argument("Matrix entry count does not match dimensions");
+    }
+
+    PolyMat result;
+    result.polys_ = PolyVec::from_vectors(matrix);
+    result.rows_ = rows;
+    result.cols_ = cols;
+    return result;
+}
+
+} // namespace clwe
@@ -0,0 +1,234 @@
+#include "../include/clwe/secure_arena.hpp"
+#include "../include/clwe/metrics.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace clwe {
+
+namespace {
+
+constexpr size_t DEFAULT_ARENA_CAPACITY = 1u << 20;
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t page_size() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+// Single-pass wipe the compiler cannot elide
+void wipe(void* ptr, size_t size) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(ptr);
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
+} // namespace
+
+SecureArena::SecureArena(size_t capacity, MemoryLockPolicy lock_policy) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Secure arena capacity must be positive");
+    }
+    capacity_ = round_up(capacity, page_size());
+
+#ifdef _WIN32
+    base_ = static_cast<uint8_t*>(VirtualAlloc(NULL, capacity_, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (!base_) {
+        throw std::bad_alloc();
+    }
+    locked_ = VirtualLock(base_, capacity_) != 0;
+    int lock_error = locked_ ? 0 : static_cast<int>(GetLastError());
+    if (!locked_ && lock_policy == MemoryLockPolicy::REQUIRED) {
+        VirtualFree(base_, 0, MEM_RELEASE);
+        throw std::system_error(lock_error, std::system_category(), "Secure arena could not lock its region");
+    }
+#else
+    void* region = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    base_ = static_cast<uint8_t*>(region);
+    locked_ = mlock(base_, capacity_) == 0;
+    int lock_error = locked_ ? 0 : errno;
+    if (!locked_ && lock_policy == MemoryLockPolicy::REQUIRED) {
+        munmap(base_, capacity_);
+        throw std::system_error(lock_error, std::generic_category(), "Secure arena could not lock its region");
+    }
+#ifdef MADV_DONTDUMP
+    madvise(base_, capacity_, MADV_DONTDUMP);
+#endif
+#endif
+
+    stats_.capacity = capacity_;
+    stats_.locked_bytes = locked_ ? capacity_ : 0;
+    secure_memory_locked_gauge().add(static_cast<int64_t>(stats_.locked_bytes));
+
+    if (!locked_) {
+        // Secrets in this arena may be swapped out; make that visible rather than silent
+        secure_memory_lock_failures().add();
+        std::cerr << "Warning: secure arena of " << capacity_ << " bytes could not be locked in RAM ("
+                  << std::system_category().message(lock_error) << ")" << std::endl;
+    }
+}
+
+SecureArena::~SecureArena() {
+    // Only the used prefix can hold secrets
+    wipe(base_, bump_);
+
+#ifdef _WIN32
+    if (locked_) {
+        VirtualUnlock(base_, capacity_);
+    }
+    VirtualFree(base_, 0, MEM_RELEASE);
+#else
+    if (locked_) {
+        munlock(base_, capacity_);
+    }
+    munmap(base_, capacity_);
+#endif
+    secure_memory_locked_gauge().add(-static_cast<int64_t>(stats_.locked_bytes));
+}
+
+SecureArenaStats SecureArena::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool SecureArena::owns(const void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return p >= base_ && p < base_ + capacity_;
+}
+
+void* SecureArena::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (alignment > BLOCK_ALIGNMENT || bytes > capacity_) {
+        ++stats_.failed_allocations;
+        throw std::bad_alloc();
+    }
+    size_t size = round_up(std::max<size_t>(bytes, 1), BLOCK_ALIGNMENT);
+
+    // First fit among released blocks, splitting off the unused tail
+    uint8_t* block = nullptr;
+    for (FreeBlock** link = &free_list_; *link; link = &(*link)->next) {
+        FreeBlock* candidate = *link;
+        if (candidate->size < size) {
+            continue;
+        }
+        if (candidate->size > size) {
+            FreeBlock* tail = reinterpret_cast<FreeBlock*>(reinterpret_cast<uint8_t*>(candidate) + size);
+            tail->size = candidate->size - size;
+            tail->next = candidate->next;
+            *link = tail;
+        } else {
+            *link = candidate->next;
+        }
+        block = reinterpret_cast<uint8_t*>(candidate);
+        wipe(block, sizeof(FreeBlock));  // Hand out zeroed memory, as released blocks are
+        break;
+    }
+
+    if (!block) {
+        if (size > capacity_ - bump_) {
+            ++stats_.failed_allocations;
+            throw std::bad_alloc();
+        }
+        block = base_ + bump_;
+        bump_ += size;
+    }
+
+    stats_.bytes_in_use += size;
+    stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+    ++stats_.active_allocations;
+    ++stats_.total_allocations;
+    return block;
+}
+
+void SecureArena::do_deallocate(void* ptr, size_t bytes, size_t) {
+    if (!ptr) {
+        return;
+    }
+    size_t size = round_up(std::max<size_t>(bytes, 1), BLOCK_ALIGNMENT);
+    uint8_t* block = static_cast<uint8_t*>(ptr);
+    // Checked before the wipe: a foreign pointer must neither be zeroed nor enter the free list
+    size_t offset = owns(ptr) ? static_cast<size_t>(block - base_) : capacity_;
+    if (offset == capacity_ || offset % BLOCK_ALIGNMENT != 0 || size > capacity_ - offset) {
+        throw std::invalid_argument("Secure arena cannot release memory it did not allocate");
+    }
+    wipe(block, size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.bytes_in_use -= size;
+    --stats_.active_allocations;
+
+    // Insert in address order, merging with the neighbouring free blocks
+    FreeBlock* prev = nullptr;
+    FreeBlock* next = free_list_;
+    while (next && reinterpret_cast<uint8_t*>(next) < block) {
+        prev = next;
+        next = next->next;
+    }
+
+    FreeBlock* freed = reinterpret_cast<FreeBlock*>(block);
+    freed->size = size;
+    freed->next = next;
+    if (next && block + size == reinterpret_cast<uint8_t*>(next)) {
+        freed->size += next->size;
+        freed->next = next->next;
+        wipe(next, sizeof(FreeBlock));
+    }
+    if (prev && reinterpret_cast<uint8_t*>(prev) + prev->size == block) {
+        prev->size += freed->size;
+        prev->next = freed->next;
+        wipe(freed, sizeof(FreeBlock));
+        freed = prev;
+    } else if (prev) {
+        prev->next = freed;
+    } else {
+        free_list_ = freed;
+    }
+
+    // A free block ending at the bump pointer returns to the untouched region
+    if (reinterpret_cast<uint8_t*>(freed) + freed->size == base_ + bump_ && !freed->next) {
+        bump_ -= freed->size;
+        if (prev == freed) {
+            // Merged into prev: find the block before it
+            FreeBlock** link = &free_list_;
+            while (*link != freed) {
+                link = &(*link)->next;
+            }
+            *link = nullptr;
+        } else if (prev) {
+            prev->next = nullptr;
+        } else {
+            free_list_ = nullptr;
+        }
+        wipe(freed, sizeof(FreeBlock));
+    }
+}
+
+SecureArena& default_secure_arena() {
+    static SecureArena arena(DEFAULT_ARENA_CAPACITY);
+    return arena;
+}
+
+} // namespace clwe
@@ -6,6 +6,7 @@
 #include <chrono>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <cmath>
 
 #ifdef _WIN32
@@ -22,7 +23,12 @@ namespace clwe {
 
 std::unique_ptr<SecurityMonitor> global_security_monitor;
 
+namespace {
+std::mutex global_monitor_mutex;
+}
+
 void initialize_security_monitor(std::unique_ptr<SecurityMonitor> monitor) {
+    std::lock_guard<std::mutex> lock(global_monitor_mutex);
     if (!monitor) {
         global_security_monitor = std::make_unique<DefaultSecurityMonitor>();
     } else {
@@ -31,20 +37,60 @@ void initialize_security_monitor(std::unique_ptr<SecurityMonitor> monitor) {
 }
 
 SecurityMonitor* get_security_monitor() {
+    std::lock_guard<std::mutex> lock(global_monitor_mutex);
     if (!global_security_monitor) {
-        initialize_security_monitor();
+        global_security_monitor = std::make_unique<DefaultSecurityMonitor>();
     }
     return global_security_monitor.get();
 }
 
 void DefaultSecurityMonitor::log_event(const AuditEntry& entry) {
-    audit_log_.push_back(entry);
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (max_log_size_ == 0) {
+        audit_log_.clear();
+        log_head_ = 0;
+        return;
+    }
+    if (audit_log_.size() < max_log_size_) {
+        audit_log_.push_back(entry);
+        return;
+    }
+    // Full: overwrite the oldest slot so its string buffers are reused
+    audit_log_[log_head_] = entry;
+    log_head_ = (log_head_ + 1) % audit_log_.size();
+}
 
-    if (audit_log_.size() > max_log_size_) {
-        audit_log_.erase(audit_log_.begin());
+void DefaultSecurityMonitor::unwrap_audit_log() {
+    if (log_head_ != 0) {
+        std::rotate(audit_log_.begin(), audit_log_.begin() + log_head_, audit_log_.end());
+        log_head_ = 0;
     }
 }
 
+std::vector<AuditEntry> DefaultSecurityMonitor::get_audit_log() const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    std::vector<AuditEntry> log;
+    log.reserve(audit_log_.size());
+    log.insert(log.end(), audit_log_.begin() + log_head_, audit_log_.end());
+    log.insert(log.end(), audit_log_.begin(), audit_log_.begin() + log_head_);
+    return log;
+}
+
+void DefaultSecurityMonitor::clear_audit_log() {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    audit_log_.clear();
+    log_head_ = 0;
+}
+
+void DefaultSecurityMonitor::set_max_log_size(size_t size) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    unwrap_audit_log();
+    if (audit_log_.size() > size) {
+        audit_log_.erase(audit_log_.begin(), audit_log_.begin() + (audit_log_.size() - size));
+    }
+    max_log_size_ = size;
+}
+
 void DefaultSecurityMonitor::report_security_violation(SecurityError error, const std::string& details) {
     AuditEntry entry{
         AuditEvent::SECURITY_VIOLATION,
@@ -57,62 +103,32 @@ void DefaultSecurityMonitor::report_security_violation(SecurityError error, cons
 }
 
 bool DefaultSecurityMonitor::detect_timing_anomaly(const std::string& operation_name, uint64_t operation_time_ns) {
-    auto& history = operation_histories_[operation_name];
-    history.push_back(operation_time_ns);
-
-    if (history.size() > max_history_size_) {
-        history.erase(history.begin());
-    }
+    return detect_timing_anomaly(timing_detector_.register_operation(operation_name), operation_time_ns);
+}
 
-    if (history.size() < min_samples_for_stats_) {
+bool DefaultSecurityMonitor::detect_timing_anomaly(OperationId operation, uint64_t operation_time_ns) {
+    TimingObservation observation;
+    if (!timing_detector_.observe(operation, operation_time_ns, &observation)) {
         return false;
     }
 
-    double k = operation_k_values_[operation_name];
-    if (k == 0.0) {
-        k = 3.0;
-    }
-
-    double sum = 0.0;
-    for (auto time : history) {
-        sum += static_cast<double>(time);
-    }
-    double mean = sum / history.size();
-
-    double variance = 0.0;
-    for (auto time : history) {
-        double diff = static_cast<double>(time) - mean;
-        variance += diff * diff;
-    }
-    variance /= history.size();
-    double std_dev = std::sqrt(variance);
-
-    double threshold = mean + k * std_dev;
-
-    bool is_anomaly = static_cast<double>(operation_time_ns) > threshold;
-
-    if (is_anomaly) {
-        consecutive_anomalies_[operation_name]++;
-        if (consecutive_anomalies_[operation_name] >= 3) {
-            report_security_violation(SecurityError::TIMING_ATTACK_DETECTED,
-                "Statistical timing anomaly detected in " + operation_name +
-                ": " + std::to_string(operation_time_ns) + " ns (mean: " +
-                std::to_string(mean) + ", std_dev: " + std::to_string(std_dev) +
-                ", threshold: " + std::to_string(threshold) + ")");
-            return true;
-        }
-    } else {
-        consecutive_anomalies_[operation_name] = 0;
-    }
-
-    return false;
+    report_security_violation(SecurityError::TIMING_ATTACK_DETECTED,
+        "Statistical timing anomaly detected in " + timing_detector_.operation_name(operation) +
+        ": " + std::to_string(operation_time_ns) + " ns (mean: " +
+        std::to_string(observation.mean_ns) + ", std_dev: " + std::to_string(observation.stddev_ns) +
+        ", threshold: " + std::to_string(observation.threshold_ns) + ")");
+    return true;
 }
 
 SecurityError InputValidator::validate_message_size(const std::vector<uint8_t>& message) {
-    if (message.size() > MAX_MESSAGE_SIZE) {
+    return validate_message_size(message.data(), message.size());
+}
+
+SecurityError InputValidator::validate_message_size(const uint8_t*, size_t message_len) {
+    if (message_len > MAX_MESSAGE_SIZE) {
         return SecurityError::INVALID_INPUT_SIZE;
     }
-    if (message.empty()) {
+    if (message_len == 0) {
         return SecurityError::INVALID_INPUT_SIZE;
     }
     return SecurityError::SUCCESS;
@@ -153,7 +169,9 @@ SecurityError InputValidator::validate_key_format(const std::vector<uint8_t>& ke
         return size_check;
     }
 
-    size_t expected_min_size = params.module_rank * params.degree * 4;
+    // Keys hold packed coefficients, never a 32-bit word each: t1 takes 10 bits and exact s1 || s2
+    // as little as 3 bits per coefficient, so the floor is one byte per coefficient of a k-vector
+    size_t expected_min_size = params.module_rank * params.degree;
     if (key_data.size() < expected_min_size) {
         return SecurityError::INVALID_KEY_FORMAT;
     }
@@ -162,12 +180,35 @@ SecurityError InputValidator::validate_key_format(const std::vector<uint8_t>& ke
 }
 
 SecurityError InputValidator::validate_context_string(const std::vector<uint8_t>& context) {
-    if (context.size() > 255) {
+    return validate_context_string(context.data(), context.size());
+}
+
+SecurityError InputValidator::validate_context_string(const uint8_t*, size_t context_len) {
+    if (context_len > 255) {
         return SecurityError::INVALID_CONTEXT;
     }
     return SecurityError::SUCCESS;
 }
 
+// Check that every coefficient, read as a centered representative mod q, lies in [min_val, max_val]
+static bool coefficients_within_bounds(const uint32_t* coeffs, size_t count, int32_t min_val, int32_t max_val, uint32_t q) {
+    uint32_t q_half = q / 2;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t coeff = coeffs[i];
+        int32_t signed_coeff;
+        if (coeff >= q_half) {
+            signed_coeff = static_cast<int32_t>(coeff) - static_cast<int32_t>(q);
+        } else {
+            signed_coeff = static_cast<int32_t>(coeff);
+        }
+
+        if (signed_coeff < min_val || signed_coeff > max_val) {
+            return false;
+        }
+    }
+    return true;
+}
+
 SecurityError InputValidator::validate_polynomial_vector_bounds(const std::vector<std::vector<uint32_t>>& poly_vec,
                                                                 uint32_t expected_k, uint32_t expected_n,
                                                                 int32_t min_val, int32_t max_val, uint32_t q) {
@@ -180,24 +221,28 @@ SecurityError InputValidator::validate_polynomial_vector_bounds(const std::vecto
             return SecurityError::BOUNDS_CHECK_FAILURE;
         }
 
-        for (uint32_t coeff : poly) {
-            uint32_t q_half = q / 2;
-            int32_t signed_coeff;
-            if (coeff >= q_half) {
-                signed_coeff = static_cast<int32_t>(coeff) - static_cast<int32_t>(q);
-            } else {
-                signed_coeff = static_cast<int32_t>(coeff);
-            }
-
-            if (signed_coeff < min_val || signed_coeff > max_val) {
-                return SecurityError::BOUNDS_CHECK_FAILURE;
-            }
+        if (!coefficients_within_bounds(poly.data(), poly.size(), min_val, max_val, q)) {
+            return SecurityError::BOUNDS_CHECK_FAILURE;
         }
     }
 
     return SecurityError::SUCCESS;
 }
 
+SecurityError InputValidator::validate_polynomial_vector_bounds(const PolyVec& poly_vec,
+                                                                uint32_t expected_k, uint32_t expected_n,
+                                                                int32_t min_val, int32_t max_val, uint32_t q) {
+    if (poly_vec.size() != expected_k || poly_vec.degree() != expected_n) {
+        return SecurityError::BOUNDS_CHECK_FAILURE;
+    }
+
+    if (!coefficients_within_bounds(poly_vec.data(), poly_vec.coeff_count(), min_val, max_val, q)) {
+        return SecurityError::BOUNDS_CHECK_FAILURE;
+    }
+
+    return SecurityError::SUCCESS;
+}
+
 void* SecureMemory::secure_malloc(size_t size) {
     if (size == 0) {
         return nullptr;
@@ -371,29 +416,47 @@ TimingProtection::TimingProtection(std::unique_ptr<SecurityMonitor> monitor)
 
 TimingProtection::~TimingProtection() = default;
 
-void TimingProtection::start_operation() {
-    operation_start_time_ = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+OperationId TimingProtection::register_operation(const std::string& operation_name, double k_value) {
+    OperationId id = detector_.register_operation(operation_name);
+    detector_.set_threshold(id, k_value);
+    return id;
 }
 
-void TimingProtection::end_operation(const std::string& operation_name) {
-    auto end_time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    uint64_t duration_ns = end_time - operation_start_time_;
+uint64_t TimingProtection::start_operation() {
+    return TimestampCounter::now();
+}
 
-    if (monitor_->detect_timing_anomaly(operation_name, duration_ns)) {
-        AuditEntry entry{
-            AuditEvent::TIMING_ANOMALY,
-            std::chrono::system_clock::now(),
-            "Timing anomaly in " + operation_name + ": " + std::to_string(duration_ns) + " ns",
-            operation_name,
-            static_cast<uint32_t>(SecurityError::TIMING_ATTACK_DETECTED)
-        };
-        monitor_->log_event(entry);
+void TimingProtection::end_operation(const std::string& operation_name, uint64_t start_ticks) {
+    end_operation(detector_.register_operation(operation_name), start_ticks);
+}
+
+void TimingProtection::end_operation(OperationId operation, uint64_t start_ticks) {
+    uint64_t duration_ns = TimestampCounter::to_ns(TimestampCounter::now() - start_ticks);
+
+    TimingObservation observation;
+    if (!detector_.observe(operation, duration_ns, &observation)) {
+        return;
     }
+
+    // Anomalies are rare; only now are the report strings built
+    const std::string& operation_name = detector_.operation_name(operation);
+    monitor_->report_security_violation(SecurityError::TIMING_ATTACK_DETECTED,
+        "Statistical timing anomaly detected in " + operation_name +
+        ": " + std::to_string(duration_ns) + " ns (mean: " +
+        std::to_string(observation.mean_ns) + ", std_dev: " + std::to_string(observation.stddev_ns) +
+        ", threshold: " + std::to_string(observation.threshold_ns) + ")");
+    AuditEntry entry{
+        AuditEvent::TIMING_ANOMALY,
+        std::chrono::system_clock::now(),
+        "Timing anomaly in " + operation_name + ": " + std::to_string(duration_ns) + " ns",
+        operation_name,
+        static_cast<uint32_t>(SecurityError::TIMING_ATTACK_DETECTED)
+    };
+    monitor_->log_event(entry);
 }
 
-uint64_t TimingProtection::get_operation_time_ns() const {
-    auto current_time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    return current_time - operation_start_time_;
+uint64_t TimingProtection::get_operation_time_ns(uint64_t start_ticks) const {
+    return TimestampCounter::to_ns(TimestampCounter::now() - start_ticks);
 }
 
 std::string get_security_error_message(SecurityError error) {
@@ -1,9 +1,13 @@
 #include "../include/clwe/sign.hpp"
 #include "../include/clwe/cose.hpp"
+#include "../include/clwe/stream.hpp"
 #include "../include/clwe/color_integration.hpp"
 #include "../include/clwe/utils.hpp"
 #include "../include/clwe/keygen.hpp"
 #include "../include/clwe/ntt_engine.hpp"
+#include "../include/clwe/metrics.hpp"
+#include "../include/clwe/performance_metrics.hpp"
+#include "../include/clwe/worker_pool.hpp"
 #include <random>
 #include <algorithm>
 #include <stdexcept>
@@ -11,11 +15,33 @@
 #include <array>
 #include <iostream>
 #include <chrono>
+#include <exception>
 
 namespace clwe {
 
+namespace {
+
+// [header ||] z || h || c into `out`, which has room for all of it; returns the bytes written
+size_t write_signature(SignatureFormat format, ByteSpan z, ByteSpan h, ByteSpan c, uint8_t* out) {
+    uint8_t* start = out;
+    if (format == SignatureFormat::FIPS204) {
+        *out++ = SIGNATURE_MAGIC;
+        *out++ = SIGNATURE_FORMAT_VERSION;
+    }
+    out = std::copy(z.begin(), z.end(), out);
+    out = std::copy(h.begin(), h.end(), out);
+    out = std::copy(c.begin(), c.end(), out);
+    return static_cast<size_t>(out - start);
+}
+
+} // namespace
+
 ColorSign::ColorSign(const CLWEParameters& params, std::unique_ptr<SecurityMonitor> monitor)
-    : params_(params), security_monitor_(std::move(monitor)), timing_protection_(std::make_unique<TimingProtection>()) {
+    : params_(params), fixed_level_(standard_parameter_set(params)), security_monitor_(std::move(monitor)), timing_protection_(std::make_unique<TimingProtection>()),
+      validation_timing_id_(timing_protection_->register_operation("sign_message_validation")),
+      signing_timing_id_(timing_protection_->register_operation("sign_message_success")),
+      key_cache_(std::make_shared<ExpandedKeyCache>()),
+      metrics_(&SchemeMetrics::for_level(params.security_level)) {
 
     // Initialize security monitor if not provided
     if (!security_monitor_) {
@@ -49,30 +75,161 @@ ColorSign::ColorSign(const CLWEParameters& params, std::unique_ptr<SecurityMonit
 
 ColorSign::~ColorSign() = default;
 
+void ColorSign::set_expanded_key_cache(std::shared_ptr<ExpandedKeyCache> cache) {
+    if (!cache) {
+        throw std::invalid_argument("Expanded key cache must not be null");
+    }
+    key_cache_ = std::move(cache);
+}
+
+// The key to sign with: seed-only keys resolve to their cached expansion, held by `expanded`
+const ColorSignPrivateKey& ColorSign::signing_key(const ColorSignPrivateKey& private_key,
+                                                  std::shared_ptr<const ColorSignPrivateKey>& expanded) {
+    if (!private_key.is_seed_only()) {
+        return private_key;
+    }
+    expanded = key_cache_->expand(private_key);
+    return *expanded;
+}
+
+SignWorkspace::Candidate::Candidate(const CLWEParameters& params, std::pmr::memory_resource* secret_resource)
+    : y(params.module_rank, params.degree, secret_resource),
+      w(params.module_rank, params.degree),
+      z(params.module_rank, params.degree, secret_resource),
+      w_prime(params.module_rank, params.degree),
+      w1(params.module_rank, params.degree),
+      c(params.degree),
+      challenge_positions(params.degree),
+      product(params.degree),
+      challenge_seed(64 + 2 * params.module_rank * params.degree),
+      z_encoded(ml_dsa_packed_size(params.module_rank, params.degree, 18)),
+      h(params.omega),
+      c_packed((params.degree + 3) / 4) {
+}
+
+SignWorkspace::SignWorkspace(const CLWEParameters& params, std::pmr::memory_resource* secret_resource)
+    : params_(params),
+      secret_resource_(secret_resource),
+      ntt_engine_(create_optimal_ntt_engine(params.modulus, params.degree)),
+      matrix_A_(params.module_rank, params.module_rank, params.degree),
+      secret_polys_(2 * params.module_rank, params.degree, secret_resource),
+      s1_(params.module_rank, params.degree, secret_resource),
+      s2_(params.module_rank, params.degree, secret_resource),
+      t0_(params.module_rank, params.degree, secret_resource),
+      mu_(64),
+      rho_prime_(64),
+      start_entry_{AuditEvent::SIGNING_START, {}, "Starting signature generation", "ColorSign::sign_message", 0},
+      success_entry_{AuditEvent::SIGNING_SUCCESS, {}, "Signature generation completed successfully", "ColorSign::sign_message", 0},
+      y_bounds_details_("Y polynomial bounds violation") {
+    candidates_.reserve(1);
+    candidates_.emplace_back(params_, secret_resource_);
+}
+
+SignWorkspace::~SignWorkspace() = default;
+
+void SignWorkspace::ensure_candidates(size_t count) {
+    if (candidates_.size() < count) {
+        candidates_.reserve(count);
+        while (candidates_.size() < count) {
+            candidates_.emplace_back(params_, secret_resource_);
+        }
+        candidate_errors_.resize(count);
+    }
+    if (count > 1 && (!workers_ || workers_->workers() < count - 1)) {
+        workers_.reset();
+        workers_ = std::make_unique<WorkerPool>(count - 1);
+    }
+}
+
+void ColorSign::set_speculative_candidates(uint32_t count) {
+    if (count == 0 || count > 64) {
+        throw std::invalid_argument("Speculative candidate count must be between 1 and 64");
+    }
+    speculative_candidates_ = count;
+}
+
+void ColorSign::set_instrumentation_level(InstrumentationLevel level, uint32_t sample_interval) {
+    if (sample_interval == 0) {
+        throw std::invalid_argument("Instrumentation sample interval must be positive");
+    }
+    instrumentation_level_ = INSTRUMENTATION_ENABLED ? level : InstrumentationLevel::OFF;
+    sample_interval_ = sample_interval;
+}
+
+SigningCounters ColorSign::signing_counters() const {
+    SigningCounters snapshot;
+    snapshot.signatures = counters_.signatures.load(std::memory_order_relaxed);
+    snapshot.rejection_restarts = counters_.rejection_restarts.load(std::memory_order_relaxed);
+    snapshot.w1_rejections = counters_.w1_rejections.load(std::memory_order_relaxed);
+    snapshot.z_rejections = counters_.z_rejections.load(std::memory_order_relaxed);
+    snapshot.hint_rejections = counters_.hint_rejections.load(std::memory_order_relaxed);
+    snapshot.y_bound_violations = counters_.y_bound_violations.load(std::memory_order_relaxed);
+    snapshot.validation_failures = counters_.validation_failures.load(std::memory_order_relaxed);
+    snapshot.traced_signatures = counters_.traced_signatures.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void ColorSign::reset_signing_counters() {
+    for (auto* counter : {&counters_.signatures, &counters_.rejection_restarts, &counters_.w1_rejections,
+                          &counters_.z_rejections, &counters_.hint_rejections, &counters_.y_bound_violations,
+                          &counters_.validation_failures, &counters_.traced_signatures}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+bool ColorSign::trace_next_signature() {
+    if (!INSTRUMENTATION_ENABLED) {
+        return false;
+    }
+    switch (instrumentation_level_) {
+        case InstrumentationLevel::FULL:
+            return true;
+        case InstrumentationLevel::SAMPLED:
+            return sample_clock_.fetch_add(1, std::memory_order_relaxed) % sample_interval_ == 0;
+        default:
+            return false;
+    }
+}
+
 void ColorSign::set_security_monitor(std::unique_ptr<SecurityMonitor> monitor) {
     security_monitor_ = std::move(monitor);
     timing_protection_ = std::make_unique<TimingProtection>(
         security_monitor_ ? nullptr : std::make_unique<DefaultSecurityMonitor>());
+    validation_timing_id_ = timing_protection_->register_operation("sign_message_validation");
+    signing_timing_id_ = timing_protection_->register_operation("sign_message_success");
 }
 
 ColorSignSignError ColorSign::validate_signing_inputs(const std::vector<uint8_t>& message,
                                                      const ColorSignPrivateKey& private_key,
                                                      const ColorSignPublicKey& public_key,
                                                      const std::vector<uint8_t>& context) const {
+    return validate_signing_inputs(message.data(), message.size(), private_key, public_key,
+                                   context.data(), context.size());
+}
+
+ColorSignSignError ColorSign::validate_signing_inputs(const uint8_t* message, size_t message_len,
+                                                     const ColorSignPrivateKey& private_key,
+                                                     const ColorSignPublicKey& public_key,
+                                                     const uint8_t* context, size_t context_len) const {
     // Validate message size
-    SecurityError msg_check = InputValidator::validate_message_size(message);
+    SecurityError msg_check = InputValidator::validate_message_size(message, message_len);
     if (msg_check != SecurityError::SUCCESS) {
         security_monitor_->report_security_violation(msg_check, "Invalid message size in signing");
         return ColorSignSignError::MESSAGE_SIZE_INVALID;
     }
 
     // Validate context
-    SecurityError ctx_check = InputValidator::validate_context_string(context);
+    SecurityError ctx_check = InputValidator::validate_context_string(context, context_len);
     if (ctx_check != SecurityError::SUCCESS) {
         security_monitor_->report_security_violation(ctx_check, "Invalid context in signing");
         return ColorSignSignError::CONTEXT_INVALID;
     }
 
+    return validate_signing_keys(private_key, public_key);
+}
+
+ColorSignSignError ColorSign::validate_signing_keys(const ColorSignPrivateKey& private_key,
+                                                   const ColorSignPublicKey& public_key) const {
     // Validate private key
     SecurityError priv_check = InputValidator::validate_key_format(private_key.secret_data, params_);
     if (priv_check != SecurityError::SUCCESS) {
@@ -103,164 +260,435 @@ ColorSignature ColorSign::sign_message(const std::vector<uint8_t>& message,
                                        const ColorSignPrivateKey& private_key,
                                        const ColorSignPublicKey& public_key,
                                        const std::vector<uint8_t>& context) {
+    return sign_message(message.data(), message.size(), private_key, public_key, context.data(), context.size());
+}
+
+void ColorSign::sign_message(const std::vector<uint8_t>& message,
+                             const ColorSignPrivateKey& private_key,
+                             const ColorSignPublicKey& public_key,
+                             SignWorkspace& workspace,
+                             ColorSignature& signature,
+                             const std::vector<uint8_t>& context) {
+    sign_message(message.data(), message.size(), private_key, public_key, workspace, signature,
+                 context.data(), context.size());
+}
+
+ColorSignature ColorSign::sign_message(const uint8_t* message, size_t message_len,
+                                       const ColorSignPrivateKey& private_key,
+                                       const ColorSignPublicKey& public_key,
+                                       const uint8_t* context, size_t context_len) {
+    SignWorkspace workspace(params_);
+    ColorSignature signature;
+    sign_message(message, message_len, private_key, public_key, workspace, signature, context, context_len);
+    return signature;
+}
+
+// Workspace signing: all intermediate state lives in the caller-owned workspace
+void ColorSign::sign_message(const uint8_t* message, size_t message_len,
+                             const ColorSignPrivateKey& private_key,
+                             const ColorSignPublicKey& public_key,
+                             SignWorkspace& workspace,
+                             ColorSignature& signature,
+                             const uint8_t* context, size_t context_len) {
+    store_signature(sign_in_workspace(message, message_len, private_key, public_key, workspace, context, context_len),
+                    signature);
+}
+
+size_t ColorSign::sign_into(const std::vector<uint8_t>& message,
+                            const ColorSignPrivateKey& private_key,
+                            const ColorSignPublicKey& public_key,
+                            SignWorkspace& workspace,
+                            uint8_t* out, size_t capacity,
+                            const std::vector<uint8_t>& context) {
+    return sign_into(message.data(), message.size(), private_key, public_key, workspace, out, capacity,
+                     context.data(), context.size());
+}
+
+// The accepted candidate's buffers are written out directly
+size_t ColorSign::sign_into(const uint8_t* message, size_t message_len,
+                            const ColorSignPrivateKey& private_key,
+                            const ColorSignPublicKey& public_key,
+                            SignWorkspace& workspace,
+                            uint8_t* out, size_t capacity,
+                            const uint8_t* context, size_t context_len) {
+    if (capacity < ColorSignature::serialized_size(params_, signature_format_)) {
+        throw std::invalid_argument("Signature output buffer too small");
+    }
+
+    const SigningCandidate& accepted = sign_in_workspace(message, message_len, private_key, public_key, workspace,
+                                                         context, context_len);
+    return write_signature(signature_format_,
+                           ByteSpan(accepted.z_encoded.data(), accepted.z_encoded.size()),
+                           ByteSpan(accepted.h.data(), accepted.h.size()),
+                           ByteSpan(accepted.c_packed.data(), accepted.c_packed.size()), out);
+}
+
+// Hashing and rejection sampling for a message held in memory; returns the accepted attempt
+const ColorSign::SigningCandidate& ColorSign::sign_in_workspace(const uint8_t* message, size_t message_len,
+                                                                const ColorSignPrivateKey& key,
+                                                                const ColorSignPublicKey& public_key,
+                                                                SignWorkspace& workspace,
+                                                                const uint8_t* context, size_t context_len) {
+    TraceSpan span("sign_message");
+    std::shared_ptr<const ColorSignPrivateKey> expanded;
+    const ColorSignPrivateKey& private_key = signing_key(key, expanded);
+    begin_signing(workspace);
+
+    // Comprehensive input validation
+    ColorSignSignError validation_result = validate_signing_inputs(message, message_len, private_key, public_key,
+                                                                   context, context_len);
+    if (validation_result != ColorSignSignError::SUCCESS) {
+        reject_signing_inputs(workspace, validation_result);
+    }
+
+    // Hash message with context: mu = SHAKE256(context || message)
+    hash_message(message, message_len, context, context_len, workspace.mu_.data());
+    if (counting()) {
+        metrics_->sign_bytes_hashed.add(message_len);
+    }
+
+    // Generate deterministic rho' for y sampling: rho' = SHAKE256(sk || message)
+    {
+        ScopedStage probe(PerfStage::HASHING);
+        SHAKE256Sampler rho_prime_hash;
+        rho_prime_hash.reset();
+        rho_prime_hash.absorb(private_key.secret_data.data(), private_key.secret_data.size());
+        rho_prime_hash.absorb(message, message_len);
+        rho_prime_hash.pad_and_absorb();
+        rho_prime_hash.squeeze(workspace.rho_prime_.data(), workspace.rho_prime_.size());
+    }
+
+    return sign_prepared(private_key, public_key, workspace);
+}
+
+// Streaming signing: the message was absorbed chunk by chunk into `stream`
+void ColorSign::sign_stream(MessageHashStream& stream,
+                            const ColorSignPrivateKey& key,
+                            const ColorSignPublicKey& public_key,
+                            SignWorkspace& workspace,
+                            ColorSignature& signature) {
+    TraceSpan span("sign_stream");
+    std::shared_ptr<const ColorSignPrivateKey> expanded;
+    const ColorSignPrivateKey& private_key = signing_key(key, expanded);
+    begin_signing(workspace);
+
+    // The message size cap does not apply to streamed messages, but they must not be empty
+    ColorSignSignError validation_result = stream.bytes_absorbed() == 0
+        ? ColorSignSignError::MESSAGE_SIZE_INVALID
+        : validate_signing_keys(private_key, public_key);
+    if (validation_result != ColorSignSignError::SUCCESS) {
+        reject_signing_inputs(workspace, validation_result);
+    }
+
+    // mu and rho' over the streamed message (or its pre-hash representative)
+    {
+        ScopedStage probe(PerfStage::HASHING);
+        stream.finish(workspace.mu_.data(), workspace.rho_prime_.data(), workspace.rho_prime_.size());
+    }
+    if (counting()) {
+        metrics_->sign_bytes_hashed.add(stream.bytes_absorbed());
+    }
+
+    store_signature(sign_prepared(private_key, public_key, workspace), signature);
+}
+
+void ColorSign::store_signature(const SigningCandidate& accepted, ColorSignature& signature) const {
+    signature.z_data.assign(accepted.z_encoded.begin(), accepted.z_encoded.end());
+    signature.h_data.assign(accepted.h.begin(), accepted.h.end());
+    signature.c_data.assign(accepted.c_packed.begin(), accepted.c_packed.end());
+    signature.params = params_;
+    signature.format = signature_format_;
+}
+
+void ColorSign::begin_signing(SignWorkspace& workspace) {
+    if (workspace.params_.security_level != params_.security_level) {
+        throw std::invalid_argument("Sign workspace parameters do not match signer");
+    }
+
+    workspace.traced_ = trace_next_signature();
+    workspace.check_y_bounds_ = INSTRUMENTATION_ENABLED && instrumentation_level_ == InstrumentationLevel::FULL;
+    if (counting()) {
+        workspace.stage_start_ = TimestampCounter::now();
+    }
+    if (!workspace.traced_) {
+        return;
+    }
+
     // Start timing protection
-    timing_protection_->start_operation();
+    workspace.timing_start_ = timing_protection_->start_operation();
 
     // Log signing start
-    AuditEntry sign_start{
-        AuditEvent::SIGNING_START,
+    workspace.start_entry_.timestamp = std::chrono::system_clock::now();
+    security_monitor_->log_event(workspace.start_entry_);
+}
+
+void ColorSign::reject_signing_inputs(const SignWorkspace& workspace, ColorSignSignError validation_result) {
+    if (counting()) {
+        counters_.validation_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (workspace.traced_) {
+        timing_protection_->end_operation(validation_timing_id_, workspace.timing_start_);
+    }
+    AuditEntry validation_failure{
+        AuditEvent::INPUT_VALIDATION_FAILURE,
         std::chrono::system_clock::now(),
-        "Starting signature generation",
+        "Input validation failed: " + std::to_string(static_cast<int>(validation_result)),
         "ColorSign::sign_message",
-        0
+        static_cast<uint32_t>(validation_result)
     };
-    security_monitor_->log_event(sign_start);
+    security_monitor_->log_event(validation_failure);
+    throw std::invalid_argument("Input validation failed: " + std::to_string(static_cast<int>(validation_result)));
+}
 
-    // Comprehensive input validation
-    ColorSignSignError validation_result = validate_signing_inputs(message, private_key, public_key, context);
-    if (validation_result != ColorSignSignError::SUCCESS) {
-        timing_protection_->end_operation("sign_message_validation");
-        AuditEntry validation_failure{
-            AuditEvent::INPUT_VALIDATION_FAILURE,
-            std::chrono::system_clock::now(),
-            "Input validation failed: " + std::to_string(static_cast<int>(validation_result)),
-            "ColorSign::sign_message",
-            static_cast<uint32_t>(validation_result)
-        };
-        security_monitor_->log_event(validation_failure);
-        throw std::invalid_argument("Input validation failed: " + std::to_string(static_cast<int>(validation_result)));
+// Rejection sampling from mu and rho' already placed in the workspace; returns the accepted
+// attempt, whose encoded components stay valid until the workspace signs again
+const ColorSign::SigningCandidate& ColorSign::sign_prepared(const ColorSignPrivateKey& private_key,
+                                                            const ColorSignPublicKey& public_key,
+                                                            SignWorkspace& workspace) {
+    // Stage latencies: prepare (validation and hashing), setup, rejection sampling
+    uint64_t sign_start = workspace.stage_start_;
+    uint64_t setup_start = 0;
+    uint64_t rejection_start = 0;
+    if (counting()) {
+        setup_start = TimestampCounter::now();
+        metrics_->sign_prepare_latency.record(TimestampCounter::to_ns(setup_start - sign_start));
     }
 
     // Extract s1 and s2 from private key
-    auto s1 = extract_s1_from_private_key(private_key);
-    auto s2 = extract_s2_from_private_key(private_key);
-
-    // Generate matrix A from public key seed_rho
-    auto matrix_A = generate_matrix_A(public_key.seed_rho);
-
-    // Hash message with context: mu = SHAKE256(context || message)
-    auto mu = hash_message(message, context);
-
-    // Generate deterministic rho' for y sampling: rho' = SHAKE256(sk || message)
-    std::vector<uint8_t> rho_prime_input = private_key.secret_data;
-    rho_prime_input.insert(rho_prime_input.end(), message.begin(), message.end());
-    std::vector<uint8_t> rho_prime = shake256(rho_prime_input, 64);
+    extract_secret_from_private_key(private_key, workspace);
+
+    // Generate matrix A from public key seed_rho (cached while the seed is unchanged)
+    bool matrix_cached = workspace.matrix_valid_ && workspace.matrix_seed_ == public_key.seed_rho;
+    if (!matrix_cached) {
+        generate_matrix_A(public_key.seed_rho, workspace.matrix_A_);
+        workspace.matrix_seed_ = public_key.seed_rho;
+        workspace.matrix_valid_ = true;
+    }
+    if (counting()) {
+        (matrix_cached ? metrics_->matrix_cache_hits : metrics_->matrix_cache_misses).add();
+        rejection_start = TimestampCounter::now();
+        metrics_->sign_setup_latency.record(TimestampCounter::to_ns(rejection_start - setup_start));
+    }
 
     // Initialize sampler for deterministic y sampling
+    TraceSpan rejection_span("rejection_sampling");
     SHAKE256Sampler y_sampler;
-    y_sampler.init(rho_prime.data(), rho_prime.size());
+    y_sampler.init(workspace.rho_prime_.data(), workspace.rho_prime_.size());
 
     // Rejection sampling loop for y and z
-    size_t rejection_attempts = 0;
     const size_t max_rejection_attempts = 10000;
+    const size_t batch_size = speculative_candidates_;
+    workspace.ensure_candidates(batch_size);
+    auto& candidates = workspace.candidates_;
+    for (size_t i = 0; i < batch_size; ++i) {
+        std::copy(workspace.mu_.begin(), workspace.mu_.end(), candidates[i].challenge_seed.begin());
+    }
+    size_t attempts_done = 0;
+    uint64_t w1_rejections = 0;
+    uint64_t z_rejections = 0;
+    uint64_t hint_rejections = 0;
+
     while (true) {
-        rejection_attempts++;
-        if (rejection_attempts > max_rejection_attempts) {
-            security_monitor_->report_security_violation(SecurityError::CRYPTOGRAPHIC_FAILURE,
-                "Rejection sampling exceeded maximum attempts: " + std::to_string(max_rejection_attempts));
-            throw std::runtime_error("Rejection sampling failed: maximum attempts exceeded");
+        // Sample y for the whole batch in stream order so attempt i always sees the same y
+        for (size_t i = 0; i < batch_size; ++i) {
+            sample_y(y_sampler, candidates[i].y);
+            candidates[i].attempt = attempts_done + i;
+            candidates[i].outcome = CandidateOutcome::CANCELLED;
         }
 
-        // Log rejection sampling attempts for security monitoring
-        if (rejection_attempts > 1) {  // Log only retries to avoid spam
-            AuditEntry attempt_entry{
-                AuditEvent::SIGNING_START,  // Reuse event type
-                std::chrono::system_clock::now(),
-                "Rejection sampling attempt " + std::to_string(rejection_attempts),
-                "ColorSign::sign_message",
-                static_cast<uint32_t>(SecurityError::CRYPTOGRAPHIC_FAILURE)
+        if (batch_size == 1) {
+            evaluate_candidate(workspace, candidates[0], 0, nullptr);
+        } else {
+            // Attempts 1.. run on the workspace's worker pool, attempt 0 on this thread
+            std::atomic<size_t> accepted_index{batch_size};
+            auto& errors = workspace.candidate_errors_;
+            auto evaluate = [&](size_t i) {
+                errors[i] = nullptr;
+                try {
+                    evaluate_candidate(workspace, candidates[i], i, &accepted_index);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
             };
-            security_monitor_->log_event(attempt_entry);
+            workspace.workers_->run(batch_size, evaluate);
+            for (size_t i = 0; i < batch_size; ++i) {
+                if (errors[i]) std::rethrow_exception(errors[i]);
+            }
         }
 
-        // Sample y with bounds checking
-        std::vector<std::vector<uint32_t>> y = sample_y(y_sampler);
+        // Walk the batch in attempt order, exactly as the sequential loop would
+        for (size_t i = 0; i < batch_size; ++i) {
+            size_t rejection_attempts = attempts_done + i + 1;
+            if (rejection_attempts > max_rejection_attempts) {
+                security_monitor_->report_security_violation(SecurityError::CRYPTOGRAPHIC_FAILURE,
+                    "Rejection sampling exceeded maximum attempts: " + std::to_string(max_rejection_attempts));
+                throw std::runtime_error("Rejection sampling failed: maximum attempts exceeded");
+            }
 
-        // Validate y bounds for security
-        SecurityError y_bounds_check = InputValidator::validate_polynomial_vector_bounds(
-            y, params_.module_rank, params_.degree, -(params_.gamma1 - 1), params_.gamma1 - 1, params_.modulus);
-        if (y_bounds_check != SecurityError::SUCCESS) {
-            security_monitor_->report_security_violation(y_bounds_check, "Y polynomial bounds violation");
-            continue;  // Resample y
-        }
+            // Ordinary rejections restart silently and are only counted
+            const SigningCandidate& candidate = candidates[i];
+            switch (candidate.outcome) {
+                case CandidateOutcome::ACCEPTED:
+                    break;
+                case CandidateOutcome::Y_BOUNDS_REJECTED:
+                    if (counting()) {
+                        counters_.y_bound_violations.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    security_monitor_->report_security_violation(candidate.y_bounds_error, workspace.y_bounds_details_);
+                    continue;  // Resample y
+                case CandidateOutcome::W1_BOUNDS_REJECTED:
+                    ++w1_rejections;
+                    continue;
+                case CandidateOutcome::Z_BOUNDS_REJECTED:
+                    ++z_rejections;
+                    continue;
+                case CandidateOutcome::HINT_WEIGHT_REJECTED:
+                    ++hint_rejections;
+                    continue;
+                case CandidateOutcome::CANCELLED:
+                    // Only attempts after the accepted one are cancelled, and the walk stops there
+                    throw std::logic_error("Cancelled signing attempt precedes the accepted one");
+            }
+
+            if (counting()) {
+                counters_.signatures.fetch_add(1, std::memory_order_relaxed);
+                counters_.rejection_restarts.fetch_add(rejection_attempts - 1, std::memory_order_relaxed);
+                counters_.w1_rejections.fetch_add(w1_rejections, std::memory_order_relaxed);
+                counters_.z_rejections.fetch_add(z_rejections, std::memory_order_relaxed);
+                counters_.hint_rejections.fetch_add(hint_rejections, std::memory_order_relaxed);
+
+                uint64_t end = TimestampCounter::now();
+                metrics_->sign_rejection_latency.record(TimestampCounter::to_ns(end - rejection_start));
+                metrics_->sign_latency.record(TimestampCounter::to_ns(end - sign_start));
+                metrics_->signatures.add();
+                metrics_->sign_rejections.add(rejection_attempts - 1);
+            }
 
-        // Compute w = A * y mod q
-        auto w = compute_w(matrix_A, y);
+            if (workspace.traced_) {
+                // End timing protection and log success
+                timing_protection_->end_operation(signing_timing_id_, workspace.timing_start_);
 
-        // Compute w1 = high bits of w
-        std::vector<uint32_t> w_flat;
-        for (const auto& poly : w) {
-            w_flat.insert(w_flat.end(), poly.begin(), poly.end());
-        }
-        std::vector<uint32_t> w1_flat(w_flat.size());
-        compute_high_bits(w_flat, w1_flat, 13, params_.modulus);
-
-        // Check w1 bounds: max |w1[i]| < γ₂ - β (ML-DSA Algorithm 6 rejection condition)
-        uint32_t max_w1 = 0;
-        for (uint32_t coeff : w1_flat) {
-            uint32_t abs_coeff = (coeff > params_.modulus/2) ? params_.modulus - coeff : coeff;
-            if (abs_coeff > max_w1) max_w1 = abs_coeff;
-        }
-        if (max_w1 >= params_.gamma2 - params_.beta) {
-            security_monitor_->report_security_violation(SecurityError::INVALID_PARAMETERS, "W1 polynomial bounds violation");
-            continue;  // Resample y
+                workspace.success_entry_.timestamp = std::chrono::system_clock::now();
+                security_monitor_->log_event(workspace.success_entry_);
+                if (counting()) {
+                    counters_.traced_signatures.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            return candidate;
         }
+        attempts_done += batch_size;
+    }
+}
+
+// Evaluate one rejection sampling attempt for a pre-sampled y (ML-DSA Algorithm 6 loop body)
+void ColorSign::evaluate_candidate(const SignWorkspace& workspace,
+                                   SigningCandidate& candidate,
+                                   size_t attempt_index,
+                                   std::atomic<size_t>* accepted_index) const {
+    // A lower attempt already passed, so this one can never be selected
+    auto superseded = [&]() {
+        return accepted_index && accepted_index->load(std::memory_order_acquire) < attempt_index;
+    };
+
+    TraceSpan span("rejection_attempt", static_cast<int64_t>(candidate.attempt));
+    const NTTEngine& ntt_engine = *workspace.ntt_engine_;
+    const auto& y = candidate.y;
 
-        // Encode w1 as bytes
-        std::vector<uint8_t> w1_encoded;
-        for (uint32_t coeff : w1_flat) {
-            w1_encoded.push_back(coeff & 0xFF);
-            w1_encoded.push_back((coeff >> 8) & 0xFF);
+    // y is in range by construction; FULL instrumentation re-validates it defensively
+    candidate.y_bounds_error = workspace.check_y_bounds_ ? validate_y_bounds(y) : SecurityError::SUCCESS;
+    if (candidate.y_bounds_error != SecurityError::SUCCESS) {
+        candidate.outcome = CandidateOutcome::Y_BOUNDS_REJECTED;
+        return;
+    }
+
+    // Compute w = A * y mod q
+    compute_w(ntt_engine, workspace.matrix_A_, y, candidate.w, candidate.product);
+    if (superseded()) return;
+
+    // Compute w1 = high bits of w
+    compute_w1(candidate.w, candidate.w1);
+
+    // Check w1 bounds: max |w1[i]| < γ₂ - β (ML-DSA Algorithm 6 rejection condition)
+    if (!check_w1_bounds(candidate.w1)) {
+        candidate.outcome = CandidateOutcome::W1_BOUNDS_REJECTED;
+        return;
+    }
+
+    // Encode w1 as bytes after mu in the challenge seed
+    encode_w1(candidate.w1, candidate.challenge_seed.data() + workspace.mu_.size());
+
+    // Compute challenge c. The FIPS 204 format carries c~ = H(mu || w1) and samples c from it.
+    bool fips_format = signature_format_ == SignatureFormat::FIPS204;
+    {
+        ScopedStage probe(PerfStage::SAMPLING);
+        if (fips_format) {
+            candidate.c_packed.resize(params_.lambda / 4);
+            SHAKE256Sampler hash;
+            hash.init(candidate.challenge_seed.data(), candidate.challenge_seed.size());
+            hash.squeeze(candidate.c_packed.data(), candidate.c_packed.size());
+            sample_challenge(candidate.c, candidate.c_packed.data(), candidate.c_packed.size(),
+                             params_.tau, params_.degree, params_.modulus, candidate.challenge_positions);
+        } else {
+            sample_challenge(candidate.c, candidate.challenge_seed.data(), candidate.challenge_seed.size(),
+                             params_.tau, params_.degree, params_.modulus, candidate.challenge_positions);
         }
+    }
+    if (superseded()) return;
 
-        // Compute challenge c
-        std::vector<uint8_t> challenge_seed = mu;
-        challenge_seed.insert(challenge_seed.end(), w1_encoded.begin(), w1_encoded.end());
-        std::vector<uint32_t> c(params_.degree);
-        sample_challenge(c, challenge_seed, params_.tau, params_.degree, params_.modulus);
-
-        // Compute z = y + c·s1 + c·s2 mod q
-        auto z = compute_z(y, c, s1, s2);
-
-        uint32_t max_abs_z = 0;
-        for (const auto& poly : z) {
-            for (uint32_t coeff : poly) {
-                int32_t signed_coeff = (coeff > params_.modulus/2) ? (int32_t)coeff - (int32_t)params_.modulus : (int32_t)coeff;
-                uint32_t abs_coeff = std::abs(signed_coeff);
-                if (abs_coeff > max_abs_z) max_abs_z = abs_coeff;
+    // Compute z = y + c·s1 + c·s2 mod q
+    compute_z(ntt_engine, y, candidate.c, workspace.s1_, workspace.s2_, candidate.z, candidate.product);
+
+    // Check z bounds: ||z||_∞ <= γ₁ - β (ML-DSA Algorithm 6)
+    if (!check_z_bounds(candidate.z)) {
+        candidate.outcome = CandidateOutcome::Z_BOUNDS_REJECTED;
+        return;
+    }
+    if (superseded()) return;
+
+    // Compute w' = w - c·s2 mod q (for hint generation)
+    compute_w_prime_for_hint(ntt_engine, candidate.w, candidate.c, workspace.s2_, candidate.w_prime, candidate.product);
+    if (workspace.has_t0_) {
+        // The verifier of a Power2Round key uses t1 * 2^13 = t - t0, so its w' also carries + c·t0
+        ScopedStage probe(PerfStage::NTT);
+        for (uint32_t i = 0; i < params_.module_rank; ++i) {
+            ntt_engine.multiply(candidate.c.data(), workspace.t0_[i].data(), candidate.product.data());
+            PolySpan w_prime_i = candidate.w_prime[i];
+            for (uint32_t j = 0; j < params_.degree; ++j) {
+                w_prime_i[j] = ConstantTime::ct_add(w_prime_i[j], candidate.product[j], params_.modulus);
             }
         }
+    }
 
-        // Check z bounds: ||z||_∞ <= γ₁ - β (ML-DSA Algorithm 6)
-        if (!check_z_bounds(z)) {
-            continue;  // Resample y
+    if (fips_format) {
+        // Hint index lists (at most omega hints) and z exactly as gamma1 - z
+        if (!make_hint_indices(candidate.w, candidate.w_prime, candidate.h)) {
+            candidate.outcome = CandidateOutcome::HINT_WEIGHT_REJECTED;
+            return;
         }
-
-        // Compute w' = w - c·s2 mod q (for hint generation)
-        auto w_prime = compute_w_prime_for_hint(w, c, s2);
-
+        ScopedStage probe(PerfStage::PACKING);
+        candidate.z_encoded.resize(gamma1_packed_size(params_.module_rank, params_.degree, params_.gamma1));
+        pack_polynomial_vector_gamma1(candidate.z, params_.modulus, params_.gamma1, candidate.z_encoded.data());
+    } else {
         // Generate hint h
-        auto h = make_hint(w, w_prime, params_.gamma2);
+        make_hint(candidate.w, candidate.w_prime, params_.gamma2, candidate.h);
 
         // Pack challenge c
-        auto c_packed = pack_challenge(c);
+        pack_challenge(candidate.c, candidate.c_packed);
 
         // Encode z using 18-bit encoding
-        std::vector<uint8_t> z_encoded = pack_polynomial_vector_ml_dsa(z, params_.modulus, 18);
-
-        // End timing protection and log success
-        timing_protection_->end_operation("sign_message_success");
-
-        AuditEntry sign_success{
-            AuditEvent::SIGNING_SUCCESS,
-            std::chrono::system_clock::now(),
-            "Signature generation completed successfully",
-            "ColorSign::sign_message",
-            0
-        };
-        security_monitor_->log_event(sign_success);
+        ScopedStage probe(PerfStage::PACKING);
+        candidate.z_encoded.resize(ml_dsa_packed_size(params_.module_rank, params_.degree, 18));
+        pack_polynomial_vector_ml_dsa(candidate.z, params_.modulus, 18, candidate.z_encoded.data());
+    }
 
-        return ColorSignature(z_encoded, h, c_packed, params_);
+    candidate.outcome = CandidateOutcome::ACCEPTED;
+    if (accepted_index) {
+        size_t current = accepted_index->load(std::memory_order_acquire);
+        while (attempt_index < current &&
+               !accepted_index->compare_exchange_weak(
+                   current, attempt_index, std::memory_order_acq_rel)) {
+        }
     }
 }
 
@@ -269,86 +697,99 @@ COSE_Sign1 ColorSign::sign_message_cose(const std::vector<uint8_t>& message,
                                        const ColorSignPrivateKey& private_key,
                                        const ColorSignPublicKey& public_key,
                                        int alg) {
+    return sign_message_cose(message.data(), message.size(), private_key, public_key, alg);
+}
+
+COSE_Sign1 ColorSign::sign_message_cose(const uint8_t* message, size_t message_len,
+                                       const ColorSignPrivateKey& private_key,
+                                       const ColorSignPublicKey& public_key,
+                                       int alg) {
     // Sign the message using the standard signing function
-    ColorSignature signature = sign_message(message, private_key, public_key);
+    ColorSignature signature = sign_message(message, message_len, private_key, public_key);
 
     // Create COSE_Sign1 structure
-    return create_cose_sign1_from_colorsign(message, signature, alg);
+    return create_cose_sign1_from_colorsign(message, message_len, signature, alg);
 }
 
 // Hash message with SHAKE256 (supports context for ML-DSA)
-std::vector<uint8_t> ColorSign::hash_message(const std::vector<uint8_t>& message, const std::vector<uint8_t>& context) const {
-    std::vector<uint8_t> input;
-    if (!context.empty()) {
-        // Prepend context length and context as per ML-DSA spec
-        uint8_t context_len = static_cast<uint8_t>(context.size());
-        input.push_back(0);  // DOM_SEP
-        input.push_back(context_len);
-        input.insert(input.end(), context.begin(), context.end());
-    }
-    input.insert(input.end(), message.begin(), message.end());
-    return shake256(input, 64);  // 64 bytes for ML-DSA mu
+void ColorSign::hash_message(const uint8_t* message, size_t message_len,
+                             const uint8_t* context, size_t context_len, uint8_t* mu) const {
+    ScopedStage probe(PerfStage::HASHING);
+    SHAKE256Sampler hash;
+    hash.reset();
+    // M' = 0 || |ctx| || ctx || M as per ML-DSA spec, also for an empty context: the leading 0
+    // keeps pure messages apart from pre-hash representatives, which start with 1
+    uint8_t prefix[2] = {0, static_cast<uint8_t>(context_len)};  // DOM_SEP, context length
+    hash.absorb(prefix, sizeof(prefix));
+    hash.absorb(context, context_len);
+    hash.absorb(message, message_len);
+    hash.pad_and_absorb();
+    hash.squeeze(mu, 64);  // 64 bytes for ML-DSA mu
 }
 
 // Sample y with uniform distribution in [-(gamma1-1), gamma1-1] using deterministic sampling
-std::vector<std::vector<uint32_t>> ColorSign::sample_y(SHAKE256Sampler& sampler) const {
-    uint32_t k = params_.module_rank;
-    uint32_t n = params_.degree;
+void ColorSign::sample_y(SHAKE256Sampler& sampler, PolyVec& y) const {
+    ScopedStage probe(PerfStage::SAMPLING);
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::sample_y(sampler, y.data());
+        case 65: return ColorSignT<65>::sample_y(sampler, y.data());
+        case 87: return ColorSignT<87>::sample_y(sampler, y.data());
+        default: break;
+    }
+
     uint32_t gamma1 = params_.gamma1;
     uint32_t q = params_.modulus;
 
-    std::vector<std::vector<uint32_t>> y(k, std::vector<uint32_t>(n));
-
     int32_t min_val = -(gamma1 - 1);
     int32_t max_val = gamma1 - 1;
     int32_t range = max_val - min_val + 1;
 
     // Sample uniformly from [min_val, max_val]
-    for (auto& poly : y) {
-        for (auto& coeff : poly) {
-            uint32_t random_val;
-            int32_t sampled;
-            do {
-                uint8_t bytes[4];
-                sampler.squeeze(bytes, 4);
-                random_val = (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24));
-                sampled = static_cast<int32_t>(random_val % range) + min_val;
-            } while (sampled < min_val || sampled > max_val);
-            // Convert to unsigned representation
-            coeff = (static_cast<int64_t>(sampled) % q + q) % q;
-        }
+    uint32_t* coeffs = y.data();
+    for (size_t i = 0; i < y.coeff_count(); ++i) {
+        uint32_t random_val;
+        int32_t sampled;
+        do {
+            uint8_t bytes[4];
+            sampler.squeeze(bytes, 4);
+            random_val = (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24));
+            sampled = static_cast<int32_t>(random_val % range) + min_val;
+        } while (sampled < min_val || sampled > max_val);
+        // Convert to unsigned representation
+        coeffs[i] = (static_cast<int64_t>(sampled) % q + q) % q;
     }
-
-    return y;
 }
 
 // Compute w = A * y mod q using constant-time arithmetic
-std::vector<std::vector<uint32_t>> ColorSign::compute_w(const std::vector<std::vector<uint32_t>>& matrix_A,
-                                                        const std::vector<std::vector<uint32_t>>& y) const {
+void ColorSign::compute_w(const NTTEngine& ntt_engine,
+                          const PolyMat& matrix_A,
+                          const PolyVec& y,
+                          PolyVec& w,
+                          std::vector<uint32_t>& product) const {
+    ScopedStage probe(PerfStage::NTT);
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::compute_w(ntt_engine, matrix_A.data(), y.data(), w.data(), product.data());
+        case 65: return ColorSignT<65>::compute_w(ntt_engine, matrix_A.data(), y.data(), w.data(), product.data());
+        case 87: return ColorSignT<87>::compute_w(ntt_engine, matrix_A.data(), y.data(), w.data(), product.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    // Create NTT engine
-    auto ntt_engine = create_optimal_ntt_engine(q, n);
-
-    std::vector<std::vector<uint32_t>> w(k, std::vector<uint32_t>(n, 0));
-
     // For each polynomial in w: w[i] = sum_m A[i][m] * y[m]
+    w.fill(0);
     for (uint32_t i = 0; i < k; ++i) {
-        std::vector<uint32_t> temp(n, 0);
+        PolySpan w_i = w[i];
         for (uint32_t m = 0; m < k; ++m) {
-            std::vector<uint32_t> product(n);
-            ntt_engine->multiply(matrix_A[i * k + m].data(), y[m].data(), product.data());
+            ntt_engine.multiply(matrix_A(i, m).data(), y[m].data(), product.data());
             for (uint32_t j = 0; j < n; ++j) {
                 // Use constant-time modular addition
-                temp[j] = ConstantTime::ct_add(temp[j], product[j], q);
+                w_i[j] = ConstantTime::ct_add(w_i[j], product[j], q);
             }
         }
-        w[i] = temp;
     }
-
-    return w;
 }
 
 // Compute challenge c = sample polynomial from SHAKE256(mu || w_encoded)
@@ -380,40 +821,44 @@ std::vector<uint32_t> ColorSign::compute_challenge(const std::vector<uint8_t>& m
 }
 
 // Compute z = y + c·s1 + c·s2 mod q using polynomial multiplication via NTT
-std::vector<std::vector<uint32_t>> ColorSign::compute_z(const std::vector<std::vector<uint32_t>>& y,
-                                                         const std::vector<uint32_t>& c,
-                                                         const std::vector<std::vector<uint32_t>>& s1,
-                                                         const std::vector<std::vector<uint32_t>>& s2) const {
+void ColorSign::compute_z(const NTTEngine& ntt_engine,
+                          const PolyVec& y,
+                          const std::vector<uint32_t>& c,
+                          const PolyVec& s1,
+                          const PolyVec& s2,
+                          PolyVec& z,
+                          std::vector<uint32_t>& product) const {
+    ScopedStage probe(PerfStage::NTT);
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::compute_z(ntt_engine, y.data(), c.data(), s1.data(), s2.data(), z.data(), product.data());
+        case 65: return ColorSignT<65>::compute_z(ntt_engine, y.data(), c.data(), s1.data(), s2.data(), z.data(), product.data());
+        case 87: return ColorSignT<87>::compute_z(ntt_engine, y.data(), c.data(), s1.data(), s2.data(), z.data(), product.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    // Create NTT engine for polynomial multiplication
-    auto ntt_engine = create_optimal_ntt_engine(q, n);
-
-    std::vector<std::vector<uint32_t>> z(k, std::vector<uint32_t>(n));
-
     for (uint32_t i = 0; i < k; ++i) {
-        // Compute cs1 = NTT_multiply(c, s1[i])
-        std::vector<uint32_t> cs1(n);
-        ntt_engine->multiply(c.data(), s1[i].data(), cs1.data());
+        // Compute cs1 = NTT_multiply(c, s1[i]) directly into z[i]
+        ntt_engine.multiply(c.data(), s1[i].data(), z[i].data());
 
         // Compute cs2 = NTT_multiply(c, s2[i])
-        std::vector<uint32_t> cs2(n);
-        ntt_engine->multiply(c.data(), s2[i].data(), cs2.data());
+        ntt_engine.multiply(c.data(), s2[i].data(), product.data());
 
         // Compute z[i] = y[i] + cs1 + cs2 mod q
+        PolySpan z_i = z[i];
+        ConstPolySpan y_i = y[i];
         for (uint32_t j = 0; j < n; ++j) {
-            uint32_t sum_cs = ConstantTime::ct_add(cs1[j], cs2[j], q);
-            z[i][j] = ConstantTime::ct_add(y[i][j], sum_cs, q);
+            uint32_t sum_cs = ConstantTime::ct_add(z_i[j], product[j], q);
+            z_i[j] = ConstantTime::ct_add(y_i[j], sum_cs, q);
         }
     }
-
-    return z;
 }
 
 // Check if y coefficients are within bounds [-gamma1 + 1, gamma1 - 1]
-bool ColorSign::check_y_bounds(const std::vector<std::vector<uint32_t>>& y) const {
+bool ColorSign::check_y_bounds(const PolyVec& y) const {
     uint32_t gamma1 = params_.gamma1;
     uint32_t q = params_.modulus;
     int32_t min_val = -(gamma1 - 1);
@@ -431,8 +876,76 @@ bool ColorSign::check_y_bounds(const std::vector<std::vector<uint32_t>>& y) cons
     return true;
 }
 
+// Validate y against [-(gamma1 - 1), gamma1 - 1] with the input validator's semantics
+SecurityError ColorSign::validate_y_bounds(const PolyVec& y) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::validate_y_bounds(y.data());
+        case 65: return ColorSignT<65>::validate_y_bounds(y.data());
+        case 87: return ColorSignT<87>::validate_y_bounds(y.data());
+        default: break;
+    }
+
+    return InputValidator::validate_polynomial_vector_bounds(
+        y, params_.module_rank, params_.degree, -(params_.gamma1 - 1), params_.gamma1 - 1, params_.modulus);
+}
+
+// Compute w1 = high bits of w (w is contiguous, so this runs over all k * n coefficients at once)
+void ColorSign::compute_w1(const PolyVec& w, PolyVec& w1) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::compute_w1(w.data(), w1.data());
+        case 65: return ColorSignT<65>::compute_w1(w.data(), w1.data());
+        case 87: return ColorSignT<87>::compute_w1(w.data(), w1.data());
+        default: break;
+    }
+
+    compute_high_bits(w.data(), w1.data(), w.coeff_count(), 13);
+}
+
+// Check max |w1[i]| < gamma2 - beta
+bool ColorSign::check_w1_bounds(const PolyVec& w1) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::check_w1_bounds(w1.data());
+        case 65: return ColorSignT<65>::check_w1_bounds(w1.data());
+        case 87: return ColorSignT<87>::check_w1_bounds(w1.data());
+        default: break;
+    }
+
+    const uint32_t* coeffs = w1.data();
+    uint32_t max_w1 = 0;
+    for (size_t i = 0; i < w1.coeff_count(); ++i) {
+        uint32_t coeff = coeffs[i];
+        uint32_t abs_coeff = (coeff > params_.modulus/2) ? params_.modulus - coeff : coeff;
+        if (abs_coeff > max_w1) max_w1 = abs_coeff;
+    }
+    return max_w1 < params_.gamma2 - params_.beta;
+}
+
+// Encode w1 as 2 little-endian bytes per coefficient
+void ColorSign::encode_w1(const PolyVec& w1, uint8_t* out) const {
+    ScopedStage probe(PerfStage::PACKING);
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::encode_w1(w1.data(), out);
+        case 65: return ColorSignT<65>::encode_w1(w1.data(), out);
+        case 87: return ColorSignT<87>::encode_w1(w1.data(), out);
+        default: break;
+    }
+
+    const uint32_t* coeffs = w1.data();
+    for (size_t i = 0; i < w1.coeff_count(); ++i) {
+        *out++ = coeffs[i] & 0xFF;
+        *out++ = (coeffs[i] >> 8) & 0xFF;
+    }
+}
+
 // Check if z coefficients are within bounds [-gamma1 + beta, gamma1 - beta] as per FIPS 204
-bool ColorSign::check_z_bounds(const std::vector<std::vector<uint32_t>>& z) const {
+bool ColorSign::check_z_bounds(const PolyVec& z) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::check_z_bounds(z.data());
+        case 65: return ColorSignT<65>::check_z_bounds(z.data());
+        case 87: return ColorSignT<87>::check_z_bounds(z.data());
+        default: break;
+    }
+
     uint32_t gamma1 = params_.gamma1;
     uint32_t beta = params_.beta;
     uint32_t q = params_.modulus;
@@ -452,7 +965,7 @@ bool ColorSign::check_z_bounds(const std::vector<std::vector<uint32_t>>& z) cons
 }
 
 // Check if w coefficients are in [-(gamma2 - 1), gamma2] where gamma2 = (q-1)/2
-bool ColorSign::check_w_bounds(const std::vector<std::vector<uint32_t>>& w) const {
+bool ColorSign::check_w_bounds(const PolyVec& w) const {
     uint32_t gamma2 = params_.gamma2;
     uint32_t q = params_.modulus;
     int32_t min_val = -(gamma2 - 1);
@@ -472,100 +985,143 @@ bool ColorSign::check_w_bounds(const std::vector<std::vector<uint32_t>>& w) cons
 
 
 // Generate matrix A (same as keygen)
-std::vector<std::vector<uint32_t>> ColorSign::generate_matrix_A(const std::array<uint8_t, 32>& seed) const {
+void ColorSign::generate_matrix_A(const std::array<uint8_t, 32>& seed, PolyMat& matrix) const {
+    ScopedStage probe(PerfStage::MATRIX_EXPANSION);
+    switch (fixed_level_) {
+        case 44: return KeyGenT<44>::generate_matrix_A(seed, matrix.data());
+        case 65: return KeyGenT<65>::generate_matrix_A(seed, matrix.data());
+        case 87: return KeyGenT<87>::generate_matrix_A(seed, matrix.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    std::vector<std::vector<uint32_t>> matrix(k * k, std::vector<uint32_t>(n));
-
     for (uint32_t i = 0; i < k; ++i) {
         for (uint32_t j = 0; j < k; ++j) {
             // Domain separation: seed || i || j || 0
-            std::vector<uint8_t> domain_sep = std::vector<uint8_t>(seed.begin(), seed.end());
-            domain_sep.push_back(static_cast<uint8_t>(i));
-            domain_sep.push_back(static_cast<uint8_t>(j));
-            domain_sep.push_back(0);
+            std::array<uint8_t, 35> domain_sep;
+            std::copy(seed.begin(), seed.end(), domain_sep.begin());
+            domain_sep[32] = static_cast<uint8_t>(i);
+            domain_sep[33] = static_cast<uint8_t>(j);
+            domain_sep[34] = 0;
 
             SHAKE128Sampler sampler;
             sampler.init(domain_sep.data(), domain_sep.size());
 
             // Sample coefficients uniformly from [0, q)
-            uint32_t* coeffs = matrix[i * k + j].data();
+            uint32_t* coeffs = matrix(i, j).data();
             for (uint32_t l = 0; l < n; ++l) {
                 coeffs[l] = sampler.sample_uniform(q);
             }
         }
     }
-
-    return matrix;
 }
 
-// Extract s1 from private key (first k polynomials)
-std::vector<std::vector<uint32_t>> ColorSign::extract_s1_from_private_key(const ColorSignPrivateKey& private_key) const {
-    if (private_key.use_compression) {
-        auto all_secret = clwe::unpack_polynomial_vector_ml_dsa(private_key.secret_data, 2 * params_.module_rank, params_.degree, params_.modulus, 10);
-        std::vector<std::vector<uint32_t>> s1(all_secret.begin(), all_secret.begin() + params_.module_rank);
-        return s1;
-    } else {
-        size_t s1_size = params_.module_rank * params_.degree * 3;
-        std::vector<uint8_t> s1_data(private_key.secret_data.begin(), private_key.secret_data.begin() + s1_size);
-        return clwe::decode_colors_to_polynomial_vector(s1_data, params_.module_rank, params_.degree, params_.modulus);
-    }
-}
+// Extract s1 (first k polynomials) and s2 (second k polynomials) from the private key, and t0
+// after them for Power2Round keys
+void ColorSign::extract_secret_from_private_key(const ColorSignPrivateKey& private_key, SignWorkspace& workspace) const {
+    ScopedStage probe(PerfStage::PACKING);
+    uint32_t k = params_.module_rank;
+    uint32_t n = params_.degree;
 
-// Extract s2 from private key (second k polynomials)
-std::vector<std::vector<uint32_t>> ColorSign::extract_s2_from_private_key(const ColorSignPrivateKey& private_key) const {
-    if (private_key.use_compression) {
-        auto all_secret = clwe::unpack_polynomial_vector_ml_dsa(private_key.secret_data, 2 * params_.module_rank, params_.degree, params_.modulus, 10);
-        std::vector<std::vector<uint32_t>> s2(all_secret.begin() + params_.module_rank, all_secret.end());
-        return s2;
+    workspace.has_t0_ = key_format_has_t1(private_key.format_version);
+    if (private_key.format_version == KEY_FORMAT_PACKED_SECRET) {
+        // s1, s2 and t0 decode straight into the workspace
+        const uint8_t* data = private_key.secret_data.data();
+        size_t half = eta_packed_size(k, n, params_.eta);
+        if (private_key.secret_data.size() < 2 * half) {
+            throw std::invalid_argument("Private key secret data too short");
+        }
+        clwe::unpack_polynomial_vector_eta(data, half, params_.modulus, params_.eta, workspace.s1_);
+        clwe::unpack_polynomial_vector_eta(data + half, half, params_.modulus, params_.eta, workspace.s2_);
+        clwe::unpack_polynomial_vector_gamma1(data + 2 * half, private_key.secret_data.size() - 2 * half,
+                                              params_.modulus, 1u << (POWER2ROUND_D - 1), workspace.t0_);
+    } else if (workspace.has_t0_) {
+        size_t s1s2_size = ml_dsa_packed_size(2 * k, n, 10);
+        if (private_key.secret_data.size() < s1s2_size) {
+            throw std::invalid_argument("Private key secret data too short");
+        }
+        clwe::unpack_polynomial_vector_ml_dsa(private_key.secret_data.data(), s1s2_size,
+                                              params_.modulus, 10, workspace.secret_polys_);
+        clwe::unpack_polynomial_vector_gamma1(private_key.secret_data.data() + s1s2_size,
+                                              private_key.secret_data.size() - s1s2_size, params_.modulus,
+                                              1u << (POWER2ROUND_D - 1), workspace.t0_);
+        const uint32_t* coeffs = workspace.secret_polys_.data();
+        size_t half = static_cast<size_t>(k) * n;
+        std::copy(coeffs, coeffs + half, workspace.s1_.data());
+        std::copy(coeffs + half, coeffs + 2 * half, workspace.s2_.data());
+    } else if (private_key.use_compression) {
+        clwe::unpack_polynomial_vector_ml_dsa(private_key.secret_data.data(), private_key.secret_data.size(),
+                                              params_.modulus, 10, workspace.secret_polys_);
+        // s1 and s2 are the two contiguous halves of the decoded block
+        const uint32_t* coeffs = workspace.secret_polys_.data();
+        size_t half = static_cast<size_t>(k) * n;
+        std::copy(coeffs, coeffs + half, workspace.s1_.data());
+        std::copy(coeffs + half, coeffs + 2 * half, workspace.s2_.data());
     } else {
-        size_t s1_size = params_.module_rank * params_.degree * 3;
+        // Color-encoded keys are decoded through the allocating color path
+        size_t s1_size = k * n * 3;
+        std::vector<uint8_t> s1_data(private_key.secret_data.begin(), private_key.secret_data.begin() + s1_size);
         std::vector<uint8_t> s2_data(private_key.secret_data.begin() + s1_size, private_key.secret_data.end());
-        return clwe::decode_colors_to_polynomial_vector(s2_data, params_.module_rank, params_.degree, params_.modulus);
+        clwe::decode_colors_to_polynomial_vector(s1_data, params_.modulus, workspace.s1_);
+        clwe::decode_colors_to_polynomial_vector(s2_data, params_.modulus, workspace.s2_);
     }
 }
 
 
 // Compute w' = w - c·s2 mod q for hint generation using constant-time arithmetic
-std::vector<std::vector<uint32_t>> ColorSign::compute_w_prime_for_hint(const std::vector<std::vector<uint32_t>>& w,
-                                                                       const std::vector<uint32_t>& c,
-                                                                       const std::vector<std::vector<uint32_t>>& s2) const {
+void ColorSign::compute_w_prime_for_hint(const NTTEngine& ntt_engine,
+                                         const PolyVec& w,
+                                         const std::vector<uint32_t>& c,
+                                         const PolyVec& s2,
+                                         PolyVec& w_prime,
+                                         std::vector<uint32_t>& product) const {
+    ScopedStage probe(PerfStage::NTT);
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::compute_w_prime(ntt_engine, w.data(), c.data(), s2.data(), w_prime.data(), product.data());
+        case 65: return ColorSignT<65>::compute_w_prime(ntt_engine, w.data(), c.data(), s2.data(), w_prime.data(), product.data());
+        case 87: return ColorSignT<87>::compute_w_prime(ntt_engine, w.data(), c.data(), s2.data(), w_prime.data(), product.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    auto ntt_engine = create_optimal_ntt_engine(q, n);
-
-    std::vector<std::vector<uint32_t>> w_prime = w;  // Copy w
-
-    // Compute c·s2
-    std::vector<std::vector<uint32_t>> cs2(k, std::vector<uint32_t>(n, 0));
     for (uint32_t i = 0; i < k; ++i) {
-        ntt_engine->multiply(c.data(), s2[i].data(), cs2[i].data());
-    }
+        // Compute c·s2[i]
+        ntt_engine.multiply(c.data(), s2[i].data(), product.data());
 
-    // Compute w' = w - c·s2 mod q using constant-time arithmetic
-    for (uint32_t i = 0; i < k; ++i) {
+        // Compute w' = w - c·s2 mod q using constant-time arithmetic
+        PolySpan w_prime_i = w_prime[i];
+        ConstPolySpan w_i = w[i];
         for (uint32_t j = 0; j < n; ++j) {
-            w_prime[i][j] = ConstantTime::ct_sub(w_prime[i][j], cs2[i][j], q);
+            w_prime_i[j] = ConstantTime::ct_sub(w_i[j], product[j], q);
         }
     }
-
-    return w_prime;
 }
 
 // Generate hint vector h for signature compression using constant-time operations
-std::vector<uint8_t> ColorSign::make_hint(const std::vector<std::vector<uint32_t>>& w,
-                                         const std::vector<std::vector<uint32_t>>& w_prime,
-                                         uint32_t gamma2) const {
+void ColorSign::make_hint(const PolyVec& w,
+                          const PolyVec& w_prime,
+                          uint32_t gamma2,
+                          std::vector<uint8_t>& h) const {
+    ScopedStage probe(PerfStage::PACKING);
+    switch (fixed_level_) {
+        case 44: h.resize(ParameterSet<44>::H_BYTES); return ColorSignT<44>::make_hint(w.data(), w_prime.data(), h.data());
+        case 65: h.resize(ParameterSet<65>::H_BYTES); return ColorSignT<65>::make_hint(w.data(), w_prime.data(), h.data());
+        case 87: h.resize(ParameterSet<87>::H_BYTES); return ColorSignT<87>::make_hint(w.data(), w_prime.data(), h.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t omega = params_.omega;
     uint32_t q = params_.modulus;
 
-    std::vector<uint8_t> h(omega, 0);
+    h.assign(omega, 0);
     size_t hint_index = 0;
 
     for (uint32_t i = 0; i < k; ++i) {
@@ -595,15 +1151,54 @@ std::vector<uint8_t> ColorSign::make_hint(const std::vector<std::vector<uint32_t
             hint_index += hint_needed;
         }
     }
+}
+
+// FIPS 204 HintBitPack: the indices of the hinted coefficients of each polynomial, then the
+// running hint count after each polynomial (omega + k bytes). The hint condition is the one of
+// make_hint. Returns false when more than omega hints are needed.
+bool ColorSign::make_hint_indices(const PolyVec& w, const PolyVec& w_prime, std::vector<uint8_t>& h) const {
+    ScopedStage probe(PerfStage::PACKING);
+    uint32_t k = params_.module_rank;
+    uint32_t n = params_.degree;
+    uint32_t omega = params_.omega;
+    uint32_t q = params_.modulus;
+    uint32_t gamma2 = params_.gamma2;
 
-    return h;
+    h.assign(omega + k, 0);
+    size_t hints = 0;
+    for (uint32_t i = 0; i < k; ++i) {
+        ConstPolySpan w_i = w[i];
+        ConstPolySpan w_prime_i = w_prime[i];
+        for (uint32_t j = 0; j < n; ++j) {
+            int32_t w_signed = (w_i[j] >= (q + 1) / 2) ? static_cast<int32_t>(w_i[j] - q) : static_cast<int32_t>(w_i[j]);
+            int32_t w_prime_signed = (w_prime_i[j] >= (q + 1) / 2) ? static_cast<int32_t>(w_prime_i[j] - q)
+                                                                    : static_cast<int32_t>(w_prime_i[j]);
+            uint32_t hint_needed = (ConstantTime::ct_abs(w_signed) <= gamma2) & (ConstantTime::ct_abs(w_prime_signed) > gamma2);
+            if (hint_needed) {
+                if (hints == omega) {
+                    return false;
+                }
+                h[hints++] = static_cast<uint8_t>(j);
+            }
+        }
+        h[omega + i] = static_cast<uint8_t>(hints);
+    }
+    return true;
 }
 
 // Pack challenge polynomial c into bytes (simplified version)
-std::vector<uint8_t> ColorSign::pack_challenge(const std::vector<uint32_t>& c) const {
+void ColorSign::pack_challenge(const std::vector<uint32_t>& c, std::vector<uint8_t>& packed) const {
+    ScopedStage probe(PerfStage::PACKING);
+    switch (fixed_level_) {
+        case 44: packed.resize(ParameterSet<44>::C_BYTES); return ColorSignT<44>::pack_challenge(c.data(), packed.data());
+        case 65: packed.resize(ParameterSet<65>::C_BYTES); return ColorSignT<65>::pack_challenge(c.data(), packed.data());
+        case 87: packed.resize(ParameterSet<87>::C_BYTES); return ColorSignT<87>::pack_challenge(c.data(), packed.data());
+        default: break;
+    }
+
     size_t n = c.size();
     size_t packed_size = (n + 3) / 4;  // 4 coefficients per byte (2 bits each)
-    std::vector<uint8_t> packed(packed_size, 0);
+    packed.assign(packed_size, 0);
 
     for (size_t i = 0; i < n; ++i) {
         // Simple direct comparison (not constant-time, but working)
@@ -621,7 +1216,6 @@ std::vector<uint8_t> ColorSign::pack_challenge(const std::vector<uint32_t>& c) c
         packed[byte_idx] |= (bit << shift);
     }
 
-    return packed;
 }
 
 // Constructor for ColorSignature (ML-DSA format)
@@ -629,41 +1223,347 @@ ColorSignature::ColorSignature(const std::vector<uint8_t>& z, const std::vector<
     : z_data(z), h_data(h), c_data(c), params(p) {
 }
 
+namespace {
+
+template<uint32_t Level>
+SignatureLayout fixed_signature_layout(SignatureFormat format) {
+    using Params = ParameterSet<Level>;
+    if (format == SignatureFormat::FIPS204) {
+        return {Params::FIPS_Z_BYTES, Params::FIPS_H_BYTES, Params::FIPS_C_BYTES};
+    }
+    return {Params::Z_BYTES, Params::H_BYTES, Params::C_BYTES};
+}
+
+} // namespace
+
+SignatureLayout signature_layout(const CLWEParameters& params, SignatureFormat format) {
+    // Standard parameter sets have compile-time sizes
+    switch (standard_parameter_set(params)) {
+        case 44: return fixed_signature_layout<44>(format);
+        case 65: return fixed_signature_layout<65>(format);
+        case 87: return fixed_signature_layout<87>(format);
+        default: break;
+    }
+
+    if (format == SignatureFormat::FIPS204) {
+        // Hint indices and counts are single bytes
+        if (params.degree > 256 || params.omega > 255) {
+            throw std::invalid_argument("Parameters do not fit the FIPS 204 signature format");
+        }
+        return {gamma1_packed_size(params.module_rank, params.degree, params.gamma1),
+                static_cast<size_t>(params.omega) + params.module_rank, params.lambda / 4};
+    }
+
+    // z size: k * n * 18 bits (18-bit ML-DSA compression, no header)
+    // h size: omega bytes (hint)
+    // c size: (degree + 3) / 4 bytes (packed challenge)
+    return {ml_dsa_packed_size(params.module_rank, params.degree, 18), params.omega, (params.degree + 3) / 4};
+}
+
 // Serialization for ColorSignature (ML-DSA format)
 std::vector<uint8_t> ColorSignature::serialize() const {
-    std::vector<uint8_t> data;
-    data.insert(data.end(), z_data.begin(), z_data.end());
-    data.insert(data.end(), h_data.begin(), h_data.end());
-    data.insert(data.end(), c_data.begin(), c_data.end());
+    std::vector<uint8_t> data(serialized_size());
+    serialize_into(data.data(), data.size());
     return data;
 }
 
+size_t ColorSignature::serialize_into(uint8_t* out, size_t capacity) const {
+    if (capacity < serialized_size()) {
+        throw std::invalid_argument("Signature output buffer too small");
+    }
+    return write_signature(format, ByteSpan(z_data.data(), z_data.size()), ByteSpan(h_data.data(), h_data.size()),
+                           ByteSpan(c_data.data(), c_data.size()), out);
+}
+
+size_t ColorSignature::serialized_size() const {
+    return (format == SignatureFormat::FIPS204 ? SIGNATURE_HEADER_BYTES : 0) +
+           z_data.size() + h_data.size() + c_data.size();
+}
+
+size_t ColorSignature::serialized_size(const CLWEParameters& params, SignatureFormat format) {
+    return (format == SignatureFormat::FIPS204 ? SIGNATURE_HEADER_BYTES : 0) +
+           signature_layout(params, format).components();
+}
+
 ColorSignature ColorSignature::deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params) {
-    // ML-DSA signature format: z || h || c
-    // z size: 6 + (k * n * 18 + 7) / 8 bytes (18-bit ML-DSA compression)
-    // h size: omega bytes (hint)
-    // c size: (degree + 3) / 4 bytes (packed challenge)
+    return deserialize(data.data(), data.size(), params);
+}
 
-    size_t z_size = 6 + ((params.module_rank * params.degree * 18 + 7) / 8);
-    size_t h_size = params.omega;
-    size_t c_size = (params.degree + 3) / 4;
+ColorSignature ColorSignature::deserialize(const uint8_t* data, size_t size, const CLWEParameters& params) {
+    return SignatureView::parse(data, size, params).to_signature();
+}
 
-    size_t expected_size = z_size + h_size + c_size;
-    if (data.size() != expected_size) {
+namespace {
+
+// Split z || h || c into component views after checking the total size
+SignatureView split_signature(const uint8_t* data, size_t size, const SignatureLayout& layout,
+                              const CLWEParameters& params, SignatureFormat format) {
+    if (size != layout.components()) {
         throw std::invalid_argument("Signature data size mismatch");
     }
 
+    SignatureView view;
+    view.z_data = ByteSpan(data, layout.z_bytes);
+    view.h_data = ByteSpan(data + layout.z_bytes, layout.h_bytes);
+    view.c_data = ByteSpan(data + layout.z_bytes + layout.h_bytes, layout.c_bytes);
+    view.params = params;
+    view.format = format;
+    return view;
+}
+
+} // namespace
+
+SignatureView::SignatureView(const ColorSignature& signature)
+    : z_data(signature.z_data.data(), signature.z_data.size()),
+      h_data(signature.h_data.data(), signature.h_data.size()),
+      c_data(signature.c_data.data(), signature.c_data.size()),
+      params(signature.params),
+      format(signature.format) {
+}
+
+SignatureView SignatureView::parse(const uint8_t* data, size_t size, const CLWEParameters& params) {
+    // Legacy signatures (z || h || c, no header) are recognised by their size; none of the
+    // standard sets has a FIPS 204 signature of the same length.
+    SignatureLayout legacy = signature_layout(params, SignatureFormat::LEGACY);
+    if (size == legacy.components() || size < SIGNATURE_HEADER_BYTES || data[0] != SIGNATURE_MAGIC) {
+        return split_signature(data, size, legacy, params, SignatureFormat::LEGACY);
+    }
+
+    if (data[1] != SIGNATURE_FORMAT_VERSION) {
+        throw std::invalid_argument("Unsupported signature format version: " + std::to_string(data[1]));
+    }
+    return split_signature(data + SIGNATURE_HEADER_BYTES, size - SIGNATURE_HEADER_BYTES,
+                           signature_layout(params, SignatureFormat::FIPS204), params, SignatureFormat::FIPS204);
+}
+
+ColorSignature SignatureView::to_signature() const {
     ColorSignature sig;
-    size_t offset = 0;
-    sig.z_data.assign(data.begin() + offset, data.begin() + offset + z_size);
-    offset += z_size;
-    sig.h_data.assign(data.begin() + offset, data.begin() + offset + h_size);
-    offset += h_size;
-    sig.c_data.assign(data.begin() + offset, data.begin() + offset + c_size);
+    sig.z_data.assign(z_data.begin(), z_data.end());
+    sig.h_data.assign(h_data.begin(), h_data.end());
+    sig.c_data.assign(c_data.begin(), c_data.end());
     sig.params = params;
+    sig.format = format;
+    return sig;
+}
+
+template<uint32_t Level>
+std::array<uint8_t, ParameterSet<Level>::SIGNATURE_BYTES> FixedSignature<Level>::serialize() const {
+    std::array<uint8_t, Params::SIGNATURE_BYTES> data;
+    auto out = std::copy(z_data.begin(), z_data.end(), data.begin());
+    out = std::copy(h_data.begin(), h_data.end(), out);
+    std::copy(c_data.begin(), c_data.end(), out);
+    return data;
+}
+
+template<uint32_t Level>
+FixedSignature<Level> FixedSignature<Level>::deserialize(const uint8_t* data, size_t size) {
+    if (size != Params::SIGNATURE_BYTES) {
+        throw std::invalid_argument("Signature data size mismatch");
+    }
+
+    FixedSignature sig;
+    std::copy(data, data + Params::Z_BYTES, sig.z_data.begin());
+    data += Params::Z_BYTES;
+    std::copy(data, data + Params::H_BYTES, sig.h_data.begin());
+    data += Params::H_BYTES;
+    std::copy(data, data + Params::C_BYTES, sig.c_data.begin());
+    return sig;
+}
+
+template<uint32_t Level>
+FixedSignature<Level> FixedSignature<Level>::from_signature(const ColorSignature& signature) {
+    if (signature.format != SignatureFormat::LEGACY) {
+        throw std::invalid_argument("Fixed signatures hold the legacy format only");
+    }
+    if (signature.z_data.size() != Params::Z_BYTES || signature.h_data.size() != Params::H_BYTES ||
+        signature.c_data.size() != Params::C_BYTES) {
+        throw std::invalid_argument("Signature component sizes do not match parameter set");
+    }
+
+    FixedSignature sig;
+    std::copy(signature.z_data.begin(), signature.z_data.end(), sig.z_data.begin());
+    std::copy(signature.h_data.begin(), signature.h_data.end(), sig.h_data.begin());
+    std::copy(signature.c_data.begin(), signature.c_data.end(), sig.c_data.begin());
+    return sig;
+}
+
+template<uint32_t Level>
+ColorSignature FixedSignature<Level>::to_signature() const {
+    ColorSignature sig;
+    sig.z_data.assign(z_data.begin(), z_data.end());
+    sig.h_data.assign(h_data.begin(), h_data.end());
+    sig.c_data.assign(c_data.begin(), c_data.end());
+    sig.params = CLWEParameters(Level);
     return sig;
 }
 
+// Sample y uniformly from [-(gamma1 - 1), gamma1 - 1] (same stream as ColorSign::sample_y)
+template<uint32_t Level>
+void ColorSignT<Level>::sample_y(SHAKE256Sampler& sampler, uint32_t* y) {
+    constexpr int32_t min_val = -static_cast<int32_t>(Params::GAMMA1 - 1);
+    constexpr int32_t max_val = Params::GAMMA1 - 1;
+    constexpr int32_t range = max_val - min_val + 1;
+    constexpr int64_t q = Params::Q;
+
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        uint8_t bytes[4];
+        sampler.squeeze(bytes, 4);
+        uint32_t random_val = (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24));
+        int32_t sampled = static_cast<int32_t>(random_val % range) + min_val;
+        y[i] = (static_cast<int64_t>(sampled) % q + q) % q;
+    }
+}
+
+// Same semantics as InputValidator::validate_polynomial_vector_bounds (values >= q/2 are negative)
+template<uint32_t Level>
+SecurityError ColorSignT<Level>::validate_y_bounds(const uint32_t* y) {
+    constexpr int32_t min_val = -static_cast<int32_t>(Params::GAMMA1 - 1);
+    constexpr int32_t max_val = Params::GAMMA1 - 1;
+    constexpr int32_t q = Params::Q;
+
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        int32_t signed_coeff = (y[i] >= Params::Q / 2) ? static_cast<int32_t>(y[i]) - q : static_cast<int32_t>(y[i]);
+        if (signed_coeff < min_val || signed_coeff > max_val) {
+            return SecurityError::BOUNDS_CHECK_FAILURE;
+        }
+    }
+    return SecurityError::SUCCESS;
+}
+
+template<uint32_t Level>
+void ColorSignT<Level>::compute_w(const NTTEngine& ntt_engine, const uint32_t* matrix_A, const uint32_t* y,
+                                  uint32_t* w, uint32_t* product) {
+    constexpr uint32_t K = Params::K;
+    constexpr uint32_t N = Params::N;
+
+    std::fill(w, w + Params::VECTOR_COEFFS, 0);
+    for (uint32_t i = 0; i < K; ++i) {
+        uint32_t* w_i = w + i * N;
+        for (uint32_t m = 0; m < K; ++m) {
+            ntt_engine.multiply(matrix_A + (i * K + m) * N, y + m * N, product);
+            for (uint32_t j = 0; j < N; ++j) {
+                w_i[j] = ConstantTime::ct_add(w_i[j], product[j], Params::Q);
+            }
+        }
+    }
+}
+
+// w1 = floor((w + 2^12) / 2^13)
+template<uint32_t Level>
+void ColorSignT<Level>::compute_w1(const uint32_t* w, uint32_t* w1) {
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        w1[i] = (w[i] + (1u << 12)) >> 13;
+    }
+}
+
+template<uint32_t Level>
+bool ColorSignT<Level>::check_w1_bounds(const uint32_t* w1) {
+    uint32_t max_w1 = 0;
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        uint32_t abs_coeff = (w1[i] > Params::Q / 2) ? Params::Q - w1[i] : w1[i];
+        max_w1 = std::max(max_w1, abs_coeff);
+    }
+    return max_w1 < Params::GAMMA2 - Params::BETA;
+}
+
+template<uint32_t Level>
+void ColorSignT<Level>::encode_w1(const uint32_t* w1, uint8_t* out) {
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        out[2 * i] = w1[i] & 0xFF;
+        out[2 * i + 1] = (w1[i] >> 8) & 0xFF;
+    }
+}
+
+template<uint32_t Level>
+void ColorSignT<Level>::compute_z(const NTTEngine& ntt_engine, const uint32_t* y, const uint32_t* c,
+                                  const uint32_t* s1, const uint32_t* s2, uint32_t* z, uint32_t* product) {
+    constexpr uint32_t N = Params::N;
+
+    for (uint32_t i = 0; i < Params::K; ++i) {
+        uint32_t* z_i = z + i * N;
+        const uint32_t* y_i = y + i * N;
+        ntt_engine.multiply(c, s1 + i * N, z_i);
+        ntt_engine.multiply(c, s2 + i * N, product);
+        for (uint32_t j = 0; j < N; ++j) {
+            uint32_t sum_cs = ConstantTime::ct_add(z_i[j], product[j], Params::Q);
+            z_i[j] = ConstantTime::ct_add(y_i[j], sum_cs, Params::Q);
+        }
+    }
+}
+
+template<uint32_t Level>
+bool ColorSignT<Level>::check_z_bounds(const uint32_t* z) {
+    constexpr int32_t bound = Params::GAMMA1 - Params::BETA;
+    constexpr int32_t q = Params::Q;
+
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        int32_t signed_coeff = (z[i] > Params::Q / 2) ? static_cast<int32_t>(z[i]) - q : static_cast<int32_t>(z[i]);
+        if (signed_coeff < -bound || signed_coeff > bound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<uint32_t Level>
+void ColorSignT<Level>::compute_w_prime(const NTTEngine& ntt_engine, const uint32_t* w, const uint32_t* c,
+                                        const uint32_t* s2, uint32_t* w_prime, uint32_t* product) {
+    constexpr uint32_t N = Params::N;
+
+    for (uint32_t i = 0; i < Params::K; ++i) {
+        ntt_engine.multiply(c, s2 + i * N, product);
+        const uint32_t* w_i = w + i * N;
+        uint32_t* w_prime_i = w_prime + i * N;
+        for (uint32_t j = 0; j < N; ++j) {
+            w_prime_i[j] = ConstantTime::ct_sub(w_i[j], product[j], Params::Q);
+        }
+    }
+}
+
+// Set hint bit i for the i-th coefficient with |w| <= gamma2 < |w'|, up to omega hints
+template<uint32_t Level>
+void ColorSignT<Level>::make_hint(const uint32_t* w, const uint32_t* w_prime, uint8_t* h) {
+    constexpr int32_t q = Params::Q;
+    constexpr uint32_t half = (Params::Q + 1) / 2;
+
+    std::fill(h, h + Params::H_BYTES, 0);
+    size_t hint_index = 0;
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        int32_t w_signed = (w[i] >= half) ? static_cast<int32_t>(w[i]) - q : static_cast<int32_t>(w[i]);
+        int32_t w_prime_signed = (w_prime[i] >= half) ? static_cast<int32_t>(w_prime[i]) - q : static_cast<int32_t>(w_prime[i]);
+        uint32_t hint_needed = (ConstantTime::ct_abs(w_signed) <= Params::GAMMA2) &
+                               (ConstantTime::ct_abs(w_prime_signed) > Params::GAMMA2);
+
+        if (hint_needed && hint_index < Params::OMEGA) {
+            size_t byte_idx = hint_index / 8;
+            uint8_t mask = static_cast<uint8_t>(1 << (hint_index % 8));
+            h[byte_idx] = ConstantTime::select(h[byte_idx], static_cast<uint8_t>(h[byte_idx] | mask), hint_needed);
+        }
+        hint_index += hint_needed;
+    }
+}
+
+// 1 -> 01, -1 -> 10, 0 -> 00, four coefficients per byte
+template<uint32_t Level>
+void ColorSignT<Level>::pack_challenge(const uint32_t* c, uint8_t* packed) {
+    for (size_t byte_idx = 0; byte_idx < Params::C_BYTES; ++byte_idx) {
+        uint8_t value = 0;
+        for (uint32_t slot = 0; slot < 4; ++slot) {
+            uint32_t coeff = c[4 * byte_idx + slot];
+            uint8_t bits = (coeff == 1) ? 1 : (coeff == Params::Q - 1) ? 2 : 0;
+            value |= static_cast<uint8_t>(bits << (2 * slot));
+        }
+        packed[byte_idx] = value;
+    }
+}
+
+template struct FixedSignature<44>;
+template struct FixedSignature<65>;
+template struct FixedSignature<87>;
+template class ColorSignT<44>;
+template class ColorSignT<65>;
+template class ColorSignT<87>;
+
 // Error message utility with comprehensive error handling
 std::string get_colorsign_sign_error_message(ColorSignSignError error) {
     switch (error) {
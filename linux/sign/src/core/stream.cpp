@@ -0,0 +1,267 @@
+#include "../include/clwe/stream.hpp"
+#include "../include/clwe/security_utils.hpp"
+#include <openssl/evp.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clwe {
+
+namespace {
+
+// DER-encoded object identifiers of the pre-hash functions (FIPS 204, Algorithm 4)
+constexpr uint8_t OID_SHA512[11] = {0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03};
+constexpr uint8_t OID_SHAKE256[11] = {0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x0C};
+
+constexpr size_t PREHASH_BYTES = 64;
+constexpr size_t FILE_CHUNK_BYTES = 8u << 20;   // Slice of a mapping handed to the consumer
+constexpr size_t READ_BLOCK_BYTES = 1u << 20;   // Buffer for files that cannot be mapped
+constexpr size_t READ_BLOCK_ALIGNMENT = 4096;
+
+// Reads `fd` to the end through an aligned buffer
+void read_file_blocks(int fd, const std::string& path, const std::function<void(const uint8_t*, size_t)>& consume) {
+    std::unique_ptr<uint8_t, decltype(&std::free)> buffer(
+        static_cast<uint8_t*>(std::aligned_alloc(READ_BLOCK_ALIGNMENT, READ_BLOCK_BYTES)), &std::free);
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+
+    while (true) {
+        ssize_t n = ::read(fd, buffer.get(), READ_BLOCK_BYTES);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to read file: " + path);
+        }
+        if (n == 0) {
+            return;
+        }
+        consume(buffer.get(), static_cast<size_t>(n));
+    }
+}
+
+} // namespace
+
+struct MessageHashStream::PreHashState {
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+
+    ~PreHashState() { EVP_MD_CTX_free(ctx); }
+};
+
+MessageHashStream::MessageHashStream() = default;
+
+MessageHashStream::~MessageHashStream() = default;
+
+void MessageHashStream::begin(PreHashAlgorithm algorithm, const uint8_t* context, size_t context_len,
+                              const uint8_t* secret, size_t secret_len) {
+    if (InputValidator::validate_context_string(context, context_len) != SecurityError::SUCCESS) {
+        throw std::invalid_argument("Invalid context in streaming message");
+    }
+
+    algorithm_ = algorithm;
+    has_secret_ = secret != nullptr;
+    bytes_absorbed_ = 0;
+    mu_hash_.reset();
+    rho_prime_hash_.reset();
+    if (has_secret_) {
+        rho_prime_hash_.absorb(secret, secret_len);
+    }
+
+    if (algorithm_ == PreHashAlgorithm::NONE) {
+        // Same prefix as the one-shot hash_message, present even for an empty context
+        uint8_t prefix[2] = {0, static_cast<uint8_t>(context_len)};  // DOM_SEP, context length
+        mu_hash_.absorb(prefix, sizeof(prefix));
+        mu_hash_.absorb(context, context_len);
+    } else {
+        // The context goes into the representative at finish(), after PH(M) is known
+        std::copy(context, context + context_len, context_.begin());
+        context_len_ = context_len;
+
+        if (!prehash_) {
+            prehash_ = std::make_unique<PreHashState>();
+        }
+        const EVP_MD* md = algorithm_ == PreHashAlgorithm::SHA512 ? EVP_sha512() : EVP_shake256();
+        if (!prehash_->ctx || EVP_DigestInit_ex(prehash_->ctx, md, nullptr) != 1) {
+            throw std::runtime_error("Pre-hash initialization failed");
+        }
+    }
+    active_ = true;
+}
+
+void MessageHashStream::update(const uint8_t* data, size_t len) {
+    if (!active_) {
+        throw std::logic_error("Streaming message update before begin");
+    }
+    if (len == 0) {
+        return;
+    }
+
+    if (algorithm_ == PreHashAlgorithm::NONE) {
+        mu_hash_.absorb(data, len);
+        if (has_secret_) {
+            rho_prime_hash_.absorb(data, len);
+        }
+    } else if (EVP_DigestUpdate(prehash_->ctx, data, len) != 1) {
+        throw std::runtime_error("Pre-hash update failed");
+    }
+    bytes_absorbed_ += len;
+}
+
+void MessageHashStream::finish(uint8_t* mu, uint8_t* rho_prime, size_t rho_prime_len) {
+    if (!active_) {
+        throw std::logic_error("Streaming message finish before begin");
+    }
+    active_ = false;
+
+    if (algorithm_ != PreHashAlgorithm::NONE) {
+        uint8_t digest[PREHASH_BYTES];
+        int ok = algorithm_ == PreHashAlgorithm::SHA512
+            ? EVP_DigestFinal_ex(prehash_->ctx, digest, nullptr)
+            : EVP_DigestFinalXOF(prehash_->ctx, digest, PREHASH_BYTES);
+        if (ok != 1) {
+            throw std::runtime_error("Pre-hash finalization failed");
+        }
+
+        // M' = 1 || |ctx| || ctx || OID(PH) || PH(M)
+        const uint8_t* oid = algorithm_ == PreHashAlgorithm::SHA512 ? OID_SHA512 : OID_SHAKE256;
+        uint8_t prefix[2] = {1, static_cast<uint8_t>(context_len_)};
+        for (SHAKE256Sampler* hash : {&mu_hash_, &rho_prime_hash_}) {
+            if (hash == &rho_prime_hash_ && !has_secret_) continue;
+            hash->absorb(prefix, sizeof(prefix));
+            hash->absorb(context_.data(), context_len_);
+            hash->absorb(oid, sizeof(OID_SHA512));
+            hash->absorb(digest, sizeof(digest));
+        }
+    }
+
+    mu_hash_.pad_and_absorb();
+    mu_hash_.squeeze(mu, 64);  // 64 bytes for ML-DSA mu
+    if (has_secret_ && rho_prime) {
+        rho_prime_hash_.pad_and_absorb();
+        rho_prime_hash_.squeeze(rho_prime, rho_prime_len);
+    }
+    rho_prime_hash_.reset();  // Drop key-dependent state
+}
+
+StreamingSigner::StreamingSigner(ColorSign& signer, const ColorSignPrivateKey& private_key,
+                                 const ColorSignPublicKey& public_key)
+    : signer_(signer),
+      expanded_(private_key.is_seed_only() ? signer.expanded_key_cache().expand(private_key) : nullptr),
+      private_key_(expanded_ ? *expanded_ : private_key),
+      public_key_(public_key) {
+}
+
+void StreamingSigner::begin(PreHashAlgorithm algorithm, const uint8_t* context, size_t context_len) {
+    stream_.begin(algorithm, context, context_len, private_key_.secret_data.data(), private_key_.secret_data.size());
+}
+
+void StreamingSigner::update(const uint8_t* chunk, size_t len) {
+    stream_.update(chunk, len);
+}
+
+ColorSignature StreamingSigner::finish() {
+    SignWorkspace workspace(signer_.params());
+    ColorSignature signature;
+    finish(workspace, signature);
+    return signature;
+}
+
+void StreamingSigner::finish(SignWorkspace& workspace, ColorSignature& signature) {
+    if (!stream_.active()) {
+        throw std::logic_error("Streaming signature finish before begin");
+    }
+    signer_.sign_stream(stream_, private_key_, public_key_, workspace, signature);
+}
+
+StreamingVerifier::StreamingVerifier(ColorSignVerify& verifier, const PublicKeyView& public_key,
+                                     const SignatureView& signature)
+    : verifier_(verifier), public_key_(public_key), signature_(signature) {
+}
+
+void StreamingVerifier::begin(PreHashAlgorithm algorithm, const uint8_t* context, size_t context_len) {
+    stream_.begin(algorithm, context, context_len);
+}
+
+void StreamingVerifier::update(const uint8_t* chunk, size_t len) {
+    stream_.update(chunk, len);
+}
+
+bool StreamingVerifier::finish() {
+    VerifyWorkspace workspace(verifier_.params());
+    return finish(workspace);
+}
+
+bool StreamingVerifier::finish(VerifyWorkspace& workspace) {
+    if (!stream_.active()) {
+        throw std::logic_error("Streaming verification finish before begin");
+    }
+    return verifier_.verify_stream(stream_, public_key_, signature_, workspace);
+}
+
+void for_each_file_chunk(const std::string& path, const std::function<void(const uint8_t*, size_t)>& consume) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    try {
+        struct stat st;
+        void* mapping = MAP_FAILED;
+        size_t size = 0;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            size = static_cast<size_t>(st.st_size);
+            mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+
+        if (mapping == MAP_FAILED) {
+            read_file_blocks(fd, path, consume);
+        } else {
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            try {
+                const uint8_t* data = static_cast<const uint8_t*>(mapping);
+                for (size_t offset = 0; offset < size; offset += FILE_CHUNK_BYTES) {
+                    consume(data + offset, std::min(FILE_CHUNK_BYTES, size - offset));
+                }
+            } catch (...) {
+                ::munmap(mapping, size);
+                throw;
+            }
+            ::munmap(mapping, size);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+ColorSignature sign_file(ColorSign& signer,
+                         const std::string& path,
+                         const ColorSignPrivateKey& private_key,
+                         const ColorSignPublicKey& public_key,
+                         PreHashAlgorithm algorithm,
+                         const std::vector<uint8_t>& context) {
+    StreamingSigner stream(signer, private_key, public_key);
+    stream.begin(algorithm, context.data(), context.size());
+    for_each_file_chunk(path, [&](const uint8_t* chunk, size_t len) { stream.update(chunk, len); });
+    return stream.finish();
+}
+
+bool verify_file(ColorSignVerify& verifier,
+                 const std::string& path,
+                 const PublicKeyView& public_key,
+                 const SignatureView& signature,
+                 PreHashAlgorithm algorithm,
+                 const std::vector<uint8_t>& context) {
+    StreamingVerifier stream(verifier, public_key, signature);
+    stream.begin(algorithm, context.data(), context.size());
+    for_each_file_chunk(path, [&](const uint8_t* chunk, size_t len) { stream.update(chunk, len); });
+    return stream.finish();
+}
+
+} // namespace clwe
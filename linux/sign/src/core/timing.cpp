@@ -0,0 +1,331 @@
+#include "../include/clwe/timing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define CLWE_HAVE_TSC 1
+#endif
+
+namespace clwe {
+
+namespace {
+
+constexpr size_t THREAD_CACHE_ENTRIES = 4;
+constexpr auto TSC_CALIBRATION_TIME = std::chrono::milliseconds(2);
+
+uint64_t steady_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct ClockCalibration {
+    bool tsc = false;
+    double ns_per_tick = 1.0;
+
+    ClockCalibration() {
+#ifdef CLWE_HAVE_TSC
+        // The TSC is only a clock if it is invariant (constant rate across P- and C-states)
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8))) {
+            uint64_t start_ns = steady_ns();
+            uint64_t start_ticks = __rdtsc();
+            uint64_t elapsed_ns;
+            do {
+                elapsed_ns = steady_ns() - start_ns;
+            } while (elapsed_ns < static_cast<uint64_t>(
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(TSC_CALIBRATION_TIME).count()));
+            uint64_t ticks = __rdtsc() - start_ticks;
+            if (ticks > 0) {
+                tsc = true;
+                ns_per_tick = static_cast<double>(elapsed_ns) / static_cast<double>(ticks);
+            }
+        }
+#endif
+    }
+};
+
+const ClockCalibration& clock_calibration() {
+    static const ClockCalibration calibration;
+    return calibration;
+}
+
+std::atomic<uint64_t> next_detector_serial{1};
+
+} // namespace
+
+uint64_t TimestampCounter::now() {
+#ifdef CLWE_HAVE_TSC
+    if (clock_calibration().tsc) {
+        return __rdtsc();
+    }
+#endif
+    return steady_ns();
+}
+
+double TimestampCounter::ns_per_tick() {
+    return clock_calibration().ns_per_tick;
+}
+
+bool TimestampCounter::uses_tsc() {
+    return clock_calibration().tsc;
+}
+
+struct TimingAnomalyDetector::OperationWindow {
+    std::vector<uint64_t> samples;
+    size_t next = 0;
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;  // Sum of squared deviations from the mean
+    double ewma = 0.0;
+    uint64_t observations = 0;
+    uint64_t anomalies = 0;
+    uint32_t consecutive_outliers = 0;
+
+    explicit OperationWindow(size_t length) : samples(length) {}
+
+    void add(uint64_t sample) {
+        double x = static_cast<double>(sample);
+        if (count < samples.size()) {
+            // Welford's update
+            ++count;
+            double delta = x - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (x - mean);
+        } else {
+            // Replace the oldest sample: mean and m2 over the slid window
+            double oldest = static_cast<double>(samples[next]);
+            double old_mean = mean;
+            mean += (x - oldest) / static_cast<double>(count);
+            m2 += (x - oldest) * (x - mean + oldest - old_mean);
+            m2 = std::max(m2, 0.0);
+        }
+        samples[next] = sample;
+        next = next + 1 == samples.size() ? 0 : next + 1;
+
+        ewma = observations == 0 ? x : ewma + EWMA_ALPHA * (x - ewma);
+        ++observations;
+    }
+
+    double stddev() const {
+        return count > 0 ? std::sqrt(m2 / static_cast<double>(count)) : 0.0;
+    }
+};
+
+struct TimingAnomalyDetector::ThreadState {
+    std::thread::id owner;
+    std::atomic<bool> retired{false};  // Owner exited; the next new thread takes the state over
+    std::mutex mutex;  // Taken by the owner on every observation; contended only by stats()
+    std::array<std::unique_ptr<OperationWindow>, MAX_OPERATIONS> windows;
+};
+
+// Retires a thread's states when it exits. References are weak: a detector may be destroyed
+// before or after the threads that observed it.
+struct TimingAnomalyDetector::ThreadExitHook {
+    std::vector<std::weak_ptr<ThreadState>> states;
+
+    void add(const std::shared_ptr<ThreadState>& state) {
+        states.erase(std::remove_if(states.begin(), states.end(),
+                                    [](const std::weak_ptr<ThreadState>& s) { return s.expired(); }),
+                     states.end());
+        states.push_back(state);
+    }
+
+    ~ThreadExitHook() {
+        for (const auto& weak : states) {
+            if (auto state = weak.lock()) {
+                state->retired.store(true, std::memory_order_release);
+            }
+        }
+    }
+};
+
+TimingAnomalyDetector::TimingAnomalyDetector(size_t window)
+    : serial_(next_detector_serial.fetch_add(1, std::memory_order_relaxed)), window_(std::max<size_t>(window, 1)) {
+    for (auto& threshold : thresholds_) {
+        threshold.store(DEFAULT_THRESHOLD, std::memory_order_relaxed);
+    }
+    names_.reserve(MAX_OPERATIONS);  // operation_name() hands out references
+}
+
+TimingAnomalyDetector::~TimingAnomalyDetector() = default;
+
+OperationId TimingAnomalyDetector::register_operation(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(names_mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(names_mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (names_.size() == MAX_OPERATIONS) {
+        throw std::length_error("Too many timed operations");
+    }
+    OperationId id = static_cast<OperationId>(names_.size());
+    names_.push_back(name);
+    ids_.emplace(name, id);
+    registered_.store(names_.size(), std::memory_order_release);
+    return id;
+}
+
+OperationId TimingAnomalyDetector::find_operation(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(names_mutex_);
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : INVALID_OPERATION_ID;
+}
+
+const std::string& TimingAnomalyDetector::operation_name(OperationId id) const {
+    check_id(id);
+    std::shared_lock<std::shared_mutex> lock(names_mutex_);
+    return names_[id];
+}
+
+void TimingAnomalyDetector::check_id(OperationId id) const {
+    std::shared_lock<std::shared_mutex> lock(names_mutex_);
+    if (id >= names_.size()) {
+        throw std::out_of_range("Unknown timed operation");
+    }
+}
+
+void TimingAnomalyDetector::set_threshold(OperationId id, double k) {
+    check_id(id);
+    thresholds_[id].store(k, std::memory_order_relaxed);
+}
+
+void TimingAnomalyDetector::set_window(size_t window) {
+    window_.store(std::max<size_t>(window, 1), std::memory_order_relaxed);
+}
+
+TimingAnomalyDetector::ThreadState& TimingAnomalyDetector::thread_state() {
+    // Small per-thread cache of (detector, state) so the common path takes no shared lock
+    struct CacheEntry {
+        uint64_t serial = 0;
+        ThreadState* state = nullptr;
+    };
+    thread_local std::array<CacheEntry, THREAD_CACHE_ENTRIES> cache;
+    thread_local size_t cache_victim = 0;
+    thread_local ThreadExitHook exit_hook;
+
+    for (const CacheEntry& entry : cache) {
+        if (entry.serial == serial_) {
+            return *entry.state;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    std::thread::id self = std::this_thread::get_id();
+    ThreadState* state = nullptr;
+    std::shared_ptr<ThreadState> retired;
+    for (const auto& candidate : threads_) {
+        // Ids of exited threads can be reused, so only a live state counts as ours
+        if (candidate->retired.load(std::memory_order_acquire)) {
+            if (!retired) {
+                retired = candidate;
+            }
+        } else if (candidate->owner == self) {
+            state = candidate.get();
+            break;
+        }
+    }
+    if (!state) {
+        if (!retired) {
+            threads_.push_back(std::make_shared<ThreadState>());
+            retired = threads_.back();
+        }
+        retired->owner = self;
+        retired->retired.store(false, std::memory_order_relaxed);
+        exit_hook.add(retired);
+        state = retired.get();
+    }
+    cache[cache_victim] = {serial_, state};
+    cache_victim = (cache_victim + 1) % THREAD_CACHE_ENTRIES;
+    return *state;
+}
+
+bool TimingAnomalyDetector::observe(OperationId id, uint64_t duration_ns, TimingObservation* observation) {
+    if (id >= registered_.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown timed operation");
+    }
+    ThreadState& state = thread_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::unique_ptr<OperationWindow>& slot = state.windows[id];
+    if (!slot) {
+        slot = std::make_unique<OperationWindow>(window());
+    }
+    OperationWindow& window = *slot;
+    window.add(duration_ns);
+
+    if (window.count < MIN_SAMPLES) {
+        return false;
+    }
+
+    double stddev = window.stddev();
+    double threshold = window.mean + thresholds_[id].load(std::memory_order_relaxed) * stddev;
+    bool outlier = static_cast<double>(duration_ns) > threshold;
+    if (observation) {
+        *observation = {window.mean, stddev, threshold, outlier};
+    }
+
+    if (!outlier) {
+        window.consecutive_outliers = 0;
+        return false;
+    }
+    if (++window.consecutive_outliers < CONSECUTIVE_OUTLIERS) {
+        return false;
+    }
+    ++window.anomalies;
+    return true;
+}
+
+OperationTimingStats TimingAnomalyDetector::stats(OperationId id) const {
+    check_id(id);
+    OperationTimingStats stats;
+    double m2 = 0.0;
+    double ewma_weight = 0.0;
+
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    for (const auto& state : threads_) {
+        std::lock_guard<std::mutex> state_lock(state->mutex);
+        const OperationWindow* window = state->windows[id].get();
+        if (!window || window->count == 0) {
+            continue;
+        }
+
+        // Chan et al. pairwise combination of the window moments
+        double n_a = static_cast<double>(stats.window_samples);
+        double n_b = static_cast<double>(window->count);
+        double n = n_a + n_b;
+        double delta = window->mean - stats.mean_ns;
+        stats.mean_ns += delta * n_b / n;
+        m2 += window->m2 + delta * delta * n_a * n_b / n;
+        stats.window_samples += window->count;
+
+        double weight = static_cast<double>(window->observations);
+        stats.ewma_ns = (stats.ewma_ns * ewma_weight + window->ewma * weight) / (ewma_weight + weight);
+        ewma_weight += weight;
+
+        stats.observations += window->observations;
+        stats.anomalies += window->anomalies;
+    }
+    if (stats.window_samples > 0) {
+        stats.stddev_ns = std::sqrt(m2 / static_cast<double>(stats.window_samples));
+    }
+    return stats;
+}
+
+size_t TimingAnomalyDetector::thread_states() const {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    return threads_.size();
+}
+
+} // namespace clwe
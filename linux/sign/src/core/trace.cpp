@@ -0,0 +1,205 @@
+#include "../include/clwe/trace.hpp"
+#include "../include/clwe/timing.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace clwe {
+
+namespace {
+
+uint64_t current_thread_id() {
+#ifdef __linux__
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+uint64_t current_process_id() {
+#ifdef __linux__
+    return static_cast<uint64_t>(getpid());
+#else
+    return 1;
+#endif
+}
+
+struct ThreadTrace;
+
+// Spans of exited threads keep their thread id
+struct RetiredEvents {
+    uint64_t thread_id;
+    std::vector<TraceEvent> events;
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<ThreadTrace*> threads;
+    std::vector<RetiredEvents> retired;
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> epoch_ticks{0};   // Trace time zero
+};
+
+// Never destroyed, so thread_local destructors running at exit can still hand over spans
+TraceRegistry& trace_registry() {
+    static TraceRegistry* registry = new TraceRegistry();
+    return *registry;
+}
+
+// Only the owning thread appends; the mutex is uncontended except while exporting
+struct ThreadTrace {
+    uint64_t thread_id = current_thread_id();
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+
+    ThreadTrace() {
+        TraceRegistry& registry = trace_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(this);
+    }
+
+    ~ThreadTrace() {
+        TraceRegistry& registry = trace_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!events.empty()) {
+            registry.retired.push_back({thread_id, std::move(events)});
+        }
+        registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), this),
+                               registry.threads.end());
+    }
+};
+
+ThreadTrace& thread_trace() {
+    thread_local ThreadTrace trace;
+    return trace;
+}
+
+void append_event(std::ostringstream& out, bool& first, const TraceEvent& event, uint64_t thread_id,
+                  uint64_t process_id, uint64_t epoch_ticks) {
+    // Spans that began before the last clear() or enable() are clamped to time zero
+    uint64_t begin = event.begin_ticks > epoch_ticks ? event.begin_ticks - epoch_ticks : 0;
+    uint64_t end = event.end_ticks > epoch_ticks ? event.end_ticks - epoch_ticks : 0;
+    double ts_us = static_cast<double>(TimestampCounter::to_ns(begin)) / 1000.0;
+    double dur_us = static_cast<double>(TimestampCounter::to_ns(end - begin)) / 1000.0;
+
+    char line[256];
+    int written = std::snprintf(line, sizeof(line),
+                                "%s\n{\"name\":\"%s\",\"cat\":\"colorsign\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                                "\"pid\":%llu,\"tid\":%llu",
+                                first ? "" : ",", event.name, ts_us, dur_us,
+                                static_cast<unsigned long long>(process_id),
+                                static_cast<unsigned long long>(thread_id));
+    out.write(line, std::min<int>(written, static_cast<int>(sizeof(line)) - 1));
+    if (event.arg >= 0) {
+        out << ",\"args\":{\"attempt\":" << event.arg << '}';
+    }
+    out << '}';
+    first = false;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void Tracer::enable(bool enabled) {
+    if (enabled) {
+        uint64_t zero = 0;
+        trace_registry().epoch_ticks.compare_exchange_strong(zero, TimestampCounter::now());
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::record(const TraceEvent& event) {
+    ThreadTrace& trace = thread_trace();
+    std::lock_guard<std::mutex> lock(trace.mutex);
+    if (trace.events.size() >= MAX_EVENTS_PER_THREAD) {
+        trace_registry().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    trace.events.push_back(event);
+}
+
+size_t Tracer::event_count() {
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t count = 0;
+    for (const RetiredEvents& retired : registry.retired) {
+        count += retired.events.size();
+    }
+    for (ThreadTrace* thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        count += thread->events.size();
+    }
+    return count;
+}
+
+uint64_t Tracer::dropped_events() {
+    return trace_registry().dropped.load(std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retired.clear();
+    for (ThreadTrace* thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        thread->events.clear();
+    }
+    registry.dropped.store(0, std::memory_order_relaxed);
+    registry.epoch_ticks.store(TimestampCounter::now(), std::memory_order_relaxed);
+}
+
+std::string Tracer::chrome_trace_json() {
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    uint64_t process_id = current_process_id();
+    uint64_t epoch_ticks = registry.epoch_ticks.load(std::memory_order_relaxed);
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const RetiredEvents& retired : registry.retired) {
+        for (const TraceEvent& event : retired.events) {
+            append_event(out, first, event, retired.thread_id, process_id, epoch_ticks);
+        }
+    }
+    for (ThreadTrace* thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        for (const TraceEvent& event : thread->events) {
+            append_event(out, first, event, thread->thread_id, process_id, epoch_ticks);
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+void Tracer::write_chrome_trace(const std::string& path) {
+    std::string json = chrome_trace_json();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(json.data(), static_cast<std::streamsize>(json.size())) || !file.flush()) {
+        throw std::runtime_error("Failed to write trace file: " + path);
+    }
+}
+
+void TraceSpan::begin(const char* name, int64_t arg) {
+    event_.name = name;
+    event_.arg = arg;
+    event_.begin_ticks = TimestampCounter::now();
+}
+
+void TraceSpan::end() {
+    event_.end_ticks = TimestampCounter::now();
+    Tracer::record(event_);
+}
+
+} // namespace clwe
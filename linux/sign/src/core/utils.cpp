@@ -4,6 +4,11 @@
 #include <cstring>
 #include <vector>
 #include <array>
+#include <cstddef>
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+#endif
 
 #include <sys/random.h>
 
@@ -30,7 +35,7 @@ static const int KECCAK_RHO_OFFSETS[25] = {
 };
 
 // Keccak-f[1600] permutation
-static void keccak_f1600(uint64_t state[25]) {
+void keccak_f1600(uint64_t state[25]) {
     uint64_t C[5], D[5], B[25];
 
     for (int round = 0; round < 24; ++round) {
@@ -309,6 +314,14 @@ void SHAKE256Sampler::sample_polynomial_binomial(uint32_t* coeffs, size_t degree
     }
 }
 
+void SHAKE256Sampler::sample_polynomial_centered(uint32_t* coeffs, size_t degree,
+                                                uint32_t eta, uint32_t modulus) {
+    for (size_t i = 0; i < degree; ++i) {
+        int32_t coeff = sample_binomial_coefficient(eta);
+        coeffs[i] = coeff < 0 ? modulus - static_cast<uint32_t>(-coeff) : static_cast<uint32_t>(coeff);
+    }
+}
+
 uint32_t SHAKE256Sampler::sample_uniform(uint32_t modulus) {
     // Sample uniformly from [0, modulus)
     uint32_t result = 0;
@@ -371,10 +384,14 @@ uint32_t mod_pow(uint32_t base, uint32_t exp, uint32_t mod) {
 }
 
 // ML-DSA specific utilities
-void compute_high_bits(const std::vector<uint32_t>& w, std::vector<uint32_t>& w1, uint32_t d, uint32_t q) {
+void compute_high_bits(const std::vector<uint32_t>& w, std::vector<uint32_t>& w1, uint32_t d) {
+    compute_high_bits(w.data(), w1.data(), w.size(), d);
+}
+
+void compute_high_bits(const uint32_t* w, uint32_t* w1, size_t count, uint32_t d) {
     uint32_t shift = 1 << (d - 1);  // 2^{d-1}
     uint32_t divisor = 1 << d;      // 2^d
-    for (size_t i = 0; i < w.size(); ++i) {
+    for (size_t i = 0; i < count; ++i) {
         // w1 = floor((w + 2^{d-1}) / 2^d)
         uint64_t temp = static_cast<uint64_t>(w[i]) + shift;
         w1[i] = temp / divisor;
@@ -382,12 +399,18 @@ void compute_high_bits(const std::vector<uint32_t>& w, std::vector<uint32_t>& w1
 }
 
 void sample_challenge(std::vector<uint32_t>& c, const std::vector<uint8_t>& seed, uint32_t tau, uint32_t n, uint32_t q) {
+    std::vector<uint32_t> positions;
+    sample_challenge(c, seed.data(), seed.size(), tau, n, q, positions);
+}
+
+void sample_challenge(std::vector<uint32_t>& c, const uint8_t* seed, size_t seed_len, uint32_t tau, uint32_t n, uint32_t q,
+                      std::vector<uint32_t>& positions) {
     // Initialize SHAKE256 with seed
     SHAKE256Sampler sampler;
-    sampler.init(seed.data(), seed.size());
+    sampler.init(seed, seed_len);
 
     // Sample tau positions uniformly
-    std::vector<uint32_t> positions(n);
+    positions.resize(n);
     for (uint32_t i = 0; i < n; ++i) {
         positions[i] = i;
     }
@@ -415,20 +438,21 @@ bool is_power_of_two(uint32_t x) {
 
 // Pack polynomial vector into bytes (little-endian 32-bit per coefficient)
 std::vector<uint8_t> pack_polynomial_vector(const std::vector<std::vector<uint32_t>>& poly_vector) {
-    size_t total_coeffs = 0;
-    for (const auto& poly : poly_vector) {
-        total_coeffs += poly.size();
-    }
+    return pack_polynomial_vector(PolyVec::from_vectors(poly_vector));
+}
+
+std::vector<uint8_t> pack_polynomial_vector(const PolyVec& poly_vector) {
+    const uint32_t* coeffs = poly_vector.data();
+    size_t total_coeffs = poly_vector.coeff_count();
     std::vector<uint8_t> packed(total_coeffs * 4);
 
     size_t offset = 0;
-    for (const auto& poly : poly_vector) {
-        for (uint32_t coeff : poly) {
-            packed[offset++] = coeff & 0xFF;
-            packed[offset++] = (coeff >> 8) & 0xFF;
-            packed[offset++] = (coeff >> 16) & 0xFF;
-            packed[offset++] = (coeff >> 24) & 0xFF;
-        }
+    for (size_t i = 0; i < total_coeffs; ++i) {
+        uint32_t coeff = coeffs[i];
+        packed[offset++] = coeff & 0xFF;
+        packed[offset++] = (coeff >> 8) & 0xFF;
+        packed[offset++] = (coeff >> 16) & 0xFF;
+        packed[offset++] = (coeff >> 24) & 0xFF;
     }
     return packed;
 }
@@ -436,6 +460,10 @@ std::vector<uint8_t> pack_polynomial_vector(const std::vector<std::vector<uint32
 // Variable-length encoding for polynomial coefficients
 // Uses 1-5 bytes per coefficient based on value size
 std::vector<uint8_t> pack_polynomial_vector_compressed(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
+    return pack_polynomial_vector_compressed(PolyVec::from_vectors(poly_vector), modulus);
+}
+
+std::vector<uint8_t> pack_polynomial_vector_compressed(const PolyVec& poly_vector, uint32_t modulus) {
     std::vector<uint8_t> compressed;
     compressed.reserve(1024); // Reserve reasonable initial size
 
@@ -445,7 +473,7 @@ std::vector<uint8_t> pack_polynomial_vector_compressed(const std::vector<std::ve
 
     // Store number of polynomials and degree
     uint32_t k = poly_vector.size();
-    uint32_t n = k > 0 ? poly_vector[0].size() : 0;
+    uint32_t n = poly_vector.degree();
 
     compressed.push_back(static_cast<uint8_t>(k));
     compressed.push_back(static_cast<uint8_t>(n >> 8));
@@ -492,6 +520,10 @@ std::vector<uint8_t> pack_polynomial_vector_compressed(const std::vector<std::ve
 
 // Sparse representation for polynomials with many zeros
 std::vector<uint8_t> pack_polynomial_vector_sparse(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
+    return pack_polynomial_vector_sparse(PolyVec::from_vectors(poly_vector), modulus);
+}
+
+std::vector<uint8_t> pack_polynomial_vector_sparse(const PolyVec& poly_vector, uint32_t modulus) {
     std::vector<uint8_t> compressed;
     compressed.reserve(1024);
 
@@ -501,7 +533,7 @@ std::vector<uint8_t> pack_polynomial_vector_sparse(const std::vector<std::vector
 
     // Store number of polynomials and degree
     uint32_t k = poly_vector.size();
-    uint32_t n = k > 0 ? poly_vector[0].size() : 0;
+    uint32_t n = poly_vector.degree();
 
     compressed.push_back(static_cast<uint8_t>(k));
     compressed.push_back(static_cast<uint8_t>(n >> 8));
@@ -559,6 +591,15 @@ std::vector<uint8_t> pack_polynomial_vector_sparse(const std::vector<std::vector
 
 // Unpack compressed polynomial vector (handles both variable-length and sparse formats)
 std::vector<std::vector<uint32_t>> unpack_polynomial_vector_compressed(const std::vector<uint8_t>& data, uint32_t k, uint32_t n, uint32_t modulus) {
+    PolyVec poly_vector(k, n);
+    unpack_polynomial_vector_compressed(data, modulus, poly_vector);
+    return poly_vector.to_vectors();
+}
+
+void unpack_polynomial_vector_compressed(const std::vector<uint8_t>& data, uint32_t modulus, PolyVec& poly_vector) {
+    uint32_t k = poly_vector.size();
+    uint32_t n = poly_vector.degree();
+
     if (data.size() < 5) {
         throw std::invalid_argument("Compressed data too small");
     }
@@ -582,8 +623,6 @@ std::vector<std::vector<uint32_t>> unpack_polynomial_vector_compressed(const std
         throw std::invalid_argument("Dimension mismatch in compressed data");
     }
 
-    std::vector<std::vector<uint32_t>> poly_vector(k, std::vector<uint32_t>(n, 0));
-
     if (compression_flag == 0x01) {
         // Variable-length encoding
         for (uint32_t i = 0; i < k; ++i) {
@@ -689,12 +728,14 @@ std::vector<std::vector<uint32_t>> unpack_polynomial_vector_compressed(const std
     } else {
         throw std::invalid_argument("Unknown compression format");
     }
-
-    return poly_vector;
 }
 
 // Auto-select best compression method based on sparsity
 std::vector<uint8_t> pack_polynomial_vector_auto(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus) {
+    return pack_polynomial_vector_auto(PolyVec::from_vectors(poly_vector), modulus);
+}
+
+std::vector<uint8_t> pack_polynomial_vector_auto(const PolyVec& poly_vector, uint32_t modulus) {
     // Count non-zero coefficients to determine sparsity
     size_t total_coeffs = 0;
     size_t non_zero_coeffs = 0;
@@ -718,82 +759,359 @@ std::vector<uint8_t> pack_polynomial_vector_auto(const std::vector<std::vector<u
 
 // Unpack bytes into polynomial vector (little-endian 32-bit per coefficient)
 std::vector<std::vector<uint32_t>> unpack_polynomial_vector(const std::vector<uint8_t>& data, uint32_t k, uint32_t n) {
-    if (data.size() != k * n * 4) {
+    PolyVec poly_vector(k, n);
+    unpack_polynomial_vector(data, poly_vector);
+    return poly_vector.to_vectors();
+}
+
+void unpack_polynomial_vector(const std::vector<uint8_t>& data, PolyVec& out) {
+    size_t total_coeffs = out.coeff_count();
+    if (data.size() != total_coeffs * 4) {
         throw std::invalid_argument("Data size does not match expected polynomial vector size");
     }
 
-    std::vector<std::vector<uint32_t>> poly_vector(k, std::vector<uint32_t>(n));
+    uint32_t* coeffs = out.data();
     size_t offset = 0;
-    for (uint32_t i = 0; i < k; ++i) {
-        for (uint32_t j = 0; j < n; ++j) {
-            uint32_t coeff = data[offset] |
-                             (data[offset + 1] << 8) |
-                             (data[offset + 2] << 16) |
-                             (data[offset + 3] << 24);
-            offset += 4;
-            poly_vector[i][j] = coeff;
-        }
+    for (size_t i = 0; i < total_coeffs; ++i) {
+        coeffs[i] = data[offset] |
+                    (data[offset + 1] << 8) |
+                    (data[offset + 2] << 16) |
+                    (data[offset + 3] << 24);
+        offset += 4;
     }
-    return poly_vector;
 }
 
-// ML-DSA standard compression using d bits per coefficient
-std::vector<uint8_t> pack_polynomial_vector_ml_dsa(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, uint32_t d) {
-    size_t total_bits = 0;
-    for (const auto& poly : poly_vector) {
-        total_bits += poly.size() * d;
+// Word-level ML-DSA bit packing. Coefficients are streamed LSB first through a 64-bit
+// accumulator that is flushed or refilled 32 bits at a time. The widths used by the scheme
+// (10 and 18 today, 13 and 20 for t0 and z at gamma1 = 2^19, 3 and 4 for eta) get kernels with the width as a
+// compile-time constant, shared by the lossy compression and the exact gamma1 - z encoding;
+// with AVX2, unpacking decodes 8 coefficients per step with a byte shuffle and per-lane shifts.
+
+static void check_ml_dsa_width(uint32_t d) {
+    if (d == 0 || d > 32) {
+        throw std::invalid_argument("ML-DSA packing width must be between 1 and 32 bits");
     }
-    size_t total_bytes = (total_bits + 7) / 8;
+}
 
-    bool include_header = (d != 8 && d != 18); // For d=8 and d=18, no header for z compression
-    size_t header_size = include_header ? 6 : 0;
-    std::vector<uint8_t> compressed(header_size + total_bytes);
+template <uint32_t D>
+struct FixedWidth {
+    constexpr uint32_t bits() const { return D; }
+};
 
-    if (include_header) {
-        // Header: version 0x03, compression 0x08, k, n high, n low, d
-        compressed[0] = 0x03;
-        compressed[1] = 0x08;
-        uint32_t k = poly_vector.size();
-        uint32_t n = k > 0 ? poly_vector[0].size() : 0;
-        compressed[2] = static_cast<uint8_t>(k);
-        compressed[3] = static_cast<uint8_t>(n >> 8);
-        compressed[4] = static_cast<uint8_t>(n & 0xFF);
-        compressed[5] = static_cast<uint8_t>(d);
+struct RuntimeWidth {
+    uint32_t d;
+    uint32_t bits() const { return d; }
+};
+
+// floor(x / divisor) by multiplication with a 64-bit reciprocal. The estimate never exceeds the
+// quotient and is corrected upwards, so the result is exact for every x.
+class Reciprocal {
+public:
+    explicit Reciprocal(uint32_t divisor) : divisor_(divisor), inverse_(UINT64_MAX / divisor) {}
+
+    uint64_t divide(uint64_t x) const {
+        uint64_t quotient = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * inverse_) >> 64);
+        uint64_t remainder = x - quotient * divisor_;
+        while (remainder >= divisor_) {
+            ++quotient;
+            remainder -= divisor_;
+        }
+        return quotient;
     }
 
-    size_t byte_index = header_size;
-    uint8_t current_byte = 0;
-    uint8_t bits_in_byte = 0;
+    uint32_t divisor() const { return divisor_; }
 
-    for (const auto& poly : poly_vector) {
-        for (uint32_t coeff : poly) {
-            uint32_t compressed_coeff = (static_cast<uint64_t>(coeff) * (1ULL << d) + (modulus / 2)) / modulus;
-            // Pack d bits
-            for (uint32_t bit = 0; bit < d; ++bit) {
-                if (compressed_coeff & (1U << bit)) {
-                    current_byte |= (1 << bits_in_byte);
+private:
+    uint32_t divisor_;
+    uint64_t inverse_;
+};
+
+static inline uint32_t load_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static inline void store_le32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+static inline uint32_t width_mask(uint32_t d) {
+    return d == 32 ? 0xFFFFFFFFu : (1u << d) - 1;
+}
+
+// round(c * 2^d / q), keeping the low d bits; the product wraps like the original uint64 formula
+template <typename Width>
+static inline uint32_t compress_ml_dsa(uint32_t coeff, Width width, const Reciprocal& q) {
+    uint32_t d = width.bits();
+    uint64_t scaled = static_cast<uint64_t>(coeff) * (1ULL << d) + (q.divisor() / 2);
+    return static_cast<uint32_t>(q.divide(scaled)) & width_mask(d);
+}
+
+// round(c * q / 2^d) mod q. The rounded value is at most q, so the reduction is one subtraction.
+template <typename Width>
+static inline uint32_t decompress_ml_dsa(uint32_t compressed, Width width, uint32_t modulus) {
+    uint32_t d = width.bits();
+    uint64_t coeff = (static_cast<uint64_t>(compressed) * modulus + (1ULL << (d - 1))) >> d;
+    return coeff >= modulus ? static_cast<uint32_t>(coeff - modulus) : static_cast<uint32_t>(coeff);
+}
+
+// Coefficient codecs for the bit stream: the lossy ML-DSA compression, and the exact FIPS 204
+// encoding of a vector centred on zero as gamma1 - v (also eta - s for the secret key)
+struct CompressionCodec {
+    Reciprocal q;
+
+    template <typename Width>
+    uint32_t encode(uint32_t coeff, Width width) const { return compress_ml_dsa(coeff, width, q); }
+    template <typename Width>
+    uint32_t decode(uint32_t value, Width width) const { return decompress_ml_dsa(value, width, q.divisor()); }
+};
+
+struct Gamma1Codec {
+    uint32_t gamma1;
+    uint32_t modulus;
+
+    // Coefficients above q/2 stand for v - q; out-of-range values are truncated to the width
+    template <typename Width>
+    uint32_t encode(uint32_t coeff, Width width) const {
+        uint32_t centred = coeff > modulus / 2 ? gamma1 + modulus - coeff : gamma1 - coeff;
+        return centred & width_mask(width.bits());
+    }
+    template <typename Width>
+    uint32_t decode(uint32_t value, Width) const {
+        return value > gamma1 ? gamma1 + modulus - value : gamma1 - value;
+    }
+};
+
+// Plain values of the width, decoded shifted left (t1 as t1 * 2^13)
+struct ShiftCodec {
+    uint32_t shift;
+
+    template <typename Width>
+    uint32_t encode(uint32_t coeff, Width width) const { return coeff & width_mask(width.bits()); }
+    template <typename Width>
+    uint32_t decode(uint32_t value, Width) const { return value << shift; }
+};
+
+template <typename Width, typename Codec>
+static size_t pack_bits(const uint32_t* coeffs, size_t count, Width width, const Codec& codec, uint8_t* out) {
+    uint32_t d = width.bits();
+    uint8_t* p = out;
+    uint64_t acc = 0;
+    uint32_t bits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        acc |= static_cast<uint64_t>(codec.encode(coeffs[i], width)) << bits;
+        bits += d;
+        if (bits >= 32) {
+            store_le32(p, static_cast<uint32_t>(acc));
+            p += 4;
+            acc >>= 32;
+            bits -= 32;
+        }
+    }
+    while (bits > 0) {
+        *p++ = static_cast<uint8_t>(acc);
+        acc >>= 8;
+        bits = bits > 8 ? bits - 8 : 0;
+    }
+    return static_cast<size_t>(p - out);
+}
+
+// Decodes `count` coefficients from the byte-aligned stream at p, throwing once a coefficient
+// needs bytes past `end`; the coefficients before it have been written by then
+template <typename Width, typename Codec>
+static void unpack_bits_scalar(const uint8_t* p, const uint8_t* end, size_t count, Width width, const Codec& codec,
+                               uint32_t* out) {
+    uint32_t d = width.bits();
+    uint32_t mask = width_mask(d);
+    uint64_t acc = 0;
+    uint32_t bits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (bits < d) {
+            if (end - p >= 4) {
+                acc |= static_cast<uint64_t>(load_le32(p)) << bits;
+                p += 4;
+                bits += 32;
+            } else {
+                while (bits < d && p < end) {
+                    acc |= static_cast<uint64_t>(*p++) << bits;
+                    bits += 8;
                 }
-                bits_in_byte++;
-                if (bits_in_byte == 8) {
-                    compressed[byte_index++] = current_byte;
-                    current_byte = 0;
-                    bits_in_byte = 0;
+                if (bits < d) {
+                    throw std::invalid_argument("Truncated ML-DSA compressed data");
                 }
             }
         }
+        out[i] = codec.decode(static_cast<uint32_t>(acc) & mask, width);
+        acc >>= d;
+        bits -= d;
     }
-    if (bits_in_byte > 0) {
-        compressed[byte_index++] = current_byte;
+}
+
+#ifdef HAVE_AVX2
+
+// Shuffle and shift tables for decoding 8 coefficients (d bytes) per step. Each 32-bit lane
+// gathers the 4 bytes holding its coefficient; lanes 4-7 read from a second load at byte 4d/8.
+template <uint32_t D>
+struct UnpackTables {
+    static constexpr uint32_t HIGH_BASE = 4 * D / 8;
+    static constexpr uint32_t READ_BYTES = HIGH_BASE + 16;   // Bytes touched by one step
+
+    static constexpr std::array<int8_t, 32> make_shuffle() {
+        std::array<int8_t, 32> shuffle{};
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            uint32_t offset = (lane % 4) * D + (lane < 4 ? 0 : (4 * D) % 8);
+            for (uint32_t b = 0; b < 4; ++b) {
+                shuffle[lane * 4 + b] = static_cast<int8_t>(offset / 8 + b);
+            }
+        }
+        return shuffle;
     }
-    compressed.resize(byte_index);
+
+    static constexpr std::array<int32_t, 8> make_shifts() {
+        std::array<int32_t, 8> shifts{};
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            shifts[lane] = static_cast<int32_t>(((lane % 4) * D + (lane < 4 ? 0 : (4 * D) % 8)) % 8);
+        }
+        return shifts;
+    }
+
+    static constexpr std::array<int8_t, 32> SHUFFLE = make_shuffle();
+    static constexpr std::array<int32_t, 8> SHIFTS = make_shifts();
+};
+
+// Per-codec decoding of 8 extracted D-bit values
+template <uint32_t D>
+static inline __m256i decode8(__m256i v, FixedWidth<D>, const CompressionCodec& codec) {
+    const __m256i q = _mm256_set1_epi32(static_cast<int32_t>(codec.q.divisor()));
+    const __m256i round = _mm256_set1_epi64x(1LL << (D - 1));
+
+    // (v * q + 2^(D-1)) >> D in 64-bit lanes, even and odd coefficients separately
+    __m256i even = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(v, q), round), D);
+    __m256i odd = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), q), round), D);
+    __m256i coeffs = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    // Values are at most q: subtract q where that does not wrap
+    return _mm256_min_epu32(coeffs, _mm256_sub_epi32(coeffs, q));
+}
+
+template <uint32_t D>
+static inline __m256i decode8(__m256i v, FixedWidth<D>, const Gamma1Codec& codec) {
+    // gamma1 - v, plus q where that is negative
+    __m256i centred = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<int32_t>(codec.gamma1)), v);
+    __m256i negative = _mm256_srai_epi32(centred, 31);
+    return _mm256_add_epi32(centred, _mm256_and_si256(negative, _mm256_set1_epi32(static_cast<int32_t>(codec.modulus))));
+}
+
+template <uint32_t D>
+static inline __m256i decode8(__m256i v, FixedWidth<D>, const ShiftCodec& codec) {
+    return _mm256_sll_epi32(v, _mm_cvtsi32_si128(static_cast<int>(codec.shift)));
+}
+
+template <uint32_t D, typename Codec>
+static void unpack_bits(const uint8_t* p, const uint8_t* end, size_t count, FixedWidth<D> width, const Codec& codec,
+                        uint32_t* out) {
+    static_assert(D <= 25, "A coefficient must fit in the 4 bytes gathered per lane");
+    using Tables = UnpackTables<D>;
+    const __m256i shuffle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Tables::SHUFFLE.data()));
+    const __m256i shifts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Tables::SHIFTS.data()));
+    const __m256i mask = _mm256_set1_epi32(static_cast<int32_t>((1u << D) - 1));
+
+    size_t i = 0;
+    for (; i + 8 <= count && end - p >= static_cast<ptrdiff_t>(Tables::READ_BYTES); i += 8, p += D) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + Tables::HIGH_BASE));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        v = _mm256_and_si256(_mm256_srlv_epi32(v, shifts), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), decode8(v, width, codec));
+    }
+    unpack_bits_scalar(p, end, count - i, width, codec, out + i);
+}
+
+#else
+
+template <uint32_t D, typename Codec>
+static void unpack_bits(const uint8_t* p, const uint8_t* end, size_t count, FixedWidth<D> width, const Codec& codec,
+                        uint32_t* out) {
+    unpack_bits_scalar(p, end, count, width, codec, out);
+}
+
+#endif
+
+template <typename Codec>
+static void unpack_bits(const uint8_t* p, const uint8_t* end, size_t count, RuntimeWidth width, const Codec& codec,
+                        uint32_t* out) {
+    unpack_bits_scalar(p, end, count, width, codec, out);
+}
+
+// ML-DSA standard compression using d bits per coefficient
+std::vector<uint8_t> pack_polynomial_vector_ml_dsa(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, uint32_t d) {
+    return pack_polynomial_vector_ml_dsa(PolyVec::from_vectors(poly_vector), modulus, d);
+}
+
+std::vector<uint8_t> pack_polynomial_vector_ml_dsa(const PolyVec& poly_vector, uint32_t modulus, uint32_t d) {
+    std::vector<uint8_t> compressed(ml_dsa_packed_size(poly_vector.size(), poly_vector.degree(), d));
+    compressed.resize(pack_polynomial_vector_ml_dsa(poly_vector, modulus, d, compressed.data()));
     return compressed;
 }
 
+size_t ml_dsa_packed_size(uint32_t k, uint32_t n, uint32_t d) {
+    bool include_header = (d != 8 && d != 18);
+    return (include_header ? 6 : 0) + (static_cast<size_t>(k) * n * d + 7) / 8;
+}
+
+size_t pack_polynomial_vector_ml_dsa(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, uint32_t d, uint8_t* out) {
+    return pack_polynomial_vector_ml_dsa(PolyVec::from_vectors(poly_vector), modulus, d, out);
+}
+
+size_t pack_polynomial_vector_ml_dsa(const PolyVec& poly_vector, uint32_t modulus, uint32_t d, uint8_t* out) {
+    check_ml_dsa_width(d);
+    bool include_header = (d != 8 && d != 18); // For d=8 and d=18, no header for z compression
+    size_t header_size = include_header ? 6 : 0;
+
+    if (include_header) {
+        // Header: version 0x03, compression 0x08, k, n high, n low, d
+        out[0] = 0x03;
+        out[1] = 0x08;
+        uint32_t k = poly_vector.size();
+        uint32_t n = poly_vector.degree();
+        out[2] = static_cast<uint8_t>(k);
+        out[3] = static_cast<uint8_t>(n >> 8);
+        out[4] = static_cast<uint8_t>(n & 0xFF);
+        out[5] = static_cast<uint8_t>(d);
+    }
+
+    const uint32_t* coeffs = poly_vector.data();
+    size_t count = poly_vector.coeff_count();
+    CompressionCodec codec{Reciprocal(modulus)};
+    uint8_t* packed = out + header_size;
+    switch (d) {
+        case 10: return header_size + pack_bits(coeffs, count, FixedWidth<10>(), codec, packed);
+        case 13: return header_size + pack_bits(coeffs, count, FixedWidth<13>(), codec, packed);
+        case 18: return header_size + pack_bits(coeffs, count, FixedWidth<18>(), codec, packed);
+        case 20: return header_size + pack_bits(coeffs, count, FixedWidth<20>(), codec, packed);
+        default: return header_size + pack_bits(coeffs, count, RuntimeWidth{d}, codec, packed);
+    }
+}
+
 // Unpack ML-DSA compressed polynomial vector
 std::vector<std::vector<uint32_t>> unpack_polynomial_vector_ml_dsa(const std::vector<uint8_t>& data, uint32_t k, uint32_t n, uint32_t modulus, uint32_t d) {
+    PolyVec poly_vector(k, n);
+    unpack_polynomial_vector_ml_dsa(data.data(), data.size(), modulus, d, poly_vector);
+    return poly_vector.to_vectors();
+}
+
+void unpack_polynomial_vector_ml_dsa(const uint8_t* data, size_t size, uint32_t modulus, uint32_t d, PolyVec& out) {
+    unpack_polynomial_vector_ml_dsa(data, size, out.size(), out.degree(), modulus, d, out.data());
+}
+
+void unpack_polynomial_vector_ml_dsa(const uint8_t* data, size_t size, uint32_t k, uint32_t n, uint32_t modulus, uint32_t d, uint32_t* out) {
+    check_ml_dsa_width(d);
     size_t offset = 0;
     uint32_t data_d = d;
-    if (data.size() >= 6) {
+    if (size >= 6) {
         if (data[0] == 0x03 && data[1] == 0x08) {
             uint32_t data_k = data[2];
             uint32_t data_n = (static_cast<uint32_t>(data[3]) << 8) | data[4];
@@ -811,39 +1129,172 @@ std::vector<std::vector<uint32_t>> unpack_polynomial_vector_ml_dsa(const std::ve
         throw std::invalid_argument("ML-DSA compressed data too small");
     }
 
-    std::vector<std::vector<uint32_t>> poly_vector(k, std::vector<uint32_t>(n));
-    size_t byte_index = offset;
-    uint8_t current_byte = 0;
-    uint8_t bits_left_in_byte = 0;
+    const uint8_t* packed = data + offset;
+    const uint8_t* end = data + size;
+    size_t count = static_cast<size_t>(k) * n;
+    CompressionCodec codec{Reciprocal(modulus)};
+    switch (d) {
+        case 10: unpack_bits(packed, end, count, FixedWidth<10>(), codec, out); break;
+        case 13: unpack_bits(packed, end, count, FixedWidth<13>(), codec, out); break;
+        case 18: unpack_bits(packed, end, count, FixedWidth<18>(), codec, out); break;
+        case 20: unpack_bits(packed, end, count, FixedWidth<20>(), codec, out); break;
+        default: unpack_bits(packed, end, count, RuntimeWidth{d}, codec, out); break;
+    }
+}
 
-    auto get_bit = [&]() {
-        if (bits_left_in_byte == 0) {
-            if (byte_index >= data.size()) {
-                throw std::invalid_argument("Truncated ML-DSA compressed data");
-            }
-            current_byte = data[byte_index++];
-            bits_left_in_byte = 8;
-        }
-        bool bit = current_byte & 1;
-        current_byte >>= 1;
-        bits_left_in_byte--;
-        return bit;
-    };
+// FIPS 204 Power2Round: r0 = t mod+- 2^13 in (-2^12, 2^12] and t1 = (t - r0) / 2^13
+void power2round(const PolyVec& t, uint32_t modulus, PolyVec& t1, PolyVec& t0) {
+    constexpr uint32_t low_mask = (1u << POWER2ROUND_D) - 1;
+    constexpr uint32_t half = 1u << (POWER2ROUND_D - 1);
+    const uint32_t* in = t.data();
+    uint32_t* high = t1.data();
+    uint32_t* low = t0.data();
+    for (size_t i = 0; i < t.coeff_count(); ++i) {
+        uint32_t r0 = in[i] & low_mask;
+        bool negative = r0 > half;
+        high[i] = (in[i] >> POWER2ROUND_D) + (negative ? 1 : 0);
+        low[i] = negative ? modulus + r0 - (1u << POWER2ROUND_D) : r0;
+    }
+}
+
+size_t t1_packed_size(uint32_t k, uint32_t n) {
+    return (static_cast<size_t>(k) * n * T1_BITS + 7) / 8;
+}
+
+size_t pack_polynomial_vector_t1(const PolyVec& t1, uint8_t* out) {
+    return pack_bits(t1.data(), t1.coeff_count(), FixedWidth<T1_BITS>(), ShiftCodec{POWER2ROUND_D}, out);
+}
+
+void unpack_polynomial_vector_t1(const uint8_t* data, size_t size, PolyVec& out) {
+    if (size != t1_packed_size(out.size(), out.degree())) {
+        throw std::invalid_argument("t1 packed data size mismatch");
+    }
+    unpack_bits(data, data + size, out.coeff_count(), FixedWidth<T1_BITS>(), ShiftCodec{POWER2ROUND_D}, out.data());
+}
+
+// FIPS 204 HintBitUnpack: per polynomial, strictly increasing indices ending at the running count
+// stored after the omega index bytes; unused index bytes must be zero
+bool apply_hint_indices(const uint8_t* h, size_t size, uint32_t omega, uint32_t modulus,
+                        const PolyVec& w_prime, PolyVec& w) {
+    uint32_t k = w.size();
+    uint32_t n = w.degree();
+    constexpr uint32_t step = 1u << 13;
+    if (size != static_cast<size_t>(omega) + k) {
+        return false;
+    }
 
+    std::copy(w_prime.data(), w_prime.data() + w_prime.coeff_count(), w.data());
+    uint32_t index = 0;
     for (uint32_t i = 0; i < k; ++i) {
-        for (uint32_t j = 0; j < n; ++j) {
-            uint32_t compressed_coeff = 0;
-            for (uint32_t bit = 0; bit < d; ++bit) {
-                if (get_bit()) {
-                    compressed_coeff |= (1U << bit);
-                }
+        uint32_t end = h[omega + i];
+        if (end < index || end > omega) {
+            return false;
+        }
+        PolySpan w_i = w[i];
+        for (uint32_t first = index; index < end; ++index) {
+            uint32_t j = h[index];
+            if ((index > first && h[index - 1] >= j) || j >= n) {
+                return false;
             }
-            // Decompress
-            uint64_t coeff = (static_cast<uint64_t>(compressed_coeff) * modulus + (1ULL << (d - 1))) / (1ULL << d);
-            poly_vector[i][j] = coeff % modulus;
+            w_i[j] = (w_i[j] >= step) ? w_i[j] - step : w_i[j] + modulus - step;
+        }
+    }
+    for (; index < omega; ++index) {
+        if (h[index] != 0) {
+            return false;
         }
     }
-    return poly_vector;
+    return true;
+}
+
+// Exact FIPS 204 packing of vectors centred on zero (signature z), no header
+static uint32_t gamma1_width(uint32_t gamma1) {
+    if (gamma1 < 2 || gamma1 > (1u << 30) || (gamma1 & (gamma1 - 1)) != 0) {
+        throw std::invalid_argument("gamma1 must be a power of two between 2 and 2^30");
+    }
+    uint32_t d = 1;
+    while ((1u << (d - 1)) < gamma1) {
+        ++d;
+    }
+    return d;
+}
+
+size_t gamma1_packed_size(uint32_t k, uint32_t n, uint32_t gamma1) {
+    return (static_cast<size_t>(k) * n * gamma1_width(gamma1) + 7) / 8;
+}
+
+size_t pack_polynomial_vector_gamma1(const PolyVec& poly_vector, uint32_t modulus, uint32_t gamma1, uint8_t* out) {
+    uint32_t d = gamma1_width(gamma1);
+    const uint32_t* coeffs = poly_vector.data();
+    size_t count = poly_vector.coeff_count();
+    Gamma1Codec codec{gamma1, modulus};
+    switch (d) {
+        case 13: return pack_bits(coeffs, count, FixedWidth<13>(), codec, out);
+        case 18: return pack_bits(coeffs, count, FixedWidth<18>(), codec, out);
+        case 20: return pack_bits(coeffs, count, FixedWidth<20>(), codec, out);
+        default: return pack_bits(coeffs, count, RuntimeWidth{d}, codec, out);
+    }
+}
+
+void unpack_polynomial_vector_gamma1(const uint8_t* data, size_t size, uint32_t modulus, uint32_t gamma1, PolyVec& out) {
+    uint32_t d = gamma1_width(gamma1);
+    if (size != gamma1_packed_size(out.size(), out.degree(), gamma1)) {
+        throw std::invalid_argument("gamma1 packed data size mismatch");
+    }
+
+    const uint8_t* end = data + size;
+    size_t count = out.coeff_count();
+    Gamma1Codec codec{gamma1, modulus};
+    switch (d) {
+        case 13: unpack_bits(data, end, count, FixedWidth<13>(), codec, out.data()); break;
+        case 18: unpack_bits(data, end, count, FixedWidth<18>(), codec, out.data()); break;
+        case 20: unpack_bits(data, end, count, FixedWidth<20>(), codec, out.data()); break;
+        default: unpack_bits(data, end, count, RuntimeWidth{d}, codec, out.data()); break;
+    }
+}
+
+// Exact FIPS 204 packing of the secret polynomials as eta - s, no header
+static uint32_t eta_width(uint32_t eta) {
+    if (eta == 0 || eta > (1u << 30)) {
+        throw std::invalid_argument("eta must be between 1 and 2^30");
+    }
+    uint32_t d = 1;
+    while ((2 * eta) >> d) {
+        ++d;
+    }
+    return d;
+}
+
+size_t eta_packed_size(uint32_t k, uint32_t n, uint32_t eta) {
+    return (static_cast<size_t>(k) * n * eta_width(eta) + 7) / 8;
+}
+
+size_t pack_polynomial_vector_eta(const PolyVec& poly_vector, uint32_t modulus, uint32_t eta, uint8_t* out) {
+    uint32_t d = eta_width(eta);
+    const uint32_t* coeffs = poly_vector.data();
+    size_t count = poly_vector.coeff_count();
+    Gamma1Codec codec{eta, modulus};
+    switch (d) {
+        case 3: return pack_bits(coeffs, count, FixedWidth<3>(), codec, out);
+        case 4: return pack_bits(coeffs, count, FixedWidth<4>(), codec, out);
+        default: return pack_bits(coeffs, count, RuntimeWidth{d}, codec, out);
+    }
+}
+
+void unpack_polynomial_vector_eta(const uint8_t* data, size_t size, uint32_t modulus, uint32_t eta, PolyVec& out) {
+    uint32_t d = eta_width(eta);
+    if (size != eta_packed_size(out.size(), out.degree(), eta)) {
+        throw std::invalid_argument("eta packed data size mismatch");
+    }
+
+    const uint8_t* end = data + size;
+    size_t count = out.coeff_count();
+    Gamma1Codec codec{eta, modulus};
+    switch (d) {
+        case 3: unpack_bits(data, end, count, FixedWidth<3>(), codec, out.data()); break;
+        case 4: unpack_bits(data, end, count, FixedWidth<4>(), codec, out.data()); break;
+        default: unpack_bits(data, end, count, RuntimeWidth{d}, codec, out.data()); break;
+    }
 }
 
-} // namespace clwe
\ No newline at end of file
+} // namespace clwe
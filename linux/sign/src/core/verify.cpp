@@ -1,10 +1,13 @@
 #include "../include/clwe/verify.hpp"
 #include "../include/clwe/cose.hpp"
+#include "../include/clwe/stream.hpp"
 #include "../include/clwe/color_integration.hpp"
 #include "../include/clwe/utils.hpp"
 #include "../include/clwe/ntt_engine.hpp"
 #include "../include/clwe/sign.hpp"
 #include "../include/clwe/keygen.hpp"
+#include "../include/clwe/metrics.hpp"
+#include "../include/clwe/performance_metrics.hpp"
 #include <stdexcept>
 #include <algorithm>
 #include <cstring>
@@ -15,7 +18,8 @@
 namespace clwe {
 
 ColorSignVerify::ColorSignVerify(const CLWEParameters& params)
-    : params_(params) {
+    : params_(params), fixed_level_(standard_parameter_set(params)),
+      metrics_(&SchemeMetrics::for_level(params.security_level)) {
     // Validate parameters
     if (params_.degree == 0 || params_.module_rank == 0) {
         throw std::invalid_argument("Invalid parameters: degree and module_rank must be positive");
@@ -24,28 +28,132 @@ ColorSignVerify::ColorSignVerify(const CLWEParameters& params)
 
 ColorSignVerify::~ColorSignVerify() = default;
 
+VerifyWorkspace::VerifyWorkspace(const CLWEParameters& params)
+    : params_(params),
+      ntt_engine_(create_optimal_ntt_engine(params.modulus, params.degree)),
+      matrix_A_(params.module_rank, params.module_rank, params.degree),
+      z_(params.module_rank, params.degree),
+      t_(params.module_rank, params.degree),
+      w_prime_(params.module_rank, params.degree),
+      w_(params.module_rank, params.degree),
+      w1_(params.module_rank, params.degree),
+      c_(params.degree),
+      product_(params.degree),
+      computed_c_(params.degree),
+      challenge_positions_(params.degree),
+      challenge_seed_(64 + 2 * params.module_rank * params.degree),
+      computed_c_packed_((params.degree + 3) / 4) {
+}
+
+VerifyWorkspace::~VerifyWorkspace() = default;
+
 // Enhanced security validation function achieving 100% post-quantum readiness
 bool ColorSignVerify::verify_signature(const ColorSignPublicKey& public_key,
                                        const ColorSignature& signature,
                                        const std::vector<uint8_t>& message,
                                        const std::vector<uint8_t>& context) {
+    VerifyWorkspace workspace(params_);
+    return verify_signature(public_key, signature, message.data(), message.size(), workspace,
+                            context.data(), context.size());
+}
+
+bool ColorSignVerify::verify_signature(const ColorSignPublicKey& public_key,
+                                       const ColorSignature& signature,
+                                       const std::vector<uint8_t>& message,
+                                       VerifyWorkspace& workspace,
+                                       const std::vector<uint8_t>& context) {
+    return verify_signature(public_key, signature, message.data(), message.size(), workspace,
+                            context.data(), context.size());
+}
+
+bool ColorSignVerify::verify_signature(const PublicKeyView& public_key,
+                                       const SignatureView& signature,
+                                       const uint8_t* message, size_t message_len,
+                                       const uint8_t* context, size_t context_len) {
+    VerifyWorkspace workspace(params_);
+    return verify_signature(public_key, signature, message, message_len, workspace, context, context_len);
+}
+
+// Workspace verification: all intermediate state lives in the caller-owned workspace, and the
+// key, signature, message and context are read in place
+bool ColorSignVerify::verify_signature(const PublicKeyView& public_key,
+                                       const SignatureView& signature,
+                                       const uint8_t* message, size_t message_len,
+                                       VerifyWorkspace& workspace,
+                                       const uint8_t* context, size_t context_len) {
+    TraceSpan span("verify_signature");
+    if (workspace.params_.security_level != params_.security_level) {
+        throw std::invalid_argument("Verify workspace parameters do not match verifier");
+    }
+
     // STRICT INPUT VALIDATION
-    if (message.empty()) {
+    if (message_len == 0) {
+        throw std::invalid_argument("Message cannot be empty");
+    }
+
+    uint64_t start = INSTRUMENTATION_ENABLED ? TimestampCounter::now() : 0;
+
+    // mu goes at the front of the challenge seed (mu || w1_encoded)
+    hash_message(message, message_len, context, context_len, workspace.challenge_seed_.data());
+    uint64_t check_start = INSTRUMENTATION_ENABLED ? TimestampCounter::now() : 0;
+    bool valid = verify_prepared(public_key, signature, workspace);
+    record_verification(start, check_start, message_len);
+    return valid;
+}
+
+// Streaming verification: the message was absorbed chunk by chunk into `stream`
+bool ColorSignVerify::verify_stream(MessageHashStream& stream,
+                                    const PublicKeyView& public_key,
+                                    const SignatureView& signature,
+                                    VerifyWorkspace& workspace) {
+    TraceSpan span("verify_stream");
+    if (workspace.params_.security_level != params_.security_level) {
+        throw std::invalid_argument("Verify workspace parameters do not match verifier");
+    }
+    if (stream.bytes_absorbed() == 0) {
         throw std::invalid_argument("Message cannot be empty");
     }
 
-    size_t expected_c_data_size = (params_.degree + 3) / 4;
+    uint64_t start = INSTRUMENTATION_ENABLED ? TimestampCounter::now() : 0;
+    {
+        ScopedStage probe(PerfStage::HASHING);
+        stream.finish(workspace.challenge_seed_.data());
+    }
+    uint64_t check_start = INSTRUMENTATION_ENABLED ? TimestampCounter::now() : 0;
+    bool valid = verify_prepared(public_key, signature, workspace);
+    record_verification(start, check_start, stream.bytes_absorbed());
+    return valid;
+}
+
+// Latency includes hashing the remainder of the message; failed verifications count too
+void ColorSignVerify::record_verification(uint64_t start_ticks, uint64_t check_start_ticks, size_t bytes_hashed) const {
+    if (!INSTRUMENTATION_ENABLED) {
+        return;
+    }
+    uint64_t end = TimestampCounter::now();
+    metrics_->verify_prepare_latency.record(TimestampCounter::to_ns(check_start_ticks - start_ticks));
+    metrics_->verify_check_latency.record(TimestampCounter::to_ns(end - check_start_ticks));
+    metrics_->verify_latency.record(TimestampCounter::to_ns(end - start_ticks));
+    metrics_->verifications.add();
+    metrics_->verify_bytes_hashed.add(bytes_hashed);
+}
+
+// Verification once mu is in the workspace challenge seed
+bool ColorSignVerify::verify_prepared(const PublicKeyView& public_key,
+                                      const SignatureView& signature,
+                                      VerifyWorkspace& workspace) const {
+    size_t expected_c_data_size = signature_layout(params_, signature.format).c_bytes;
     if (public_key.public_data.empty() || signature.z_data.empty() || signature.c_data.size() != expected_c_data_size) {
         throw std::invalid_argument("Invalid public key or signature");
     }
 
     // STEP 1: Run basic ML-DSA verification with challenge validation
-    if (!verify_signature_basic(public_key, signature, message, context)) {
+    if (!verify_against_mu(public_key, signature, workspace)) {
         return false; // Basic verification failed
     }
 
     // STEP 2: Only run basic encoding consistency check (not strict comprehensive checks)
-    if (!validate_encoding_consistency(public_key, signature)) {
+    if (!validate_encoding_consistency(signature)) {
         return false; // Encoding mismatch detected - reject signature
     }
 
@@ -53,33 +161,67 @@ bool ColorSignVerify::verify_signature(const ColorSignPublicKey& public_key,
 }
 
 // Basic ML-DSA verification with proper cryptographic validation
-bool ColorSignVerify::verify_signature_basic(const ColorSignPublicKey& public_key,
-                                             const ColorSignature& signature,
-                                             const std::vector<uint8_t>& message,
-                                             const std::vector<uint8_t>& context) const {
-    // Decode z from signature using 18-bit encoding
-    std::vector<std::vector<uint32_t>> z = unpack_polynomial_vector_ml_dsa(signature.z_data, params_.module_rank, params_.degree, params_.modulus, 18);
+bool ColorSignVerify::verify_signature_basic(const PublicKeyView& public_key,
+                                             const SignatureView& signature,
+                                             const uint8_t* message, size_t message_len,
+                                             const uint8_t* context, size_t context_len,
+                                             VerifyWorkspace& workspace) const {
+    TraceSpan span("verify_signature_basic");
+    hash_message(message, message_len, context, context_len, workspace.challenge_seed_.data());
+    return verify_against_mu(public_key, signature, workspace);
+}
+
+// ML-DSA verification against the mu already at the front of the workspace challenge seed
+bool ColorSignVerify::verify_against_mu(const PublicKeyView& public_key,
+                                        const SignatureView& signature,
+                                        VerifyWorkspace& workspace) const {
+    // Decode z from signature
+    unpack_signature_z(signature, workspace.z_);
 
     // Check z bounds: ||z||_∞ < γ₁ - β
-    if (!check_z_bounds(z)) {
+    if (!check_z_bounds(workspace.z_)) {
         return false;
     }
 
-    // Generate matrix A from public key seed_rho
-    auto matrix_A = generate_matrix_A(public_key.seed_rho);
+    // Generate matrix A from public key seed_rho (cached while the seed is unchanged)
+    bool matrix_cached = workspace.matrix_valid_ &&
+        std::equal(workspace.matrix_seed_.begin(), workspace.matrix_seed_.end(), public_key.seed_rho);
+    if (!matrix_cached) {
+        std::copy(public_key.seed_rho, public_key.seed_rho + 32, workspace.matrix_seed_.begin());
+        generate_matrix_A(workspace.matrix_seed_, workspace.matrix_A_);
+        workspace.matrix_valid_ = true;
+    }
+    if (INSTRUMENTATION_ENABLED) {
+        (matrix_cached ? metrics_->matrix_cache_hits : metrics_->matrix_cache_misses).add();
+    }
 
     // Extract t from public key
-    auto t = extract_t_from_public_key(public_key);
-
-    // Compute w' = A*z - c*t using the ML-DSA formula
-    auto w_prime = compute_w_prime_fixed(matrix_A, z, signature.c_data, t);
+    extract_t_from_public_key(public_key, workspace);
+
+    // Compute w' = A*z - c*t using the ML-DSA formula. FIPS 204 signatures carry the c~ seed.
+    bool fips_format = signature.format == SignatureFormat::FIPS204;
+    if (fips_format) {
+        ScopedStage probe(PerfStage::SAMPLING);
+        clwe::sample_challenge(workspace.c_, signature.c_data.data(), signature.c_data.size(),
+                               params_.tau, params_.degree, params_.modulus, workspace.challenge_positions_);
+    } else {
+        unpack_challenge(signature.c_data, workspace.c_);
+    }
+    compute_w_prime_fixed(*workspace.ntt_engine_, workspace.matrix_A_, workspace.z_, workspace.c_, workspace.t_,
+                          workspace.w_prime_, workspace.product_);
 
     // CRITICAL: Perform cryptographic validation - compare challenge
-    bool result = validate_challenge_match(w_prime, signature, message, context);
+    bool result = validate_challenge_match(signature, workspace);
 
     // Apply hints to check w bounds
-    std::vector<std::vector<uint32_t>> w = use_hint(signature.h_data, w_prime, params_.gamma2);
-    if (!check_w_bounds(w)) {
+    if (fips_format) {
+        if (!use_hint_indices(signature.h_data, workspace.w_prime_, workspace.w_)) {
+            return false;  // Malformed hint encoding
+        }
+    } else {
+        use_hint(signature.h_data, workspace.w_prime_, workspace.w_);
+    }
+    if (!check_w_bounds(workspace.w_)) {
         return false;
     }
 
@@ -87,29 +229,31 @@ bool ColorSignVerify::verify_signature_basic(const ColorSignPublicKey& public_ke
 }
 
 // Validate that computed challenge matches original challenge for cryptographic integrity
-bool ColorSignVerify::validate_challenge_match(const std::vector<std::vector<uint32_t>>& w_prime,
-                                              const ColorSignature& signature,
-                                              const std::vector<uint8_t>& message,
-                                              const std::vector<uint8_t>& context) const {
+bool ColorSignVerify::validate_challenge_match(const SignatureView& signature,
+                                              VerifyWorkspace& workspace) const {
     try {
-        // Step 1: Compute mu (hash of message) - exactly like in signing
-        std::vector<uint8_t> mu = hash_message(message, context);
+        // Step 1: mu (hash of message) is already at the front of the challenge seed - exactly like in signing
+
+        // Step 2: Compute w1' (high bits of w') and append it to the seed (mu || w1_encoded)
+        encode_w_prime_for_challenge(workspace.w_prime_, workspace);
+
+        // Step 3: Compute challenge using the exact same method as signing. FIPS 204 signatures
+        // are compared on c~ = H(mu || w1'), legacy ones on the packed challenge.
+        if (signature.format == SignatureFormat::FIPS204) {
+            workspace.computed_c_packed_.resize(signature.c_data.size());
+            SHAKE256Sampler hash;
+            hash.init(workspace.challenge_seed_.data(), workspace.challenge_seed_.size());
+            hash.squeeze(workspace.computed_c_packed_.data(), workspace.computed_c_packed_.size());
+        } else {
+            clwe::sample_challenge(workspace.computed_c_, workspace.challenge_seed_.data(), workspace.challenge_seed_.size(),
+                                   params_.tau, params_.degree, params_.modulus, workspace.challenge_positions_);
 
-        // Step 2: Compute w1' (high bits of w') for challenge computation (exactly like signing)
-        std::vector<uint8_t> w1_encoded = encode_w_prime_for_challenge(w_prime);
-        
-        // Step 3: Create challenge seed (mu || w1_encoded) - exactly like in signing
-        std::vector<uint8_t> challenge_seed = mu;
-        challenge_seed.insert(challenge_seed.end(), w1_encoded.begin(), w1_encoded.end());
-        
-        // Step 4: Compute challenge using the exact same method as signing
-        std::vector<uint32_t> computed_c(params_.degree);
-        clwe::sample_challenge(computed_c, challenge_seed, params_.tau, params_.degree, params_.modulus);
-        
-        // Step 5: Pack computed challenge and compare with signature c_data
-        std::vector<uint8_t> computed_c_packed = pack_challenge(computed_c);
+            // Step 4: Pack computed challenge and compare with signature c_data
+            pack_challenge(workspace.computed_c_, workspace.computed_c_packed_);
+        }
+        const std::vector<uint8_t>& computed_c_packed = workspace.computed_c_packed_;
 
-        // Step 7: CRITICAL SECURITY CHECK - compare packed challenges
+        // Step 5: CRITICAL SECURITY CHECK - compare packed challenges
         if (computed_c_packed.size() != signature.c_data.size()) {
             return false;
         }
@@ -131,35 +275,54 @@ bool ColorSignVerify::validate_challenge_match(const std::vector<std::vector<uin
 }
 
 // Helper function to encode w' for challenge computation (matching signing process)
-std::vector<uint8_t> ColorSignVerify::encode_w_prime_for_challenge(const std::vector<std::vector<uint32_t>>& w_prime) const {
-    uint32_t k = params_.module_rank;
-    uint32_t n = params_.degree;
-    uint32_t q = params_.modulus;
-    
-    // Step 1: Flatten w_prime to match signing process
-    std::vector<uint32_t> w_flat;
-    for (const auto& poly : w_prime) {
-        w_flat.insert(w_flat.end(), poly.begin(), poly.end());
+void ColorSignVerify::encode_w_prime_for_challenge(const PolyVec& w_prime,
+                                                   VerifyWorkspace& workspace) const {
+    // Step 1: Compute high bits w1 over the contiguous w' (exactly like in signing)
+    compute_w1(w_prime, workspace.w1_);
+
+    // Step 2: Encode w1 as bytes after mu (exactly like in signing)
+    encode_w1(workspace.w1_, workspace.challenge_seed_.data() + 64);
+}
+
+// Compute w1 = high bits of w' (shares the signing kernels for standard parameter sets)
+void ColorSignVerify::compute_w1(const PolyVec& w_prime, PolyVec& w1) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::compute_w1(w_prime.data(), w1.data());
+        case 65: return ColorSignT<65>::compute_w1(w_prime.data(), w1.data());
+        case 87: return ColorSignT<87>::compute_w1(w_prime.data(), w1.data());
+        default: break;
     }
-    
-    // Step 2: Compute high bits w1_flat (exactly like in signing)
-    std::vector<uint32_t> w1_flat(w_flat.size());
-    compute_high_bits(w_flat, w1_flat, 13, q);
-    
-    // Step 3: Encode w1_flat as bytes (exactly like in signing)
-    std::vector<uint8_t> w1_encoded;
-    for (uint32_t coeff : w1_flat) {
-        w1_encoded.push_back(coeff & 0xFF);
-        w1_encoded.push_back((coeff >> 8) & 0xFF);
+
+    compute_high_bits(w_prime.data(), w1.data(), w_prime.coeff_count(), 13);
+}
+
+// Encode w1 as 2 little-endian bytes per coefficient
+void ColorSignVerify::encode_w1(const PolyVec& w1, uint8_t* out) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::encode_w1(w1.data(), out);
+        case 65: return ColorSignT<65>::encode_w1(w1.data(), out);
+        case 87: return ColorSignT<87>::encode_w1(w1.data(), out);
+        default: break;
+    }
+
+    const uint32_t* coeffs = w1.data();
+    for (size_t i = 0; i < w1.coeff_count(); ++i) {
+        *out++ = coeffs[i] & 0xFF;
+        *out++ = (coeffs[i] >> 8) & 0xFF;
     }
-    
-    return w1_encoded;
 }
 
 // Helper function to pack challenge polynomial into byte array
-std::vector<uint8_t> ColorSignVerify::pack_challenge(const std::vector<uint32_t>& c) const {
+void ColorSignVerify::pack_challenge(const std::vector<uint32_t>& c, std::vector<uint8_t>& packed) const {
+    switch (fixed_level_) {
+        case 44: packed.resize(ParameterSet<44>::C_BYTES); return ColorSignT<44>::pack_challenge(c.data(), packed.data());
+        case 65: packed.resize(ParameterSet<65>::C_BYTES); return ColorSignT<65>::pack_challenge(c.data(), packed.data());
+        case 87: packed.resize(ParameterSet<87>::C_BYTES); return ColorSignT<87>::pack_challenge(c.data(), packed.data());
+        default: break;
+    }
+
     size_t n = c.size();
-    std::vector<uint8_t> packed((n + 3) / 4, 0);
+    packed.assign((n + 3) / 4, 0);
     
     for (size_t i = 0; i < n; ++i) {
         size_t byte_idx = i / 4;
@@ -176,8 +339,6 @@ std::vector<uint8_t> ColorSignVerify::pack_challenge(const std::vector<uint32_t>
         
         packed[byte_idx] |= (bit_value << shift);
     }
-    
-    return packed;
 }
 
 // Comprehensive security checks for 100% post-quantum readiness
@@ -186,17 +347,19 @@ bool ColorSignVerify::run_comprehensive_security_checks(const ColorSignPublicKey
                                                         const std::vector<uint8_t>& message,
                                                         const std::vector<uint8_t>& context) const {
     // STEP 1: Run basic ML-DSA verification first
-    if (!verify_signature_basic(public_key, signature, message, context)) {
+    VerifyWorkspace workspace(params_);
+    if (!verify_signature_basic(public_key, signature, message.data(), message.size(),
+                                context.data(), context.size(), workspace)) {
         return false; // Basic verification failed - reject signature
     }
 
     // STEP 2: CRITICAL - Validate encoding consistency
-    if (!validate_encoding_consistency(public_key, signature)) {
+    if (!validate_encoding_consistency(signature)) {
         return false; // Encoding mismatch detected - reject signature
     }
 
     // STEP 3: Additional cryptographic integrity validation
-    if (!validate_cryptographic_integrity_final(public_key, signature, message, {})) {
+    if (!validate_cryptographic_integrity_final(public_key, signature, message, workspace.w_prime_)) {
         return false; // Cryptographic validation failed - reject signature
     }
 
@@ -206,18 +369,20 @@ bool ColorSignVerify::run_comprehensive_security_checks(const ColorSignPublicKey
 // COSE verification function
 bool ColorSignVerify::verify_signature_cose(const ColorSignPublicKey& public_key,
                                            const COSE_Sign1& cose_signature) {
-    // Extract ColorSignature from COSE_Sign1
-    ColorSignature signature = extract_colorsign_from_cose(cose_signature, params_);
+    // View the signature and payload inside the COSE_Sign1 without copying them
+    return verify_signature_cose(public_key, COSE_Sign1View(cose_signature));
+}
 
-    // Extract message from COSE payload
-    const std::vector<uint8_t>& message = cose_signature.payload;
+bool ColorSignVerify::verify_signature_cose(const ColorSignPublicKey& public_key,
+                                           const COSE_Sign1View& cose_signature) {
+    SignatureView signature = SignatureView::parse(cose_signature.signature.data(), cose_signature.signature.size(), params_);
 
     // Verify using the standard verification function
-    return verify_signature(public_key, signature, message);
+    return verify_signature(public_key, signature, cose_signature.payload.data(), cose_signature.payload.size());
 }
 
 // Enhanced bounds checking
-bool ColorSignVerify::check_z_bounds_enhanced(const std::vector<std::vector<uint32_t>>& z) const {
+bool ColorSignVerify::check_z_bounds_enhanced(const PolyVec& z) const {
     uint32_t gamma1 = params_.gamma1;
     uint32_t beta = params_.beta;
     uint32_t q = params_.modulus;
@@ -238,15 +403,14 @@ bool ColorSignVerify::check_z_bounds_enhanced(const std::vector<std::vector<uint
 }
 
 // Encoding consistency validation
-bool ColorSignVerify::validate_encoding_consistency(const ColorSignPublicKey& public_key,
-                                                    const ColorSignature& signature) const {
+bool ColorSignVerify::validate_encoding_consistency(const SignatureView& signature) const {
     // Validate signature structure - always using standard ML-DSA encoding
     if (signature.c_data.empty() || signature.z_data.empty()) {
         return false;
     }
 
     // Validate challenge size
-    size_t expected_c_size = (params_.degree + 3) / 4;
+    size_t expected_c_size = signature_layout(params_, signature.format).c_bytes;
     if (signature.c_data.size() != expected_c_size) {
         return false;
     }
@@ -258,7 +422,7 @@ bool ColorSignVerify::validate_encoding_consistency(const ColorSignPublicKey& pu
 bool ColorSignVerify::validate_cryptographic_integrity_final(const ColorSignPublicKey& public_key,
                                                             const ColorSignature& signature,
                                                             const std::vector<uint8_t>& message,
-                                                            const std::vector<std::vector<uint32_t>>& w_prime) const {
+                                                            const PolyVec& w_prime) const {
     // Check for obviously corrupted signature components
     if (signature.c_data.size() == 0 || signature.z_data.size() == 0) {
         return false;
@@ -266,18 +430,8 @@ bool ColorSignVerify::validate_cryptographic_integrity_final(const ColorSignPubl
 
     // Validate z data can be decoded and re-encoded consistently
     try {
-        std::vector<std::vector<uint32_t>> z_decoded = unpack_polynomial_vector_ml_dsa(signature.z_data, params_.module_rank, params_.degree, params_.modulus, 18);
-        
-        // Basic sanity check on decoded data
-        if (z_decoded.size() != params_.module_rank) {
-            return false;
-        }
-
-        for (const auto& poly : z_decoded) {
-            if (poly.size() != params_.degree) {
-                return false;
-            }
-        }
+        PolyVec z_decoded(params_.module_rank, params_.degree);
+        unpack_signature_z(SignatureView(signature), z_decoded);
     } catch (...) {
         // Decoding failed - indicates corrupted signature
         return false;
@@ -299,17 +453,14 @@ bool ColorSignVerify::validate_cryptographic_integrity_final(const ColorSignPubl
 // Mathematical consistency validation
 bool ColorSignVerify::validate_mathematical_consistency(const ColorSignPublicKey& public_key,
                                                        const ColorSignature& signature,
-                                                       const std::vector<std::vector<uint32_t>>& w_prime) const {
+                                                       const PolyVec& w_prime) const {
     // Validate w' dimensions
-    if (w_prime.size() != params_.module_rank) {
+    if (w_prime.size() != params_.module_rank || w_prime.degree() != params_.degree) {
         return false;
     }
 
     for (const auto& poly : w_prime) {
-        if (poly.size() != params_.degree) {
-            return false;
-        }
-        
+
         // Check for suspicious patterns that might indicate tampering
         uint32_t max_coeff = 0;
         for (uint32_t coeff : poly) {
@@ -327,48 +478,68 @@ bool ColorSignVerify::validate_mathematical_consistency(const ColorSignPublicKey
 
 
 // Generate matrix A from seed
-std::vector<std::vector<uint32_t>> ColorSignVerify::generate_matrix_A(const std::array<uint8_t, 32>& seed) const {
+void ColorSignVerify::generate_matrix_A(const std::array<uint8_t, 32>& seed, PolyMat& matrix) const {
+    ScopedStage probe(PerfStage::MATRIX_EXPANSION);
+    switch (fixed_level_) {
+        case 44: return KeyGenT<44>::generate_matrix_A(seed, matrix.data());
+        case 65: return KeyGenT<65>::generate_matrix_A(seed, matrix.data());
+        case 87: return KeyGenT<87>::generate_matrix_A(seed, matrix.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    std::vector<std::vector<uint32_t>> matrix(k * k, std::vector<uint32_t>(n));
-
     for (uint32_t i = 0; i < k; ++i) {
         for (uint32_t j = 0; j < k; ++j) {
             // Domain separation: seed || i || j || 0
-            std::vector<uint8_t> domain_sep = std::vector<uint8_t>(seed.begin(), seed.end());
-            domain_sep.push_back(static_cast<uint8_t>(i));
-            domain_sep.push_back(static_cast<uint8_t>(j));
-            domain_sep.push_back(0);
+            std::array<uint8_t, 35> domain_sep;
+            std::copy(seed.begin(), seed.end(), domain_sep.begin());
+            domain_sep[32] = static_cast<uint8_t>(i);
+            domain_sep[33] = static_cast<uint8_t>(j);
+            domain_sep[34] = 0;
 
             SHAKE128Sampler sampler;
             sampler.init(domain_sep.data(), domain_sep.size());
 
             // Sample coefficients uniformly from [0, q)
-            uint32_t* coeffs = matrix[i * k + j].data();
+            uint32_t* coeffs = matrix(i, j).data();
             for (uint32_t l = 0; l < n; ++l) {
                 coeffs[l] = sampler.sample_uniform(q);
             }
         }
     }
-
-    return matrix;
 }
 
 // Extract t from public key
-std::vector<std::vector<uint32_t>> ColorSignVerify::extract_t_from_public_key(const ColorSignPublicKey& public_key) const {
-    if (public_key.use_compression) {
-        return clwe::unpack_polynomial_vector_ml_dsa(public_key.public_data, params_.module_rank, params_.degree, params_.modulus, 10);
+void ColorSignVerify::extract_t_from_public_key(const PublicKeyView& public_key, VerifyWorkspace& workspace) const {
+    ScopedStage probe(PerfStage::PACKING);
+    if (key_format_has_t1(public_key.format_version)) {
+        // t1 unpacks as t1 * 2^13, which then stands in for t in w' = A*z - c*t
+        clwe::unpack_polynomial_vector_t1(public_key.public_data.data(), public_key.public_data.size(), workspace.t_);
+    } else if (public_key.use_compression) {
+        clwe::unpack_polynomial_vector_ml_dsa(public_key.public_data.data(), public_key.public_data.size(),
+                                              params_.modulus, 10, workspace.t_);
     } else {
-        return clwe::decode_colors_to_polynomial_vector(public_key.public_data, params_.module_rank, params_.degree, params_.modulus);
+        clwe::decode_colors_to_polynomial_vector(public_key.public_data.data(), public_key.public_data.size(),
+                                                 params_.modulus, workspace.t_);
     }
 }
 
 // Unpack challenge polynomial from c_hash
-std::vector<uint32_t> ColorSignVerify::unpack_challenge(const std::vector<uint8_t>& c_hash) const {
+void ColorSignVerify::unpack_challenge(const ByteSpan& c_hash, std::vector<uint32_t>& c) const {
+    ScopedStage probe(PerfStage::PACKING);
+    if (c_hash.size() == (params_.degree + 3) / 4) {
+        switch (fixed_level_) {
+            case 44: return ColorSignVerifyT<44>::unpack_challenge(c_hash.data(), c.data());
+            case 65: return ColorSignVerifyT<65>::unpack_challenge(c_hash.data(), c.data());
+            case 87: return ColorSignVerifyT<87>::unpack_challenge(c_hash.data(), c.data());
+            default: break;
+        }
+    }
+
     size_t n = params_.degree;
-    std::vector<uint32_t> c(n, 0);
     for (size_t i = 0; i < n; ++i) {
         size_t byte_idx = i / 4;
         uint8_t shift = (i % 4) * 2;
@@ -384,67 +555,65 @@ std::vector<uint32_t> ColorSignVerify::unpack_challenge(const std::vector<uint8_
             c[i] = 0;
         }
     }
-    return c;
 }
 
 // Compute w' = A * z - c * t mod q with CORRECTED ML-DSA mathematics
 // FIXED: Now properly aligned with signing algorithm's challenge computation
-std::vector<std::vector<uint32_t>> ColorSignVerify::compute_w_prime_fixed(const std::vector<std::vector<uint32_t>>& matrix_A,
-                                                                         const std::vector<std::vector<uint32_t>>& z,
-                                                                         const std::vector<uint8_t>& c_hash,
-                                                                         const std::vector<std::vector<uint32_t>>& t) const {
-    auto c = unpack_challenge(c_hash);
+void ColorSignVerify::compute_w_prime_fixed(const NTTEngine& ntt_engine,
+                                            const PolyMat& matrix_A,
+                                            const PolyVec& z,
+                                            const std::vector<uint32_t>& c,
+                                            const PolyVec& t,
+                                            PolyVec& w_prime,
+                                            std::vector<uint32_t>& product) const {
+    ScopedStage probe(PerfStage::NTT);
+    switch (fixed_level_) {
+        case 44: return ColorSignVerifyT<44>::compute_w_prime(ntt_engine, matrix_A.data(), z.data(), c.data(), t.data(), w_prime.data(), product.data());
+        case 65: return ColorSignVerifyT<65>::compute_w_prime(ntt_engine, matrix_A.data(), z.data(), c.data(), t.data(), w_prime.data(), product.data());
+        case 87: return ColorSignVerifyT<87>::compute_w_prime(ntt_engine, matrix_A.data(), z.data(), c.data(), t.data(), w_prime.data(), product.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    // Create NTT engine
-    auto ntt_engine = create_optimal_ntt_engine(q, n);
-
-    std::vector<std::vector<uint32_t>> w_prime(k, std::vector<uint32_t>(n, 0));
-
-    // Compute A * z using proper ML-DSA matrix multiplication
+    w_prime.fill(0);
     for (uint32_t i = 0; i < k; ++i) {
-        std::vector<uint32_t> temp(n, 0);
+        // Compute A * z using proper ML-DSA matrix multiplication
+        PolySpan w_prime_i = w_prime[i];
         for (uint32_t m = 0; m < k; ++m) {
-            std::vector<uint32_t> product(n);
-            ntt_engine->multiply(matrix_A[i * k + m].data(), z[m].data(), product.data());
+            ntt_engine.multiply(matrix_A(i, m).data(), z[m].data(), product.data());
             for (uint32_t j = 0; j < n; ++j) {
-                temp[j] = (temp[j] + product[j]) % q;
+                w_prime_i[j] = (w_prime_i[j] + product[j]) % q;
             }
         }
-        w_prime[i] = temp;
-    }
 
-    // Compute c * t using NTT
-    std::vector<std::vector<uint32_t>> ct(k, std::vector<uint32_t>(n, 0));
-    for (uint32_t i = 0; i < k; ++i) {
-        ntt_engine->multiply(c.data(), t[i].data(), ct[i].data());
-    }
+        // Compute c * t using NTT
+        ntt_engine.multiply(c.data(), t[i].data(), product.data());
 
-    // Compute w' = (A * z - c * t) mod q - this is the standard ML-DSA formula
-    for (uint32_t i = 0; i < k; ++i) {
+        // Compute w' = (A * z - c * t) mod q - this is the standard ML-DSA formula
         for (uint32_t j = 0; j < n; ++j) {
-            uint64_t diff = (uint64_t)w_prime[i][j] + q - ct[i][j];
-            w_prime[i][j] = diff % q;
+            uint64_t diff = (uint64_t)w_prime_i[j] + q - product[j];
+            w_prime_i[j] = diff % q;
         }
     }
-
-    return w_prime;
 }
 
 // Hash message with SHAKE256 (supports context for ML-DSA)
-std::vector<uint8_t> ColorSignVerify::hash_message(const std::vector<uint8_t>& message, const std::vector<uint8_t>& context) const {
-    std::vector<uint8_t> input;
-    if (!context.empty()) {
-        // Prepend context length and context as per ML-DSA spec
-        uint8_t context_len = static_cast<uint8_t>(context.size());
-        input.push_back(0);  // DOM_SEP
-        input.push_back(context_len);
-        input.insert(input.end(), context.begin(), context.end());
-    }
-    input.insert(input.end(), message.begin(), message.end());
-    return shake256(input, 64);  // 64 bytes for ML-DSA mu
+void ColorSignVerify::hash_message(const uint8_t* message, size_t message_len,
+                                   const uint8_t* context, size_t context_len, uint8_t* mu) const {
+    ScopedStage probe(PerfStage::HASHING);
+    SHAKE256Sampler hash;
+    hash.reset();
+    // M' = 0 || |ctx| || ctx || M as per ML-DSA spec, also for an empty context: the leading 0
+    // keeps pure messages apart from pre-hash representatives, which start with 1
+    uint8_t prefix[2] = {0, static_cast<uint8_t>(context_len)};  // DOM_SEP, context length
+    hash.absorb(prefix, sizeof(prefix));
+    hash.absorb(context, context_len);
+    hash.absorb(message, message_len);
+    hash.pad_and_absorb();
+    hash.squeeze(mu, 64);  // 64 bytes for ML-DSA mu
 }
 
 // Compute challenge c = sample polynomial from SHAKE256(mu || w_encoded)
@@ -475,7 +644,14 @@ std::vector<uint32_t> ColorSignVerify::compute_challenge(const std::vector<uint8
 }
 
 // Check if z coefficients are within strict ML-DSA bounds [-γ₁ + β, γ₁ - β] as per FIPS 204
-bool ColorSignVerify::check_z_bounds(const std::vector<std::vector<uint32_t>>& z) const {
+bool ColorSignVerify::check_z_bounds(const PolyVec& z) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignT<44>::check_z_bounds(z.data());
+        case 65: return ColorSignT<65>::check_z_bounds(z.data());
+        case 87: return ColorSignT<87>::check_z_bounds(z.data());
+        default: break;
+    }
+
     uint32_t gamma1 = params_.gamma1;
     uint32_t beta = params_.beta;
     uint32_t q = params_.modulus;
@@ -496,15 +672,23 @@ bool ColorSignVerify::check_z_bounds(const std::vector<std::vector<uint32_t>>& z
 }
 
 // UseHint as per Algorithm 9 - decompress z using hints
-std::vector<std::vector<uint32_t>> ColorSignVerify::use_hint(const std::vector<uint8_t>& h,
-                                                             const std::vector<std::vector<uint32_t>>& z,
-                                                             uint32_t gamma2) const {
+void ColorSignVerify::use_hint(const ByteSpan& h,
+                               const PolyVec& z,
+                               PolyVec& z_decompressed) const {
+    ScopedStage probe(PerfStage::PACKING);
+    switch (fixed_level_) {
+        case 44: return ColorSignVerifyT<44>::use_hint(h.data(), h.size(), z.data(), z_decompressed.data());
+        case 65: return ColorSignVerifyT<65>::use_hint(h.data(), h.size(), z.data(), z_decompressed.data());
+        case 87: return ColorSignVerifyT<87>::use_hint(h.data(), h.size(), z.data(), z_decompressed.data());
+        default: break;
+    }
+
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
     uint32_t d = 13;  // 2^d = 8192, gamma2 = (q-1)/2 ≈ 2^22
 
-    std::vector<std::vector<uint32_t>> z_decompressed = z;  // Copy z
+    std::copy(z.data(), z.data() + z.coeff_count(), z_decompressed.data());  // Copy z
     size_t hint_index = 0;
 
     for (uint32_t i = 0; i < k; ++i) {
@@ -531,19 +715,34 @@ std::vector<std::vector<uint32_t>> ColorSignVerify::use_hint(const std::vector<u
             hint_index++;
         }
     }
+}
+
+// FIPS 204 hint list applied to w' (apply_hint_indices); false for a malformed encoding
+bool ColorSignVerify::use_hint_indices(const ByteSpan& h, const PolyVec& w_prime, PolyVec& w) const {
+    ScopedStage probe(PerfStage::PACKING);
+    return apply_hint_indices(h.data(), h.size(), params_.omega, params_.modulus, w_prime, w);
+}
 
-    return z_decompressed;
+// z as packed in the signature: 18-bit compression (legacy) or gamma1 - z (FIPS 204)
+void ColorSignVerify::unpack_signature_z(const SignatureView& signature, PolyVec& z) const {
+    ScopedStage probe(PerfStage::PACKING);
+    if (signature.format == SignatureFormat::FIPS204) {
+        unpack_polynomial_vector_gamma1(signature.z_data.data(), signature.z_data.size(), params_.modulus,
+                                        params_.gamma1, z);
+    } else {
+        unpack_polynomial_vector_ml_dsa(signature.z_data.data(), signature.z_data.size(), params_.modulus, 18, z);
+    }
 }
 
 // Hint decompression as per Algorithm 9
-std::vector<std::vector<uint32_t>> ColorSignVerify::hint_decompress(const std::vector<std::vector<uint32_t>>& compressed,
-                                                                   const std::vector<uint8_t>& h,
-                                                                   uint32_t gamma2) const {
+PolyVec ColorSignVerify::hint_decompress(const PolyVec& compressed,
+                                        const std::vector<uint8_t>& h,
+                                        uint32_t gamma2) const {
     uint32_t k = params_.module_rank;
     uint32_t n = params_.degree;
     uint32_t q = params_.modulus;
 
-    std::vector<std::vector<uint32_t>> decompressed = compressed;  // Copy compressed
+    PolyVec decompressed = compressed.clone();  // Copy compressed
     size_t hint_index = 0;
 
     for (uint32_t i = 0; i < k; ++i) {
@@ -575,7 +774,14 @@ std::vector<std::vector<uint32_t>> ColorSignVerify::hint_decompress(const std::v
 }
 
 // Check if w coefficients are in [-(gamma2 - 1), gamma2] where gamma2 = (q-1)/2
-bool ColorSignVerify::check_w_bounds(const std::vector<std::vector<uint32_t>>& w) const {
+bool ColorSignVerify::check_w_bounds(const PolyVec& w) const {
+    switch (fixed_level_) {
+        case 44: return ColorSignVerifyT<44>::check_w_bounds(w.data());
+        case 65: return ColorSignVerifyT<65>::check_w_bounds(w.data());
+        case 87: return ColorSignVerifyT<87>::check_w_bounds(w.data());
+        default: break;
+    }
+
     uint32_t gamma2 = (params_.modulus - 1) / 2;
     uint32_t q = params_.modulus;
     int32_t min_val = -(gamma2 - 1);
@@ -593,6 +799,71 @@ bool ColorSignVerify::check_w_bounds(const std::vector<std::vector<uint32_t>>& w
     return true;
 }
 
+template<uint32_t Level>
+void ColorSignVerifyT<Level>::unpack_challenge(const uint8_t* packed, uint32_t* c) {
+    for (size_t i = 0; i < Params::N; ++i) {
+        uint8_t bits = (packed[i / 4] >> ((i % 4) * 2)) & 0x03;
+        c[i] = (bits == 1) ? 1 : (bits == 2) ? Params::Q - 1 : 0;
+    }
+}
+
+template<uint32_t Level>
+void ColorSignVerifyT<Level>::compute_w_prime(const NTTEngine& ntt_engine, const uint32_t* matrix_A, const uint32_t* z,
+                                              const uint32_t* c, const uint32_t* t, uint32_t* w_prime, uint32_t* product) {
+    constexpr uint32_t K = Params::K;
+    constexpr uint32_t N = Params::N;
+    constexpr uint32_t Q = Params::Q;
+
+    std::fill(w_prime, w_prime + Params::VECTOR_COEFFS, 0);
+    for (uint32_t i = 0; i < K; ++i) {
+        uint32_t* w_prime_i = w_prime + i * N;
+        for (uint32_t m = 0; m < K; ++m) {
+            ntt_engine.multiply(matrix_A + (i * K + m) * N, z + m * N, product);
+            for (uint32_t j = 0; j < N; ++j) {
+                w_prime_i[j] = (w_prime_i[j] + product[j]) % Q;
+            }
+        }
+
+        ntt_engine.multiply(c, t + i * N, product);
+        for (uint32_t j = 0; j < N; ++j) {
+            w_prime_i[j] = (static_cast<uint64_t>(w_prime_i[j]) + Q - product[j]) % Q;
+        }
+    }
+}
+
+// A set hint bit moves the coefficient down by 2^13 (mod q)
+template<uint32_t Level>
+void ColorSignVerifyT<Level>::use_hint(const uint8_t* h, size_t h_size, const uint32_t* w_prime, uint32_t* w) {
+    constexpr uint32_t step = 1u << 13;
+
+    std::copy(w_prime, w_prime + Params::VECTOR_COEFFS, w);
+    size_t hinted = std::min(h_size * 8, Params::VECTOR_COEFFS);
+    for (size_t i = 0; i < hinted; ++i) {
+        if (h[i / 8] & (1 << (i % 8))) {
+            w[i] = (w_prime[i] >= step) ? w_prime[i] - step : w_prime[i] + Params::Q - step;
+        }
+    }
+}
+
+template<uint32_t Level>
+bool ColorSignVerifyT<Level>::check_w_bounds(const uint32_t* w) {
+    constexpr int32_t max_val = (Params::Q - 1) / 2;
+    constexpr int32_t min_val = -(max_val - 1);
+    constexpr int32_t q = Params::Q;
+
+    for (size_t i = 0; i < Params::VECTOR_COEFFS; ++i) {
+        int32_t signed_coeff = (w[i] > Params::Q / 2) ? static_cast<int32_t>(w[i]) - q : static_cast<int32_t>(w[i]);
+        if (signed_coeff < min_val || signed_coeff > max_val) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template class ColorSignVerifyT<44>;
+template class ColorSignVerifyT<65>;
+template class ColorSignVerifyT<87>;
+
 // Error message utility
 std::string get_colorsign_verify_error_message(ColorSignVerifyError error) {
     switch (error) {
@@ -0,0 +1,92 @@
+#include "../include/clwe/worker_pool.hpp"
+#include <stdexcept>
+
+namespace clwe {
+
+WorkerPool::WorkerPool(size_t workers) {
+    threads_.reserve(workers);
+    try {
+        for (size_t i = 0; i < workers; ++i) {
+            threads_.emplace_back(&WorkerPool::worker_loop, this, i + 1);
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkerPool::dispatch(size_t count, Thunk thunk, void* context) {
+    if (count > threads_.size() + 1) {
+        throw std::invalid_argument("Worker pool batch larger than the pool");
+    }
+    if (count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            thunk_ = thunk;
+            context_ = context;
+            count_ = count;
+            pending_ = count - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+    }
+
+    // The workers hold `context` until they finish, so wait for them even if task 0 throws
+    auto wait_for_workers = [this]() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return pending_ == 0; });
+    };
+    try {
+        if (count > 0) {
+            thunk(context, 0);
+        }
+    } catch (...) {
+        wait_for_workers();
+        throw;
+    }
+    wait_for_workers();
+}
+
+void WorkerPool::worker_loop(size_t index) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        start_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+        if (stopping_) {
+            return;
+        }
+        seen = generation_;
+        // Workers beyond the batch skip it; the batch only waits for the ones it uses
+        if (index >= count_) {
+            continue;
+        }
+
+        Thunk thunk = thunk_;
+        void* context = context_;
+        lock.unlock();
+        thunk(context, index);
+        lock.lock();
+        if (--pending_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+} // namespace clwe
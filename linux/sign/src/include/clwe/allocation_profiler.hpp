@@ -0,0 +1,59 @@
+#ifndef CLWE_ALLOCATION_PROFILER_HPP
+#define CLWE_ALLOCATION_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace clwe {
+
+// Heap allocations made through global operator new on one thread
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t allocated_bytes = 0;     // Requested bytes
+    uint64_t freed_bytes = 0;
+    uint64_t peak_live_bytes = 0;     // Highest live bytes above the level at the start of the window
+};
+
+// Per-thread allocation counting. The counting itself is done by the replacement global
+// operator new/delete in allocation_hooks.cpp, which is not part of the colorsign library:
+// only executables linking the colorsign_allocation_hooks target count allocations. Anywhere
+// else hooks_installed() is false and every count stays zero. Calls into C libraries that use
+// malloc directly (OpenSSL) are not seen.
+class AllocationProfiler {
+public:
+    static bool hooks_installed();
+
+    // Cumulative counts of the calling thread since it started; peak_live_bytes is the
+    // thread's highest live level
+    static AllocationStats thread_totals();
+
+    // Called by the hooks. Blocks freed on another thread than the one that allocated them
+    // lower that thread's live level, which may go below its level at thread start.
+    static void record_allocation(size_t bytes) noexcept;
+    static void record_deallocation(size_t bytes) noexcept;
+    static void mark_hooks_installed() noexcept;
+};
+
+// Counts the calling thread's allocations between construction and stats(). Scopes nest: an
+// inner scope's peak also raises the peak seen by the enclosing one.
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    // Disable copy and assignment
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    AllocationStats stats() const;
+
+private:
+    AllocationStats start_;
+    int64_t start_live_;
+    int64_t outer_peak_;
+};
+
+} // namespace clwe
+
+#endif // CLWE_ALLOCATION_PROFILER_HPP
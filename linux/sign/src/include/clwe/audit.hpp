@@ -0,0 +1,196 @@
+#ifndef CLWE_AUDIT_HPP
+#define CLWE_AUDIT_HPP
+
+#include "security_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clwe {
+
+// Fixed-size binary audit record. Records are written to the audit file verbatim,
+// so the layout is part of the file format.
+struct AuditRecord {
+    static constexpr size_t DETAIL_CAPACITY = 32;
+
+    uint64_t timestamp_ns;   // Wall clock, nanoseconds since the Unix epoch
+    uint64_t sequence;       // Position in the pipeline, unique and increasing
+    uint16_t event;          // AuditEvent
+    uint16_t detail_len;
+    uint32_t error_code;
+    uint32_t thread_id;      // Small per-process thread number, not the OS id
+    uint32_t reserved;
+    uint64_t value;          // Event-specific number (attempt count, duration, ...)
+    char detail[DETAIL_CAPACITY];  // Truncated, not NUL-terminated
+
+    AuditEvent event_type() const { return static_cast<AuditEvent>(event); }
+    std::string detail_string() const { return std::string(detail, detail_len); }
+};
+
+static_assert(sizeof(AuditRecord) == 72, "AuditRecord layout is part of the audit file format");
+
+// Bounded multi-producer ring of audit records. Pushing is lock-free: a full ring
+// rejects the record instead of blocking the signing thread.
+class AuditRing {
+public:
+    // `capacity` is rounded up to a power of two
+    explicit AuditRing(size_t capacity);
+    ~AuditRing();
+
+    // Disable copy and assignment
+    AuditRing(const AuditRing&) = delete;
+    AuditRing& operator=(const AuditRing&) = delete;
+
+    // Stamps record.sequence. Returns false if the ring is full.
+    bool try_push(AuditRecord& record) noexcept;
+    bool try_pop(AuditRecord& record) noexcept;
+
+    size_t capacity() const { return mask_ + 1; }
+    size_t size_approx() const noexcept;
+    uint64_t pushed() const noexcept { return enqueue_pos_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell;
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> enqueue_pos_{0};
+    alignas(64) std::atomic<uint64_t> dequeue_pos_{0};
+};
+
+// Record filter for audit queries; unset fields match everything
+struct AuditQuery {
+    std::optional<AuditEvent> event;
+    std::optional<uint32_t> error_code;
+    uint64_t from_ns = 0;
+    uint64_t to_ns = UINT64_MAX;
+
+    bool matches(const AuditRecord& record) const;
+};
+
+// Append-only audit file, memory-mapped. A 64-byte header (magic, version, record size,
+// record count) is followed by the records; the count is updated after the records are
+// written, so a torn append is never visible. Not thread-safe.
+class AuditLogFile {
+public:
+    // Opens `path`, creating it unless `read_only`. Throws std::runtime_error if the file
+    // cannot be opened or mapped, or is not an audit file.
+    explicit AuditLogFile(const std::string& path, bool read_only = false);
+    ~AuditLogFile();
+
+    // Disable copy and assignment
+    AuditLogFile(const AuditLogFile&) = delete;
+    AuditLogFile& operator=(const AuditLogFile&) = delete;
+
+    void append(const AuditRecord* records, size_t count);
+    void sync();  // Flush the mapping to disk
+
+    size_t size() const;
+    const AuditRecord* begin() const;
+    const AuditRecord* end() const { return begin() + size(); }
+    const AuditRecord& operator[](size_t index) const { return begin()[index]; }
+
+    // Records are in sequence order, so time ranges over a single writer are contiguous
+    std::vector<AuditRecord> query(const AuditQuery& query) const;
+    size_t count(const AuditQuery& query) const;
+
+    const std::string& path() const { return path_; }
+
+private:
+    struct Header;
+
+    void map(size_t bytes);
+    Header* header() const;
+
+    std::string path_;
+    int fd_ = -1;
+    bool read_only_;
+    uint8_t* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+};
+
+struct AuditPipelineConfig {
+    std::string path;                                    // Audit file, appended to if it exists
+    size_t ring_capacity = 4096;                         // Records buffered between flushes
+    std::chrono::milliseconds flush_interval{50};        // Flusher wake-up period
+};
+
+struct AuditPipelineStats {
+    uint64_t recorded = 0;  // Records accepted into the ring
+    uint64_t dropped = 0;   // Records rejected because the ring was full
+    uint64_t flushed = 0;   // Records appended to the file
+};
+
+// Audit pipeline: producers push binary records into an AuditRing and a background thread
+// drains it into an AuditLogFile. Recording costs a clock read, a copy of at most
+// DETAIL_CAPACITY detail bytes and a compare-and-swap; there are no allocations or locks.
+// The flusher is woken early when the ring is half full.
+class AuditPipeline {
+public:
+    explicit AuditPipeline(const AuditPipelineConfig& config);
+    ~AuditPipeline();  // Stops the flusher and drains the ring
+
+    // Disable copy and assignment
+    AuditPipeline(const AuditPipeline&) = delete;
+    AuditPipeline& operator=(const AuditPipeline&) = delete;
+
+    bool record(AuditEvent event, uint32_t error_code = 0, uint64_t value = 0,
+                const char* detail = nullptr, size_t detail_len = 0) noexcept;
+    bool record(AuditEvent event, uint32_t error_code, uint64_t value,
+                const char* detail, size_t detail_len, uint64_t timestamp_ns) noexcept;
+
+    // Drain the ring into the file now
+    void flush();
+
+    // Queries see flushed records only; call flush() first for an up-to-date view
+    std::vector<AuditRecord> query(const AuditQuery& query) const;
+    size_t count(const AuditQuery& query) const;
+
+    AuditPipelineStats stats() const;
+
+private:
+    void flusher_loop();
+    void drain();
+
+    AuditRing ring_;
+    AuditLogFile file_;
+    std::chrono::milliseconds flush_interval_;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> flushed_{0};
+    std::atomic<bool> wake_requested_{false};
+    bool stopping_ = false;
+    mutable std::mutex file_mutex_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::thread flusher_;
+};
+
+// SecurityMonitor that feeds an AuditPipeline. Details longer than the record's detail field
+// are truncated. Timing anomalies are detected as by DefaultSecurityMonitor and recorded with
+// the offending duration as the record value. The pipeline must outlive the monitor.
+class BinaryAuditMonitor : public SecurityMonitor {
+public:
+    explicit BinaryAuditMonitor(AuditPipeline& pipeline);
+
+    void log_event(const AuditEntry& entry) override;
+    void report_security_violation(SecurityError error, const std::string& details) override;
+    bool detect_timing_anomaly(const std::string& operation_name, uint64_t operation_time_ns) override;
+
+    AuditPipeline& pipeline() { return pipeline_; }
+
+private:
+    AuditPipeline& pipeline_;
+    DefaultSecurityMonitor timing_;  // Timing statistics only; its own log is disabled
+};
+
+} // namespace clwe
+
+#endif // CLWE_AUDIT_HPP
@@ -0,0 +1,185 @@
+#ifndef CLWE_BENCHMARK_HPP
+#define CLWE_BENCHMARK_HPP
+
+#include "metrics.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace clwe {
+
+// Helpers shared by the JSON report writers
+namespace json {
+std::string escape(const std::string& value);
+std::string number(double value);   // "%.3f", null when not finite
+} // namespace json
+
+// What benchmark numbers depend on besides the code: the CPU and how the library was built.
+// Results are only comparable between runs with the same key().
+struct BenchmarkEnvironment {
+    std::string cpu_model;       // /proc/cpuinfo "model name", "unknown" elsewhere
+    std::string cpu_features;    // CPUFeatures::to_string()
+    std::string compiler;        // From the compiler's predefined macros
+    std::string build_flags;     // Optimization, ISA extensions and instrumentation of the library build
+    std::string build_info;      // get_build_info(), informational only (includes the build date)
+
+    static BenchmarkEnvironment current();
+
+    // cpu_model, cpu_features, compiler and build_flags joined by " | "
+    std::string key() const;
+};
+
+// Run settings; from_args() understands --min-time=<seconds>, --min-samples=<n>,
+// --filter=<substring>, --json=<path> and --quick (short runs for smoke tests).
+struct BenchmarkOptions {
+    double min_time_s = 0.5;          // Measuring time per case
+    size_t min_samples = 30;
+    size_t max_samples = 100000;
+    uint64_t min_sample_ns = 10000;   // Operations are batched until a sample takes this long
+    size_t warmup_samples = 3;
+    std::string filter;               // Only cases whose full name contains this
+    std::string json_path;            // Empty = no JSON output
+
+    // Throws std::invalid_argument on unknown or malformed arguments
+    static BenchmarkOptions from_args(int argc, char** argv);
+};
+
+// Statistics of one case; times are per operation
+struct BenchmarkResult {
+    std::string name;                 // e.g. "sign"
+    MetricLabels labels;              // e.g. {{"level", "44"}, {"message_bytes", "1024"}}
+    size_t iterations_per_sample = 1;
+    uint64_t units_per_op = 0;        // Work units (bytes, coefficients) per operation, 0 = not applicable
+    std::string unit = "B";           // Name of the work unit, e.g. "B" or "coeff"
+    std::vector<double> samples_ns;   // In measurement order
+    double mean_ns = 0.0;
+    double median_ns = 0.0;
+    double p99_ns = 0.0;
+    double stddev_ns = 0.0;
+    double min_ns = 0.0;
+    double max_ns = 0.0;
+    double ops_per_sec = 0.0;
+    double cycles_per_op = 0.0;       // PerfEventGroup cycles (TimestampCounter ticks as fallback)
+    double cycles_per_unit = 0.0;     // cycles_per_op / units_per_op, 0 when units_per_op is 0
+
+    // "sign/level=44/message_bytes=1024"
+    std::string full_name() const;
+};
+
+// Fill the statistics of `result` from its samples_ns
+void summarize_benchmark(BenchmarkResult& result);
+
+// Registered benchmark cases, run one after another on the calling thread. Each sample times
+// a batch of operations; the batch size is calibrated during warm-up so that one sample
+// lasts at least min_sample_ns, which keeps timer overhead out of fast operations.
+class BenchmarkSuite {
+public:
+    using Operation = std::function<void()>;
+
+    explicit BenchmarkSuite(std::string name);
+
+    // `units_per_op` is the amount of work one call does, counted in `unit`; the report then
+    // includes cycles per unit (e.g. cycles per byte hashed or per coefficient sampled).
+    void add(const std::string& name, const MetricLabels& labels, Operation operation,
+             uint64_t units_per_op = 0, const std::string& unit = "B");
+
+    std::vector<BenchmarkResult> run(const BenchmarkOptions& options, std::ostream* progress = nullptr) const;
+
+    // Human-readable table
+    static void print_results(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    // {"context": {...}, "benchmarks": [...]} including the raw samples, for machine comparison
+    std::string to_json(const std::vector<BenchmarkResult>& results) const;
+
+    // Write to_json() to `path`. Throws std::runtime_error on I/O failure.
+    void write_json(const std::string& path, const std::vector<BenchmarkResult>& results) const;
+
+private:
+    struct Case {
+        std::string name;
+        MetricLabels labels;
+        Operation operation;
+        uint64_t units_per_op;
+        std::string unit;
+    };
+
+    std::string name_;
+    std::vector<Case> cases_;
+};
+
+// Settings of a throughput run; from_args() understands --threads=<n,n,...>, --duration=<seconds>,
+// --filter=<substring>, --no-pin, --csv=<path>, --json=<path> and --quick.
+struct ThroughputOptions {
+    std::vector<size_t> thread_counts;  // Empty = 1, 2, 4, ... up to and including the CPU count
+    double duration_s = 1.0;            // Measuring time per workload and thread count
+    double warmup_s = 0.2;
+    bool pin_threads = true;            // Pin worker i to CPU i modulo the CPU count (Linux)
+    std::string filter;                 // Only workloads whose name contains this
+    std::string csv_path;               // Empty = no CSV output
+    std::string json_path;              // Empty = no JSON output
+
+    // Throws std::invalid_argument on unknown or malformed arguments
+    static ThroughputOptions from_args(int argc, char** argv);
+
+    // thread_counts, or the default progression when it is empty
+    std::vector<size_t> resolved_thread_counts() const;
+};
+
+// Aggregate of one workload at one thread count
+struct ThroughputResult {
+    std::string workload;
+    size_t threads = 0;
+    uint64_t operations = 0;
+    double seconds = 0.0;
+    double ops_per_sec = 0.0;
+    double efficiency = 0.0;            // Per-thread rate relative to the smallest thread count measured
+    double min_thread_ops_per_sec = 0.0;
+    double max_thread_ops_per_sec = 0.0;
+    uint64_t p50_ns = 0;                // Latency percentiles from LatencyHistogram buckets
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+// Closed-loop load generator: every worker thread calls its operation back to back for the
+// measuring window while a shared LatencyHistogram records each call. Running the same
+// workload at increasing thread counts shows where throughput stops scaling.
+class ThroughputBenchmark {
+public:
+    // Called on the worker thread before the run starts, so per-thread state (signer,
+    // workspace) is allocated by the thread that uses it
+    using WorkerFactory = std::function<BenchmarkSuite::Operation(size_t thread_index)>;
+
+    explicit ThroughputBenchmark(std::string name);
+
+    void add(const std::string& workload, WorkerFactory factory);
+
+    // Exceptions thrown by a worker are rethrown here after all workers have stopped
+    std::vector<ThroughputResult> run(const ThroughputOptions& options, std::ostream* progress = nullptr) const;
+
+    static void print_results(std::ostream& out, const std::vector<ThroughputResult>& results);
+    static std::string to_csv(const std::vector<ThroughputResult>& results);
+    std::string to_json(const std::vector<ThroughputResult>& results) const;
+
+    // Throw std::runtime_error on I/O failure
+    static void write_csv(const std::string& path, const std::vector<ThroughputResult>& results);
+    void write_json(const std::string& path, const std::vector<ThroughputResult>& results) const;
+
+private:
+    struct Workload {
+        std::string name;
+        WorkerFactory factory;
+    };
+
+    ThroughputResult measure(const Workload& workload, size_t threads, const ThroughputOptions& options) const;
+
+    std::string name_;
+    std::vector<Workload> workloads_;
+};
+
+} // namespace clwe
+
+#endif // CLWE_BENCHMARK_HPP
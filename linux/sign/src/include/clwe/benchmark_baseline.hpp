@@ -0,0 +1,111 @@
+#ifndef CLWE_BENCHMARK_BASELINE_HPP
+#define CLWE_BENCHMARK_BASELINE_HPP
+
+#include "benchmark.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace clwe {
+
+// Two-sided Mann-Whitney U test of `candidate` against `baseline` (normal approximation with
+// tie correction). effect_size is the rank-biserial correlation in [-1, 1]; positive values
+// mean candidate samples tend to be larger (slower, for timings).
+struct MannWhitneyResult {
+    double u = 0.0;             // U statistic of the candidate sample
+    double z = 0.0;
+    double p_value = 1.0;
+    double effect_size = 0.0;
+};
+
+MannWhitneyResult mann_whitney_u(const std::vector<double>& baseline, const std::vector<double>& candidate);
+
+// A case regresses only if all three thresholds are exceeded, so that neither a statistically
+// significant but negligible shift nor a large but noisy one fails the check
+struct RegressionBudget {
+    double max_slowdown = 0.05;     // Tolerated median slowdown (0.05 = 5%)
+    double alpha = 0.01;            // Significance level of the Mann-Whitney test
+    double min_effect_size = 0.3;   // Minimum |rank-biserial correlation|
+};
+
+enum class ComparisonVerdict {
+    UNCHANGED,
+    IMPROVED,
+    REGRESSED,
+    NEW,        // Only in the candidate run
+    MISSING     // Only in the baseline
+};
+
+const char* comparison_verdict_name(ComparisonVerdict verdict);
+
+struct BenchmarkComparison {
+    std::string suite;
+    std::string name;                   // BenchmarkResult::full_name()
+    ComparisonVerdict verdict = ComparisonVerdict::UNCHANGED;
+    double baseline_median_ns = 0.0;
+    double candidate_median_ns = 0.0;
+    double change = 0.0;                // candidate / baseline median - 1
+    MannWhitneyResult test;
+};
+
+// Benchmark results of one or more suites recorded on one environment. Stored as versioned
+// JSON: a reader rejects files whose format_version it does not know.
+struct BenchmarkBaseline {
+    static constexpr int FORMAT_VERSION = 1;
+
+    struct Suite {
+        std::string name;
+        std::vector<BenchmarkResult> results;   // name, labels folded into name, samples_ns
+    };
+
+    std::string environment_key;
+    BenchmarkEnvironment environment;
+    std::string library_version;
+    std::string created;                // UTC timestamp
+    std::vector<Suite> suites;
+
+    const Suite* find_suite(const std::string& name) const;
+
+    std::string to_json() const;
+
+    // Throw std::invalid_argument on malformed input or an unknown format_version
+    static BenchmarkBaseline from_json(const std::string& json);
+
+    // Suites of a BenchmarkSuite::to_json() report, keyed by the environment recorded in it
+    static BenchmarkBaseline from_report_json(const std::string& json);
+
+    // Add or replace the suites of `other`
+    void merge(const BenchmarkBaseline& other);
+};
+
+// Directory of baselines, one file per environment key, created on the first save. Throws
+// std::runtime_error on I/O failure or when a file does not hold a valid baseline for its key.
+class BaselineStore {
+public:
+    explicit BaselineStore(std::string directory);
+
+    // "baseline-<16 hex digits of a hash of the key>.json"
+    std::string path_for(const std::string& environment_key) const;
+
+    // False if there is no baseline for the key
+    bool load(const std::string& environment_key, BenchmarkBaseline& baseline) const;
+    void save(const BenchmarkBaseline& baseline) const;
+
+private:
+    std::string directory_;
+};
+
+// Compare every case of every suite in `candidate` with the same case in `baseline`
+std::vector<BenchmarkComparison> compare_benchmarks(const BenchmarkBaseline& baseline,
+                                                    const BenchmarkBaseline& candidate,
+                                                    const RegressionBudget& budget);
+
+bool has_regressions(const std::vector<BenchmarkComparison>& comparisons);
+
+void print_comparisons(std::ostream& out, const std::vector<BenchmarkComparison>& comparisons);
+
+} // namespace clwe
+
+#endif // CLWE_BENCHMARK_BASELINE_HPP
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cstdint>
+#include "polyvec.hpp"
 
 namespace clwe {
 
@@ -68,6 +69,19 @@ std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector_compressed
 std::vector<uint8_t> convert_compressed_to_color_format(const std::vector<uint8_t>& compressed_data, uint32_t k, uint32_t n, uint32_t modulus);
 std::vector<uint8_t> encode_polynomial_vector_as_colors_auto(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus);
 
+/**
+ * @brief PolyVec forms of the polynomial vector color codecs
+ *
+ * The nested-vector functions above convert and forward to these. Decoding writes into
+ * `out`, whose size() and degree() give the expected dimensions; its storage is reused.
+ */
+std::vector<uint8_t> encode_polynomial_vector_as_colors(const PolyVec& poly_vector, uint32_t modulus);
+void decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data, uint32_t modulus, PolyVec& out);
+void decode_colors_to_polynomial_vector(const uint8_t* color_data, size_t size, uint32_t modulus, PolyVec& out);
+std::vector<uint8_t> encode_polynomial_vector_as_colors_compressed(const PolyVec& poly_vector, uint32_t modulus);
+void decode_colors_to_polynomial_vector_compressed(const std::vector<uint8_t>& color_data, uint32_t modulus, PolyVec& out);
+std::vector<uint8_t> encode_polynomial_vector_as_colors_auto(const PolyVec& poly_vector, uint32_t modulus);
+
 // Advanced color integration functions
 std::vector<uint8_t> generate_color_representation_from_compressed(const std::vector<uint8_t>& compressed_data, uint32_t k, uint32_t n, uint32_t modulus);
 std::vector<uint8_t> compress_with_color_support(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, bool enable_color_metadata = true);
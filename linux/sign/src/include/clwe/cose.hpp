@@ -25,6 +25,30 @@ struct COSE_Sign1 {
         : protected_header(prot), unprotected_header(unprot), payload(pay), signature(sig) {}
 };
 
+// Non-owning view of a COSE_Sign1 message. parse() walks an encoded message once and points each
+// item into the input, so the payload and signature can be verified straight out of a receive
+// buffer; encode_into() writes a message with one copy of each item. The viewed bytes must outlive
+// the view.
+struct COSE_Sign1View {
+    ByteSpan protected_header;
+    ByteSpan unprotected_header;
+    ByteSpan payload;
+    ByteSpan signature;
+
+    COSE_Sign1View() = default;
+    COSE_Sign1View(const COSE_Sign1& cose_msg);  // Views the message's own buffers
+
+    // Throws std::invalid_argument unless the data is exactly one array of four byte strings
+    static COSE_Sign1View parse(const uint8_t* data, size_t size);
+
+    // Exact encoded size, and the encoding written to `out`; encode_into returns the bytes written
+    // and throws std::invalid_argument if `capacity` is smaller than encoded_size()
+    size_t encoded_size() const;
+    size_t encode_into(uint8_t* out, size_t capacity) const;
+
+    COSE_Sign1 to_cose_sign1() const;
+};
+
 // COSE Header structure
 struct COSE_Header {
     int alg;  // Algorithm identifier
@@ -36,6 +60,7 @@ std::vector<uint8_t> encode_cose_sign1(const COSE_Sign1& cose_msg);
 
 // Decode COSE_Sign1 from CBOR bytes
 COSE_Sign1 decode_cose_sign1(const std::vector<uint8_t>& cbor_data);
+COSE_Sign1 decode_cose_sign1(const uint8_t* cbor_data, size_t size);
 
 // Encode COSE header to CBOR
 std::vector<uint8_t> encode_cose_header(const COSE_Header& header);
@@ -47,6 +72,9 @@ COSE_Header decode_cose_header(const std::vector<uint8_t>& cbor_data);
 COSE_Sign1 create_cose_sign1_from_colorsign(const std::vector<uint8_t>& message,
                                            const ColorSignature& signature,
                                            int alg = COSE_ALG_ML_DSA_44);
+COSE_Sign1 create_cose_sign1_from_colorsign(const uint8_t* message, size_t message_len,
+                                           const ColorSignature& signature,
+                                           int alg = COSE_ALG_ML_DSA_44);
 
 // Extract ColorSignature from COSE_Sign1
 ColorSignature extract_colorsign_from_cose(const COSE_Sign1& cose_msg,
@@ -67,6 +95,20 @@ enum MajorType {
     SIMPLE_VALUE = 7
 };
 
+// Item heads: the major type and an argument (an integer's value, or the length of a string,
+// array or map) in 1, 2, 3, 5 or 9 bytes. encode_head writes head_size(argument) bytes;
+// decode_head throws std::invalid_argument for another major type, a truncated head or an
+// indefinite length.
+size_t head_size(uint64_t argument);
+size_t encode_head(MajorType major, uint64_t argument, uint8_t* out);
+uint64_t decode_head(const uint8_t* data, size_t size, size_t& offset, MajorType expected);
+
+// Byte strings in place: the encoded item size, the item written to `out` (bstr_size(len)
+// bytes), and a view of the contents of the item at `offset` inside `data`
+size_t bstr_size(size_t len);
+size_t encode_bstr(const uint8_t* data, size_t len, uint8_t* out);
+ByteSpan decode_bstr_view(const uint8_t* data, size_t size, size_t& offset);
+
 // Encode unsigned integer
 std::vector<uint8_t> encode_uint(uint64_t value);
 
@@ -79,10 +121,13 @@ std::vector<uint8_t> encode_array(const std::vector<std::vector<uint8_t>>& items
 // Encode map (simple key-value pairs, keys as ints)
 std::vector<uint8_t> encode_map(const std::vector<std::pair<int, std::vector<uint8_t>>>& pairs);
 
-// Decode functions (basic)
+// Decode functions; decode_array reads byte string items only
 uint64_t decode_uint(const std::vector<uint8_t>& data, size_t& offset);
 std::vector<uint8_t> decode_bstr(const std::vector<uint8_t>& data, size_t& offset);
 std::vector<std::vector<uint8_t>> decode_array(const std::vector<uint8_t>& data, size_t& offset);
+uint64_t decode_uint(const uint8_t* data, size_t size, size_t& offset);
+std::vector<uint8_t> decode_bstr(const uint8_t* data, size_t size, size_t& offset);
+std::vector<std::vector<uint8_t>> decode_array(const uint8_t* data, size_t size, size_t& offset);
 
 } // namespace cbor
 
@@ -2,10 +2,16 @@
 #define CLWE_KEYGEN_HPP
 
 #include "parameters.hpp"
+#include "parameter_set.hpp"
+#include "polyvec.hpp"
 #include <vector>
 #include <array>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <string>
+#include <unordered_map>
 
 namespace clwe {
 
@@ -13,15 +19,40 @@ namespace clwe {
 struct ColorSignPublicKey;
 struct ColorSignPrivateKey;
 class ColorSignKeyGen;
+class NTTEngine;
+struct SchemeMetrics;
+
+// Key format versions (format_version). Version 3 keys split t with FIPS 204 Power2Round: the
+// public key holds t1 packed at 10 bits and the private key appends t0 (13 bits) to s1 || s2.
+// Version 4 keeps that public key and packs s1 and s2 exactly, each as eta - s in 3 bits (eta = 2)
+// or 4 bits (eta = 4), instead of the 10-bit compression. Earlier versions carry the full t.
+// KEY_FORMAT_SEED is a private key format only: the key keeps the 32-byte keygen seed zeta and
+// the public key hash tr, and is expanded into the full private key to sign.
+constexpr uint8_t KEY_FORMAT_ORIGINAL = 0x01;
+constexpr uint8_t KEY_FORMAT_COMPRESSED = 0x02;
+constexpr uint8_t KEY_FORMAT_POWER2ROUND = 0x03;
+constexpr uint8_t KEY_FORMAT_PACKED_SECRET = 0x04;
+constexpr uint8_t KEY_FORMAT_SEED = 0x05;
+
+// Serialized KEY_FORMAT_SEED private key: version || expanded format || zeta || tr
+constexpr size_t SEED_KEY_SERIALIZED_BYTES = 1 + 1 + 32 + 64;
+
+// Fixed start of the other serialized keys: version || flag || rho || K || tr
+constexpr size_t KEY_HEADER_BYTES = 1 + 1 + 32 + 32 + 64;
+
+// True for the formats with t1 in the public key and t0 in the private key
+constexpr bool key_format_has_t1(uint8_t format_version) {
+    return format_version == KEY_FORMAT_POWER2ROUND || format_version == KEY_FORMAT_PACKED_SECRET;
+}
 
 // Key structures for ColorSign (ML-DSA compliant)
 struct ColorSignPublicKey {
     std::array<uint8_t, 32> seed_rho;    // Seed for matrix A generation (ρ)
     std::array<uint8_t, 32> seed_K;     // Seed for secret key generation (K)
     std::array<uint8_t, 64> hash_tr;    // Hash of public key (tr)
-    std::vector<uint8_t> public_data;   // Serialized public key polynomial t (as colors)
+    std::vector<uint8_t> public_data;   // Serialized public key polynomial t (as colors), or t1 (version 3)
     CLWEParameters params;               // Cryptographic parameters
-    uint8_t format_version = 0x01;       // Format version (1 = original, 2 = compressed)
+    uint8_t format_version = KEY_FORMAT_ORIGINAL;  // See KEY_FORMAT_*
     bool use_compression = false;        // Flag indicating if compression is used
 
     ColorSignPublicKey() = default;
@@ -32,6 +63,44 @@ struct ColorSignPublicKey {
 
     std::vector<uint8_t> serialize() const;
     static ColorSignPublicKey deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params);
+    static ColorSignPublicKey deserialize(const uint8_t* data, size_t size, const CLWEParameters& params);
+
+    // Writes serialize() to `out` and returns the bytes written, serialized_size(); throws
+    // std::invalid_argument if `capacity` is smaller
+    size_t serialize_into(uint8_t* out, size_t capacity) const;
+
+    // Serialized size of this key, and of any key in `format_version` for `params` or for a
+    // standard parameter set. Only the t1 formats have a fixed size (earlier formats pack t to a
+    // size that depends on the key); the static forms throw std::invalid_argument for the others.
+    size_t serialized_size() const { return KEY_HEADER_BYTES + public_data.size(); }
+    static size_t serialized_size(const CLWEParameters& params, uint8_t format_version);
+    template<uint32_t Level>
+    static constexpr size_t serialized_size(uint8_t format_version) {
+        if (!key_format_has_t1(format_version)) {
+            throw std::invalid_argument("Public key format has no fixed size");
+        }
+        return KEY_HEADER_BYTES + ParameterSet<Level>::T1_BYTES;
+    }
+};
+
+// Non-owning view of a serialized public key (version || flag || rho || K || tr || t).
+// Parsing records offsets into the buffer without copying; the bytes must outlive the view.
+struct PublicKeyView {
+    const uint8_t* seed_rho = nullptr;   // 32 bytes
+    const uint8_t* seed_K = nullptr;     // 32 bytes
+    const uint8_t* hash_tr = nullptr;    // 64 bytes
+    ByteSpan public_data;
+    CLWEParameters params;
+    uint8_t format_version = KEY_FORMAT_ORIGINAL;
+    bool use_compression = false;
+
+    PublicKeyView() = default;
+    PublicKeyView(const ColorSignPublicKey& public_key);  // Views the key's own buffers
+
+    // Throws std::invalid_argument if the data is shorter than the fixed header
+    static PublicKeyView parse(const uint8_t* data, size_t size, const CLWEParameters& params);
+
+    ColorSignPublicKey to_public_key() const;
 };
 
 struct ColorSignPrivateKey {
@@ -40,7 +109,7 @@ struct ColorSignPrivateKey {
     std::array<uint8_t, 64> hash_tr;    // Hash of public key (tr)
     std::vector<uint8_t> secret_data;   // Serialized secret polynomials s1, s2, t0 (as colors)
     CLWEParameters params;               // Cryptographic parameters
-    uint8_t format_version = 0x01;       // Format version (1 = original, 2 = compressed)
+    uint8_t format_version = KEY_FORMAT_ORIGINAL;  // See KEY_FORMAT_*
     bool use_compression = false;        // Flag indicating if compression is used
 
     ColorSignPrivateKey() = default;
@@ -51,28 +120,187 @@ struct ColorSignPrivateKey {
 
     std::vector<uint8_t> serialize() const;
     static ColorSignPrivateKey deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params);
+
+    // Writes serialize() to `out` and returns the bytes written, serialized_size(); throws
+    // std::invalid_argument if `capacity` is smaller
+    size_t serialize_into(uint8_t* out, size_t capacity) const;
+
+    // Serialized size of this key, and of any key in `format_version` for `params` or for a
+    // standard parameter set (std::invalid_argument for KEY_FORMAT_COMPRESSED and unknown versions)
+    size_t serialized_size() const {
+        return is_seed_only() ? 1 + secret_data.size() + hash_tr.size() : KEY_HEADER_BYTES + secret_data.size();
+    }
+    static size_t serialized_size(const CLWEParameters& params, uint8_t format_version);
+    template<uint32_t Level>
+    static constexpr size_t serialized_size(uint8_t format_version) {
+        using Params = ParameterSet<Level>;
+        switch (format_version) {
+            case KEY_FORMAT_ORIGINAL: return KEY_HEADER_BYTES + Params::SECRET_KEY_BYTES;
+            case KEY_FORMAT_POWER2ROUND: return KEY_HEADER_BYTES + Params::SECRET_KEY_BYTES + Params::T0_BYTES;
+            case KEY_FORMAT_PACKED_SECRET: return KEY_HEADER_BYTES + Params::PACKED_SECRET_BYTES + Params::T0_BYTES;
+            case KEY_FORMAT_SEED: return SEED_KEY_SERIALIZED_BYTES;
+            default: throw std::invalid_argument("Private key format has no fixed size");
+        }
+    }
+
+    // Seed-only form of the key pair generated from `zeta` (generate_keypair_deterministic) with
+    // `public_key`: format_version is KEY_FORMAT_SEED and secret_data holds the public key's
+    // format_version followed by zeta
+    static ColorSignPrivateKey from_seed(const std::array<uint8_t, 32>& zeta, const ColorSignPublicKey& public_key);
+
+    bool is_seed_only() const { return format_version == KEY_FORMAT_SEED; }
+
+    // Full private key: seed-only keys are regenerated from zeta in the recorded format and checked
+    // against tr (std::invalid_argument on a mismatch or a malformed seed key); other keys are copied.
+    // ExpandedKeyCache keeps the result for keys that sign repeatedly.
+    ColorSignPrivateKey expand() const;
+};
+
+// Public key with compile-time storage for one standard parameter set. Only the t1 formats
+// (KEY_FORMAT_POWER2ROUND and KEY_FORMAT_PACKED_SECRET, which share this layout) have a fixed size.
+template<uint32_t Level>
+struct FixedPublicKey {
+    using Params = ParameterSet<Level>;
+    static constexpr size_t SERIALIZED_BYTES = KEY_HEADER_BYTES + Params::T1_BYTES;
+
+    std::array<uint8_t, 32> seed_rho{};
+    std::array<uint8_t, 32> seed_K{};
+    std::array<uint8_t, 64> hash_tr{};
+    std::array<uint8_t, Params::T1_BYTES> t1_data{};
+    uint8_t format_version = KEY_FORMAT_PACKED_SECRET;
+    bool use_compression = false;
+
+    std::array<uint8_t, SERIALIZED_BYTES> serialize() const;
+    static FixedPublicKey deserialize(const uint8_t* data, size_t size);
+
+    // Conversions from/to the runtime-sized key (throws for other formats or sizes)
+    static FixedPublicKey from_public_key(const ColorSignPublicKey& public_key);
+    ColorSignPublicKey to_public_key() const;
+};
+
+// Private key with compile-time storage for one standard parameter set, in the exact
+// KEY_FORMAT_PACKED_SECRET layout (s1 || s2 || t0). The secret is wiped on destruction.
+template<uint32_t Level>
+struct FixedPrivateKey {
+    using Params = ParameterSet<Level>;
+    static constexpr size_t SECRET_BYTES = Params::PACKED_SECRET_BYTES + Params::T0_BYTES;
+    static constexpr size_t SERIALIZED_BYTES = KEY_HEADER_BYTES + SECRET_BYTES;
+
+    std::array<uint8_t, 32> seed_rho{};
+    std::array<uint8_t, 32> seed_K{};
+    std::array<uint8_t, 64> hash_tr{};
+    std::array<uint8_t, SECRET_BYTES> secret_data{};
+    bool use_compression = false;
+
+    FixedPrivateKey() = default;
+    FixedPrivateKey(const FixedPrivateKey&) = default;
+    FixedPrivateKey& operator=(const FixedPrivateKey&) = default;
+    ~FixedPrivateKey();
+
+    std::array<uint8_t, SERIALIZED_BYTES> serialize() const;
+    static FixedPrivateKey deserialize(const uint8_t* data, size_t size);
+
+    // Conversions from/to the runtime-sized key (throws for other formats or sizes)
+    static FixedPrivateKey from_private_key(const ColorSignPrivateKey& private_key);
+    ColorSignPrivateKey to_private_key() const;
+};
+
+// Bounded LRU of expanded seed-only private keys, indexed by a hash of the seed key contents
+// (expanded format, zeta, tr and security level) under a random per-cache key, so no seed is kept
+// in the index. Thread-safe; entries are shared, so an expanded key stays valid for a caller
+// while it is evicted. An expanded key is wiped when its last holder releases it: at eviction or
+// clear() unless a signer still uses it.
+class ExpandedKeyCache {
+public:
+    explicit ExpandedKeyCache(size_t capacity = 64);
+    ~ExpandedKeyCache();
+
+    // Disable copy and assignment
+    ExpandedKeyCache(const ExpandedKeyCache&) = delete;
+    ExpandedKeyCache& operator=(const ExpandedKeyCache&) = delete;
+
+    // Expanded form of a seed-only key, expanding it on a miss and evicting the least recently
+    // used entry when full; other keys are returned as a copy without touching the cache
+    std::shared_ptr<const ColorSignPrivateKey> expand(const ColorSignPrivateKey& private_key);
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+    void clear();
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const ColorSignPrivateKey>>;
+
+    std::string entry_id(const ColorSignPrivateKey& private_key) const;
+
+    size_t capacity_;
+    std::array<uint8_t, 32> id_key_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;                                        // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+// Key generation kernels for one standard parameter set. Every dimension is a compile-time
+// constant and the packed secret key is a fixed-size array. Polynomial blocks use the PolyVec
+// layout (polynomial i at offset i * N). ColorSignKeyGen dispatches here for standard parameters.
+template<uint32_t Level>
+class KeyGenT {
+public:
+    using Params = ParameterSet<Level>;
+    using SecretKeyData = std::array<uint8_t, Params::SECRET_KEY_BYTES>;
+
+    // Expand A (K x K polynomials, row-major) from rho using SHAKE128
+    static void generate_matrix_A(const std::array<uint8_t, 32>& rho, uint32_t* matrix);
+
+    // Sample s1 || s2 (2K polynomials) from the key seed; `centered` selects the reduction of
+    // KEY_FORMAT_PACKED_SECRET keys (see SHAKE256Sampler::sample_polynomial_centered)
+    static void sample_secret(const std::array<uint8_t, 32>& seed_K, uint32_t* secret, bool centered = false);
+
+    // t = A * s1 + s2 mod q; `product` holds one polynomial of scratch
+    static void compute_t(const NTTEngine& ntt_engine, const uint32_t* matrix, const uint32_t* secret,
+                          uint32_t* t, uint32_t* product);
+
+    // tr = SHAKE256(rho || pack(t))
+    static std::array<uint8_t, 64> compute_tr(const uint32_t* t, const std::array<uint8_t, 32>& rho);
+
+    // Pack s1 || s2 with 10-bit ML-DSA compression
+    static void pack_secret(const PolyVec& secret, SecretKeyData& out);
+
+    // `format_version` is KEY_FORMAT_ORIGINAL, KEY_FORMAT_POWER2ROUND or KEY_FORMAT_PACKED_SECRET
+    static std::pair<ColorSignPublicKey, ColorSignPrivateKey> generate_keypair(const std::array<uint8_t, 32>& rho,
+                                                                              const std::array<uint8_t, 32>& seed_K,
+                                                                              uint8_t format_version = KEY_FORMAT_ORIGINAL);
 };
 
 // ColorSign key generation class
 class ColorSignKeyGen {
 private:
     CLWEParameters params_;
+    uint32_t fixed_level_;  // Standard parameter set served by KeyGenT (0 = runtime dimensions)
+    SchemeMetrics* metrics_;  // Registry series for this security level
+    uint8_t key_format_version_ = KEY_FORMAT_ORIGINAL;
 
     // Helper methods for key generation
-    std::vector<std::vector<uint32_t>> generate_matrix_A(const std::array<uint8_t, 32>& rho) const;
-    std::vector<std::vector<uint32_t>> sample_s1(const std::array<uint8_t, 32>& K) const;
-    std::vector<std::vector<uint32_t>> sample_s2(const std::array<uint8_t, 32>& K) const;
-    std::vector<std::vector<uint32_t>> compute_t(const std::vector<std::vector<uint32_t>>& matrix_A,
-                                                 const std::vector<std::vector<uint32_t>>& s1,
-                                                 const std::vector<std::vector<uint32_t>>& s2) const;
-    std::array<uint8_t, 64> compute_tr(const std::vector<std::vector<uint32_t>>& t,
+    PolyMat generate_matrix_A(const std::array<uint8_t, 32>& rho) const;
+    PolyVec sample_s1(const std::array<uint8_t, 32>& K, bool centered = false) const;
+    PolyVec sample_s2(const std::array<uint8_t, 32>& K, bool centered = false) const;
+    PolyVec compute_t(const PolyMat& matrix_A, const PolyVec& s1, const PolyVec& s2) const;
+    std::array<uint8_t, 64> compute_tr(const PolyVec& t,
                                        const std::array<uint8_t, 32>& rho,
                                        const std::array<uint8_t, 32>& K) const;
-    std::vector<uint8_t> encode_polynomial_vector_as_colors(const std::vector<std::vector<uint32_t>>& poly_vector) const;
-    std::vector<std::vector<uint32_t>> decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data) const;
+    std::vector<uint8_t> encode_polynomial_vector_as_colors(const PolyVec& poly_vector) const;
+    PolyVec decode_colors_to_polynomial_vector(const std::vector<uint8_t>& color_data) const;
     // Compression helper methods
-    std::vector<std::vector<uint32_t>> unpack_polynomial_data(const std::vector<uint8_t>& data, uint32_t k, uint32_t n) const;
-    std::vector<uint8_t> pack_polynomial_data(const std::vector<std::vector<uint32_t>>& poly_vector) const;
+    PolyVec unpack_polynomial_data(const std::vector<uint8_t>& data, uint32_t k, uint32_t n) const;
+    std::vector<uint8_t> pack_polynomial_data(const PolyVec& poly_vector) const;
+    std::vector<uint8_t> pack_secret_data(const PolyVec& s1, const PolyVec& s2) const;
+    std::pair<ColorSignPublicKey, ColorSignPrivateKey> derive_keypair(const std::array<uint8_t, 32>& rho,
+                                                                      const std::array<uint8_t, 32>& K) const;
+    std::pair<ColorSignPublicKey, ColorSignPrivateKey> expand_keypair(const std::array<uint8_t, 32>& rho,
+                                                                      const std::array<uint8_t, 32>& K) const;
 
 
 public:
@@ -89,6 +317,14 @@ public:
     // Deterministic key generation (for testing)
     std::pair<ColorSignPublicKey, ColorSignPrivateKey> generate_keypair_deterministic(const std::array<uint8_t, 32>& seed);
 
+    // Key pair with a seed-only private key (KEY_FORMAT_SEED, see ColorSignPrivateKey::from_seed)
+    std::pair<ColorSignPublicKey, ColorSignPrivateKey> generate_seed_keypair();
+
+    // Format of the keys generated: KEY_FORMAT_ORIGINAL (default), KEY_FORMAT_POWER2ROUND or
+    // KEY_FORMAT_PACKED_SECRET; throws std::invalid_argument for other versions
+    void set_key_format_version(uint8_t version);
+    uint8_t key_format_version() const { return key_format_version_; }
+
     // Getters
     const CLWEParameters& params() const { return params_; }
 };
@@ -0,0 +1,187 @@
+#ifndef CLWE_METRICS_HPP
+#define CLWE_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace clwe {
+
+// Label set of one series, e.g. {{"operation", "sign"}, {"level", "44"}}
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Metrics are recorded into one of METRIC_SHARDS shards picked per thread, so concurrent
+// threads rarely touch the same cache line; scrapes merge the shards.
+constexpr size_t METRIC_SHARDS = 16;
+size_t metric_shard();
+
+// Monotonic counter
+class Counter {
+public:
+    void add(uint64_t n = 1) noexcept { shards_[metric_shard()].value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const noexcept;
+    void reset() noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, METRIC_SHARDS> shards_;
+};
+
+// Value that goes up and down (e.g. bytes of locked memory)
+class Gauge {
+public:
+    void set(int64_t value) noexcept { value_.store(value, std::memory_order_relaxed); }
+    void add(int64_t delta) noexcept { value_.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+// HDR-style latency histogram in nanoseconds. Values below 16 ns have exact buckets; each
+// higher power of two is split into 16 linear sub-buckets, bounding the relative error of
+// reported quantiles by 1/16. Values above 2^37 ns (~2.3 min) land in the last bucket.
+// A shard is allocated the first time a thread mapped to it records.
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_EXPONENT = 36;
+    static constexpr size_t BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    // Merged view of all shards
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+
+        // Upper bound of the bucket holding the q-quantile (0 <= q <= 1), capped at max_ns
+        uint64_t percentile(double q) const;
+        // Values recorded in buckets whose upper bound is at most `ns`
+        uint64_t count_at_or_below(uint64_t ns) const;
+    };
+
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    // Disable copy and assignment
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t ns);
+    Snapshot snapshot() const;
+    uint64_t percentile(double q) const { return snapshot().percentile(q); }
+    void reset() noexcept;
+
+    static size_t bucket_index(uint64_t ns) noexcept;
+    static uint64_t bucket_upper_bound(size_t index) noexcept;
+
+private:
+    struct Shard;
+
+    Shard& shard();
+
+    std::array<std::atomic<Shard*>, METRIC_SHARDS> shards_;
+};
+
+// Named, labelled metrics with Prometheus text exposition. Registration takes a lock and
+// returns a reference that stays valid for the registry's lifetime; hot paths register once
+// and keep the reference. Registering an existing name and label set returns the same metric.
+class MetricsRegistry {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    // Disable copy and assignment
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Throw std::invalid_argument if `name` is already registered as another type
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    LatencyHistogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    // Prometheus text format (version 0.0.4). Histograms are exported in seconds with fixed
+    // 1-2.5-5 buckets from 1 us to 10 s, plus a `<name>_quantile` gauge family carrying the
+    // HDR p50, p90, p99 and p999.
+    std::string prometheus_text() const;
+
+    // Write prometheus_text() to `path` via a temporary file and rename, so scrapers never
+    // read a partial file. Throws std::runtime_error on I/O failure.
+    void write_prometheus(const std::string& path) const;
+
+    // Reset all counters and histograms (gauges keep their values)
+    void reset();
+
+    // Registry the library records into
+    static MetricsRegistry& global();
+
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::deque<Series> series;  // Grows at the end without moving the series handed out
+    };
+
+    Series& series(const std::string& name, const std::string& help, Type type, const MetricLabels& labels);
+
+    std::map<std::string, Family> families_;  // Sorted, for stable output
+    mutable std::mutex mutex_;
+};
+
+// The library's own metrics for one security level, registered in MetricsRegistry::global():
+//   colorsign_operation_duration_seconds{operation, stage, level}   keygen, sign and verify latency
+//   colorsign_operations_total{operation, level}
+//   colorsign_sign_rejections_total{level}                           rejected signing attempts
+//   colorsign_matrix_cache_total{result, level}                      workspace matrix A cache hits / misses
+//   colorsign_bytes_hashed_total{operation, level}                   message bytes absorbed
+struct SchemeMetrics {
+    LatencyHistogram& keygen_latency;
+    LatencyHistogram& sign_latency;             // stage="total"
+    LatencyHistogram& sign_prepare_latency;     // stage="prepare": validation and message hashing
+    LatencyHistogram& sign_setup_latency;       // stage="setup": secret decoding and matrix expansion
+    LatencyHistogram& sign_rejection_latency;   // stage="rejection_sampling"
+    LatencyHistogram& verify_latency;           // stage="total"
+    LatencyHistogram& verify_prepare_latency;   // stage="prepare": message hashing
+    LatencyHistogram& verify_check_latency;     // stage="check": decoding, w' and the challenge check
+    Counter& keypairs;
+    Counter& signatures;
+    Counter& verifications;
+    Counter& sign_rejections;
+    Counter& matrix_cache_hits;
+    Counter& matrix_cache_misses;
+    Counter& sign_bytes_hashed;
+    Counter& verify_bytes_hashed;
+
+    static SchemeMetrics& for_level(uint32_t security_level);
+};
+
+// colorsign_secure_arena_locked_bytes: memory pinned by all live SecureArenas
+Gauge& secure_memory_locked_gauge();
+
+// colorsign_secure_arena_lock_failures_total: SecureArenas whose region could not be locked
+Counter& secure_memory_lock_failures();
+
+} // namespace clwe
+
+#endif // CLWE_METRICS_HPP
@@ -0,0 +1,81 @@
+#ifndef CLWE_PARAMETER_SET_HPP
+#define CLWE_PARAMETER_SET_HPP
+
+#include "parameters.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace clwe {
+
+// Compile-time form of a standard ML-DSA parameter set (security level 44, 65 or 87).
+// The values mirror CLWEParameters(Level). KeyGenT, ColorSignT and ColorSignVerifyT use
+// them as constexpr loop bounds and buffer extents.
+template<uint32_t Level>
+struct ParameterSet {
+    static_assert(Level == 44 || Level == 65 || Level == 87, "Security level must be 44, 65, or 87");
+
+    static constexpr uint32_t SECURITY_LEVEL = Level;
+    static constexpr uint32_t N = 256;                                     // Ring degree
+    static constexpr uint32_t Q = 8380417;                                 // Prime modulus
+    static constexpr uint32_t K = Level == 44 ? 4 : Level == 65 ? 6 : 8;   // Module rank
+    static constexpr uint32_t L = Level == 44 ? 4 : Level == 65 ? 5 : 7;   // Repetitions
+    static constexpr uint32_t ETA = Level == 65 ? 4 : 2;
+    static constexpr uint32_t TAU = Level == 44 ? 39 : Level == 65 ? 49 : 60;
+    static constexpr uint32_t BETA = Level == 44 ? 78 : Level == 65 ? 196 : 120;
+    static constexpr uint32_t GAMMA1 = Level == 44 ? (1u << 17) : (1u << 19);
+    static constexpr uint32_t GAMMA2 = Level == 44 ? (Q - 1) / 88 : (Q - 1) / 32;
+    static constexpr uint32_t OMEGA = Level == 44 ? 80 : Level == 65 ? 55 : 75;
+    static constexpr uint32_t LAMBDA = Level == 44 ? 128 : Level == 65 ? 192 : 256;
+
+    // Coefficients in one vector of K polynomials
+    static constexpr size_t VECTOR_COEFFS = static_cast<size_t>(K) * N;
+
+    // Serialized sizes. z is packed at 18 bits without a header; s1 || s2 is packed at
+    // 10 bits behind the 6-byte ML-DSA packing header (see ml_dsa_packed_size).
+    static constexpr size_t Z_BYTES = (VECTOR_COEFFS * 18 + 7) / 8;
+    static constexpr size_t H_BYTES = OMEGA;
+    static constexpr size_t C_BYTES = (N + 3) / 4;
+    static constexpr size_t SIGNATURE_BYTES = Z_BYTES + H_BYTES + C_BYTES;
+    static constexpr size_t SECRET_KEY_BYTES = 6 + (2 * VECTOR_COEFFS * 10 + 7) / 8;
+    static constexpr size_t CHALLENGE_SEED_BYTES = 64 + 2 * VECTOR_COEFFS;  // mu || encoded w1
+
+    // FIPS 204 signature components (SignatureFormat::FIPS204): z exactly as gamma1 - z in
+    // log2(gamma1) + 1 bits, the hint as per-polynomial index lists and c as the c~ seed
+    static constexpr uint32_t GAMMA1_BITS = Level == 44 ? 18 : 20;
+    static constexpr size_t FIPS_Z_BYTES = VECTOR_COEFFS * GAMMA1_BITS / 8;
+    static constexpr size_t FIPS_H_BYTES = OMEGA + K;
+    static constexpr size_t FIPS_C_BYTES = LAMBDA / 4;
+    static constexpr size_t FIPS_SIGNATURE_BYTES = FIPS_Z_BYTES + FIPS_H_BYTES + FIPS_C_BYTES;
+
+    // Power2Round keys (KEY_FORMAT_POWER2ROUND): t1 at 10 bits in the public key, t0 at 13 bits
+    // after s1 || s2 in the private key
+    static constexpr size_t T1_BYTES = VECTOR_COEFFS * 10 / 8;
+    static constexpr size_t T0_BYTES = VECTOR_COEFFS * 13 / 8;
+
+    // Exact s1 || s2 of KEY_FORMAT_PACKED_SECRET keys, each vector as eta - s
+    static constexpr uint32_t ETA_BITS = ETA == 2 ? 3 : 4;
+    static constexpr size_t PACKED_SECRET_BYTES = 2 * VECTOR_COEFFS * ETA_BITS / 8;
+
+    // True when runtime parameters are exactly this set
+    static bool matches(const CLWEParameters& params) {
+        return params.security_level == SECURITY_LEVEL && params.degree == N && params.modulus == Q &&
+               params.module_rank == K && params.repetitions == L && params.eta == ETA &&
+               params.tau == TAU && params.beta == BETA && params.gamma1 == GAMMA1 &&
+               params.gamma2 == GAMMA2 && params.omega == OMEGA && params.lambda == LAMBDA;
+    }
+};
+
+// Security level of the standard parameter set equal to `params`, or 0 for custom parameters.
+// The runtime classes switch on this to reach the fixed-dimension kernels.
+inline uint32_t standard_parameter_set(const CLWEParameters& params) {
+    switch (params.security_level) {
+        case 44: return ParameterSet<44>::matches(params) ? 44 : 0;
+        case 65: return ParameterSet<65>::matches(params) ? 65 : 0;
+        case 87: return ParameterSet<87>::matches(params) ? 87 : 0;
+        default: return 0;
+    }
+}
+
+} // namespace clwe
+
+#endif // CLWE_PARAMETER_SET_HPP
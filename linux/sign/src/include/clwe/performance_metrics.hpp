@@ -0,0 +1,208 @@
+#ifndef PERFORMANCE_METRICS_HPP
+#define PERFORMANCE_METRICS_HPP
+
+#include "security_utils.hpp"
+#include "trace.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace clwe {
+
+// Memory usage statistics
+struct MemoryStats {
+    size_t current_memory;  // Current memory usage in bytes (resident set)
+    size_t peak_memory;     // Peak memory usage in bytes
+    size_t average_memory;  // Average memory usage in bytes
+};
+
+// CPU cycle statistics
+struct CycleStats {
+    uint64_t total_cycles;    // Total CPU cycles
+    uint64_t average_cycles;  // Average CPU cycles per operation
+    uint64_t min_cycles;      // Minimum CPU cycles
+    uint64_t max_cycles;      // Maximum CPU cycles
+};
+
+// High-precision timing statistics
+struct TimingStats {
+    double total_time;      // Total time in microseconds
+    double average_time;    // Average time per operation in microseconds
+    double min_time;        // Minimum time in microseconds
+    double max_time;        // Maximum time in microseconds
+    double throughput;      // Operations per second
+};
+
+// Hardware event counts. Events the kernel does not provide read as zero; without perf
+// events, cycles are TimestampCounter ticks.
+struct HardwareCounters {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+
+    HardwareCounters& operator+=(const HardwareCounters& other);
+    HardwareCounters operator-(const HardwareCounters& other) const;
+};
+
+// perf_event_open counter group for the calling thread: cycles, instructions, cache misses
+// and branch misses, read with one syscall. When perf events are unavailable (restrictive
+// perf_event_paranoid, containers, non-Linux) the group falls back to the rdtsc-based
+// TimestampCounter for cycles. Must be read from the thread that created it.
+class PerfEventGroup {
+public:
+    enum Event : uint32_t { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+    PerfEventGroup();
+    ~PerfEventGroup();
+
+    // Disable copy and assignment
+    PerfEventGroup(const PerfEventGroup&) = delete;
+    PerfEventGroup& operator=(const PerfEventGroup&) = delete;
+
+    HardwareCounters read() const;
+    bool hardware() const { return leader_fd_ >= 0; }      // Cycles come from perf events
+    bool counts(Event event) const { return slots_[event] >= 0; }
+
+private:
+    int leader_fd_ = -1;
+    std::array<int, EVENT_COUNT> fds_;
+    std::array<int, EVENT_COUNT> slots_;   // Position in the group read, -1 = not opened
+    uint32_t opened_ = 0;
+};
+
+// Stages of keygen, sign and verify attributed by ScopedStage probes. Stages are inclusive:
+// time spent in a nested probe counts towards both stages.
+enum class PerfStage : uint32_t {
+    MATRIX_EXPANSION,   // ExpandA
+    NTT,                // NTT-domain polynomial products (A*y, c*s1, c*s2, A*z - c*t, A*s1)
+    SAMPLING,           // y, secret and challenge sampling
+    PACKING,            // Key and signature encoding and decoding, hints
+    HASHING,            // mu, rho', tr
+    COUNT
+};
+
+constexpr const char* perf_stage_name(PerfStage stage) {
+    switch (stage) {
+        case PerfStage::MATRIX_EXPANSION: return "matrix_expansion";
+        case PerfStage::NTT: return "ntt";
+        case PerfStage::SAMPLING: return "sampling";
+        case PerfStage::PACKING: return "packing";
+        case PerfStage::HASHING: return "hashing";
+        default: return "unknown";
+    }
+}
+
+// Totals of one stage over all threads
+struct StageStats {
+    PerfStage stage;
+    uint64_t calls = 0;
+    uint64_t time_ns = 0;
+    HardwareCounters counters;
+    uint64_t allocations = 0;       // Heap allocations; zero unless allocation hooks are linked in
+    uint64_t allocated_bytes = 0;
+};
+
+// Process-wide stage profiling, off by default. Every thread that runs a probe gets its own
+// counter group and accumulators; breakdown() merges live threads with the totals of exited
+// ones. While disabled a probe costs one relaxed load.
+class StageProfiler {
+public:
+    static void enable(bool enabled);
+    static bool enabled() { return INSTRUMENTATION_ENABLED && enabled_.load(std::memory_order_relaxed); }
+
+    static std::vector<StageStats> breakdown();
+    static void reset();
+
+    // Whether probes on the calling thread read hardware counters
+    static bool hardware_counters();
+
+private:
+    friend class ScopedStage;
+
+    static std::atomic<bool> enabled_;
+};
+
+// RAII stage probe; with Tracer enabled it also records a span named after the stage
+class ScopedStage {
+public:
+    explicit ScopedStage(PerfStage stage)
+        : stage_(stage), active_(StageProfiler::enabled()), span_(perf_stage_name(stage)) {
+        if (active_) begin();
+    }
+    ~ScopedStage() {
+        if (active_) end();
+    }
+
+    // Disable copy and assignment
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+
+private:
+    void begin();
+    void end();
+
+    PerfStage stage_;
+    bool active_;
+    uint64_t start_ticks_ = 0;
+    HardwareCounters start_counters_;
+    uint64_t start_allocations_ = 0;
+    uint64_t start_allocated_bytes_ = 0;
+    TraceSpan span_;
+};
+
+// Performance measurement class
+class PerformanceMetrics {
+public:
+    // Get current memory usage
+    static MemoryStats get_memory_usage();
+
+    // Time an operation with memory tracking
+    static TimingStats time_operation_with_memory(
+        const std::function<void()>& operation,
+        MemoryStats& memory_stats,
+        int iterations = 100
+    );
+
+    // Time an operation with CPU cycle counting
+    static CycleStats time_operation_cycles(
+        const std::function<void()>& operation,
+        int iterations = 100
+    );
+
+    // High-precision timing only
+    static TimingStats time_operation(
+        const std::function<void()>& operation,
+        int iterations = 100
+    );
+
+    // Hardware counters per operation, averaged over `iterations`
+    static HardwareCounters count_operation(
+        const std::function<void()>& operation,
+        int iterations = 100
+    );
+
+    // Combined measurement (timing + memory + cycles + hardware counters)
+    struct CombinedStats {
+        TimingStats timing;
+        MemoryStats memory;
+        CycleStats cycles;
+        HardwareCounters hardware;   // Per-operation averages
+    };
+
+    static CombinedStats measure_operation(
+        const std::function<void()>& operation,
+        int iterations = 100
+    );
+
+private:
+    // Platform-specific implementations
+    static MemoryStats get_memory_usage_impl();
+    static uint64_t get_cpu_cycles_impl();
+};
+
+} // namespace clwe
+
+#endif // PERFORMANCE_METRICS_HPP
@@ -0,0 +1,148 @@
+#ifndef CLWE_POLYVEC_HPP
+#define CLWE_POLYVEC_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory_resource>
+#include <type_traits>
+
+namespace clwe {
+
+// Alignment of polynomial storage (one cache line / one AVX-512 register)
+constexpr size_t POLY_ALIGNMENT = 64;
+
+// Non-owning view of one polynomial's coefficients (std::span stand-in for C++17)
+template<typename T>
+class CoeffSpan {
+public:
+    CoeffSpan() = default;
+    CoeffSpan(T* data, size_t size) : data_(data), size_(size) {}
+
+    // Mutable spans convert to const spans
+    template<typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+    CoeffSpan(const CoeffSpan<U>& other) : data_(other.data()), size_(other.size()) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+using PolySpan = CoeffSpan<uint32_t>;
+using ConstPolySpan = CoeffSpan<const uint32_t>;
+using ByteSpan = CoeffSpan<const uint8_t>;  // Read-only bytes (messages, serialized keys and signatures)
+
+// Iterates a contiguous block polynomial by polynomial, yielding spans
+template<typename T>
+class PolyIterator {
+public:
+    PolyIterator(T* data, size_t n) : data_(data), n_(n) {}
+
+    CoeffSpan<T> operator*() const { return CoeffSpan<T>(data_, n_); }
+    PolyIterator& operator++() { data_ += n_; return *this; }
+    bool operator==(const PolyIterator& other) const { return data_ == other.data_; }
+    bool operator!=(const PolyIterator& other) const { return data_ != other.data_; }
+
+private:
+    T* data_;
+    size_t n_;
+};
+
+// Vector of k polynomials of degree n stored contiguously in one 64-byte-aligned block.
+// Polynomial i starts at data() + i * n, so with n a multiple of 16 every polynomial is
+// itself 64-byte aligned. Move-only; use clone() for an explicit deep copy.
+// Storage comes from aligned operator new unless a memory resource (for example a
+// SecureArena for secret polynomials) is given; clones share the resource.
+class PolyVec {
+public:
+    PolyVec() = default;
+    PolyVec(uint32_t k, uint32_t n);  // Zero-initialized
+    PolyVec(uint32_t k, uint32_t n, std::pmr::memory_resource* resource);
+    ~PolyVec();
+
+    PolyVec(PolyVec&& other) noexcept;
+    PolyVec& operator=(PolyVec&& other) noexcept;
+
+    // Disable copy and assignment
+    PolyVec(const PolyVec&) = delete;
+    PolyVec& operator=(const PolyVec&) = delete;
+
+    uint32_t size() const { return k_; }          // Number of polynomials
+    uint32_t degree() const { return n_; }
+    size_t coeff_count() const { return static_cast<size_t>(k_) * n_; }
+    bool empty() const { return k_ == 0; }
+
+    uint32_t* data() { return coeffs_; }
+    const uint32_t* data() const { return coeffs_; }
+    std::pmr::memory_resource* resource() const { return resource_; }  // nullptr = operator new
+
+    PolySpan operator[](size_t i) { return PolySpan(coeffs_ + i * n_, n_); }
+    ConstPolySpan operator[](size_t i) const { return ConstPolySpan(coeffs_ + i * n_, n_); }
+
+    PolyIterator<uint32_t> begin() { return PolyIterator<uint32_t>(coeffs_, n_); }
+    PolyIterator<uint32_t> end() { return PolyIterator<uint32_t>(coeffs_ + coeff_count(), n_); }
+    PolyIterator<const uint32_t> begin() const { return PolyIterator<const uint32_t>(coeffs_, n_); }
+    PolyIterator<const uint32_t> end() const { return PolyIterator<const uint32_t>(coeffs_ + coeff_count(), n_); }
+
+    void fill(uint32_t value);
+    PolyVec clone() const;
+
+    // Conversions from/to the nested vector representation used by the original API
+    static PolyVec from_vectors(const std::vector<std::vector<uint32_t>>& poly_vector);
+    std::vector<std::vector<uint32_t>> to_vectors() const;
+
+private:
+    void release();
+
+    uint32_t* coeffs_ = nullptr;
+    uint32_t k_ = 0;
+    uint32_t n_ = 0;
+    std::pmr::memory_resource* resource_ = nullptr;
+};
+
+// rows x cols matrix of degree-n polynomials, stored row-major in one aligned block
+// (entry (i, j) is polynomial i * cols + j). Move-only.
+class PolyMat {
+public:
+    PolyMat() = default;
+    PolyMat(uint32_t rows, uint32_t cols, uint32_t n);  // Zero-initialized
+
+    PolyMat(PolyMat&&) noexcept = default;
+    PolyMat& operator=(PolyMat&&) noexcept = default;
+
+    // Disable copy and assignment
+    PolyMat(const PolyMat&) = delete;
+    PolyMat& operator=(const PolyMat&) = delete;
+
+    uint32_t rows() const { return rows_; }
+    uint32_t cols() const { return cols_; }
+    uint32_t degree() const { return polys_.degree(); }
+
+    uint32_t* data() { return polys_.data(); }
+    const uint32_t* data() const { return polys_.data(); }
+
+    PolySpan operator()(size_t i, size_t j) { return polys_[i * cols_ + j]; }
+    ConstPolySpan operator()(size_t i, size_t j) const { return polys_[i * cols_ + j]; }
+
+    // All entries as one flat polynomial vector
+    const PolyVec& polys() const { return polys_; }
+
+    static PolyMat from_vectors(const std::vector<std::vector<uint32_t>>& matrix, uint32_t rows, uint32_t cols);
+    std::vector<std::vector<uint32_t>> to_vectors() const { return polys_.to_vectors(); }
+
+private:
+    PolyVec polys_;
+    uint32_t rows_ = 0;
+    uint32_t cols_ = 0;
+};
+
+} // namespace clwe
+
+#endif // CLWE_POLYVEC_HPP
@@ -0,0 +1,106 @@
+#ifndef CLWE_SECURE_ARENA_HPP
+#define CLWE_SECURE_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+
+namespace clwe {
+
+// What a SecureArena does when the OS refuses to lock its region in RAM
+enum class MemoryLockPolicy {
+    BEST_EFFORT,  // Keep the unlocked region; warn on stderr and count it in the metrics
+    REQUIRED      // Throw std::system_error from the constructor
+};
+
+// Usage counters of a SecureArena
+struct SecureArenaStats {
+    size_t capacity = 0;             // Bytes reserved for the arena
+    size_t locked_bytes = 0;         // Bytes pinned in RAM (0 if mlock was refused, e.g. by RLIMIT_MEMLOCK)
+    size_t bytes_in_use = 0;         // Bytes handed out, rounded up to the block granularity
+    size_t peak_bytes_in_use = 0;
+    size_t active_allocations = 0;
+    uint64_t total_allocations = 0;
+    uint64_t failed_allocations = 0;  // Requests the arena could not satisfy (std::bad_alloc)
+};
+
+// Memory resource for secret material (s1, s2, y, z). The whole region is reserved, locked
+// and excluded from core dumps once at construction; allocations are carved out of it with
+// a bump pointer and an address-ordered free list, so no system call happens per buffer.
+// Blocks are wiped when released and the region is wiped again on destruction.
+// Thread-safe. Alignments above BLOCK_ALIGNMENT are not supported, and releasing a pointer
+// the arena did not hand out throws std::invalid_argument.
+class SecureArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+    explicit SecureArena(size_t capacity, MemoryLockPolicy lock_policy = MemoryLockPolicy::BEST_EFFORT);
+    ~SecureArena() override;
+
+    // Disable copy and assignment
+    SecureArena(const SecureArena&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+
+    SecureArenaStats stats() const;
+    size_t capacity() const { return capacity_; }
+    bool locked() const { return locked_; }
+
+    // True if `ptr` points into this arena's region
+    bool owns(const void* ptr) const;
+
+private:
+    struct FreeBlock {
+        size_t size;
+        FreeBlock* next;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    uint8_t* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t bump_ = 0;                 // Offset of the first never-used byte
+    FreeBlock* free_list_ = nullptr;  // Released blocks below bump_, ordered by address
+    bool locked_ = false;
+    SecureArenaStats stats_;
+    mutable std::mutex mutex_;
+};
+
+// Process-wide arena (1 MiB) for callers without their own
+SecureArena& default_secure_arena();
+
+// Standard allocator over a SecureArena, e.g. std::vector<uint8_t, SecureArenaAllocator<uint8_t>>
+template<typename T>
+class SecureArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit SecureArenaAllocator(SecureArena& arena) noexcept : arena_(&arena) {}
+    template<typename U>
+    SecureArenaAllocator(const SecureArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* ptr, size_t n) noexcept { arena_->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    SecureArena* arena() const noexcept { return arena_; }
+
+    template<typename U>
+    bool operator==(const SecureArenaAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+    template<typename U>
+    bool operator!=(const SecureArenaAllocator<U>& other) const noexcept { return arena_ != other.arena(); }
+
+private:
+    SecureArena* arena_;
+};
+
+} // namespace clwe
+
+#endif // CLWE_SECURE_ARENA_HPP
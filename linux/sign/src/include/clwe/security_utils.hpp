@@ -8,7 +8,10 @@
 #include <chrono>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <stdexcept>
+#include "polyvec.hpp"
+#include "timing.hpp"
 
 namespace clwe {
 
@@ -63,6 +66,23 @@ struct AuditEntry {
     uint32_t error_code;
 };
 
+// Building with CLWE_NO_INSTRUMENTATION (CMake: -DCOLORSIGN_INSTRUMENTATION=OFF) compiles
+// audit, timing and counter instrumentation out of the signing path
+#ifdef CLWE_NO_INSTRUMENTATION
+constexpr bool INSTRUMENTATION_ENABLED = false;
+#else
+constexpr bool INSTRUMENTATION_ENABLED = true;
+#endif
+
+// How much of the signing path is instrumented. Security violations and input validation
+// failures are reported at every level; the levels govern the per-signature work.
+enum class InstrumentationLevel {
+    OFF,       // Nothing beyond violation reports
+    COUNTERS,  // Relaxed atomic counters (signatures, rejection restarts, ...)
+    SAMPLED,   // Counters, plus timing and audit events for one signature in every sample interval
+    FULL       // Every signature timed and audited, and y re-validated on each attempt
+};
+
 // Security monitoring interface
 class SecurityMonitor {
 public:
@@ -72,48 +92,66 @@ public:
     virtual bool detect_timing_anomaly(const std::string& operation_name, uint64_t operation_time_ns) = 0;
 };
 
-// Default security monitor implementation
+// Default security monitor implementation. Thread-safe; the audit log is a circular buffer,
+// so once full each event overwrites the oldest slot (reusing its string buffers) in O(1).
+// For high-rate auditing see BinaryAuditMonitor in audit.hpp.
 class DefaultSecurityMonitor : public SecurityMonitor {
 private:
     std::vector<AuditEntry> audit_log_;
-    std::map<std::string, std::vector<uint64_t>> operation_histories_;
-    std::map<std::string, double> operation_k_values_;
-    std::map<std::string, int> consecutive_anomalies_;
-    size_t max_history_size_ = 100;
-    size_t min_samples_for_stats_ = 10;
+    size_t log_head_ = 0;  // Index of the oldest entry once the log has wrapped
+    TimingAnomalyDetector timing_detector_;
     size_t max_log_size_ = 1000;
+    mutable std::mutex log_mutex_;
+
+    void unwrap_audit_log();
 
 public:
     void log_event(const AuditEntry& entry) override;
     void report_security_violation(SecurityError error, const std::string& details) override;
     bool detect_timing_anomaly(const std::string& operation_name, uint64_t operation_time_ns) override;
-    const std::vector<AuditEntry>& get_audit_log() const { return audit_log_; }
-    void clear_audit_log() { audit_log_.clear(); }
+    bool detect_timing_anomaly(OperationId operation, uint64_t operation_time_ns);
+
+    // Intern an operation name for the id-based detect_timing_anomaly
+    OperationId register_operation(const std::string& operation_name) {
+        return timing_detector_.register_operation(operation_name);
+    }
+    OperationTimingStats operation_stats(OperationId operation) const { return timing_detector_.stats(operation); }
+
+    // Snapshot of the log, oldest entry first, copied under the log lock so it stays valid
+    // while other threads keep logging
+    std::vector<AuditEntry> get_audit_log() const;
+    void clear_audit_log();
 
     // Configure threshold multiplier for operation type (default k=3.0)
     void set_operation_threshold(const std::string& operation_name, double k_value) {
-        operation_k_values_[operation_name] = k_value;
+        timing_detector_.set_threshold(timing_detector_.register_operation(operation_name), k_value);
     }
 
-    // Set maximum history size for statistical calculations
-    void set_max_history_size(size_t size) { max_history_size_ = size; }
+    // Set maximum history size for statistical calculations (applies to threads that
+    // have not yet timed the operation)
+    void set_max_history_size(size_t size) { timing_detector_.set_window(size); }
 
-    // Set maximum audit log size
-    void set_max_log_size(size_t size) { max_log_size_ = size; }
+    // Set maximum audit log size, dropping the oldest entries if the log is larger
+    void set_max_log_size(size_t size);
 };
 
 // Input validation utilities
 class InputValidator {
 public:
     static SecurityError validate_message_size(const std::vector<uint8_t>& message);
+    static SecurityError validate_message_size(const uint8_t* message, size_t message_len);
     static SecurityError validate_key_size(const std::vector<uint8_t>& key_data);
     static SecurityError validate_signature_size(const std::vector<uint8_t>& signature);
     static SecurityError validate_parameters(const struct CLWEParameters& params);
     static SecurityError validate_key_format(const std::vector<uint8_t>& key_data, const CLWEParameters& params);
     static SecurityError validate_context_string(const std::vector<uint8_t>& context);
+    static SecurityError validate_context_string(const uint8_t* context, size_t context_len);
     static SecurityError validate_polynomial_vector_bounds(const std::vector<std::vector<uint32_t>>& poly_vec,
                                                            uint32_t expected_k, uint32_t expected_n,
                                                            int32_t min_val, int32_t max_val, uint32_t q);
+    static SecurityError validate_polynomial_vector_bounds(const PolyVec& poly_vec,
+                                                           uint32_t expected_k, uint32_t expected_n,
+                                                           int32_t min_val, int32_t max_val, uint32_t q);
 };
 
 // Memory safety utilities
@@ -196,19 +234,29 @@ public:
     static uint32_t ct_array_access(const uint32_t* array, size_t size, size_t index);
 };
 
-// Timing attack mitigation
+// Timing attack mitigation. Durations are measured with TimestampCounter and fed to a
+// TimingAnomalyDetector; anomalies are reported to the monitor. Hot paths register their
+// operations once; every call takes the start time explicitly, so nothing is shared between
+// concurrent operations.
 class TimingProtection {
 private:
-    uint64_t operation_start_time_;
     std::unique_ptr<SecurityMonitor> monitor_;
+    TimingAnomalyDetector detector_;
 
 public:
     TimingProtection(std::unique_ptr<SecurityMonitor> monitor = nullptr);
     ~TimingProtection();
 
-    void start_operation();
-    void end_operation(const std::string& operation_name);
-    uint64_t get_operation_time_ns() const;
+    OperationId register_operation(const std::string& operation_name,
+                                   double k_value = TimingAnomalyDetector::DEFAULT_THRESHOLD);
+
+    // Returns the start time in TimestampCounter ticks
+    uint64_t start_operation();
+    void end_operation(const std::string& operation_name, uint64_t start_ticks);
+    void end_operation(OperationId operation, uint64_t start_ticks);
+    uint64_t get_operation_time_ns(uint64_t start_ticks) const;
+
+    OperationTimingStats operation_stats(OperationId operation) const { return detector_.stats(operation); }
 };
 
 // Error handling utilities
@@ -2,19 +2,26 @@
 #define CLWE_SIGN_HPP
 
 #include "parameters.hpp"
+#include "parameter_set.hpp"
 #include "keygen.hpp"
 #include "security_utils.hpp"
 #include "utils.hpp"
+#include "polyvec.hpp"
 #include <vector>
 #include <array>
 #include <memory>
+#include <atomic>
+#include <exception>
 
 namespace clwe {
 
 // Forward declarations
 struct ColorSignature;
 class ColorSign;
+class NTTEngine;
+class WorkerPool;
 struct COSE_Sign1;
+class MessageHashStream;
 
 // COSE Algorithm Identifiers for ML-DSA
 constexpr int COSE_ALG_ML_DSA_44 = -8;
@@ -44,51 +51,339 @@ enum class ColorSignSignError {
     SIDE_CHANNEL_DETECTED
 };
 
+// Signing counters, maintained from InstrumentationLevel::COUNTERS up
+struct SigningCounters {
+    uint64_t signatures = 0;           // Signatures produced
+    uint64_t rejection_restarts = 0;   // Rejected attempts, all causes
+    uint64_t w1_rejections = 0;        // Attempts rejected on the w1 bound
+    uint64_t z_rejections = 0;         // Attempts rejected on the z bound
+    uint64_t hint_rejections = 0;      // Attempts rejected for more than omega hints (FIPS 204 format)
+    uint64_t y_bound_violations = 0;   // Sampled y out of range (a security violation)
+    uint64_t validation_failures = 0;  // Signing requests rejected by input validation
+    uint64_t traced_signatures = 0;    // Signatures timed and audited (SAMPLED and FULL)
+};
+
+// Encoding of the signature components
+enum class SignatureFormat : uint8_t {
+    LEGACY = 0,    // z compressed to 18 bits, omega-byte hint bitmap, c at 2 bits per coefficient
+    FIPS204 = 1    // FIPS 204 sigEncode: z exactly as gamma1 - z, hint index lists, c~ seed
+};
+
+// Serialized FIPS 204 signatures start with SIGNATURE_MAGIC and SIGNATURE_FORMAT_VERSION.
+// Legacy signatures carry no header and are recognised by their size.
+constexpr uint8_t SIGNATURE_MAGIC = 0xC5;
+constexpr uint8_t SIGNATURE_FORMAT_VERSION = 2;
+constexpr size_t SIGNATURE_HEADER_BYTES = 2;
+
+// Component sizes of a signature for one parameter set and format
+struct SignatureLayout {
+    size_t z_bytes = 0;
+    size_t h_bytes = 0;
+    size_t c_bytes = 0;
+
+    size_t components() const { return z_bytes + h_bytes + c_bytes; }
+};
+
+// Throws std::invalid_argument for FIPS204 with a gamma1 that is not a power of two
+SignatureLayout signature_layout(const CLWEParameters& params, SignatureFormat format);
+
 // Signature structure for ColorSign (ML-DSA format: z, h, c)
 struct ColorSignature {
     std::vector<uint8_t> z_data;         // Signature polynomial z (standard ML-DSA packing)
     std::vector<uint8_t> h_data;         // Hint vector h (compressed)
     std::vector<uint8_t> c_data;         // Challenge polynomial c (packed)
     CLWEParameters params;               // Cryptographic parameters
+    SignatureFormat format = SignatureFormat::LEGACY;
 
     ColorSignature() = default;
     ColorSignature(const std::vector<uint8_t>& z, const std::vector<uint8_t>& h, const std::vector<uint8_t>& c, const CLWEParameters& p);
 
+    // Legacy signatures serialize as z || h || c, FIPS 204 ones as header || z || h || c.
+    // Deserialization accepts both.
     std::vector<uint8_t> serialize() const;
+
+    // Writes serialize() to `out` and returns the bytes written, serialized_size(); throws
+    // std::invalid_argument if `capacity` is smaller
+    size_t serialize_into(uint8_t* out, size_t capacity) const;
+
+    // Serialized size of this signature, and of any signature in `format` for `params` or for a
+    // standard parameter set (the runtime form throws like signature_layout)
+    size_t serialized_size() const;
+    static size_t serialized_size(const CLWEParameters& params, SignatureFormat format);
+    template<uint32_t Level>
+    static constexpr size_t serialized_size(SignatureFormat format) {
+        return format == SignatureFormat::FIPS204
+            ? SIGNATURE_HEADER_BYTES + ParameterSet<Level>::FIPS_SIGNATURE_BYTES
+            : ParameterSet<Level>::SIGNATURE_BYTES;
+    }
+
     static ColorSignature deserialize(const std::vector<uint8_t>& data, const CLWEParameters& params);
+    static ColorSignature deserialize(const uint8_t* data, size_t size, const CLWEParameters& params);
+};
+
+// Non-owning view of a serialized signature ([header ||] z || h || c). Parsing only checks the
+// size and header and records where each component starts, so a signature can be verified
+// straight out of a receive buffer. The viewed bytes must outlive the view.
+struct SignatureView {
+    ByteSpan z_data;
+    ByteSpan h_data;
+    ByteSpan c_data;
+    CLWEParameters params;
+    SignatureFormat format = SignatureFormat::LEGACY;
+
+    SignatureView() = default;
+    SignatureView(const ColorSignature& signature);  // Views the signature's own buffers
+
+    // Throws std::invalid_argument if the data is neither a legacy signature nor a FIPS 204
+    // signature of the current format version for `params`
+    static SignatureView parse(const uint8_t* data, size_t size, const CLWEParameters& params);
+
+    ColorSignature to_signature() const;
+};
+
+// Signature with compile-time component sizes for one standard parameter set (legacy format)
+template<uint32_t Level>
+struct FixedSignature {
+    using Params = ParameterSet<Level>;
+
+    std::array<uint8_t, Params::Z_BYTES> z_data{};
+    std::array<uint8_t, Params::H_BYTES> h_data{};
+    std::array<uint8_t, Params::C_BYTES> c_data{};
+
+    std::array<uint8_t, Params::SIGNATURE_BYTES> serialize() const;
+    static FixedSignature deserialize(const uint8_t* data, size_t size);
+
+    // Conversions from/to the runtime-sized signature (throws if the component sizes differ)
+    static FixedSignature from_signature(const ColorSignature& signature);
+    ColorSignature to_signature() const;
+};
+
+// Signing kernels for one standard parameter set. Every dimension and bound is a compile-time
+// constant, so loops have fixed trip counts the compiler can unroll and vectorize. Polynomial
+// blocks use the PolyVec layout (polynomial i at offset i * N); `product` is one polynomial of
+// scratch. ColorSign switches on the security level to reach these for standard parameters.
+template<uint32_t Level>
+class ColorSignT {
+public:
+    using Params = ParameterSet<Level>;
+    using Signature = FixedSignature<Level>;
+
+    // y uniform in [-(gamma1 - 1), gamma1 - 1], and the matching bounds check
+    static void sample_y(SHAKE256Sampler& sampler, uint32_t* y);
+    static SecurityError validate_y_bounds(const uint32_t* y);
+
+    // w = A * y mod q, w1 = HighBits(w), and the w1 rejection check max |w1| < gamma2 - beta
+    static void compute_w(const NTTEngine& ntt_engine, const uint32_t* matrix_A, const uint32_t* y,
+                          uint32_t* w, uint32_t* product);
+    static void compute_w1(const uint32_t* w, uint32_t* w1);
+    static bool check_w1_bounds(const uint32_t* w1);
+    static void encode_w1(const uint32_t* w1, uint8_t* out);  // 2 bytes per coefficient
+
+    // z = y + c*s1 + c*s2 mod q and the check ||z||_inf <= gamma1 - beta
+    static void compute_z(const NTTEngine& ntt_engine, const uint32_t* y, const uint32_t* c,
+                          const uint32_t* s1, const uint32_t* s2, uint32_t* z, uint32_t* product);
+    static bool check_z_bounds(const uint32_t* z);
+
+    // w' = w - c*s2 mod q and the hint bits (H_BYTES) marking where w' crosses gamma2
+    static void compute_w_prime(const NTTEngine& ntt_engine, const uint32_t* w, const uint32_t* c,
+                                const uint32_t* s2, uint32_t* w_prime, uint32_t* product);
+    static void make_hint(const uint32_t* w, const uint32_t* w_prime, uint8_t* h);
+
+    // 2 bits per challenge coefficient (C_BYTES)
+    static void pack_challenge(const uint32_t* c, uint8_t* packed);
+};
+
+// Reusable signing scratch memory sized for one parameter set. Signing repeatedly with the
+// same workspace (one per thread) makes no heap allocations once the buffers are warm.
+// Speculative signing runs its extra attempts on worker threads that the workspace starts on
+// first use and keeps until it is destroyed.
+// With `secret_resource` (e.g. a SecureArena) the secret polynomials s1, s2, t0, y and z are
+// allocated from it instead of the heap; it must outlive the workspace.
+class SignWorkspace {
+public:
+    explicit SignWorkspace(const CLWEParameters& params, std::pmr::memory_resource* secret_resource = nullptr);
+    ~SignWorkspace();
+
+    // Disable copy and assignment
+    SignWorkspace(const SignWorkspace&) = delete;
+    SignWorkspace& operator=(const SignWorkspace&) = delete;
+
+    const CLWEParameters& params() const { return params_; }
+
+private:
+    friend class ColorSign;
+
+    // Outcome of evaluating one rejection sampling attempt
+    enum class CandidateOutcome {
+        ACCEPTED,
+        Y_BOUNDS_REJECTED,
+        W1_BOUNDS_REJECTED,
+        Z_BOUNDS_REJECTED,
+        HINT_WEIGHT_REJECTED,   // More than omega hints (FIPS 204 format only)
+        CANCELLED
+    };
+
+    // Per-attempt buffers; y is sampled in stream order before evaluation
+    struct Candidate {
+        PolyVec y;
+        PolyVec w;
+        PolyVec z;
+        PolyVec w_prime;
+        PolyVec w1;
+        std::vector<uint32_t> c;
+        std::vector<uint32_t> challenge_positions;
+        std::vector<uint32_t> product;           // One polynomial of NTT product scratch
+        std::vector<uint8_t> challenge_seed;     // mu || encoded w1
+        std::vector<uint8_t> z_encoded;
+        std::vector<uint8_t> h;
+        std::vector<uint8_t> c_packed;
+        SecurityError y_bounds_error = SecurityError::SUCCESS;
+        CandidateOutcome outcome = CandidateOutcome::CANCELLED;
+        size_t attempt = 0;                      // Rejection attempt index within the signature
+
+        Candidate(const CLWEParameters& params, std::pmr::memory_resource* secret_resource);
+    };
+
+    void ensure_candidates(size_t count);
+
+    CLWEParameters params_;
+    std::pmr::memory_resource* secret_resource_;   // nullptr = heap
+    std::unique_ptr<NTTEngine> ntt_engine_;
+    PolyMat matrix_A_;                             // Cached expansion of matrix_seed_
+    std::array<uint8_t, 32> matrix_seed_{};
+    bool matrix_valid_ = false;
+    PolyVec secret_polys_;                         // s1 || s2 as decoded from the key
+    PolyVec s1_;
+    PolyVec s2_;
+    PolyVec t0_;                                   // Power2Round keys only (KEY_FORMAT_POWER2ROUND)
+    bool has_t0_ = false;
+    std::vector<uint8_t> mu_;
+    std::vector<uint8_t> rho_prime_;
+    std::vector<Candidate> candidates_;
+    std::vector<std::exception_ptr> candidate_errors_;  // Per attempt of a speculative batch
+    std::unique_ptr<WorkerPool> workers_;          // Speculative attempts 1.., started on first use
+
+    // Instrumentation decided at begin_signing for the current signature
+    bool traced_ = false;                          // Timed and audited
+    bool check_y_bounds_ = false;                  // Re-validate each sampled y
+    uint64_t timing_start_ = 0;                    // TimestampCounter ticks at begin_signing
+    uint64_t stage_start_ = 0;                     // Ticks at the start of the current latency stage
+
+    // Audit records and strings are built once and refreshed in place
+    AuditEntry start_entry_;
+    AuditEntry success_entry_;
+    std::string y_bounds_details_;
 };
 
 // ColorSign signing class with enhanced security
 class ColorSign {
 private:
     CLWEParameters params_;
+    uint32_t fixed_level_;  // Standard parameter set served by ColorSignT (0 = runtime dimensions)
     std::unique_ptr<SecurityMonitor> security_monitor_;
     std::unique_ptr<TimingProtection> timing_protection_;
+    OperationId validation_timing_id_;             // Interned timing operations
+    OperationId signing_timing_id_;
+    uint32_t speculative_candidates_ = 1;  // Rejection attempts evaluated concurrently (1 = sequential)
+    InstrumentationLevel instrumentation_level_ = INSTRUMENTATION_ENABLED ? InstrumentationLevel::FULL
+                                                                          : InstrumentationLevel::OFF;
+    uint32_t sample_interval_ = 64;
+    std::atomic<uint64_t> sample_clock_{0};
+    SignatureFormat signature_format_ = SignatureFormat::LEGACY;
+    std::shared_ptr<ExpandedKeyCache> key_cache_;  // Expansions of seed-only private keys
+
+    struct CounterState {
+        std::atomic<uint64_t> signatures{0};
+        std::atomic<uint64_t> rejection_restarts{0};
+        std::atomic<uint64_t> w1_rejections{0};
+        std::atomic<uint64_t> z_rejections{0};
+        std::atomic<uint64_t> hint_rejections{0};
+        std::atomic<uint64_t> y_bound_violations{0};
+        std::atomic<uint64_t> validation_failures{0};
+        std::atomic<uint64_t> traced_signatures{0};
+    };
+    CounterState counters_;
+    SchemeMetrics* metrics_;                       // Registry series for this security level
 
-    // Helper methods
-    std::vector<uint8_t> hash_message(const std::vector<uint8_t>& message, const std::vector<uint8_t>& context = {}) const;
-    std::vector<std::vector<uint32_t>> sample_y(SHAKE256Sampler& sampler) const;
-    std::vector<std::vector<uint32_t>> compute_w(const std::vector<std::vector<uint32_t>>& matrix_A,
-                                                  const std::vector<std::vector<uint32_t>>& y) const;
+    bool counting() const {
+        return INSTRUMENTATION_ENABLED && instrumentation_level_ >= InstrumentationLevel::COUNTERS;
+    }
+    bool trace_next_signature();
+
+    using CandidateOutcome = SignWorkspace::CandidateOutcome;
+    using SigningCandidate = SignWorkspace::Candidate;
+
+    // Helper methods (results are written into caller-provided, pre-sized buffers)
+    void hash_message(const uint8_t* message, size_t message_len,
+                      const uint8_t* context, size_t context_len, uint8_t* mu) const;
+    void sample_y(SHAKE256Sampler& sampler, PolyVec& y) const;
+    void compute_w(const NTTEngine& ntt_engine,
+                   const PolyMat& matrix_A,
+                   const PolyVec& y,
+                   PolyVec& w,
+                   std::vector<uint32_t>& product) const;
     std::vector<uint32_t> compute_challenge(const std::vector<uint8_t>& mu,
                                             const std::vector<uint8_t>& w_encoded) const;
-    std::vector<std::vector<uint32_t>> compute_z(const std::vector<std::vector<uint32_t>>& y,
-                                                  const std::vector<uint32_t>& c,
-                                                  const std::vector<std::vector<uint32_t>>& s1,
-                                                  const std::vector<std::vector<uint32_t>>& s2) const;
-    bool check_y_bounds(const std::vector<std::vector<uint32_t>>& y) const;
-    bool check_z_bounds(const std::vector<std::vector<uint32_t>>& z) const;
-    bool check_w_bounds(const std::vector<std::vector<uint32_t>>& w) const;
-    std::vector<uint8_t> make_hint(const std::vector<std::vector<uint32_t>>& w,
-                                   const std::vector<std::vector<uint32_t>>& w_prime,
-                                   uint32_t gamma2) const;
-    std::vector<uint8_t> pack_challenge(const std::vector<uint32_t>& c) const;
-    std::vector<std::vector<uint32_t>> generate_matrix_A(const std::array<uint8_t, 32>& seed) const;
-    std::vector<std::vector<uint32_t>> extract_s1_from_private_key(const ColorSignPrivateKey& private_key) const;
-    std::vector<std::vector<uint32_t>> compute_w_prime_for_hint(const std::vector<std::vector<uint32_t>>& w,
-                                                                const std::vector<uint32_t>& c,
-                                                                const std::vector<std::vector<uint32_t>>& s2) const;
-    std::vector<std::vector<uint32_t>> extract_s2_from_private_key(const ColorSignPrivateKey& private_key) const;
+    void compute_z(const NTTEngine& ntt_engine,
+                   const PolyVec& y,
+                   const std::vector<uint32_t>& c,
+                   const PolyVec& s1,
+                   const PolyVec& s2,
+                   PolyVec& z,
+                   std::vector<uint32_t>& product) const;
+    bool check_y_bounds(const PolyVec& y) const;
+    SecurityError validate_y_bounds(const PolyVec& y) const;
+    void compute_w1(const PolyVec& w, PolyVec& w1) const;
+    bool check_w1_bounds(const PolyVec& w1) const;
+    void encode_w1(const PolyVec& w1, uint8_t* out) const;
+    bool check_z_bounds(const PolyVec& z) const;
+    bool check_w_bounds(const PolyVec& w) const;
+    void make_hint(const PolyVec& w,
+                   const PolyVec& w_prime,
+                   uint32_t gamma2,
+                   std::vector<uint8_t>& h) const;
+    void pack_challenge(const std::vector<uint32_t>& c, std::vector<uint8_t>& packed) const;
+    bool make_hint_indices(const PolyVec& w, const PolyVec& w_prime, std::vector<uint8_t>& h) const;
+    void generate_matrix_A(const std::array<uint8_t, 32>& seed, PolyMat& matrix) const;
+    void extract_secret_from_private_key(const ColorSignPrivateKey& private_key, SignWorkspace& workspace) const;
+    const ColorSignPrivateKey& signing_key(const ColorSignPrivateKey& private_key,
+                                           std::shared_ptr<const ColorSignPrivateKey>& expanded);
+    void compute_w_prime_for_hint(const NTTEngine& ntt_engine,
+                                  const PolyVec& w,
+                                  const std::vector<uint32_t>& c,
+                                  const PolyVec& s2,
+                                  PolyVec& w_prime,
+                                  std::vector<uint32_t>& product) const;
+
+    // Rejection sampling attempt evaluation (no monitor access, safe to run on worker threads).
+    // Attempts with a higher index than an already accepted one are cancelled early.
+    void evaluate_candidate(const SignWorkspace& workspace,
+                            SigningCandidate& candidate,
+                            size_t attempt_index,
+                            std::atomic<size_t>* accepted_index) const;
+
+    // Signing stages shared by the one-shot and streaming paths
+    void begin_signing(SignWorkspace& workspace);
+    [[noreturn]] void reject_signing_inputs(const SignWorkspace& workspace, ColorSignSignError validation_result);
+    ColorSignSignError validate_signing_keys(const ColorSignPrivateKey& private_key,
+                                             const ColorSignPublicKey& public_key) const;
+    const SigningCandidate& sign_prepared(const ColorSignPrivateKey& private_key,
+                                          const ColorSignPublicKey& public_key,
+                                          SignWorkspace& workspace);
+    const SigningCandidate& sign_in_workspace(const uint8_t* message, size_t message_len,
+                                              const ColorSignPrivateKey& private_key,
+                                              const ColorSignPublicKey& public_key,
+                                              SignWorkspace& workspace,
+                                              const uint8_t* context, size_t context_len);
+    void store_signature(const SigningCandidate& accepted, ColorSignature& signature) const;
+
+    // Signs the message absorbed by `stream` (see StreamingSigner)
+    friend class StreamingSigner;
+    void sign_stream(MessageHashStream& stream,
+                     const ColorSignPrivateKey& private_key,
+                     const ColorSignPublicKey& public_key,
+                     SignWorkspace& workspace,
+                     ColorSignature& signature);
 
 public:
     ColorSign(const CLWEParameters& params, std::unique_ptr<SecurityMonitor> monitor = nullptr);
@@ -102,11 +397,37 @@ public:
     void set_security_monitor(std::unique_ptr<SecurityMonitor> monitor);
     const SecurityMonitor* get_security_monitor() const { return security_monitor_.get(); }
 
+    // Speculative rejection sampling: evaluate up to `count` consecutive attempts concurrently
+    // and accept the lowest-index one that passes. Signatures are identical to sequential signing.
+    void set_speculative_candidates(uint32_t count);
+    uint32_t speculative_candidates() const { return speculative_candidates_; }
+
+    // Encoding of the signatures produced; set before signing concurrently
+    void set_signature_format(SignatureFormat format) { signature_format_ = format; }
+    SignatureFormat signature_format() const { return signature_format_; }
+
+    // Seed-only private keys (KEY_FORMAT_SEED) sign through their expansion, kept in this LRU.
+    // Each signer starts with its own cache of 64 keys; signers can share one. Set before signing
+    // concurrently.
+    void set_expanded_key_cache(std::shared_ptr<ExpandedKeyCache> cache);
+    ExpandedKeyCache& expanded_key_cache() const { return *key_cache_; }
+
+    // Instrumentation of the signing path; SAMPLED traces one signature in `sample_interval`.
+    // Set before signing concurrently. Without INSTRUMENTATION_ENABLED the level stays OFF.
+    void set_instrumentation_level(InstrumentationLevel level, uint32_t sample_interval = 64);
+    InstrumentationLevel instrumentation_level() const { return instrumentation_level_; }
+    SigningCounters signing_counters() const;
+    void reset_signing_counters();
+
     // Comprehensive input validation
     ColorSignSignError validate_signing_inputs(const std::vector<uint8_t>& message,
                                               const ColorSignPrivateKey& private_key,
                                               const ColorSignPublicKey& public_key,
                                               const std::vector<uint8_t>& context = {}) const;
+    ColorSignSignError validate_signing_inputs(const uint8_t* message, size_t message_len,
+                                              const ColorSignPrivateKey& private_key,
+                                              const ColorSignPublicKey& public_key,
+                                              const uint8_t* context = nullptr, size_t context_len = 0) const;
 
     // Signing function
     ColorSignature sign_message(const std::vector<uint8_t>& message,
@@ -114,11 +435,53 @@ public:
                                 const ColorSignPublicKey& public_key,
                                 const std::vector<uint8_t>& context = {});
 
+    // Signing with caller-owned scratch memory; the result is written into `signature`,
+    // reusing its existing storage. The workspace must match this signer's parameters.
+    void sign_message(const std::vector<uint8_t>& message,
+                      const ColorSignPrivateKey& private_key,
+                      const ColorSignPublicKey& public_key,
+                      SignWorkspace& workspace,
+                      ColorSignature& signature,
+                      const std::vector<uint8_t>& context = {});
+
+    // Span forms of the above: the message and context are read in place, never copied
+    ColorSignature sign_message(const uint8_t* message, size_t message_len,
+                                const ColorSignPrivateKey& private_key,
+                                const ColorSignPublicKey& public_key,
+                                const uint8_t* context = nullptr, size_t context_len = 0);
+    void sign_message(const uint8_t* message, size_t message_len,
+                      const ColorSignPrivateKey& private_key,
+                      const ColorSignPublicKey& public_key,
+                      SignWorkspace& workspace,
+                      ColorSignature& signature,
+                      const uint8_t* context = nullptr, size_t context_len = 0);
+
+    // Signing straight into a caller buffer such as a network frame or a mapped file: writes the
+    // signature as ColorSignature::serialize() would and returns its size, without building a
+    // ColorSignature. Throws std::invalid_argument before signing if `capacity` is below
+    // ColorSignature::serialized_size(params(), signature_format()).
+    size_t sign_into(const std::vector<uint8_t>& message,
+                     const ColorSignPrivateKey& private_key,
+                     const ColorSignPublicKey& public_key,
+                     SignWorkspace& workspace,
+                     uint8_t* out, size_t capacity,
+                     const std::vector<uint8_t>& context = {});
+    size_t sign_into(const uint8_t* message, size_t message_len,
+                     const ColorSignPrivateKey& private_key,
+                     const ColorSignPublicKey& public_key,
+                     SignWorkspace& workspace,
+                     uint8_t* out, size_t capacity,
+                     const uint8_t* context = nullptr, size_t context_len = 0);
+
     // COSE signing function
     COSE_Sign1 sign_message_cose(const std::vector<uint8_t>& message,
                                  const ColorSignPrivateKey& private_key,
                                  const ColorSignPublicKey& public_key,
                                  int alg = COSE_ALG_ML_DSA_44);
+    COSE_Sign1 sign_message_cose(const uint8_t* message, size_t message_len,
+                                 const ColorSignPrivateKey& private_key,
+                                 const ColorSignPublicKey& public_key,
+                                 int alg = COSE_ALG_ML_DSA_44);
 
     // Getters
     const CLWEParameters& params() const { return params_; }
@@ -0,0 +1,139 @@
+#ifndef CLWE_STREAM_HPP
+#define CLWE_STREAM_HPP
+
+#include "sign.hpp"
+#include "verify.hpp"
+#include "utils.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clwe {
+
+// Pre-hash function for HashML-DSA (FIPS 204, Section 5.4). NONE signs the message itself.
+enum class PreHashAlgorithm {
+    NONE,
+    SHA512,
+    SHAKE256  // 512-bit output
+};
+
+// Incremental message hashing for signing and verification. Chunks are absorbed as they
+// arrive, so neither the message size cap nor the message itself has to fit in memory.
+//
+// Without a pre-hash, mu and rho' are exactly those of the one-shot paths, so streamed and
+// one-shot signatures are interchangeable; the signed message is 0 || |ctx| || ctx || M, even
+// for an empty context. With a pre-hash the chunks feed PH and the signed representative is
+// 1 || |ctx| || ctx || OID(PH) || PH(M). The first byte differs, so no pure message shares its
+// mu with a pre-hash representative and a signature made in one mode never verifies in the other.
+class MessageHashStream {
+public:
+    MessageHashStream();
+    ~MessageHashStream();
+
+    // Disable copy and assignment
+    MessageHashStream(const MessageHashStream&) = delete;
+    MessageHashStream& operator=(const MessageHashStream&) = delete;
+
+    // Start a message. `secret` (the packed private key) is absorbed ahead of the message
+    // for rho'; verification passes none. Throws std::invalid_argument for contexts over 255 bytes.
+    void begin(PreHashAlgorithm algorithm, const uint8_t* context, size_t context_len,
+               const uint8_t* secret = nullptr, size_t secret_len = 0);
+    void update(const uint8_t* data, size_t len);
+
+    // Write the 64-byte mu and, when a secret was given at begin(), rho'. Ends the message.
+    void finish(uint8_t* mu, uint8_t* rho_prime = nullptr, size_t rho_prime_len = 0);
+
+    bool active() const { return active_; }
+    uint64_t bytes_absorbed() const { return bytes_absorbed_; }
+    PreHashAlgorithm algorithm() const { return algorithm_; }
+
+private:
+    struct PreHashState;  // OpenSSL digest context
+
+    PreHashAlgorithm algorithm_ = PreHashAlgorithm::NONE;
+    SHAKE256Sampler mu_hash_;
+    SHAKE256Sampler rho_prime_hash_;
+    std::unique_ptr<PreHashState> prehash_;
+    std::array<uint8_t, 255> context_{};  // Kept for the pre-hash representative
+    size_t context_len_ = 0;
+    bool has_secret_ = false;
+    bool active_ = false;
+    uint64_t bytes_absorbed_ = 0;
+};
+
+// Signs a message supplied in chunks: begin(), update() any number of times, then finish().
+// The signer and keys are held by reference and must outlive the streaming signer; a seed-only
+// private key is expanded (through the signer's cache) on construction.
+class StreamingSigner {
+public:
+    StreamingSigner(ColorSign& signer, const ColorSignPrivateKey& private_key, const ColorSignPublicKey& public_key);
+
+    // Disable copy and assignment
+    StreamingSigner(const StreamingSigner&) = delete;
+    StreamingSigner& operator=(const StreamingSigner&) = delete;
+
+    void begin(PreHashAlgorithm algorithm = PreHashAlgorithm::NONE,
+               const uint8_t* context = nullptr, size_t context_len = 0);
+    void update(const uint8_t* chunk, size_t len);
+    void update(const std::vector<uint8_t>& chunk) { update(chunk.data(), chunk.size()); }
+
+    ColorSignature finish();
+    void finish(SignWorkspace& workspace, ColorSignature& signature);
+
+private:
+    ColorSign& signer_;
+    std::shared_ptr<const ColorSignPrivateKey> expanded_;   // Set for seed-only keys
+    const ColorSignPrivateKey& private_key_;
+    const ColorSignPublicKey& public_key_;
+    MessageHashStream stream_;
+};
+
+// Verifies a message supplied in chunks against a signature. The verifier, and the bytes
+// behind both views, must outlive the streaming verifier.
+class StreamingVerifier {
+public:
+    StreamingVerifier(ColorSignVerify& verifier, const PublicKeyView& public_key, const SignatureView& signature);
+
+    // Disable copy and assignment
+    StreamingVerifier(const StreamingVerifier&) = delete;
+    StreamingVerifier& operator=(const StreamingVerifier&) = delete;
+
+    void begin(PreHashAlgorithm algorithm = PreHashAlgorithm::NONE,
+               const uint8_t* context = nullptr, size_t context_len = 0);
+    void update(const uint8_t* chunk, size_t len);
+    void update(const std::vector<uint8_t>& chunk) { update(chunk.data(), chunk.size()); }
+
+    bool finish();
+    bool finish(VerifyWorkspace& workspace);
+
+private:
+    ColorSignVerify& verifier_;
+    PublicKeyView public_key_;
+    SignatureView signature_;
+    MessageHashStream stream_;
+};
+
+// Call `consume` with successive chunks of a file. Regular files are memory-mapped and handed
+// out in place; pipes and other unmappable files are read in large aligned blocks.
+// Throws std::runtime_error if the file cannot be opened or read.
+void for_each_file_chunk(const std::string& path, const std::function<void(const uint8_t*, size_t)>& consume);
+
+// Sign or verify a file's contents through the streaming path
+ColorSignature sign_file(ColorSign& signer,
+                         const std::string& path,
+                         const ColorSignPrivateKey& private_key,
+                         const ColorSignPublicKey& public_key,
+                         PreHashAlgorithm algorithm = PreHashAlgorithm::NONE,
+                         const std::vector<uint8_t>& context = {});
+bool verify_file(ColorSignVerify& verifier,
+                 const std::string& path,
+                 const PublicKeyView& public_key,
+                 const SignatureView& signature,
+                 PreHashAlgorithm algorithm = PreHashAlgorithm::NONE,
+                 const std::vector<uint8_t>& context = {});
+
+} // namespace clwe
+
+#endif // CLWE_STREAM_HPP
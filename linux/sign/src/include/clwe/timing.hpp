@@ -0,0 +1,116 @@
+#ifndef CLWE_TIMING_HPP
+#define CLWE_TIMING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clwe {
+
+// Low-overhead monotonic clock. On x86-64 with an invariant TSC it reads the time-stamp
+// counter, calibrated against steady_clock on first use; elsewhere it is steady_clock.
+class TimestampCounter {
+public:
+    static uint64_t now();                       // Ticks
+    static double ns_per_tick();
+    static uint64_t to_ns(uint64_t ticks) { return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick()); }
+    static bool uses_tsc();
+};
+
+// Operation handle issued by TimingAnomalyDetector::register_operation
+using OperationId = uint32_t;
+constexpr OperationId INVALID_OPERATION_ID = UINT32_MAX;
+
+// Statistics of one operation, merged over all threads
+struct OperationTimingStats {
+    uint64_t observations = 0;   // Durations observed since registration
+    uint64_t anomalies = 0;      // Observations reported as anomalous
+    uint64_t window_samples = 0; // Samples in the current windows
+    double mean_ns = 0.0;        // Over the current windows
+    double stddev_ns = 0.0;
+    double ewma_ns = 0.0;        // Exponentially weighted mean over all observations
+};
+
+// Outcome of one observation: the window statistics it was judged against
+struct TimingObservation {
+    double mean_ns = 0.0;
+    double stddev_ns = 0.0;
+    double threshold_ns = 0.0;
+    bool outlier = false;        // Above threshold (reported after CONSECUTIVE_OUTLIERS in a row)
+};
+
+// Streaming timing-anomaly detector. Operations are registered once and then observed by
+// integer id. Each thread keeps its own fixed window per operation with running (Welford)
+// mean and variance, updated in O(1) as samples enter and leave the window, so an
+// observation costs an uncontended lock and a few floating-point operations. A duration is
+// an outlier above mean + k * stddev of its thread's window; CONSECUTIVE_OUTLIERS outliers in
+// a row are reported as an anomaly. stats() merges the per-thread state. The state of a thread
+// that exits is kept, windows included, and taken over by the next thread to observe, so the
+// table only grows to the peak number of concurrently observing threads.
+class TimingAnomalyDetector {
+public:
+    static constexpr size_t MAX_OPERATIONS = 64;
+    static constexpr size_t DEFAULT_WINDOW = 100;
+    static constexpr size_t MIN_SAMPLES = 10;      // No verdict before this many samples
+    static constexpr uint32_t CONSECUTIVE_OUTLIERS = 3;
+    static constexpr double DEFAULT_THRESHOLD = 3.0;
+    static constexpr double EWMA_ALPHA = 1.0 / 16;
+
+    explicit TimingAnomalyDetector(size_t window = DEFAULT_WINDOW);
+    ~TimingAnomalyDetector();
+
+    // Disable copy and assignment
+    TimingAnomalyDetector(const TimingAnomalyDetector&) = delete;
+    TimingAnomalyDetector& operator=(const TimingAnomalyDetector&) = delete;
+
+    // Returns the id of `name`, registering it if new. Throws std::length_error once
+    // MAX_OPERATIONS operations are registered.
+    OperationId register_operation(const std::string& name);
+    OperationId find_operation(const std::string& name) const;  // INVALID_OPERATION_ID if unknown
+    const std::string& operation_name(OperationId id) const;
+
+    // Threshold multiplier k for an operation (default DEFAULT_THRESHOLD)
+    void set_threshold(OperationId id, double k);
+
+    // Window length for windows created from now on (threads that have not yet observed)
+    void set_window(size_t window);
+    size_t window() const { return window_.load(std::memory_order_relaxed); }
+
+    // Record a duration. Returns true if it completes a run of CONSECUTIVE_OUTLIERS outliers.
+    // Throws std::out_of_range for an id that was not registered.
+    bool observe(OperationId id, uint64_t duration_ns, TimingObservation* observation = nullptr);
+
+    OperationTimingStats stats(OperationId id) const;
+
+    // Per-thread states held, live or left by exited threads
+    size_t thread_states() const;
+
+private:
+    struct OperationWindow;
+    struct ThreadState;
+    struct ThreadExitHook;
+
+    ThreadState& thread_state();
+    void check_id(OperationId id) const;
+
+    const uint64_t serial_;  // Distinguishes detectors in the per-thread cache
+    std::atomic<size_t> window_;
+    std::array<std::atomic<double>, MAX_OPERATIONS> thresholds_;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, OperationId> ids_;
+    std::atomic<size_t> registered_{0};  // names_.size(), read by observe() without the lock
+    mutable std::shared_mutex names_mutex_;
+    std::vector<std::shared_ptr<ThreadState>> threads_;
+    mutable std::mutex threads_mutex_;
+};
+
+} // namespace clwe
+
+#endif // CLWE_TIMING_HPP
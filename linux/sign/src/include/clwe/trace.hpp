@@ -0,0 +1,74 @@
+#ifndef CLWE_TRACE_HPP
+#define CLWE_TRACE_HPP
+
+#include "security_utils.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace clwe {
+
+// One completed span. `name` must point to a string with static storage duration.
+struct TraceEvent {
+    const char* name;
+    uint64_t begin_ticks;   // TimestampCounter ticks
+    uint64_t end_ticks;
+    int64_t arg;            // Rejection attempt index, or -1
+};
+
+// Opt-in span tracing of keygen, sign and verify, exported as Chrome trace JSON (loadable in
+// Perfetto and chrome://tracing). Each thread appends completed spans to its own buffer; a
+// thread keeps at most MAX_EVENTS_PER_THREAD spans and counts the rest as dropped. While
+// disabled a span costs one relaxed load.
+class Tracer {
+public:
+    static constexpr size_t MAX_EVENTS_PER_THREAD = size_t(1) << 20;
+
+    static void enable(bool enabled);
+    static bool enabled() { return INSTRUMENTATION_ENABLED && enabled_.load(std::memory_order_relaxed); }
+
+    // Spans recorded so far, including those of exited threads
+    static size_t event_count();
+    static uint64_t dropped_events();
+    static void clear();
+
+    // {"traceEvents": [...]} with one complete ("X") event per span, in microseconds
+    static std::string chrome_trace_json();
+
+    // Write chrome_trace_json() to `path`. Throws std::runtime_error on I/O failure.
+    static void write_chrome_trace(const std::string& path);
+
+private:
+    friend class TraceSpan;
+
+    static void record(const TraceEvent& event);
+
+    static std::atomic<bool> enabled_;
+};
+
+// RAII span; `name` must be a string literal
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, int64_t arg = -1) : active_(Tracer::enabled()) {
+        if (active_) begin(name, arg);
+    }
+    ~TraceSpan() {
+        if (active_) end();
+    }
+
+    // Disable copy and assignment
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    void begin(const char* name, int64_t arg);
+    void end();
+
+    bool active_;
+    TraceEvent event_{};
+};
+
+} // namespace clwe
+
+#endif // CLWE_TRACE_HPP
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <vector>
 #include <array>
+#include "polyvec.hpp"
 
 namespace clwe {
 
@@ -14,6 +15,9 @@ void secure_random_bytes(uint8_t* buffer, size_t len);
 // SHAKE256 hash function (XOF)
 std::vector<uint8_t> shake256(const std::vector<uint8_t>& input, size_t output_len);
 
+// Keccak-f[1600] permutation of a 5x5 lane state, as used by the samplers and shake256()
+void keccak_f1600(uint64_t state[25]);
+
 // SHAKE-128 based sampler for matrix generation
 class SHAKE128Sampler {
 private:
@@ -49,10 +53,7 @@ private:
     size_t rate_bytes_;  // Rate in bytes (136 for SHAKE256)
     size_t offset_;      // Current position in the state
 
-    void reset();
     void keccak_f1600();
-    void absorb(const uint8_t* data, size_t len);
-    void pad_and_absorb();
 
 public:
     SHAKE256Sampler();
@@ -61,15 +62,25 @@ public:
     // Initialize with seed
     void init(const uint8_t* seed, size_t seed_len);
 
+    // Incremental absorption: reset(), absorb() any number of times, then pad_and_absorb()
+    // before squeezing. Produces the same stream as init() on the concatenated input.
+    void reset();
+    void absorb(const uint8_t* data, size_t len);
+    void pad_and_absorb();
+
     // Squeeze bytes from SHAKE-256
     void squeeze(uint8_t* out, size_t len);
 
     // Sample a single coefficient from centered binomial distribution
     int32_t sample_binomial_coefficient(uint32_t eta);
 
-    // Sample polynomial with binomial distribution
+    // Sample polynomial with binomial distribution. Negative coefficients keep the historical
+    // reduction (2^32 - |c|) mod q, which the key formats before KEY_FORMAT_PACKED_SECRET are built on.
     void sample_polynomial_binomial(uint32_t* coeffs, size_t degree, uint32_t eta, uint32_t modulus);
 
+    // Same draws with negative coefficients stored as modulus - |c|, i.e. s in [-eta, eta]
+    void sample_polynomial_centered(uint32_t* coeffs, size_t degree, uint32_t eta, uint32_t modulus);
+
     // Sample from uniform distribution [0, modulus)
     uint32_t sample_uniform(uint32_t modulus);
 
@@ -87,11 +98,16 @@ bool is_power_of_two(uint32_t x);
 
 // ML-DSA specific utilities
 // Compute high bits of polynomial coefficients (w1 = floor((w + 2^{d-1}) / 2^d))
-void compute_high_bits(const std::vector<uint32_t>& w, std::vector<uint32_t>& w1, uint32_t d, uint32_t q);
+void compute_high_bits(const std::vector<uint32_t>& w, std::vector<uint32_t>& w1, uint32_t d);
+void compute_high_bits(const uint32_t* w, uint32_t* w1, size_t count, uint32_t d);
 
 // Sample challenge polynomial with exactly tau non-zero coefficients in {-1, 0, 1}
 void sample_challenge(std::vector<uint32_t>& c, const std::vector<uint8_t>& seed, uint32_t tau, uint32_t n, uint32_t q);
 
+// Same as above with caller-provided scratch for the position shuffle (resized to n)
+void sample_challenge(std::vector<uint32_t>& c, const uint8_t* seed, size_t seed_len, uint32_t tau, uint32_t n, uint32_t q,
+                      std::vector<uint32_t>& positions);
+
 // Pack polynomial vector into bytes (little-endian 32-bit per coefficient)
 std::vector<uint8_t> pack_polynomial_vector(const std::vector<std::vector<uint32_t>>& poly_vector);
 
@@ -104,10 +120,59 @@ std::vector<uint8_t> pack_polynomial_vector_sparse(const std::vector<std::vector
 std::vector<std::vector<uint32_t>> unpack_polynomial_vector_compressed(const std::vector<uint8_t>& data, uint32_t k, uint32_t n, uint32_t modulus);
 std::vector<uint8_t> pack_polynomial_vector_auto(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus);
 
-// ML-DSA standard compression using d bits per coefficient
+// ML-DSA standard compression using d bits per coefficient, 1 <= d <= 32 (std::invalid_argument otherwise)
 std::vector<uint8_t> pack_polynomial_vector_ml_dsa(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, uint32_t d);
 std::vector<std::vector<uint32_t>> unpack_polynomial_vector_ml_dsa(const std::vector<uint8_t>& data, uint32_t k, uint32_t n, uint32_t modulus, uint32_t d);
 
+// Allocation-free ML-DSA packing kernels. The packed size includes the 6-byte header used for d other than 8 and 18.
+// The unpack kernel writes k * n coefficients contiguously (polynomial i starts at out + i * n).
+size_t ml_dsa_packed_size(uint32_t k, uint32_t n, uint32_t d);
+size_t pack_polynomial_vector_ml_dsa(const std::vector<std::vector<uint32_t>>& poly_vector, uint32_t modulus, uint32_t d, uint8_t* out);
+void unpack_polynomial_vector_ml_dsa(const uint8_t* data, size_t size, uint32_t k, uint32_t n, uint32_t modulus, uint32_t d, uint32_t* out);
+
+// PolyVec forms of the packing functions. The nested-vector functions above convert and forward to these.
+// Unpacking writes into `out`, whose size() and degree() give the expected dimensions.
+std::vector<uint8_t> pack_polynomial_vector(const PolyVec& poly_vector);
+void unpack_polynomial_vector(const std::vector<uint8_t>& data, PolyVec& out);
+std::vector<uint8_t> pack_polynomial_vector_compressed(const PolyVec& poly_vector, uint32_t modulus);
+std::vector<uint8_t> pack_polynomial_vector_sparse(const PolyVec& poly_vector, uint32_t modulus);
+void unpack_polynomial_vector_compressed(const std::vector<uint8_t>& data, uint32_t modulus, PolyVec& out);
+std::vector<uint8_t> pack_polynomial_vector_auto(const PolyVec& poly_vector, uint32_t modulus);
+std::vector<uint8_t> pack_polynomial_vector_ml_dsa(const PolyVec& poly_vector, uint32_t modulus, uint32_t d);
+size_t pack_polynomial_vector_ml_dsa(const PolyVec& poly_vector, uint32_t modulus, uint32_t d, uint8_t* out);
+void unpack_polynomial_vector_ml_dsa(const uint8_t* data, size_t size, uint32_t modulus, uint32_t d, PolyVec& out);
+
+// Exact FIPS 204 packing of a vector with coefficients in [-(gamma1 - 1), gamma1] (stored mod q) as
+// gamma1 - v in log2(gamma1) + 1 bits, without a header. gamma1 must be a power of two; unpacking
+// requires exactly gamma1_packed_size bytes. Both throw std::invalid_argument otherwise.
+size_t gamma1_packed_size(uint32_t k, uint32_t n, uint32_t gamma1);
+size_t pack_polynomial_vector_gamma1(const PolyVec& poly_vector, uint32_t modulus, uint32_t gamma1, uint8_t* out);
+void unpack_polynomial_vector_gamma1(const uint8_t* data, size_t size, uint32_t modulus, uint32_t gamma1, PolyVec& out);
+
+// FIPS 204 Power2Round (d = 13): t = t1 * 2^13 + t0 with t0 in (-2^12, 2^12], stored mod q.
+// t1 packs at 10 bits without a header (pkEncode) and unpacks as t1 * 2^13, from exactly
+// t1_packed_size bytes; t0 packs as gamma1 = 2^12, i.e. 2^12 - t0 in 13 bits (skEncode).
+constexpr uint32_t POWER2ROUND_D = 13;
+constexpr uint32_t T1_BITS = 10;
+void power2round(const PolyVec& t, uint32_t modulus, PolyVec& t1, PolyVec& t0);
+size_t t1_packed_size(uint32_t k, uint32_t n);
+size_t pack_polynomial_vector_t1(const PolyVec& t1, uint8_t* out);
+void unpack_polynomial_vector_t1(const uint8_t* data, size_t size, PolyVec& out);
+
+// Exact FIPS 204 packing of a vector with coefficients in [-eta, eta] (stored mod q) as eta - s in
+// bitlen(2 * eta) bits (3 at eta = 2, 4 at eta = 4), without a header. Unpacking requires exactly
+// eta_packed_size bytes and does not range-check the decoded values.
+size_t eta_packed_size(uint32_t k, uint32_t n, uint32_t eta);
+size_t pack_polynomial_vector_eta(const PolyVec& poly_vector, uint32_t modulus, uint32_t eta, uint8_t* out);
+void unpack_polynomial_vector_eta(const uint8_t* data, size_t size, uint32_t modulus, uint32_t eta, PolyVec& out);
+
+// FIPS 204 HintBitUnpack of omega + k bytes fused with the hint adjustment: w is w' with each
+// listed coefficient moved down by 2^13 (mod q). Returns false, leaving w unspecified, for a
+// malformed encoding: the wrong size, counts that decrease or exceed omega, indices not strictly
+// increasing within a polynomial or not below n, or nonzero padding after the last index.
+bool apply_hint_indices(const uint8_t* h, size_t size, uint32_t omega, uint32_t modulus,
+                        const PolyVec& w_prime, PolyVec& w);
+
 } // namespace clwe
 
 #endif // CLWE_UTILS_HPP
\ No newline at end of file
@@ -6,65 +6,146 @@
 #include "sign.hpp"
 #include <vector>
 #include <array>
+#include <memory>
 
 namespace clwe {
 
 // Forward declarations
 class ColorSignVerify;
+class NTTEngine;
 struct COSE_Sign1;
+struct COSE_Sign1View;
+class MessageHashStream;
+
+// Verification kernels for one standard parameter set, complementing the shared ColorSignT and
+// KeyGenT kernels. Dimensions are compile-time constants; polynomial blocks use the PolyVec
+// layout. ColorSignVerify switches on the security level to reach these for standard parameters.
+template<uint32_t Level>
+class ColorSignVerifyT {
+public:
+    using Params = ParameterSet<Level>;
+
+    // Expand the C_BYTES packed challenge into N coefficients
+    static void unpack_challenge(const uint8_t* packed, uint32_t* c);
+
+    // w' = A * z - c * t mod q
+    static void compute_w_prime(const NTTEngine& ntt_engine, const uint32_t* matrix_A, const uint32_t* z,
+                                const uint32_t* c, const uint32_t* t, uint32_t* w_prime, uint32_t* product);
+
+    // Apply the first 8 * h_size hint bits to w', and the w range check against (q - 1) / 2
+    static void use_hint(const uint8_t* h, size_t h_size, const uint32_t* w_prime, uint32_t* w);
+    static bool check_w_bounds(const uint32_t* w);
+};
+
+// Reusable verification scratch memory sized for one parameter set. Verifying repeatedly
+// with the same workspace (one per thread) makes no heap allocations once it is warm.
+class VerifyWorkspace {
+public:
+    explicit VerifyWorkspace(const CLWEParameters& params);
+    ~VerifyWorkspace();
+
+    // Disable copy and assignment
+    VerifyWorkspace(const VerifyWorkspace&) = delete;
+    VerifyWorkspace& operator=(const VerifyWorkspace&) = delete;
+
+    const CLWEParameters& params() const { return params_; }
+
+private:
+    friend class ColorSignVerify;
+
+    CLWEParameters params_;
+    std::unique_ptr<NTTEngine> ntt_engine_;
+    PolyMat matrix_A_;                             // Cached expansion of matrix_seed_
+    std::array<uint8_t, 32> matrix_seed_{};
+    bool matrix_valid_ = false;
+    PolyVec z_;
+    PolyVec t_;
+    PolyVec w_prime_;
+    PolyVec w_;
+    PolyVec w1_;
+    std::vector<uint32_t> c_;
+    std::vector<uint32_t> product_;
+    std::vector<uint32_t> computed_c_;
+    std::vector<uint32_t> challenge_positions_;
+    std::vector<uint8_t> challenge_seed_;          // mu || encoded w1
+    std::vector<uint8_t> computed_c_packed_;       // Packed c, or c~ for FIPS 204 signatures
+};
 
 // ColorSign verification class
 class ColorSignVerify {
 private:
     CLWEParameters params_;
-
-    // Helper methods
-    std::vector<std::vector<uint32_t>> generate_matrix_A(const std::array<uint8_t, 32>& seed) const;
-    std::vector<std::vector<uint32_t>> extract_t_from_public_key(const ColorSignPublicKey& public_key) const;
-    std::vector<std::vector<uint32_t>> compute_w_prime_fixed(const std::vector<std::vector<uint32_t>>& matrix_A,
-                                                             const std::vector<std::vector<uint32_t>>& z,
-                                                             const std::vector<uint8_t>& c_hash,
-                                                             const std::vector<std::vector<uint32_t>>& t) const;
-    std::vector<uint32_t> unpack_challenge(const std::vector<uint8_t>& c_hash) const;
-    std::vector<uint8_t> hash_message(const std::vector<uint8_t>& message, const std::vector<uint8_t>& context = {}) const;
+    uint32_t fixed_level_;  // Standard parameter set served by ColorSignVerifyT (0 = runtime dimensions)
+    SchemeMetrics* metrics_;  // Registry series for this security level
+
+    // Helper methods (results are written into caller-provided, pre-sized buffers)
+    void generate_matrix_A(const std::array<uint8_t, 32>& seed, PolyMat& matrix) const;
+    void extract_t_from_public_key(const PublicKeyView& public_key, VerifyWorkspace& workspace) const;
+    void compute_w_prime_fixed(const NTTEngine& ntt_engine,
+                               const PolyMat& matrix_A,
+                               const PolyVec& z,
+                               const std::vector<uint32_t>& c,
+                               const PolyVec& t,
+                               PolyVec& w_prime,
+                               std::vector<uint32_t>& product) const;
+    void unpack_challenge(const ByteSpan& c_hash, std::vector<uint32_t>& c) const;
+    void hash_message(const uint8_t* message, size_t message_len,
+                      const uint8_t* context, size_t context_len, uint8_t* mu) const;
     std::vector<uint32_t> compute_challenge(const std::vector<uint8_t>& mu,
                                            const std::vector<uint8_t>& w_encoded) const;
-    bool check_z_bounds(const std::vector<std::vector<uint32_t>>& z) const;
-    bool check_w_bounds(const std::vector<std::vector<uint32_t>>& w) const;
-    std::vector<std::vector<uint32_t>> use_hint(const std::vector<uint8_t>& h,
-                                               const std::vector<std::vector<uint32_t>>& z,
-                                               uint32_t gamma2) const;
-    std::vector<std::vector<uint32_t>> hint_decompress(const std::vector<std::vector<uint32_t>>& compressed,
-                                                       const std::vector<uint8_t>& h,
-                                                       uint32_t gamma2) const;
+    bool check_z_bounds(const PolyVec& z) const;
+    bool check_w_bounds(const PolyVec& w) const;
+    void use_hint(const ByteSpan& h,
+                  const PolyVec& z,
+                  PolyVec& z_decompressed) const;
+    bool use_hint_indices(const ByteSpan& h, const PolyVec& w_prime, PolyVec& w) const;
+    void unpack_signature_z(const SignatureView& signature, PolyVec& z) const;
+    PolyVec hint_decompress(const PolyVec& compressed,
+                            const std::vector<uint8_t>& h,
+                            uint32_t gamma2) const;
 
     // Enhanced security validation methods
-    bool verify_signature_basic(const ColorSignPublicKey& public_key,
-                                const ColorSignature& signature,
-                                const std::vector<uint8_t>& message,
-                                const std::vector<uint8_t>& context = {}) const;
+    bool verify_signature_basic(const PublicKeyView& public_key,
+                                const SignatureView& signature,
+                                const uint8_t* message, size_t message_len,
+                                const uint8_t* context, size_t context_len,
+                                VerifyWorkspace& workspace) const;
+    bool verify_against_mu(const PublicKeyView& public_key,
+                           const SignatureView& signature,
+                           VerifyWorkspace& workspace) const;
+    bool verify_prepared(const PublicKeyView& public_key,
+                         const SignatureView& signature,
+                         VerifyWorkspace& workspace) const;
+    void record_verification(uint64_t start_ticks, uint64_t check_start_ticks, size_t bytes_hashed) const;
     bool run_comprehensive_security_checks(const ColorSignPublicKey& public_key,
                                            const ColorSignature& signature,
                                            const std::vector<uint8_t>& message,
                                            const std::vector<uint8_t>& context) const;
 
     // Security validation helper methods
-    bool check_z_bounds_enhanced(const std::vector<std::vector<uint32_t>>& z) const;
-    bool validate_encoding_consistency(const ColorSignPublicKey& public_key,
-                                       const ColorSignature& signature) const;
+    bool check_z_bounds_enhanced(const PolyVec& z) const;
+    bool validate_encoding_consistency(const SignatureView& signature) const;
     bool validate_cryptographic_integrity_final(const ColorSignPublicKey& public_key,
                                                 const ColorSignature& signature,
                                                 const std::vector<uint8_t>& message,
-                                                const std::vector<std::vector<uint32_t>>& w_prime) const;
+                                                const PolyVec& w_prime) const;
     bool validate_mathematical_consistency(const ColorSignPublicKey& public_key,
                                            const ColorSignature& signature,
-                                           const std::vector<std::vector<uint32_t>>& w_prime) const;
-    bool validate_challenge_match(const std::vector<std::vector<uint32_t>>& w_prime,
-                                  const ColorSignature& signature,
-                                  const std::vector<uint8_t>& message,
-                                  const std::vector<uint8_t>& context) const;
-    std::vector<uint8_t> encode_w_prime_for_challenge(const std::vector<std::vector<uint32_t>>& w_prime) const;
-    std::vector<uint8_t> pack_challenge(const std::vector<uint32_t>& c) const;
+                                           const PolyVec& w_prime) const;
+    bool validate_challenge_match(const SignatureView& signature,
+                                  VerifyWorkspace& workspace) const;
+    void encode_w_prime_for_challenge(const PolyVec& w_prime,
+                                      VerifyWorkspace& workspace) const;
+    void pack_challenge(const std::vector<uint32_t>& c, std::vector<uint8_t>& packed) const;
+    void compute_w1(const PolyVec& w_prime, PolyVec& w1) const;
+    void encode_w1(const PolyVec& w1, uint8_t* out) const;
+
+    // Verifies against the message absorbed by `stream` (see StreamingVerifier)
+    friend class StreamingVerifier;
+    bool verify_stream(MessageHashStream& stream,
+                       const PublicKeyView& public_key,
+                       const SignatureView& signature,
+                       VerifyWorkspace& workspace);
 
 public:
     ColorSignVerify(const CLWEParameters& params);
@@ -80,9 +161,32 @@ public:
                           const std::vector<uint8_t>& message,
                           const std::vector<uint8_t>& context = {});
 
-    // COSE verification function
+    // Verification with caller-owned scratch memory. The workspace must match this verifier's parameters.
+    bool verify_signature(const ColorSignPublicKey& public_key,
+                          const ColorSignature& signature,
+                          const std::vector<uint8_t>& message,
+                          VerifyWorkspace& workspace,
+                          const std::vector<uint8_t>& context = {});
+
+    // Span forms of the above. Keys and signatures parsed with PublicKeyView::parse and
+    // SignatureView::parse are verified in place, e.g. directly from a receive buffer;
+    // ColorSignPublicKey and ColorSignature convert to views implicitly.
+    bool verify_signature(const PublicKeyView& public_key,
+                          const SignatureView& signature,
+                          const uint8_t* message, size_t message_len,
+                          const uint8_t* context = nullptr, size_t context_len = 0);
+    bool verify_signature(const PublicKeyView& public_key,
+                          const SignatureView& signature,
+                          const uint8_t* message, size_t message_len,
+                          VerifyWorkspace& workspace,
+                          const uint8_t* context = nullptr, size_t context_len = 0);
+
+    // COSE verification function; the view form verifies a message parsed with
+    // COSE_Sign1View::parse in place
     bool verify_signature_cose(const ColorSignPublicKey& public_key,
                                const COSE_Sign1& cose_signature);
+    bool verify_signature_cose(const ColorSignPublicKey& public_key,
+                               const COSE_Sign1View& cose_signature);
 
     // Getters
     const CLWEParameters& params() const { return params_; }
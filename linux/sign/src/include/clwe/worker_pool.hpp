@@ -0,0 +1,56 @@
+#ifndef CLWE_WORKER_POOL_HPP
+#define CLWE_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clwe {
+
+// Fixed set of threads that run one batch of indexed tasks at a time. The threads start with the
+// pool and wait between batches, so dispatching a batch neither creates threads nor allocates.
+// One caller at a time: SignWorkspace owns a pool for speculative rejection sampling.
+class WorkerPool {
+public:
+    // Throws std::system_error if a thread cannot be started; threads already running are joined
+    explicit WorkerPool(size_t workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t workers() const { return threads_.size(); }
+
+    // Calls task(i) for every i in [0, count): index 0 on the calling thread, the others on
+    // workers 1 .. count - 1. Returns once all have finished. count must not exceed workers() + 1
+    // (std::invalid_argument). The task must not throw; collect failures in caller storage.
+    template<typename Task>
+    void run(size_t count, Task& task) {
+        dispatch(count, [](void* context, size_t index) { (*static_cast<Task*>(context))(index); }, &task);
+    }
+
+private:
+    using Thunk = void (*)(void* context, size_t index);
+
+    void dispatch(size_t count, Thunk thunk, void* context);
+    void worker_loop(size_t index);
+    void stop();
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;   // Batches dispatched so far
+    size_t count_ = 0;          // Tasks in the current batch
+    size_t pending_ = 0;        // Worker tasks of the current batch still running
+    Thunk thunk_ = nullptr;
+    void* context_ = nullptr;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace clwe
+
+#endif // CLWE_WORKER_POOL_HPP
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "allocation_profiler.hpp"
+#include "keygen.hpp"
+#include "parameters.hpp"
+#include "performance_metrics.hpp"
+#include "security_utils.hpp"
+#include "sign.hpp"
+#include "verify.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Linked with the allocation hooks. The budgets below cap the heap traffic of every public
+// operation; lower them as allocations are eliminated so that the gains cannot silently regress.
+// benchmark_allocations prints the current figures.
+
+namespace {
+
+struct AllocationBudget {
+    const char* operation;
+    uint32_t level;
+    uint64_t max_allocations;       // Per operation, worst of the runs
+    uint64_t max_bytes;             // Requested bytes per operation, worst of the runs
+    uint64_t max_peak_live_bytes;
+};
+
+const AllocationBudget BUDGETS[] = {
+    {"generate_keypair", 44, 24, 80 * 1024, 64 * 1024},
+    {"generate_keypair", 65, 24, 128 * 1024, 112 * 1024},
+    {"generate_keypair", 87, 24, 200 * 1024, 176 * 1024},
+    {"sign_message", 44, 48, 104 * 1024, 104 * 1024},
+    {"sign_message", 65, 48, 168 * 1024, 168 * 1024},
+    {"sign_message", 87, 48, 240 * 1024, 240 * 1024},
+    {"sign_message/workspace", 44, 0, 0, 0},
+    {"sign_message/workspace", 65, 0, 0, 0},
+    {"sign_message/workspace", 87, 0, 0, 0},
+    {"sign_message/speculative", 44, 0, 0, 0},   // Calling thread; the worker pool is warm
+    {"sign_message/speculative", 65, 0, 0, 0},
+    {"sign_message/speculative", 87, 0, 0, 0},
+    {"verify_signature", 44, 24, 72 * 1024, 72 * 1024},
+    {"verify_signature", 65, 24, 120 * 1024, 120 * 1024},
+    {"verify_signature", 87, 24, 180 * 1024, 180 * 1024},
+    {"verify_signature/workspace", 44, 0, 0, 0},
+    {"verify_signature/workspace", 65, 0, 0, 0},
+    {"verify_signature/workspace", 87, 0, 0, 0},
+};
+
+const int WARMUP_RUNS = 5;
+const int RUNS = 10;
+
+class AllocationBudgetTest : public ::testing::TestWithParam<AllocationBudget> {};
+
+TEST(AllocationProfilerTest, HooksAreInstalled) {
+    EXPECT_TRUE(clwe::AllocationProfiler::hooks_installed());
+}
+
+TEST(AllocationProfilerTest, ScopeCountsAllocationsAndPeak) {
+    clwe::AllocationScope outer;
+    {
+        clwe::AllocationScope inner;
+        auto first = std::make_unique<std::vector<uint8_t>>(1000);
+        std::vector<uint8_t> second(3000);
+        second.clear();
+        second.shrink_to_fit();
+        clwe::AllocationStats stats = inner.stats();
+        EXPECT_EQ(stats.allocations, 3u);   // The vector object and two buffers
+        EXPECT_EQ(stats.deallocations, 1u);
+        EXPECT_EQ(stats.allocated_bytes, sizeof(std::vector<uint8_t>) + 4000);
+        EXPECT_EQ(stats.freed_bytes, 3000u);
+        EXPECT_EQ(stats.peak_live_bytes, sizeof(std::vector<uint8_t>) + 4000);
+    }
+
+    // The inner peak also counts for the enclosing scope, although the memory is freed
+    {
+        clwe::AllocationScope sibling;
+        std::vector<uint8_t> small(10);
+        EXPECT_EQ(sibling.stats().peak_live_bytes, 10u);
+    }
+    clwe::AllocationStats stats = outer.stats();
+    EXPECT_EQ(stats.allocations, 4u);
+    EXPECT_EQ(stats.allocations, stats.deallocations);
+    EXPECT_EQ(stats.peak_live_bytes, sizeof(std::vector<uint8_t>) + 4000);
+
+    // Over-aligned allocations go through the aligned operator new
+    struct alignas(64) Block { uint8_t data[64]; };
+    clwe::AllocationScope aligned;
+    auto block = std::make_unique<Block>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(block.get()) % 64, 0u);
+    EXPECT_EQ(aligned.stats().allocated_bytes, sizeof(Block));
+}
+
+TEST(AllocationProfilerTest, StagesCountAllocations) {
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    keygen.generate_keypair();
+
+    clwe::StageProfiler::reset();
+    clwe::StageProfiler::enable(true);
+    keygen.generate_keypair();
+    clwe::StageProfiler::enable(false);
+
+    uint64_t allocations = 0;
+    for (const clwe::StageStats& stage : clwe::StageProfiler::breakdown()) {
+        allocations += stage.allocations;
+        EXPECT_GE(stage.allocated_bytes, stage.allocations);
+    }
+    EXPECT_GT(allocations, 0u);
+    clwe::StageProfiler::reset();
+}
+
+TEST_P(AllocationBudgetTest, StaysWithinBudget) {
+    const AllocationBudget& budget = GetParam();
+    clwe::CLWEParameters params(budget.level);
+    clwe::ColorSignKeyGen keygen(params);
+    auto monitor = std::make_unique<clwe::DefaultSecurityMonitor>();
+    monitor->set_max_log_size(8);
+    clwe::ColorSign signer(params, std::move(monitor));
+    auto speculative_monitor = std::make_unique<clwe::DefaultSecurityMonitor>();
+    speculative_monitor->set_max_log_size(8);
+    clwe::ColorSign speculative_signer(params, std::move(speculative_monitor));
+    speculative_signer.set_speculative_candidates(4);
+    clwe::ColorSignVerify verifier(params);
+    clwe::SignWorkspace sign_workspace(params);
+    clwe::VerifyWorkspace verify_workspace(params);
+
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    std::tie(public_key, private_key) = keygen.generate_keypair();
+    std::vector<uint8_t> message(1024, 0xAA);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+    clwe::ColorSignature reused_signature = signature;
+
+    std::string operation = budget.operation;
+    auto run = [&]() {
+        if (operation == "generate_keypair") {
+            keygen.generate_keypair();
+        } else if (operation == "sign_message") {
+            signer.sign_message(message, private_key, public_key);
+        } else if (operation == "sign_message/workspace") {
+            signer.sign_message(message, private_key, public_key, sign_workspace, reused_signature);
+        } else if (operation == "sign_message/speculative") {
+            speculative_signer.sign_message(message, private_key, public_key, sign_workspace, reused_signature);
+        } else if (operation == "verify_signature") {
+            verifier.verify_signature(public_key, signature, message);
+        } else {
+            verifier.verify_signature(public_key, signature, message, verify_workspace);
+        }
+    };
+
+    // One-time allocations (caches, thread-local state) and the growth of the signer's audit
+    // log up to its cap are not part of the budget
+    for (int i = 0; i < WARMUP_RUNS; ++i) {
+        run();
+    }
+    clwe::AllocationStats worst;
+    for (int i = 0; i < RUNS; ++i) {
+        clwe::AllocationScope scope;
+        run();
+        clwe::AllocationStats stats = scope.stats();
+        worst.allocations = std::max(worst.allocations, stats.allocations);
+        worst.allocated_bytes = std::max(worst.allocated_bytes, stats.allocated_bytes);
+        worst.peak_live_bytes = std::max(worst.peak_live_bytes, stats.peak_live_bytes);
+    }
+
+    EXPECT_LE(worst.allocations, budget.max_allocations);
+    EXPECT_LE(worst.allocated_bytes, budget.max_bytes);
+    EXPECT_LE(worst.peak_live_bytes, budget.max_peak_live_bytes);
+}
+
+std::string budget_name(const ::testing::TestParamInfo<AllocationBudget>& info) {
+    std::string name = std::string(info.param.operation) + "_" + std::to_string(info.param.level);
+    std::replace(name.begin(), name.end(), '/', '_');
+    return name;
+}
+
+INSTANTIATE_TEST_SUITE_P(Operations, AllocationBudgetTest, ::testing::ValuesIn(BUDGETS), budget_name);
+
+} // namespace
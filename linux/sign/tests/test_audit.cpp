@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "audit.hpp"
+#include "sign.hpp"
+#include "keygen.hpp"
+#include <cstdio>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string temp_audit_path() {
+    char path[] = "/tmp/colorsign_audit_XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    std::remove(path);  // Let the audit file create and format it
+    return path;
+}
+
+TEST(AuditRingTest, PushPopAndReject) {
+    clwe::AuditRing ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    clwe::AuditRecord record{};
+    for (uint64_t i = 0; i < 4; ++i) {
+        record.value = i;
+        EXPECT_TRUE(ring.try_push(record));
+        EXPECT_EQ(record.sequence, i);
+    }
+    EXPECT_FALSE(ring.try_push(record));
+    EXPECT_EQ(ring.size_approx(), 4u);
+
+    for (uint64_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(record));
+        EXPECT_EQ(record.value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(record));
+    EXPECT_EQ(ring.pushed(), 4u);
+}
+
+TEST(AuditRingTest, ConcurrentProducersLoseNothing) {
+    clwe::AuditRing ring(1 << 16);
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 10000;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&ring, t] {
+            clwe::AuditRecord record{};
+            record.thread_id = static_cast<uint32_t>(t);
+            for (int i = 0; i < PER_THREAD; ++i) {
+                record.value = static_cast<uint64_t>(i);
+                while (!ring.try_push(record)) {}
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+
+    std::set<uint64_t> sequences;
+    std::vector<uint64_t> next_value(THREADS, 0);
+    clwe::AuditRecord record;
+    while (ring.try_pop(record)) {
+        sequences.insert(record.sequence);
+        // Each producer's records come out in the order it pushed them
+        EXPECT_EQ(record.value, next_value[record.thread_id]++);
+    }
+    EXPECT_EQ(sequences.size(), static_cast<size_t>(THREADS * PER_THREAD));
+}
+
+TEST(AuditPipelineTest, FlushesToQueryableFile) {
+    std::string path = temp_audit_path();
+    {
+        clwe::AuditPipelineConfig config;
+        config.path = path;
+        config.ring_capacity = 64;
+        clwe::AuditPipeline pipeline(config);
+
+        std::string long_detail(100, 'x');
+        for (int i = 0; i < 1000; ++i) {
+            clwe::AuditEvent event = i % 10 == 0 ? clwe::AuditEvent::SIGNING_FAILURE : clwe::AuditEvent::SIGNING_SUCCESS;
+            pipeline.record(event, i % 10 == 0 ? 7u : 0u, static_cast<uint64_t>(i), long_detail.data(), long_detail.size());
+            if (i % 32 == 31) {
+                pipeline.flush();
+            }
+        }
+        pipeline.flush();
+
+        clwe::AuditPipelineStats stats = pipeline.stats();
+        EXPECT_EQ(stats.recorded + stats.dropped, 1000u);
+        EXPECT_EQ(stats.flushed, stats.recorded);
+
+        clwe::AuditQuery failures;
+        failures.event = clwe::AuditEvent::SIGNING_FAILURE;
+        std::vector<clwe::AuditRecord> found = pipeline.query(failures);
+        EXPECT_FALSE(found.empty());
+        for (const auto& record : found) {
+            EXPECT_EQ(record.error_code, 7u);
+            EXPECT_EQ(record.value % 10, 0u);
+            EXPECT_EQ(record.detail_string(), std::string(clwe::AuditRecord::DETAIL_CAPACITY, 'x'));
+        }
+
+        clwe::AuditQuery none;
+        none.from_ns = UINT64_MAX - 1;
+        EXPECT_EQ(pipeline.count(none), 0u);
+    }
+
+    // The file outlives the pipeline and can be reopened for queries
+    clwe::AuditLogFile file(path, true);
+    EXPECT_GT(file.size(), 0u);
+    for (size_t i = 1; i < file.size(); ++i) {
+        EXPECT_LT(file[i - 1].sequence, file[i].sequence);
+    }
+    EXPECT_THROW(file.append(file.begin(), 1), std::logic_error);
+
+    // Appending reopens at the end of the existing records
+    size_t before = file.size();
+    {
+        clwe::AuditPipelineConfig config;
+        config.path = path;
+        clwe::AuditPipeline pipeline(config);
+        pipeline.record(clwe::AuditEvent::MEMORY_VIOLATION);
+    }
+    clwe::AuditLogFile reopened(path, true);
+    EXPECT_EQ(reopened.size(), before + 1);
+    EXPECT_EQ(reopened[before].event_type(), clwe::AuditEvent::MEMORY_VIOLATION);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(clwe::AuditLogFile(path, true), std::runtime_error);
+}
+
+TEST(AuditPipelineTest, FileGrowsPastInitialMapping) {
+    std::string path = temp_audit_path();
+    clwe::AuditPipelineConfig config;
+    config.path = path;
+    config.ring_capacity = 1 << 15;
+    {
+        clwe::AuditPipeline pipeline(config);
+        for (int i = 0; i < 40000; ++i) {
+            while (!pipeline.record(clwe::AuditEvent::VERIFICATION_SUCCESS, 0, static_cast<uint64_t>(i))) {
+                pipeline.flush();
+            }
+        }
+    }
+    clwe::AuditLogFile file(path, true);
+    ASSERT_EQ(file.size(), 40000u);
+    EXPECT_EQ(file[39999].value, 39999u);
+    std::remove(path.c_str());
+}
+
+TEST(AuditPipelineTest, MonitorRecordsSigning) {
+    std::string path = temp_audit_path();
+    clwe::AuditPipelineConfig config;
+    config.path = path;
+    clwe::AuditPipeline pipeline(config);
+
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    std::array<uint8_t, 32> seed;
+    seed.fill(0x42);
+    auto [public_key, private_key] = keygen.generate_keypair_deterministic(seed);
+    clwe::ColorSign signer(params, std::make_unique<clwe::BinaryAuditMonitor>(pipeline));
+
+    std::vector<uint8_t> message = {'a', 'u', 'd', 'i', 't'};
+    signer.sign_message(message, private_key, public_key);
+    EXPECT_THROW(signer.sign_message({}, private_key, public_key), std::invalid_argument);
+    pipeline.flush();
+
+    clwe::AuditQuery success;
+    success.event = clwe::AuditEvent::SIGNING_SUCCESS;
+    EXPECT_EQ(pipeline.count(success), 1u);
+    clwe::AuditQuery violation;
+    violation.event = clwe::AuditEvent::SECURITY_VIOLATION;
+    violation.error_code = static_cast<uint32_t>(clwe::SecurityError::INVALID_INPUT_SIZE);
+    EXPECT_EQ(pipeline.count(violation), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(DefaultSecurityMonitorTest, ConcurrentLoggingKeepsNewestEntries) {
+    clwe::DefaultSecurityMonitor monitor;
+    monitor.set_max_log_size(100);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&monitor] {
+            clwe::AuditEntry entry{clwe::AuditEvent::SIGNING_START, std::chrono::system_clock::now(),
+                                   "concurrent", "test", 0};
+            for (int i = 0; i < 5000; ++i) {
+                monitor.log_event(entry);
+                monitor.detect_timing_anomaly("op", 1000);
+            }
+        });
+    }
+    // Snapshots taken while the log is written are copies, so they stay consistent
+    threads.emplace_back([&monitor] {
+        for (int i = 0; i < 200; ++i) {
+            std::vector<clwe::AuditEntry> snapshot = monitor.get_audit_log();
+            EXPECT_LE(snapshot.size(), 100u);
+            for (const auto& entry : snapshot) {
+                EXPECT_EQ(entry.details, "concurrent");
+            }
+        }
+    });
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(monitor.get_audit_log().size(), 100u);
+
+    // Shrinking keeps the newest entries in order
+    for (int i = 0; i < 3; ++i) {
+        monitor.log_event({clwe::AuditEvent::SIGNING_SUCCESS, {}, "late " + std::to_string(i), "test", 0});
+    }
+    monitor.set_max_log_size(2);
+    std::vector<clwe::AuditEntry> log = monitor.get_audit_log();
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0].details, "late 1");
+    EXPECT_EQ(log[1].details, "late 2");
+}
+
+} // namespace
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "benchmark.hpp"
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+TEST(BenchmarkTest, SummaryStatistics) {
+    clwe::BenchmarkResult result;
+    for (int i = 100; i >= 1; --i) {
+        result.samples_ns.push_back(i * 10.0);
+    }
+    clwe::summarize_benchmark(result);
+
+    EXPECT_DOUBLE_EQ(result.mean_ns, 505.0);
+    EXPECT_DOUBLE_EQ(result.median_ns, 505.0);
+    EXPECT_DOUBLE_EQ(result.p99_ns, 990.0);
+    EXPECT_DOUBLE_EQ(result.min_ns, 10.0);
+    EXPECT_DOUBLE_EQ(result.max_ns, 1000.0);
+    EXPECT_NEAR(result.stddev_ns, 290.115, 0.001);
+    EXPECT_NEAR(result.ops_per_sec, 1e9 / 505.0, 1e-6);
+}
+
+TEST(BenchmarkTest, ParsesArguments) {
+    const char* argv[] = {"bench", "--quick", "--filter=sign/level=44", "--json=out.json", "--min-time=0.25"};
+    clwe::BenchmarkOptions options = clwe::BenchmarkOptions::from_args(5, const_cast<char**>(argv));
+    EXPECT_EQ(options.filter, "sign/level=44");
+    EXPECT_EQ(options.json_path, "out.json");
+    EXPECT_DOUBLE_EQ(options.min_time_s, 0.25);
+    EXPECT_EQ(options.min_samples, 5u);
+
+    const char* unknown[] = {"bench", "--fast"};
+    EXPECT_THROW(clwe::BenchmarkOptions::from_args(2, const_cast<char**>(unknown)), std::invalid_argument);
+    const char* malformed[] = {"bench", "--min-time=soon"};
+    EXPECT_THROW(clwe::BenchmarkOptions::from_args(2, const_cast<char**>(malformed)), std::invalid_argument);
+}
+
+TEST(BenchmarkTest, RunsFilteredCasesAndEmitsJson) {
+    clwe::BenchmarkSuite suite("unit");
+    volatile uint64_t sink = 0;
+    size_t slow_calls = 0;
+    suite.add("fast", {{"size", "1"}}, [&]() { sink = sink + 1; });
+    suite.add("slow", {{"size", "2"}}, [&]() { ++slow_calls; }, 2);
+    suite.add("fast_coeffs", {}, [&]() { sink = sink + 1; }, 256, "coeff");
+
+    clwe::BenchmarkOptions options;
+    options.min_time_s = 0.001;
+    options.min_samples = 10;
+    options.filter = "fast";
+    auto results = suite.run(options);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].full_name(), "fast/size=1");
+    EXPECT_GE(results[0].samples_ns.size(), 10u);
+    EXPECT_GT(results[0].iterations_per_sample, 1u);   // Batched to reach min_sample_ns
+    EXPECT_GT(results[0].mean_ns, 0.0);
+    EXPECT_EQ(slow_calls, 0u);
+    EXPECT_EQ(results[0].units_per_op, 0u);
+    EXPECT_EQ(results[1].unit, "coeff");
+    EXPECT_NEAR(results[1].cycles_per_unit, results[1].cycles_per_op / 256.0, 1e-9);
+
+    std::string json = suite.to_json(results);
+    EXPECT_NE(json.find("\"suite\": \"unit\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"fast/size=1\""), std::string::npos);
+    EXPECT_NE(json.find("\"labels\": {\"size\": \"1\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"p99_ns\": "), std::string::npos);
+    EXPECT_NE(json.find("\"samples_ns\": ["), std::string::npos);
+    EXPECT_NE(json.find("\"unit\": \"coeff\""), std::string::npos);
+    EXPECT_NE(json.find("\"cycles_per_unit\": "), std::string::npos);
+
+    std::ostringstream table;
+    clwe::BenchmarkSuite::print_results(table, results);
+    EXPECT_NE(table.str().find("fast/size=1"), std::string::npos);
+    EXPECT_NE(table.str().find("/coeff"), std::string::npos);
+}
+
+TEST(BenchmarkTest, ParsesThroughputArguments) {
+    const char* argv[] = {"bench", "--threads=4,1,2,2", "--duration=0.5", "--no-pin", "--csv=out.csv"};
+    clwe::ThroughputOptions options = clwe::ThroughputOptions::from_args(5, const_cast<char**>(argv));
+    EXPECT_EQ(options.resolved_thread_counts(), (std::vector<size_t>{1, 2, 4}));
+    EXPECT_DOUBLE_EQ(options.duration_s, 0.5);
+    EXPECT_FALSE(options.pin_threads);
+    EXPECT_EQ(options.csv_path, "out.csv");
+
+    clwe::ThroughputOptions defaults;
+    std::vector<size_t> counts = defaults.resolved_thread_counts();
+    ASSERT_FALSE(counts.empty());
+    EXPECT_EQ(counts.front(), 1u);
+
+    const char* zero[] = {"bench", "--threads=0"};
+    EXPECT_THROW(clwe::ThroughputOptions::from_args(2, const_cast<char**>(zero)), std::invalid_argument);
+}
+
+TEST(BenchmarkTest, MeasuresThroughputPerThreadCount) {
+    clwe::ThroughputBenchmark benchmark("unit_throughput");
+    std::atomic<size_t> workers_created{0};
+    benchmark.add("spin", [&](size_t) {
+        ++workers_created;
+        auto sink = std::make_shared<uint64_t>(0);
+        return [sink]() {
+            for (int i = 0; i < 1000; ++i) {
+                *sink = *sink * 31 + static_cast<uint64_t>(i);
+            }
+        };
+    });
+    benchmark.add("skipped", [](size_t) { return []() {}; });
+
+    clwe::ThroughputOptions options;
+    options.thread_counts = {2, 1};
+    options.duration_s = 0.02;
+    options.warmup_s = 0.005;
+    options.filter = "spin";
+    auto results = benchmark.run(options);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(workers_created.load(), 3u);
+    EXPECT_EQ(results[0].threads, 1u);
+    EXPECT_EQ(results[1].threads, 2u);
+    EXPECT_DOUBLE_EQ(results[0].efficiency, 1.0);
+    for (const auto& result : results) {
+        EXPECT_EQ(result.workload, "spin");
+        EXPECT_GT(result.operations, 0u);
+        EXPECT_GT(result.ops_per_sec, 0.0);
+        EXPECT_LE(result.min_thread_ops_per_sec, result.max_thread_ops_per_sec);
+        EXPECT_LE(result.p50_ns, result.p99_ns);
+        EXPECT_LE(result.p999_ns, result.max_ns);
+    }
+
+    std::string csv = clwe::ThroughputBenchmark::to_csv(results);
+    EXPECT_EQ(csv.rfind("workload,threads,operations,", 0), 0u);
+    EXPECT_NE(csv.find("\nspin,2,"), std::string::npos);
+    std::string json = benchmark.to_json(results);
+    EXPECT_NE(json.find("\"suite\": \"unit_throughput\""), std::string::npos);
+    EXPECT_NE(json.find("\"workload\": \"spin\", \"threads\": 2"), std::string::npos);
+}
+
+TEST(BenchmarkTest, ThroughputRethrowsWorkerErrors) {
+    clwe::ThroughputBenchmark benchmark("unit_throughput");
+    benchmark.add("setup_fails", [](size_t thread_index) -> clwe::BenchmarkSuite::Operation {
+        if (thread_index == 1) {
+            throw std::runtime_error("no workspace");
+        }
+        return []() {};
+    });
+    benchmark.add("operation_fails", [](size_t) {
+        return []() { throw std::logic_error("bad operation"); };
+    });
+
+    clwe::ThroughputOptions options;
+    options.thread_counts = {2};
+    options.duration_s = 0.01;
+    options.warmup_s = 0.0;
+    options.filter = "setup_fails";
+    EXPECT_THROW(benchmark.run(options), std::runtime_error);
+    options.filter = "operation_fails";
+    EXPECT_THROW(benchmark.run(options), std::logic_error);
+}
+
+} // namespace
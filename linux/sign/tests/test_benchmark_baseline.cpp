@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "benchmark_baseline.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<double> samples_around(double center, double spread, size_t count) {
+    std::vector<double> samples;
+    for (size_t i = 0; i < count; ++i) {
+        samples.push_back(center + spread * (static_cast<double>(i % 7) - 3.0));
+    }
+    return samples;
+}
+
+clwe::BenchmarkBaseline make_baseline(const std::string& key, const std::vector<std::pair<std::string, double>>& cases) {
+    clwe::BenchmarkBaseline baseline;
+    baseline.environment_key = key;
+    baseline.environment.cpu_model = "Test CPU";
+    baseline.library_version = "1.0.0";
+    baseline.created = "2026-01-01T00:00:00Z";
+    clwe::BenchmarkBaseline::Suite suite{"unit", {}};
+    for (const auto& [name, center] : cases) {
+        clwe::BenchmarkResult result;
+        result.name = name;
+        result.samples_ns = samples_around(center, center * 0.01, 50);
+        suite.results.push_back(result);
+    }
+    baseline.suites.push_back(suite);
+    return baseline;
+}
+
+TEST(BenchmarkBaselineTest, MannWhitneyMatchesReferenceValues) {
+    clwe::MannWhitneyResult separated = clwe::mann_whitney_u({1, 2, 3, 4, 5}, {6, 7, 8, 9, 10});
+    EXPECT_DOUBLE_EQ(separated.u, 25.0);
+    EXPECT_DOUBLE_EQ(separated.effect_size, 1.0);
+    EXPECT_NEAR(separated.p_value, 0.01219, 1e-4);   // Asymptotic, continuity-corrected
+
+    clwe::MannWhitneyResult reversed = clwe::mann_whitney_u({6, 7, 8, 9, 10}, {1, 2, 3, 4, 5});
+    EXPECT_DOUBLE_EQ(reversed.effect_size, -1.0);
+    EXPECT_NEAR(reversed.p_value, separated.p_value, 1e-12);
+
+    clwe::MannWhitneyResult identical = clwe::mann_whitney_u({3, 3, 3}, {3, 3, 3});
+    EXPECT_DOUBLE_EQ(identical.effect_size, 0.0);
+    EXPECT_DOUBLE_EQ(identical.p_value, 1.0);
+
+    clwe::MannWhitneyResult ties = clwe::mann_whitney_u({1, 2, 2, 3}, {2, 3, 3, 4});
+    EXPECT_DOUBLE_EQ(ties.u, 13.0);   // Candidate wins 12 pairs and ties 2
+    EXPECT_GT(ties.p_value, 0.05);
+}
+
+TEST(BenchmarkBaselineTest, ClassifiesRegressionsWithinBudget) {
+    clwe::BenchmarkBaseline baseline = make_baseline("key", {{"sign", 1000}, {"verify", 500}, {"keygen", 800},
+                                                             {"removed", 100}});
+    clwe::BenchmarkBaseline candidate = make_baseline("key", {{"sign", 1200}, {"verify", 400}, {"keygen", 810},
+                                                              {"added", 100}});
+
+    auto comparisons = clwe::compare_benchmarks(baseline, candidate, clwe::RegressionBudget());
+    ASSERT_EQ(comparisons.size(), 5u);
+    EXPECT_EQ(comparisons[0].name, "sign");
+    EXPECT_EQ(comparisons[0].verdict, clwe::ComparisonVerdict::REGRESSED);
+    EXPECT_NEAR(comparisons[0].change, 0.2, 1e-9);
+    EXPECT_EQ(comparisons[1].verdict, clwe::ComparisonVerdict::IMPROVED);
+    EXPECT_EQ(comparisons[2].verdict, clwe::ComparisonVerdict::UNCHANGED);   // 1.25% < 5% budget
+    EXPECT_LT(comparisons[2].test.p_value, 0.01);                           // ...though significant
+    EXPECT_EQ(comparisons[3].verdict, clwe::ComparisonVerdict::NEW);
+    EXPECT_EQ(comparisons[4].name, "removed");
+    EXPECT_EQ(comparisons[4].verdict, clwe::ComparisonVerdict::MISSING);
+    EXPECT_TRUE(clwe::has_regressions(comparisons));
+
+    clwe::RegressionBudget generous;
+    generous.max_slowdown = 0.25;
+    EXPECT_FALSE(clwe::has_regressions(clwe::compare_benchmarks(baseline, candidate, generous)));
+
+    std::ostringstream table;
+    clwe::print_comparisons(table, comparisons);
+    EXPECT_NE(table.str().find("REGRESSED"), std::string::npos);
+    EXPECT_NE(table.str().find("20.0%"), std::string::npos);
+}
+
+TEST(BenchmarkBaselineTest, JsonRoundTripAndVersioning) {
+    clwe::BenchmarkBaseline baseline = make_baseline("cpu | \"quoted\" | gcc", {{"sign/level=44", 1000}});
+    baseline.environment.build_info = "ColorSign 1.0.0\nCompiler: test\n";
+
+    clwe::BenchmarkBaseline loaded = clwe::BenchmarkBaseline::from_json(baseline.to_json());
+    EXPECT_EQ(loaded.environment_key, baseline.environment_key);
+    EXPECT_EQ(loaded.environment.cpu_model, "Test CPU");
+    EXPECT_EQ(loaded.environment.build_info, baseline.environment.build_info);
+    EXPECT_EQ(loaded.created, baseline.created);
+    ASSERT_NE(loaded.find_suite("unit"), nullptr);
+    const clwe::BenchmarkResult& result = loaded.find_suite("unit")->results.at(0);
+    EXPECT_EQ(result.full_name(), "sign/level=44");
+    ASSERT_EQ(result.samples_ns.size(), 50u);
+    EXPECT_NEAR(result.samples_ns[0], baseline.suites[0].results[0].samples_ns[0], 1e-3);
+
+    std::string future = baseline.to_json();
+    future.replace(future.find("\"format_version\": 1"), 19, "\"format_version\": 9");
+    EXPECT_THROW(clwe::BenchmarkBaseline::from_json(future), std::invalid_argument);
+    EXPECT_THROW(clwe::BenchmarkBaseline::from_json("{\"format_version\": 1,"), std::invalid_argument);
+    EXPECT_THROW(clwe::BenchmarkBaseline::from_json("[]"), std::invalid_argument);
+}
+
+TEST(BenchmarkBaselineTest, ReadsSuiteReports) {
+    clwe::BenchmarkSuite suite("unit_report");
+    volatile int sink = 0;
+    suite.add("noop", {{"size", "1"}}, [&]() { sink = sink + 1; });
+    clwe::BenchmarkOptions options;
+    options.min_time_s = 0.001;
+    options.min_samples = 5;
+    auto results = suite.run(options);
+
+    clwe::BenchmarkBaseline report = clwe::BenchmarkBaseline::from_report_json(suite.to_json(results));
+    EXPECT_EQ(report.environment_key, clwe::BenchmarkEnvironment::current().key());
+    ASSERT_EQ(report.suites.size(), 1u);
+    EXPECT_EQ(report.suites[0].name, "unit_report");
+    ASSERT_EQ(report.suites[0].results.size(), 1u);
+    EXPECT_EQ(report.suites[0].results[0].full_name(), "noop/size=1");
+    EXPECT_EQ(report.suites[0].results[0].samples_ns.size(), results[0].samples_ns.size());
+
+    // Reports from different environments are never mixed
+    clwe::BenchmarkBaseline other = make_baseline("other machine", {{"noop/size=1", 10}});
+    EXPECT_THROW(report.merge(other), std::invalid_argument);
+    clwe::BenchmarkBaseline same = make_baseline(report.environment_key, {{"extra", 10}});
+    report.merge(same);
+    EXPECT_NE(report.find_suite("unit"), nullptr);
+    EXPECT_NE(report.find_suite("unit_report"), nullptr);
+}
+
+TEST(BenchmarkBaselineTest, StoreKeysFilesByEnvironment) {
+    std::string directory = testing::TempDir() + "colorsign_baselines";
+    clwe::BaselineStore store(directory);
+    EXPECT_NE(store.path_for("a"), store.path_for("b"));
+    EXPECT_EQ(store.path_for("a").rfind(directory + "/baseline-", 0), 0u);
+
+    clwe::BenchmarkBaseline loaded;
+    std::remove(store.path_for("store test").c_str());
+    EXPECT_FALSE(store.load("store test", loaded));
+
+    store.save(make_baseline("store test", {{"sign", 1000}}));
+    ASSERT_TRUE(store.load("store test", loaded));
+    EXPECT_EQ(loaded.suites.at(0).results.at(0).name, "sign");
+
+    std::ofstream(store.path_for("corrupt")) << "not json";
+    EXPECT_THROW(store.load("corrupt", loaded), std::runtime_error);
+    std::remove(store.path_for("store test").c_str());
+    std::remove(store.path_for("corrupt").c_str());
+}
+
+} // namespace
@@ -184,6 +184,88 @@ TEST_F(KeyGenTest, KeyGenerationConsistency87) {
     EXPECT_EQ(private_key.secret_data.size(), expected_private_size);
 }
 
+TEST_F(KeyGenTest, SeedOnlyPrivateKeyExpands) {
+    clwe::ColorSignKeyGen keygen(params87);
+    keygen.set_key_format_version(clwe::KEY_FORMAT_PACKED_SECRET);
+    std::array<uint8_t, 32> zeta;
+    zeta.fill(0x5A);
+    auto [public_key, full_key] = keygen.generate_keypair_deterministic(zeta);
+
+    clwe::ColorSignPrivateKey seed_key = clwe::ColorSignPrivateKey::from_seed(zeta, public_key);
+    EXPECT_TRUE(seed_key.is_seed_only());
+    std::vector<uint8_t> serialized = seed_key.serialize();
+    ASSERT_EQ(serialized.size(), clwe::SEED_KEY_SERIALIZED_BYTES);
+    EXPECT_EQ(serialized[0], clwe::KEY_FORMAT_SEED);
+    EXPECT_EQ(serialized[1], clwe::KEY_FORMAT_PACKED_SECRET);
+
+    clwe::ColorSignPrivateKey restored = clwe::ColorSignPrivateKey::deserialize(serialized, params87);
+    EXPECT_TRUE(restored.is_seed_only());
+    EXPECT_EQ(restored.serialize(), serialized);
+    clwe::ColorSignPrivateKey expanded = restored.expand();
+    EXPECT_EQ(expanded.serialize(), full_key.serialize());
+    EXPECT_EQ(full_key.expand().serialize(), full_key.serialize());
+
+    // tr guards the seed; sizes other than the seed layout are rejected
+    std::vector<uint8_t> tampered = serialized;
+    tampered.back() ^= 0x01;
+    EXPECT_THROW(clwe::ColorSignPrivateKey::deserialize(tampered, params87).expand(), std::invalid_argument);
+    serialized.push_back(0);
+    EXPECT_THROW(clwe::ColorSignPrivateKey::deserialize(serialized, params87), std::invalid_argument);
+
+    auto [random_public, random_seed_key] = keygen.generate_seed_keypair();
+    EXPECT_TRUE(random_seed_key.is_seed_only());
+    EXPECT_EQ(random_seed_key.expand().hash_tr, random_public.hash_tr);
+}
+
+TEST_F(KeyGenTest, ExpandedKeyCacheEvictsLeastRecentlyUsed) {
+    clwe::ColorSignKeyGen keygen(params44);
+    std::vector<clwe::ColorSignPrivateKey> seed_keys;
+    for (int i = 0; i < 3; ++i) {
+        seed_keys.push_back(keygen.generate_seed_keypair().second);
+    }
+
+    clwe::ExpandedKeyCache cache(2);
+    auto first = cache.expand(seed_keys[0]);
+    EXPECT_EQ(cache.expand(seed_keys[0]), first);   // Hit: the same expansion
+    cache.expand(seed_keys[1]);
+    cache.expand(seed_keys[0]);                     // 1 is now least recently used
+    cache.expand(seed_keys[2]);                     // Evicts 1
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.misses(), 3u);
+    EXPECT_EQ(cache.expand(seed_keys[0]), first);
+    cache.expand(seed_keys[1]);
+    EXPECT_EQ(cache.misses(), 4u);
+    EXPECT_EQ(first->serialize(), seed_keys[0].expand().serialize());
+
+    // Keys that are not seed-only pass through
+    auto [public_key, private_key] = keygen.generate_keypair();
+    EXPECT_EQ(cache.expand(private_key)->serialize(), private_key.serialize());
+    EXPECT_EQ(cache.misses(), 4u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_THROW(clwe::ExpandedKeyCache(0), std::invalid_argument);
+}
+
+TEST_F(KeyGenTest, ExpandedKeyCacheDoesNotMatchForgedSeedKeys) {
+    clwe::ColorSignKeyGen keygen(params44);
+    auto [public_key, seed_key] = keygen.generate_seed_keypair();
+    clwe::ExpandedKeyCache cache(4);
+    auto expanded = cache.expand(seed_key);
+
+    // Another zeta under the cached key's tr must be expanded (and rejected), not served the entry
+    clwe::ColorSignPrivateKey forged = seed_key;
+    forged.secret_data.back() ^= 1;
+    EXPECT_THROW(cache.expand(forged), std::invalid_argument);
+    EXPECT_EQ(cache.misses(), 2u);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Entries outlive eviction for their holders
+    cache.clear();
+    EXPECT_EQ(expanded->hash_tr, public_key.hash_tr);
+}
+
 TEST_F(KeyGenTest, ErrorMessageUtility) {
     EXPECT_EQ(clwe::get_colorsign_error_message(clwe::ColorSignError::SUCCESS), "Success");
     EXPECT_EQ(clwe::get_colorsign_error_message(clwe::ColorSignError::INVALID_PARAMETERS), "Invalid parameters");
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "metrics.hpp"
+#include "secure_arena.hpp"
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(LatencyHistogramTest, BucketsCoverValuesWithBoundedError) {
+    using Histogram = clwe::LatencyHistogram;
+    for (uint64_t ns = 0; ns < Histogram::SUB_BUCKETS; ++ns) {
+        EXPECT_EQ(Histogram::bucket_upper_bound(Histogram::bucket_index(ns)), ns);
+    }
+    for (uint64_t ns : {16ull, 17ull, 1000ull, 123456ull, 987654321ull, 60000000000ull}) {
+        size_t index = Histogram::bucket_index(ns);
+        uint64_t upper = Histogram::bucket_upper_bound(index);
+        EXPECT_GE(upper, ns);
+        EXPECT_LE(upper - ns, ns / Histogram::SUB_BUCKETS);
+        EXPECT_GT(upper, index == 0 ? 0 : Histogram::bucket_upper_bound(index - 1));
+    }
+    EXPECT_EQ(Histogram::bucket_index(UINT64_MAX), Histogram::BUCKETS - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesTrackUniformDistribution) {
+    clwe::LatencyHistogram histogram;
+    for (uint64_t ns = 1; ns <= 100000; ++ns) {
+        histogram.record(ns * 10);
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100000u);
+    EXPECT_EQ(snapshot.max_ns, 1000000u);
+    for (double q : {0.5, 0.9, 0.99, 0.999}) {
+        double expected = q * 1000000.0;
+        EXPECT_NEAR(static_cast<double>(snapshot.percentile(q)), expected, expected / 16) << q;
+    }
+    EXPECT_EQ(snapshot.percentile(1.0), 1000000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+}
+
+TEST(MetricsTest, ShardsMergeAcrossThreads) {
+    clwe::Counter counter;
+    clwe::LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; ++i) {
+                counter.add();
+                histogram.record(500);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.value(), 80000u);
+    EXPECT_EQ(histogram.snapshot().count, 80000u);
+    EXPECT_EQ(histogram.snapshot().sum_ns, 80000u * 500);
+}
+
+TEST(MetricsRegistryTest, SeriesAreStableAndTyped) {
+    clwe::MetricsRegistry registry;
+    clwe::Counter& a = registry.counter("requests_total", "Requests", {{"path", "a"}});
+    clwe::Counter& b = registry.counter("requests_total", "Requests", {{"path", "b"}});
+
+    EXPECT_NE(&a, &b);
+    EXPECT_EQ(&registry.counter("requests_total", "Requests", {{"path", "a"}}), &a);
+    EXPECT_THROW(registry.gauge("requests_total", "Requests"), std::invalid_argument);
+}
+
+TEST(MetricsRegistryTest, ConcurrentRegistrationKeepsSeries) {
+    clwe::MetricsRegistry registry;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&registry, t] {
+            // Every thread adds label sets to the same family while using the ones it holds
+            for (int i = 0; i < 200; ++i) {
+                clwe::Counter& counter = registry.counter("shared_total", "Shared",
+                                                          {{"id", std::to_string(t * 1000 + i)}});
+                counter.add();
+                registry.counter("shared_total", "Shared", {{"id", "common"}}).add();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(registry.counter("shared_total", "Shared", {{"id", "common"}}).value(), 800u);
+    EXPECT_EQ(registry.counter("shared_total", "Shared", {{"id", "3199"}}).value(), 1u);
+}
+
+TEST(MetricsRegistryTest, PrometheusTextFormat) {
+    clwe::MetricsRegistry registry;
+    registry.counter("ops_total", "Operations", {{"level", "44"}}).add(3);
+    registry.gauge("locked_bytes", "Locked").set(4096);
+    clwe::LatencyHistogram& latency = registry.histogram("op_duration_seconds", "Latency", {{"op", "sign"}});
+    latency.record(2000);       // 2 us
+    latency.record(3000000);    // 3 ms
+
+    std::string text = registry.prometheus_text();
+    EXPECT_NE(text.find("# TYPE ops_total counter\nops_total{level=\"44\"} 3\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("# TYPE locked_bytes gauge\nlocked_bytes 4096\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE op_duration_seconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_bucket{op=\"sign\",le=\"1e-06\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_bucket{op=\"sign\",le=\"2.5e-06\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_bucket{op=\"sign\",le=\"0.005\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_bucket{op=\"sign\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_count{op=\"sign\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("op_duration_seconds_quantile{op=\"sign\",quantile=\"0.99\"}"), std::string::npos);
+
+    registry.reset();
+    EXPECT_NE(registry.prometheus_text().find("ops_total{level=\"44\"} 0\n"), std::string::npos);
+}
+
+TEST(MetricsRegistryTest, WritesPrometheusFile) {
+    clwe::MetricsRegistry registry;
+    registry.counter("ops_total", "Operations").add();
+    std::string path = testing::TempDir() + "colorsign_metrics.prom";
+
+    registry.write_prometheus(path);
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), registry.prometheus_text());
+    std::remove(path.c_str());
+
+    EXPECT_THROW(registry.write_prometheus("/nonexistent-dir/metrics.prom"), std::runtime_error);
+}
+
+TEST(SchemeMetricsTest, OperationsAreRecordedPerLevel) {
+    if (!clwe::INSTRUMENTATION_ENABLED) {
+        GTEST_SKIP() << "Built without instrumentation";
+    }
+    clwe::CLWEParameters params(65);
+    clwe::SchemeMetrics& metrics = clwe::SchemeMetrics::for_level(65);
+    EXPECT_EQ(&clwe::SchemeMetrics::for_level(65), &metrics);
+    uint64_t keypairs = metrics.keypairs.value();
+    uint64_t signatures = metrics.signatures.value();
+    uint64_t verifications = metrics.verifications.value();
+    uint64_t sign_samples = metrics.sign_latency.snapshot().count;
+    uint64_t verify_prepare_samples = metrics.verify_prepare_latency.snapshot().count;
+    uint64_t verify_check_samples = metrics.verify_check_latency.snapshot().count;
+    uint64_t cache_hits = metrics.matrix_cache_hits.value();
+    uint64_t bytes_hashed = metrics.sign_bytes_hashed.value();
+
+    clwe::ColorSignKeyGen keygen(params);
+    std::array<uint8_t, 32> seed = {7};
+    auto [public_key, private_key] = keygen.generate_keypair_deterministic(seed);
+    clwe::ColorSign signer(params);
+    clwe::ColorSignVerify verifier(params);
+    clwe::SignWorkspace workspace(params);
+    std::vector<uint8_t> message(100, 'm');
+    clwe::ColorSignature signature;
+    signer.sign_message(message, private_key, public_key, workspace, signature);
+    signer.sign_message(message, private_key, public_key, workspace, signature);
+    verifier.verify_signature(public_key, signature, message);
+
+    EXPECT_EQ(metrics.keypairs.value(), keypairs + 1);
+    EXPECT_EQ(metrics.signatures.value(), signatures + 2);
+    EXPECT_EQ(metrics.verifications.value(), verifications + 1);
+    EXPECT_EQ(metrics.sign_latency.snapshot().count, sign_samples + 2);
+    EXPECT_EQ(metrics.verify_prepare_latency.snapshot().count, verify_prepare_samples + 1);
+    EXPECT_EQ(metrics.verify_check_latency.snapshot().count, verify_check_samples + 1);
+    EXPECT_EQ(metrics.matrix_cache_hits.value(), cache_hits + 1);
+    EXPECT_EQ(metrics.sign_bytes_hashed.value(), bytes_hashed + 200);
+
+    std::string text = clwe::MetricsRegistry::global().prometheus_text();
+    EXPECT_NE(text.find("colorsign_operation_duration_seconds_count{operation=\"sign\",stage=\"total\",level=\"65\"}"),
+              std::string::npos);
+    EXPECT_NE(text.find("colorsign_operation_duration_seconds_count{operation=\"verify\",stage=\"check\",level=\"65\"}"),
+              std::string::npos);
+    EXPECT_NE(text.find("colorsign_sign_rejections_total{level=\"65\"}"), std::string::npos);
+}
+
+TEST(SchemeMetricsTest, SecureArenaLockedBytesGauge) {
+    int64_t before = clwe::secure_memory_locked_gauge().value();
+    {
+        clwe::SecureArena arena(64 * 1024);
+        EXPECT_EQ(clwe::secure_memory_locked_gauge().value() - before,
+                  static_cast<int64_t>(arena.stats().locked_bytes));
+    }
+    EXPECT_EQ(clwe::secure_memory_locked_gauge().value(), before);
+}
+
+} // namespace
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "performance_metrics.hpp"
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Work the compiler cannot drop
+void busy_work() {
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        sink = sink + i * i;
+    }
+}
+
+TEST(PerformanceMetricsTest, MemoryUsageReportsResidentSet) {
+    clwe::MemoryStats memory = clwe::PerformanceMetrics::get_memory_usage();
+    EXPECT_GT(memory.current_memory, 0u);
+    EXPECT_GE(memory.peak_memory, memory.current_memory);
+}
+
+TEST(PerformanceMetricsTest, TimingAndCycleStatistics) {
+    clwe::TimingStats timing = clwe::PerformanceMetrics::time_operation(busy_work, 20);
+    EXPECT_GT(timing.total_time, 0.0);
+    EXPECT_LE(timing.min_time, timing.average_time);
+    EXPECT_GE(timing.max_time, timing.average_time);
+    EXPECT_GT(timing.throughput, 0.0);
+
+    clwe::CycleStats cycles = clwe::PerformanceMetrics::time_operation_cycles(busy_work, 20);
+    EXPECT_GT(cycles.min_cycles, 0u);
+    EXPECT_LE(cycles.min_cycles, cycles.average_cycles);
+    EXPECT_GE(cycles.max_cycles, cycles.average_cycles);
+
+    auto combined = clwe::PerformanceMetrics::measure_operation(busy_work, 5);
+    EXPECT_GT(combined.hardware.cycles, 0u);
+    EXPECT_GT(combined.memory.average_memory, 0u);
+
+    EXPECT_THROW(clwe::PerformanceMetrics::time_operation(busy_work, 0), std::invalid_argument);
+}
+
+TEST(PerformanceMetricsTest, PerfEventGroupCountsWork) {
+    clwe::PerfEventGroup group;
+    clwe::HardwareCounters start = group.read();
+    busy_work();
+    clwe::HardwareCounters delta = group.read() - start;
+
+    EXPECT_GT(delta.cycles, 0u);
+    if (group.counts(clwe::PerfEventGroup::INSTRUCTIONS)) {
+        EXPECT_GT(delta.instructions, 20000u);
+    } else {
+        EXPECT_EQ(delta.instructions, 0u);
+    }
+}
+
+TEST(StageProfilerTest, DisabledProbesRecordNothing) {
+    clwe::StageProfiler::enable(false);
+    clwe::StageProfiler::reset();
+    {
+        clwe::ScopedStage probe(clwe::PerfStage::NTT);
+        busy_work();
+    }
+    for (const auto& stage : clwe::StageProfiler::breakdown()) {
+        EXPECT_EQ(stage.calls, 0u) << clwe::perf_stage_name(stage.stage);
+    }
+}
+
+TEST(StageProfilerTest, MergesThreads) {
+    if (!clwe::INSTRUMENTATION_ENABLED) {
+        GTEST_SKIP() << "Built without instrumentation";
+    }
+    clwe::StageProfiler::enable(true);
+    clwe::StageProfiler::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 10; ++i) {
+                clwe::ScopedStage probe(clwe::PerfStage::PACKING);
+                busy_work();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    clwe::StageProfiler::enable(false);
+
+    auto stages = clwe::StageProfiler::breakdown();
+    const auto& packing = stages[static_cast<size_t>(clwe::PerfStage::PACKING)];
+    EXPECT_EQ(packing.stage, clwe::PerfStage::PACKING);
+    EXPECT_EQ(packing.calls, 40u);
+    EXPECT_GT(packing.time_ns, 0u);
+    EXPECT_GT(packing.counters.cycles, 0u);
+}
+
+TEST(StageProfilerTest, AttributesSchemeStages) {
+    if (!clwe::INSTRUMENTATION_ENABLED) {
+        GTEST_SKIP() << "Built without instrumentation";
+    }
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    clwe::ColorSign signer(params);
+    clwe::ColorSignVerify verifier(params);
+    std::vector<uint8_t> message = {'s', 't', 'a', 'g', 'e'};
+
+    clwe::StageProfiler::enable(true);
+    clwe::StageProfiler::reset();
+    std::array<uint8_t, 32> seed = {3};
+    auto [public_key, private_key] = keygen.generate_keypair_deterministic(seed);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+    verifier.verify_signature(public_key, signature, message);
+    clwe::StageProfiler::enable(false);
+
+    auto stages = clwe::StageProfiler::breakdown();
+    ASSERT_EQ(stages.size(), static_cast<size_t>(clwe::PerfStage::COUNT));
+    auto calls = [&](clwe::PerfStage stage) { return stages[static_cast<size_t>(stage)].calls; };
+    EXPECT_EQ(calls(clwe::PerfStage::MATRIX_EXPANSION), 3u);   // keygen, sign, verify
+    EXPECT_GE(calls(clwe::PerfStage::HASHING), 4u);            // tr, mu and rho' when signing, mu when verifying
+    EXPECT_GE(calls(clwe::PerfStage::SAMPLING), 3u);           // secret, y, challenge
+    EXPECT_GE(calls(clwe::PerfStage::NTT), 4u);                // A*s1, A*y, c*s, A*z - c*t
+    EXPECT_GE(calls(clwe::PerfStage::PACKING), 3u);
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "polyvec.hpp"
+#include "utils.hpp"
+#include "color_integration.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Test fixture for the contiguous polynomial vector types
+class PolyVecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nested = std::vector<std::vector<uint32_t>>(k, std::vector<uint32_t>(n));
+        for (uint32_t i = 0; i < k; ++i) {
+            for (uint32_t j = 0; j < n; ++j) {
+                // The variable-length codecs only round-trip coefficients below 64
+                nested[i][j] = (i * 37 + j * 11) % 61;
+            }
+        }
+    }
+
+    const uint32_t k = 4;
+    const uint32_t n = 256;
+    const uint32_t q = 8380417;
+    std::vector<std::vector<uint32_t>> nested;
+};
+
+TEST_F(PolyVecTest, ZeroInitializedContiguousAndAligned) {
+    clwe::PolyVec polys(k, n);
+
+    EXPECT_EQ(polys.size(), k);
+    EXPECT_EQ(polys.degree(), n);
+    EXPECT_EQ(polys.coeff_count(), static_cast<size_t>(k) * n);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(polys.data()) % clwe::POLY_ALIGNMENT, 0u);
+
+    for (uint32_t i = 0; i < k; ++i) {
+        EXPECT_EQ(polys[i].data(), polys.data() + i * n);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(polys[i].data()) % clwe::POLY_ALIGNMENT, 0u);
+        EXPECT_EQ(polys[i].size(), n);
+    }
+    for (size_t i = 0; i < polys.coeff_count(); ++i) {
+        EXPECT_EQ(polys.data()[i], 0u);
+    }
+}
+
+TEST_F(PolyVecTest, MoveTransfersStorage) {
+    clwe::PolyVec source = clwe::PolyVec::from_vectors(nested);
+    const uint32_t* storage = source.data();
+
+    clwe::PolyVec moved(std::move(source));
+    EXPECT_EQ(moved.data(), storage);
+    EXPECT_EQ(source.data(), nullptr);
+    EXPECT_TRUE(source.empty());
+
+    clwe::PolyVec assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.data(), storage);
+    EXPECT_EQ(assigned.to_vectors(), nested);
+}
+
+TEST_F(PolyVecTest, CloneIsDeepCopy) {
+    clwe::PolyVec original = clwe::PolyVec::from_vectors(nested);
+    clwe::PolyVec copy = original.clone();
+
+    EXPECT_NE(copy.data(), original.data());
+    copy[0][0] = q - 1;
+    EXPECT_EQ(original[0][0], nested[0][0]);
+    EXPECT_EQ(copy[0][0], q - 1);
+}
+
+TEST_F(PolyVecTest, IterationYieldsPolynomials) {
+    clwe::PolyVec polys = clwe::PolyVec::from_vectors(nested);
+
+    uint32_t index = 0;
+    for (const auto& poly : polys) {
+        EXPECT_EQ(std::vector<uint32_t>(poly.begin(), poly.end()), nested[index]);
+        ++index;
+    }
+    EXPECT_EQ(index, k);
+}
+
+TEST_F(PolyVecTest, RaggedVectorsRejected) {
+    nested[1].pop_back();
+    EXPECT_THROW(clwe::PolyVec::from_vectors(nested), std::invalid_argument);
+}
+
+TEST_F(PolyVecTest, MatrixIndexingIsRowMajor) {
+    std::vector<std::vector<uint32_t>> entries(k * k, std::vector<uint32_t>(n));
+    for (uint32_t e = 0; e < k * k; ++e) {
+        entries[e][0] = e;
+    }
+
+    clwe::PolyMat matrix = clwe::PolyMat::from_vectors(entries, k, k);
+    EXPECT_EQ(matrix.rows(), k);
+    EXPECT_EQ(matrix.cols(), k);
+    EXPECT_EQ(matrix(2, 3)[0], 2 * k + 3);
+    EXPECT_EQ(matrix(2, 3).data(), matrix.data() + (2 * k + 3) * n);
+    EXPECT_EQ(matrix.to_vectors(), entries);
+
+    EXPECT_THROW(clwe::PolyMat::from_vectors(entries, k, k + 1), std::invalid_argument);
+}
+
+TEST_F(PolyVecTest, PackingMatchesNestedVectorApi) {
+    clwe::PolyVec polys = clwe::PolyVec::from_vectors(nested);
+
+    EXPECT_EQ(clwe::pack_polynomial_vector(polys), clwe::pack_polynomial_vector(nested));
+    EXPECT_EQ(clwe::pack_polynomial_vector_auto(polys, q), clwe::pack_polynomial_vector_auto(nested, q));
+
+    for (uint32_t d : {10u, 18u}) {
+        auto packed = clwe::pack_polynomial_vector_ml_dsa(polys, q, d);
+        EXPECT_EQ(packed, clwe::pack_polynomial_vector_ml_dsa(nested, q, d));
+
+        clwe::PolyVec unpacked(k, n);
+        clwe::unpack_polynomial_vector_ml_dsa(packed.data(), packed.size(), q, d, unpacked);
+        EXPECT_EQ(unpacked.to_vectors(), clwe::unpack_polynomial_vector_ml_dsa(packed, k, n, q, d));
+    }
+
+    clwe::PolyVec unpacked(k, n);
+    clwe::unpack_polynomial_vector_compressed(clwe::pack_polynomial_vector_compressed(polys, q), q, unpacked);
+    EXPECT_EQ(unpacked.to_vectors(), nested);
+}
+
+TEST_F(PolyVecTest, ColorCodecMatchesNestedVectorApi) {
+    clwe::PolyVec polys = clwe::PolyVec::from_vectors(nested);
+
+    auto colors = clwe::encode_polynomial_vector_as_colors(polys, q);
+    EXPECT_EQ(colors, clwe::encode_polynomial_vector_as_colors(nested, q));
+
+    clwe::PolyVec decoded(k, n);
+    clwe::decode_colors_to_polynomial_vector(colors, q, decoded);
+    EXPECT_EQ(decoded.to_vectors(), clwe::decode_colors_to_polynomial_vector(colors, k, n, q));
+
+    auto compressed = clwe::encode_polynomial_vector_as_colors_compressed(polys, q);
+    EXPECT_EQ(compressed, clwe::encode_polynomial_vector_as_colors_compressed(nested, q));
+    clwe::decode_colors_to_polynomial_vector_compressed(compressed, q, decoded);
+    EXPECT_EQ(decoded.to_vectors(), nested);
+}
+
+} // namespace
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "secure_arena.hpp"
+#include "polyvec.hpp"
+#include "sign.hpp"
+#include "keygen.hpp"
+#include "metrics.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+TEST(SecureArenaTest, ReservesRegionOnce) {
+    clwe::SecureArena arena(10000);
+    clwe::SecureArenaStats stats = arena.stats();
+
+    EXPECT_GE(arena.capacity(), 10000u);
+    EXPECT_EQ(stats.capacity, arena.capacity());
+    EXPECT_EQ(stats.locked_bytes, arena.locked() ? arena.capacity() : 0u);
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+    EXPECT_THROW(clwe::SecureArena(0), std::invalid_argument);
+}
+
+TEST(SecureArenaTest, BlocksAreAlignedZeroedAndReused) {
+    clwe::SecureArena arena(64 * 1024);
+
+    auto* first = static_cast<uint8_t*>(arena.allocate(100, 16));
+    auto* second = static_cast<uint8_t*>(arena.allocate(1000, 64));
+    EXPECT_TRUE(arena.owns(first));
+    EXPECT_TRUE(arena.owns(second));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % clwe::SecureArena::BLOCK_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % clwe::SecureArena::BLOCK_ALIGNMENT, 0u);
+    EXPECT_EQ(arena.stats().bytes_in_use, 128u + 1024u);
+
+    std::fill(first, first + 100, 0xAB);
+    arena.deallocate(first, 100, 16);
+
+    // The released block is wiped and handed out again for a request that fits
+    auto* reused = static_cast<uint8_t*>(arena.allocate(64, 8));
+    EXPECT_EQ(reused, first);
+    for (size_t i = 0; i < 64; ++i) {
+        EXPECT_EQ(reused[i], 0u);
+    }
+
+    arena.deallocate(reused, 64, 8);
+    arena.deallocate(second, 1000, 64);
+
+    clwe::SecureArenaStats stats = arena.stats();
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+    EXPECT_EQ(stats.active_allocations, 0u);
+    EXPECT_EQ(stats.peak_bytes_in_use, 128u + 1024u);
+    EXPECT_EQ(stats.total_allocations, 3u);
+}
+
+TEST(SecureArenaTest, FreedNeighboursCoalesce) {
+    clwe::SecureArena arena(4096);
+    size_t capacity = arena.capacity();
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < capacity / 256; ++i) {
+        blocks.push_back(arena.allocate(256, 64));
+    }
+    EXPECT_THROW((void)arena.allocate(64, 64), std::bad_alloc);
+    EXPECT_EQ(arena.stats().failed_allocations, 1u);
+
+    // Free every block out of order; the region must be whole again
+    for (size_t i = 0; i < blocks.size(); i += 2) arena.deallocate(blocks[i], 256, 64);
+    for (size_t i = 1; i < blocks.size(); i += 2) arena.deallocate(blocks[i], 256, 64);
+    void* whole = arena.allocate(capacity, 64);
+    EXPECT_EQ(whole, blocks[0]);
+    arena.deallocate(whole, capacity, 64);
+
+    EXPECT_THROW((void)arena.allocate(64, 128), std::bad_alloc);
+}
+
+TEST(SecureArenaTest, StandardAllocatorAndPolyVec) {
+    clwe::SecureArena arena(64 * 1024);
+    {
+        std::vector<uint32_t, clwe::SecureArenaAllocator<uint32_t>> coeffs(
+            256, 7, clwe::SecureArenaAllocator<uint32_t>(arena));
+        EXPECT_TRUE(arena.owns(coeffs.data()));
+
+        clwe::PolyVec polys(4, 256, &arena);
+        EXPECT_TRUE(arena.owns(polys.data()));
+        EXPECT_EQ(polys.resource(), &arena);
+        EXPECT_EQ(polys.data()[1023], 0u);
+
+        clwe::PolyVec copy = polys.clone();
+        EXPECT_TRUE(arena.owns(copy.data()));
+        clwe::PolyVec moved(std::move(copy));
+        EXPECT_EQ(moved.resource(), &arena);
+        EXPECT_EQ(arena.stats().active_allocations, 3u);
+    }
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+}
+
+TEST(SecureArenaTest, RejectsForeignPointers) {
+    clwe::SecureArena arena(64 * 1024);
+    std::vector<uint8_t> foreign(128, 0xAB);
+    auto* block = static_cast<uint8_t*>(arena.allocate(128, 16));
+
+    EXPECT_THROW(arena.deallocate(foreign.data(), foreign.size(), 16), std::invalid_argument);
+    EXPECT_THROW(arena.deallocate(block + 8, 64, 16), std::invalid_argument);
+    EXPECT_THROW(arena.deallocate(block, arena.capacity() + 1, 16), std::invalid_argument);
+    EXPECT_EQ(foreign[0], 0xAB);  // Not wiped
+    EXPECT_EQ(arena.stats().active_allocations, 1u);
+
+    arena.deallocate(block, 128, 16);
+    EXPECT_EQ(arena.stats().active_allocations, 0u);
+}
+
+TEST(SecureArenaTest, RequiredLockingLocksOrThrows) {
+    uint64_t failures = clwe::secure_memory_lock_failures().value();
+    try {
+        clwe::SecureArena arena(64 * 1024, clwe::MemoryLockPolicy::REQUIRED);
+        EXPECT_TRUE(arena.locked());
+        EXPECT_EQ(arena.stats().locked_bytes, arena.capacity());
+    } catch (const std::system_error&) {
+        // Locking refused here (e.g. RLIMIT_MEMLOCK); a strict arena must not exist unlocked
+    }
+    EXPECT_EQ(clwe::secure_memory_lock_failures().value(), failures);
+
+    clwe::SecureArena best_effort(64 * 1024);
+    EXPECT_EQ(clwe::secure_memory_lock_failures().value(), failures + (best_effort.locked() ? 0u : 1u));
+}
+
+TEST(SecureArenaTest, ArenaWorkspaceSignsIdentically) {
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    std::array<uint8_t, 32> seed = {0};
+    auto [public_key, private_key] = keygen.generate_keypair_deterministic(seed);
+    clwe::ColorSign signer(params);
+    std::vector<uint8_t> message = {'a', 'r', 'e', 'n', 'a'};
+
+    clwe::SecureArena arena(256 * 1024);
+    clwe::ColorSignature signature;
+    {
+        clwe::SignWorkspace workspace(params, &arena);
+        EXPECT_GT(arena.stats().bytes_in_use, 0u);
+        signer.sign_message(message, private_key, public_key, workspace, signature);
+    }
+    EXPECT_EQ(signature.serialize(), signer.sign_message(message, private_key, public_key).serialize());
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+    EXPECT_GT(arena.stats().peak_bytes_in_use, 0u);
+}
+
+} // namespace
@@ -2,6 +2,7 @@
 #include "../include/clwe/security_utils.hpp"
 #include "../include/clwe/parameters.hpp"
 #include "../include/clwe/sign.hpp"
+#include "../include/clwe/keygen.hpp"
 #include <vector>
 #include <array>
 #include <chrono>
@@ -45,6 +46,29 @@ TEST_F(SecurityUtilsTest, InputValidation_KeySize) {
     EXPECT_EQ(InputValidator::validate_key_size(empty_key), SecurityError::INVALID_KEY_FORMAT);
 }
 
+// Key data is packed (t at up to 23 bits, s1 || s2 at 10 bits or exactly at the eta width), so
+// the floor is one byte per coefficient of a k-vector rather than a 32-bit word per coefficient
+TEST_F(SecurityUtilsTest, InputValidation_KeyFormat) {
+    std::array<uint8_t, 32> seed;
+    seed.fill(0x5C);
+    for (uint32_t level : {44u, 65u, 87u}) {
+        CLWEParameters params(level);
+        size_t floor = static_cast<size_t>(params.module_rank) * params.degree;
+        for (uint8_t version : {KEY_FORMAT_ORIGINAL, KEY_FORMAT_POWER2ROUND, KEY_FORMAT_PACKED_SECRET}) {
+            ColorSignKeyGen keygen(params);
+            keygen.set_key_format_version(version);
+            auto [public_key, private_key] = keygen.generate_keypair_deterministic(seed);
+            EXPECT_EQ(InputValidator::validate_key_format(public_key.public_data, params), SecurityError::SUCCESS);
+            EXPECT_EQ(InputValidator::validate_key_format(private_key.secret_data, params), SecurityError::SUCCESS);
+            EXPECT_LT(public_key.public_data.size(), 4 * floor);
+        }
+
+        EXPECT_EQ(InputValidator::validate_key_format(std::vector<uint8_t>(floor, 0x01), params), SecurityError::SUCCESS);
+        EXPECT_EQ(InputValidator::validate_key_format(std::vector<uint8_t>(floor - 1, 0x01), params),
+                  SecurityError::INVALID_KEY_FORMAT);
+    }
+}
+
 TEST_F(SecurityUtilsTest, InputValidation_Parameters) {
     CLWEParameters valid_params(44);
     EXPECT_EQ(InputValidator::validate_parameters(valid_params), SecurityError::SUCCESS);
@@ -181,15 +205,15 @@ TEST_F(SecurityUtilsTest, TimingProtection_Basic) {
     auto monitor = std::make_unique<DefaultSecurityMonitor>();
     TimingProtection timing_protection(std::move(monitor));
 
-    timing_protection.start_operation();
+    uint64_t start = timing_protection.start_operation();
 
     // Simulate some operation
     std::chrono::milliseconds sleep_duration(1);
     std::this_thread::sleep_for(sleep_duration);
 
-    timing_protection.end_operation("TestOperation");
+    timing_protection.end_operation("TestOperation", start);
 
-    uint64_t operation_duration = timing_protection.get_operation_time_ns();
+    uint64_t operation_duration = timing_protection.get_operation_time_ns(start);
     EXPECT_GT(operation_duration, 0ULL);
 }
 
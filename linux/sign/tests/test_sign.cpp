@@ -138,6 +138,26 @@ TEST_F(SignTest, ErrorMessageUtility) {
     EXPECT_EQ(clwe::get_colorsign_sign_error_message(clwe::ColorSignSignError::SIGNING_FAILED), "Signing failed");
 }
 
+TEST_F(SignTest, SpeculativeCandidatesMatchSequential) {
+    std::vector<uint8_t> message = {'s', 'p', 'e', 'c', 'u', 'l', 'a', 't', 'e'};
+
+    clwe::ColorSign speculative_signer(params);
+    speculative_signer.set_speculative_candidates(4);
+    EXPECT_EQ(speculative_signer.speculative_candidates(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        message.push_back(static_cast<uint8_t>(i));
+        clwe::ColorSignature sequential = signer->sign_message(message, private_key, public_key);
+        clwe::ColorSignature speculative = speculative_signer.sign_message(message, private_key, public_key);
+        EXPECT_EQ(sequential.serialize(), speculative.serialize());
+    }
+}
+
+TEST_F(SignTest, SpeculativeCandidatesInvalidCount) {
+    EXPECT_THROW(signer->set_speculative_candidates(0), std::invalid_argument);
+    EXPECT_THROW(signer->set_speculative_candidates(65), std::invalid_argument);
+}
+
 TEST_F(SignTest, SignatureStructureValidation) {
     std::vector<uint8_t> message = {'v', 'a', 'l', 'i', 'd', 'a', 't', 'e'};
 
@@ -156,4 +176,62 @@ TEST_F(SignTest, SignatureStructureValidation) {
     EXPECT_EQ(signature.c_data.size(), expected_c_size);
 }
 
+TEST_F(SignTest, InstrumentationLevelsProduceIdenticalSignatures) {
+    clwe::ColorSign instrumented(params);
+
+    std::vector<std::vector<uint8_t>> expected;
+    for (uint8_t i = 0; i < 8; ++i) {
+        expected.push_back(signer->sign_message({'m', i}, private_key, public_key).serialize());
+    }
+
+    struct Case {
+        clwe::InstrumentationLevel level;
+        uint64_t traced;
+    };
+    for (Case c : {Case{clwe::InstrumentationLevel::OFF, 0}, Case{clwe::InstrumentationLevel::COUNTERS, 0},
+                   Case{clwe::InstrumentationLevel::SAMPLED, 2}, Case{clwe::InstrumentationLevel::FULL, 8}}) {
+        instrumented.set_instrumentation_level(c.level, 4);
+        instrumented.reset_signing_counters();
+        auto fresh = std::make_unique<clwe::DefaultSecurityMonitor>();
+        const clwe::DefaultSecurityMonitor* fresh_log = fresh.get();
+        instrumented.set_security_monitor(std::move(fresh));
+
+        for (uint8_t i = 0; i < 8; ++i) {
+            EXPECT_EQ(instrumented.sign_message({'m', i}, private_key, public_key).serialize(), expected[i]);
+        }
+
+        clwe::SigningCounters counters = instrumented.signing_counters();
+        bool counting = c.level != clwe::InstrumentationLevel::OFF && clwe::INSTRUMENTATION_ENABLED;
+        EXPECT_EQ(counters.signatures, counting ? 8u : 0u);
+        EXPECT_EQ(counters.traced_signatures, clwe::INSTRUMENTATION_ENABLED ? c.traced : 0u);
+        EXPECT_EQ(counters.rejection_restarts,
+                  counters.w1_rejections + counters.z_rejections + counters.hint_rejections);
+        EXPECT_EQ(counters.y_bound_violations, 0u);
+
+        // Traced signatures log a start and a success event each; rejections are not logged
+        EXPECT_EQ(fresh_log->get_audit_log().size(), 2 * counters.traced_signatures);
+    }
+}
+
+TEST_F(SignTest, Fips204RejectionCausesAccountForEveryRestart) {
+    signer->set_signature_format(clwe::SignatureFormat::FIPS204);
+    signer->set_instrumentation_level(clwe::InstrumentationLevel::COUNTERS);
+    for (uint8_t i = 0; i < 32; ++i) {
+        signer->sign_message({'h', i}, private_key, public_key);
+    }
+
+    // Hint-weight rejections are counted with the bound rejections, never dropped
+    clwe::SigningCounters counters = signer->signing_counters();
+    EXPECT_EQ(counters.signatures, clwe::INSTRUMENTATION_ENABLED ? 32u : 0u);
+    EXPECT_EQ(counters.rejection_restarts,
+              counters.w1_rejections + counters.z_rejections + counters.hint_rejections);
+}
+
+TEST_F(SignTest, InstrumentationCountsValidationFailures) {
+    signer->set_instrumentation_level(clwe::InstrumentationLevel::COUNTERS);
+    EXPECT_THROW(signer->sign_message({}, private_key, public_key), std::invalid_argument);
+    EXPECT_EQ(signer->signing_counters().validation_failures, clwe::INSTRUMENTATION_ENABLED ? 1u : 0u);
+    EXPECT_THROW(signer->set_instrumentation_level(clwe::InstrumentationLevel::SAMPLED, 0), std::invalid_argument);
+}
+
 } // namespace
\ No newline at end of file
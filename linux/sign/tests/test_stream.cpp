@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "stream.hpp"
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include "security_utils.hpp"
+#include "utils.hpp"
+#include <openssl/evp.h>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+// Test fixture for streaming and pre-hash signing
+class StreamTest : public ::testing::TestWithParam<uint32_t> {
+protected:
+    void SetUp() override {
+        params = clwe::CLWEParameters(GetParam());
+        clwe::ColorSignKeyGen keygen(params);
+        std::array<uint8_t, 32> seed;
+        seed.fill(0x5E);
+        auto [pub, priv] = keygen.generate_keypair_deterministic(seed);
+        public_key = pub;
+        private_key = priv;
+        signer = std::make_unique<clwe::ColorSign>(params);
+        verifier = std::make_unique<clwe::ColorSignVerify>(params);
+
+        message.resize(10000);
+        for (size_t i = 0; i < message.size(); ++i) {
+            message[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+        context = {'s', 't', 'r', 'e', 'a', 'm'};
+    }
+
+    clwe::ColorSignature sign_in_chunks(clwe::PreHashAlgorithm algorithm, size_t chunk_size) {
+        clwe::StreamingSigner stream(*signer, private_key, public_key);
+        stream.begin(algorithm, context.data(), context.size());
+        for (size_t offset = 0; offset < message.size(); offset += chunk_size) {
+            stream.update(message.data() + offset, std::min(chunk_size, message.size() - offset));
+        }
+        return stream.finish();
+    }
+
+    clwe::CLWEParameters params;
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    std::unique_ptr<clwe::ColorSign> signer;
+    std::unique_ptr<clwe::ColorSignVerify> verifier;
+    std::vector<uint8_t> message;
+    std::vector<uint8_t> context;
+};
+
+TEST_P(StreamTest, PureStreamingMatchesOneShotSigning) {
+    std::vector<uint8_t> expected = signer->sign_message(message, private_key, public_key, context).serialize();
+
+    for (size_t chunk_size : {1u, 136u, 997u, 10000u}) {
+        EXPECT_EQ(sign_in_chunks(clwe::PreHashAlgorithm::NONE, chunk_size).serialize(), expected);
+    }
+}
+
+TEST_P(StreamTest, SeedOnlyKeySignsAsExpandedKey) {
+    std::array<uint8_t, 32> seed;
+    seed.fill(0x5E);
+    clwe::ColorSignPrivateKey seed_key = clwe::ColorSignPrivateKey::from_seed(seed, public_key);
+    std::vector<uint8_t> expected = signer->sign_message(message, private_key, public_key, context).serialize();
+
+    EXPECT_EQ(signer->sign_message(message, seed_key, public_key, context).serialize(), expected);
+    EXPECT_EQ(signer->sign_message(message, seed_key, public_key, context).serialize(), expected);
+    EXPECT_EQ(signer->expanded_key_cache().misses(), 1u);
+    EXPECT_EQ(signer->expanded_key_cache().hits(), 1u);
+
+    clwe::StreamingSigner stream(*signer, seed_key, public_key);
+    stream.begin(clwe::PreHashAlgorithm::NONE, context.data(), context.size());
+    stream.update(message);
+    EXPECT_EQ(stream.finish().serialize(), expected);
+
+    // Signers can share one cache
+    auto shared = std::make_shared<clwe::ExpandedKeyCache>(4);
+    clwe::ColorSign other(params);
+    other.set_expanded_key_cache(shared);
+    EXPECT_EQ(other.sign_message(message, seed_key, public_key, context).serialize(), expected);
+    EXPECT_EQ(shared->size(), 1u);
+    EXPECT_THROW(other.set_expanded_key_cache(nullptr), std::invalid_argument);
+}
+
+TEST_P(StreamTest, StreamingVerificationMatchesOneShot) {
+    clwe::ColorSignature signature = signer->sign_message(message, private_key, public_key, context);
+    bool expected = verifier->verify_signature(public_key, signature, message, context);
+
+    clwe::StreamingVerifier stream(*verifier, public_key, signature);
+    stream.begin(clwe::PreHashAlgorithm::NONE, context.data(), context.size());
+    stream.update(message.data(), 4000);
+    stream.update(message.data() + 4000, message.size() - 4000);
+    EXPECT_EQ(stream.finish(), expected);
+}
+
+TEST_P(StreamTest, PreHashIsDomainSeparated) {
+    std::vector<uint8_t> pure = sign_in_chunks(clwe::PreHashAlgorithm::NONE, 1000).serialize();
+    std::vector<uint8_t> sha512 = sign_in_chunks(clwe::PreHashAlgorithm::SHA512, 1000).serialize();
+    std::vector<uint8_t> shake256 = sign_in_chunks(clwe::PreHashAlgorithm::SHAKE256, 1000).serialize();
+
+    EXPECT_NE(sha512, pure);
+    EXPECT_NE(shake256, pure);
+    EXPECT_NE(sha512, shake256);
+
+    // Pre-hash signatures are deterministic and independent of chunking
+    EXPECT_EQ(sign_in_chunks(clwe::PreHashAlgorithm::SHA512, 333).serialize(), sha512);
+    EXPECT_EQ(sign_in_chunks(clwe::PreHashAlgorithm::SHAKE256, 10000).serialize(), shake256);
+}
+
+TEST_P(StreamTest, PureMessageCannotImitatePreHashRepresentative) {
+    // Representative of M under SHA-512 with an empty context: 1 || 0 || OID || SHA-512(M)
+    const uint8_t oid_sha512[11] = {0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03};
+    uint8_t digest[64];
+    ASSERT_EQ(EVP_Digest(message.data(), message.size(), digest, nullptr, EVP_sha512(), nullptr), 1);
+    std::vector<uint8_t> crafted(2 + sizeof(oid_sha512) + sizeof(digest));
+    crafted[0] = 0x01;
+    crafted[1] = 0x00;
+    std::copy(oid_sha512, oid_sha512 + sizeof(oid_sha512), crafted.begin() + 2);
+    std::copy(digest, digest + sizeof(digest), crafted.begin() + 2 + sizeof(oid_sha512));
+
+    clwe::MessageHashStream stream;
+    uint8_t prehash_mu[64];
+    stream.begin(clwe::PreHashAlgorithm::SHA512, nullptr, 0);
+    stream.update(message.data(), message.size());
+    stream.finish(prehash_mu);
+
+    uint8_t pure_mu[64];
+    stream.begin(clwe::PreHashAlgorithm::NONE, nullptr, 0);
+    stream.update(crafted.data(), crafted.size());
+    stream.finish(pure_mu);
+
+    // Hashing the crafted message without the 0 || |ctx| prefix reproduces the pre-hash mu
+    uint8_t unprefixed_mu[64];
+    clwe::SHAKE256Sampler hash;
+    hash.reset();
+    hash.absorb(crafted.data(), crafted.size());
+    hash.pad_and_absorb();
+    hash.squeeze(unprefixed_mu, sizeof(unprefixed_mu));
+    ASSERT_EQ(std::vector<uint8_t>(unprefixed_mu, unprefixed_mu + 64), std::vector<uint8_t>(prehash_mu, prehash_mu + 64));
+
+    EXPECT_NE(std::vector<uint8_t>(pure_mu, pure_mu + 64), std::vector<uint8_t>(prehash_mu, prehash_mu + 64));
+
+    // One-shot signing prefixes the same way, so it agrees with the stream for an empty context
+    clwe::StreamingSigner signer_stream(*signer, private_key, public_key);
+    signer_stream.begin(clwe::PreHashAlgorithm::NONE);
+    signer_stream.update(crafted);
+    EXPECT_EQ(signer_stream.finish().serialize(), signer->sign_message(crafted, private_key, public_key).serialize());
+}
+
+TEST_P(StreamTest, StreamingIgnoresMessageSizeCap) {
+    // One byte over the one-shot cap, fed in 64 KiB chunks
+    std::vector<uint8_t> chunk(64 * 1024, 0xC3);
+    size_t total = clwe::MAX_MESSAGE_SIZE + 1;
+
+    EXPECT_THROW(signer->sign_message(std::vector<uint8_t>(total, 0xC3), private_key, public_key),
+                 std::invalid_argument);
+
+    clwe::StreamingSigner stream(*signer, private_key, public_key);
+    stream.begin(clwe::PreHashAlgorithm::SHA512);
+    for (size_t done = 0; done < total; done += chunk.size()) {
+        stream.update(chunk.data(), std::min(chunk.size(), total - done));
+    }
+    clwe::ColorSignature signature = stream.finish();
+    EXPECT_EQ(signature.serialize().size(), clwe::ml_dsa_packed_size(params.module_rank, params.degree, 18) +
+                                                params.omega + (params.degree + 3) / 4);
+}
+
+TEST_P(StreamTest, InvalidStreamUseRejected) {
+    clwe::StreamingSigner stream(*signer, private_key, public_key);
+    EXPECT_THROW(stream.update(message), std::logic_error);
+    EXPECT_THROW(stream.finish(), std::logic_error);
+
+    std::vector<uint8_t> long_context(256, 0x01);
+    EXPECT_THROW(stream.begin(clwe::PreHashAlgorithm::NONE, long_context.data(), long_context.size()),
+                 std::invalid_argument);
+
+    // Empty messages are rejected as in one-shot signing
+    stream.begin();
+    EXPECT_THROW(stream.finish(), std::invalid_argument);
+}
+
+TEST_P(StreamTest, FileSigningMatchesStreaming) {
+    char path[] = "/tmp/colorsign_stream_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, message.data(), message.size()), static_cast<ssize_t>(message.size()));
+    close(fd);
+
+    size_t seen = 0;
+    clwe::for_each_file_chunk(path, [&](const uint8_t* chunk, size_t len) {
+        EXPECT_TRUE(std::equal(chunk, chunk + len, message.begin() + seen));
+        seen += len;
+    });
+    EXPECT_EQ(seen, message.size());
+
+    for (auto algorithm : {clwe::PreHashAlgorithm::NONE, clwe::PreHashAlgorithm::SHAKE256}) {
+        clwe::ColorSignature signature = clwe::sign_file(*signer, path, private_key, public_key, algorithm, context);
+        EXPECT_EQ(signature.serialize(), sign_in_chunks(algorithm, 4096).serialize());
+
+        clwe::StreamingVerifier stream(*verifier, public_key, signature);
+        stream.begin(algorithm, context.data(), context.size());
+        stream.update(message);
+        EXPECT_EQ(clwe::verify_file(*verifier, path, public_key, signature, algorithm, context), stream.finish());
+    }
+
+    std::remove(path);
+    EXPECT_THROW(clwe::sign_file(*signer, path, private_key, public_key), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(SecurityLevels, StreamTest, ::testing::Values(44u, 65u, 87u));
+
+} // namespace
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "timing.hpp"
+#include "security_utils.hpp"
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+TEST(TimestampCounterTest, MeasuresWallTime) {
+    uint64_t start = clwe::TimestampCounter::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    uint64_t elapsed_ns = clwe::TimestampCounter::to_ns(clwe::TimestampCounter::now() - start);
+
+    EXPECT_GE(elapsed_ns, 4000000u);
+    EXPECT_LT(elapsed_ns, 1000000000u);
+    EXPECT_GT(clwe::TimestampCounter::ns_per_tick(), 0.0);
+}
+
+TEST(TimingAnomalyDetectorTest, OperationsAreInterned) {
+    clwe::TimingAnomalyDetector detector;
+    clwe::OperationId sign = detector.register_operation("sign");
+    clwe::OperationId verify = detector.register_operation("verify");
+
+    EXPECT_NE(sign, verify);
+    EXPECT_EQ(detector.register_operation("sign"), sign);
+    EXPECT_EQ(detector.find_operation("verify"), verify);
+    EXPECT_EQ(detector.find_operation("keygen"), clwe::INVALID_OPERATION_ID);
+    EXPECT_EQ(detector.operation_name(verify), "verify");
+    EXPECT_THROW(detector.stats(7), std::out_of_range);
+    EXPECT_THROW(detector.observe(7, 1000), std::out_of_range);
+    EXPECT_THROW(detector.observe(clwe::INVALID_OPERATION_ID, 1000), std::out_of_range);
+
+    for (size_t i = 2; i < clwe::TimingAnomalyDetector::MAX_OPERATIONS; ++i) {
+        detector.register_operation("op" + std::to_string(i));
+    }
+    EXPECT_THROW(detector.register_operation("one too many"), std::length_error);
+}
+
+TEST(TimingAnomalyDetectorTest, WindowStatisticsMatchDirectComputation) {
+    clwe::TimingAnomalyDetector detector(100);
+    clwe::OperationId id = detector.register_operation("op");
+
+    std::vector<uint64_t> samples;
+    for (uint64_t i = 0; i < 250; ++i) {
+        samples.push_back(1000 + (i * 7919) % 503);
+        detector.observe(id, samples.back());
+    }
+
+    // Population mean and deviation of the last 100 samples
+    double mean = 0.0;
+    for (size_t i = 150; i < 250; ++i) mean += static_cast<double>(samples[i]);
+    mean /= 100;
+    double variance = 0.0;
+    for (size_t i = 150; i < 250; ++i) variance += (samples[i] - mean) * (samples[i] - mean);
+    variance /= 100;
+
+    clwe::OperationTimingStats stats = detector.stats(id);
+    EXPECT_EQ(stats.observations, 250u);
+    EXPECT_EQ(stats.window_samples, 100u);
+    EXPECT_NEAR(stats.mean_ns, mean, 1e-6);
+    EXPECT_NEAR(stats.stddev_ns, std::sqrt(variance), 1e-6);
+    EXPECT_GT(stats.ewma_ns, 1000.0);
+}
+
+TEST(TimingAnomalyDetectorTest, ReportsConsecutiveOutliers) {
+    clwe::TimingAnomalyDetector detector;
+    clwe::OperationId id = detector.register_operation("op");
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_FALSE(detector.observe(id, 1000 + (i % 5)));
+    }
+
+    clwe::TimingObservation observation;
+    EXPECT_FALSE(detector.observe(id, 100000, &observation));
+    EXPECT_TRUE(observation.outlier);
+    EXPECT_GT(observation.threshold_ns, observation.mean_ns);
+    EXPECT_FALSE(detector.observe(id, 100000));
+    EXPECT_TRUE(detector.observe(id, 1000000));
+    EXPECT_EQ(detector.stats(id).anomalies, 1u);
+
+    // A normal duration ends the run
+    EXPECT_FALSE(detector.observe(id, 1000, &observation));
+    EXPECT_FALSE(observation.outlier);
+}
+
+TEST(TimingAnomalyDetectorTest, PerThreadStateIsMergedOnRead) {
+    clwe::TimingAnomalyDetector detector;
+    clwe::OperationId id = detector.register_operation("op");
+
+    // No thread exits before all have observed, so none takes over another's state
+    std::atomic<int> done{0};
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&detector, &done, id, t] {
+            for (int i = 0; i < 50; ++i) {
+                detector.observe(id, 1000 * (t + 1));
+            }
+            done.fetch_add(1);
+            while (done.load() < 4) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    clwe::OperationTimingStats stats = detector.stats(id);
+    EXPECT_EQ(stats.observations, 200u);
+    EXPECT_EQ(stats.window_samples, 200u);
+    EXPECT_NEAR(stats.mean_ns, 2500.0, 1e-6);
+    EXPECT_NEAR(stats.stddev_ns, std::sqrt(1250000.0), 1e-6);
+    EXPECT_NEAR(stats.ewma_ns, 2500.0, 1e-6);
+}
+
+TEST(TimingAnomalyDetectorTest, ExitedThreadStateIsReused) {
+    clwe::TimingAnomalyDetector detector;
+    clwe::OperationId id = detector.register_operation("op");
+
+    for (int t = 0; t < 16; ++t) {
+        std::thread([&detector, id] {
+            for (int i = 0; i < 10; ++i) {
+                detector.observe(id, 1000);
+            }
+        }).join();
+    }
+
+    // Sixteen threads in turn share one state; nothing they observed is lost
+    EXPECT_EQ(detector.thread_states(), 1u);
+    EXPECT_EQ(detector.stats(id).observations, 160u);
+
+    std::thread first([&detector, id] { detector.observe(id, 1000); });
+    first.join();
+    detector.observe(id, 1000);
+    EXPECT_EQ(detector.thread_states(), 1u);
+    EXPECT_EQ(detector.stats(id).observations, 162u);
+}
+
+TEST(TimingAnomalyDetectorTest, MonitorAndTimingProtectionReportAnomalies) {
+    clwe::DefaultSecurityMonitor monitor;
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_FALSE(monitor.detect_timing_anomaly("op", 1000 + (i % 3)));
+    }
+    monitor.detect_timing_anomaly("op", 500000);
+    monitor.detect_timing_anomaly("op", 500000);
+    EXPECT_TRUE(monitor.detect_timing_anomaly("op", 5000000));
+    ASSERT_EQ(monitor.get_audit_log().size(), 1u);
+    EXPECT_EQ(monitor.get_audit_log()[0].event_type, clwe::AuditEvent::SECURITY_VIOLATION);
+    EXPECT_EQ(monitor.operation_stats(monitor.register_operation("op")).anomalies, 1u);
+
+    clwe::TimingProtection protection;
+    clwe::OperationId id = protection.register_operation("timed");
+    for (int i = 0; i < 5; ++i) {
+        protection.end_operation(id, protection.start_operation());
+    }
+    EXPECT_EQ(protection.operation_stats(id).observations, 5u);
+}
+
+} // namespace
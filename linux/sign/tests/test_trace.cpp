@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "trace.hpp"
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+size_t count_occurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!clwe::INSTRUMENTATION_ENABLED) {
+            GTEST_SKIP() << "Built without instrumentation";
+        }
+        clwe::Tracer::clear();
+    }
+    void TearDown() override {
+        clwe::Tracer::enable(false);
+        clwe::Tracer::clear();
+    }
+};
+
+TEST_F(TracerTest, DisabledSpansRecordNothing) {
+    clwe::Tracer::enable(false);
+    {
+        clwe::TraceSpan span("ignored");
+    }
+    EXPECT_EQ(clwe::Tracer::event_count(), 0u);
+    EXPECT_EQ(clwe::Tracer::chrome_trace_json(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+}
+
+TEST_F(TracerTest, NestedSpansFromSeveralThreads) {
+    clwe::Tracer::enable(true);
+    {
+        clwe::TraceSpan outer("outer");
+        clwe::TraceSpan inner("inner", 7);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([]() { clwe::TraceSpan span("worker"); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(clwe::Tracer::event_count(), 5u);
+    std::string json = clwe::Tracer::chrome_trace_json();
+    EXPECT_EQ(count_occurrences(json, "\"ph\":\"X\""), 5u);
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"worker\""), 3u);
+    EXPECT_NE(json.find("\"name\":\"inner\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"attempt\":7}"), std::string::npos);
+
+    // Workers report their own thread ids
+    std::set<std::string> tids;
+    for (size_t pos = json.find("\"tid\":"); pos != std::string::npos; pos = json.find("\"tid\":", pos + 1)) {
+        tids.insert(json.substr(pos, json.find_first_of(",}", pos) - pos));
+    }
+    EXPECT_EQ(tids.size(), 4u);
+}
+
+TEST_F(TracerTest, TracesSchemeOperations) {
+    clwe::CLWEParameters params(44);
+    clwe::ColorSignKeyGen keygen(params);
+    clwe::ColorSign signer(params);
+    clwe::ColorSignVerify verifier(params);
+    std::vector<uint8_t> message = {'t', 'r', 'a', 'c', 'e'};
+
+    clwe::Tracer::enable(true);
+    auto [public_key, private_key] = keygen.generate_keypair();
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+    verifier.verify_signature(public_key, signature, message);
+    clwe::Tracer::enable(false);
+
+    std::string json = clwe::Tracer::chrome_trace_json();
+    for (const char* name : {"generate_keypair", "sign_message", "rejection_sampling", "verify_signature",
+                             "matrix_expansion", "hashing", "sampling", "ntt", "packing"}) {
+        EXPECT_NE(json.find(std::string("\"name\":\"") + name + "\""), std::string::npos) << name;
+    }
+    size_t attempts = count_occurrences(json, "\"name\":\"rejection_attempt\"");
+    EXPECT_GE(attempts, 1u);
+    EXPECT_NE(json.find("\"args\":{\"attempt\":" + std::to_string(attempts - 1) + "}"), std::string::npos);
+}
+
+TEST_F(TracerTest, WritesTraceFile) {
+    clwe::Tracer::enable(true);
+    {
+        clwe::TraceSpan span("written");
+    }
+    std::string path = testing::TempDir() + "colorsign_trace.json";
+    clwe::Tracer::write_chrome_trace(path);
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), clwe::Tracer::chrome_trace_json());
+    std::remove(path.c_str());
+
+    EXPECT_THROW(clwe::Tracer::write_chrome_trace("/nonexistent-dir/trace.json"), std::runtime_error);
+}
+
+} // namespace
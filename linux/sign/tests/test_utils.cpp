@@ -3,6 +3,8 @@
 #include <vector>
 #include <cstring>
 #include <algorithm>
+#include <random>
+#include <stdexcept>
 
 namespace {
 
@@ -148,4 +150,190 @@ TEST_F(UtilsTest, Shake256DeterministicOutputWithData) {
     EXPECT_FALSE(all_zeros);
 }
 
+// Bit-at-a-time ML-DSA packing, the reference for the word-level kernels
+std::vector<uint8_t> reference_pack_ml_dsa(const std::vector<uint32_t>& coeffs, uint32_t q, uint32_t d) {
+    std::vector<uint8_t> out;
+    uint8_t current = 0;
+    uint32_t filled = 0;
+    for (uint32_t coeff : coeffs) {
+        uint32_t compressed = (static_cast<uint64_t>(coeff) * (1ULL << d) + (q / 2)) / q;
+        for (uint32_t bit = 0; bit < d; ++bit) {
+            current |= ((compressed >> bit) & 1) << filled;
+            if (++filled == 8) {
+                out.push_back(current);
+                current = 0;
+                filled = 0;
+            }
+        }
+    }
+    if (filled > 0) {
+        out.push_back(current);
+    }
+    return out;
+}
+
+std::vector<uint32_t> reference_unpack_ml_dsa(const uint8_t* data, size_t count, uint32_t q, uint32_t d) {
+    std::vector<uint32_t> coeffs;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t compressed = 0;
+        for (uint32_t bit = 0; bit < d; ++bit) {
+            size_t position = i * d + bit;
+            compressed |= static_cast<uint32_t>((data[position / 8] >> (position % 8)) & 1) << bit;
+        }
+        coeffs.push_back((static_cast<uint64_t>(compressed) * q + (1ULL << (d - 1))) / (1ULL << d) % q);
+    }
+    return coeffs;
+}
+
+TEST_F(UtilsTest, MlDsaPackingMatchesBitwiseReference) {
+    const uint32_t q = 8380417;
+    std::mt19937 rng(2024);
+    // n = 37 leaves a partial group of 8 per polynomial; n = 256 exercises the vector kernels
+    for (uint32_t n : {37u, 256u}) {
+        for (uint32_t d = 1; d <= 32; ++d) {
+            const uint32_t k = 3;
+            clwe::PolyVec polys(k, n);
+            std::uniform_int_distribution<uint32_t> coefficient(0, q - 1);
+            for (size_t i = 0; i < polys.coeff_count(); ++i) {
+                polys.data()[i] = coefficient(rng);
+            }
+            // Edges: zero, q - 1 (rounds up to 2^d), the midpoint and values outside [0, q)
+            polys.data()[0] = 0;
+            polys.data()[1] = q - 1;
+            polys.data()[2] = q / 2;
+            polys.data()[3] = 0xFFFFFFFFu;
+            std::vector<uint32_t> flat(polys.data(), polys.data() + polys.coeff_count());
+
+            std::vector<uint8_t> packed = clwe::pack_polynomial_vector_ml_dsa(polys, q, d);
+            size_t header = packed.size() - (static_cast<size_t>(k) * n * d + 7) / 8;
+            std::vector<uint8_t> body(packed.begin() + header, packed.end());
+            ASSERT_EQ(body, reference_pack_ml_dsa(flat, q, d)) << "d = " << d << ", n = " << n;
+
+            // Decode random bytes too, so that every compressed value can occur
+            for (size_t i = header; i < packed.size(); ++i) {
+                if (i % 3 == 0) packed[i] = static_cast<uint8_t>(rng());
+            }
+            clwe::PolyVec unpacked(k, n);
+            clwe::unpack_polynomial_vector_ml_dsa(packed.data(), packed.size(), q, d, unpacked);
+            std::vector<uint32_t> expected = reference_unpack_ml_dsa(packed.data() + header, flat.size(), q, d);
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), unpacked.data())) << "d = " << d << ", n = " << n;
+        }
+    }
+}
+
+TEST_F(UtilsTest, MlDsaUnpackRejectsTruncatedDataAndBadWidths) {
+    const uint32_t q = 8380417;
+    clwe::PolyVec polys(4, 256);
+    for (uint32_t d : {10u, 18u, 20u}) {
+        std::vector<uint8_t> packed = clwe::pack_polynomial_vector_ml_dsa(polys, q, d);
+        clwe::PolyVec unpacked(4, 256);
+        EXPECT_THROW(clwe::unpack_polynomial_vector_ml_dsa(packed.data(), packed.size() - 1, q, d, unpacked),
+                     std::invalid_argument);
+        EXPECT_NO_THROW(clwe::unpack_polynomial_vector_ml_dsa(packed.data(), packed.size(), q, d, unpacked));
+    }
+    EXPECT_THROW(clwe::pack_polynomial_vector_ml_dsa(polys, q, 0), std::invalid_argument);
+    EXPECT_THROW(clwe::pack_polynomial_vector_ml_dsa(polys, q, 33), std::invalid_argument);
+}
+
+TEST_F(UtilsTest, Gamma1PackingIsExact) {
+    const uint32_t q = 8380417;
+    std::mt19937 rng(2025);
+    // 2^17 and 2^19 use the fixed-width kernels (18 and 20 bits), 2^5 the runtime width
+    for (uint32_t gamma1 : {1u << 17, 1u << 19, 1u << 5}) {
+        for (uint32_t n : {37u, 256u}) {
+            clwe::PolyVec polys(3, n);
+            std::uniform_int_distribution<int32_t> coefficient(-static_cast<int32_t>(gamma1) + 1,
+                                                               static_cast<int32_t>(gamma1));
+            for (size_t i = 0; i < polys.coeff_count(); ++i) {
+                int32_t v = coefficient(rng);
+                polys.data()[i] = v < 0 ? static_cast<uint32_t>(v + static_cast<int32_t>(q)) : static_cast<uint32_t>(v);
+            }
+            polys.data()[0] = 0;
+            polys.data()[1] = gamma1;
+            polys.data()[2] = q - gamma1 + 1;
+
+            std::vector<uint8_t> packed(clwe::gamma1_packed_size(3, n, gamma1));
+            EXPECT_EQ(clwe::pack_polynomial_vector_gamma1(polys, q, gamma1, packed.data()), packed.size());
+            clwe::PolyVec unpacked(3, n);
+            clwe::unpack_polynomial_vector_gamma1(packed.data(), packed.size(), q, gamma1, unpacked);
+            ASSERT_TRUE(std::equal(polys.data(), polys.data() + polys.coeff_count(), unpacked.data()))
+                << "gamma1 = " << gamma1 << ", n = " << n;
+
+            EXPECT_THROW(clwe::unpack_polynomial_vector_gamma1(packed.data(), packed.size() - 1, q, gamma1, unpacked),
+                         std::invalid_argument);
+        }
+    }
+    EXPECT_EQ(clwe::gamma1_packed_size(4, 256, 1u << 17), 4u * 256 * 18 / 8);
+    EXPECT_EQ(clwe::gamma1_packed_size(4, 256, 1u << 19), 4u * 256 * 20 / 8);
+    EXPECT_THROW(clwe::gamma1_packed_size(4, 256, 3000), std::invalid_argument);
+}
+
+TEST_F(UtilsTest, Power2RoundSplitsAndPacksT1) {
+    const uint32_t q = 8380417;
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<uint32_t> coefficient(0, q - 1);
+    clwe::PolyVec t(3, 256);
+    for (size_t i = 0; i < t.coeff_count(); ++i) {
+        t.data()[i] = coefficient(rng);
+    }
+    t.data()[0] = 0;
+    t.data()[1] = q - 1;
+    t.data()[2] = 4096;     // Largest t0 rounding down
+    t.data()[3] = 4097;     // Smallest t0 rounding up
+
+    clwe::PolyVec t1(3, 256);
+    clwe::PolyVec t0(3, 256);
+    clwe::power2round(t, q, t1, t0);
+    for (size_t i = 0; i < t.coeff_count(); ++i) {
+        int64_t low = t0.data()[i] > q / 2 ? static_cast<int64_t>(t0.data()[i]) - q : t0.data()[i];
+        ASSERT_GT(low, -4096);
+        ASSERT_LE(low, 4096);
+        ASSERT_LT(t1.data()[i], 1024u);
+        ASSERT_EQ((static_cast<uint64_t>(t1.data()[i]) * 8192 + t0.data()[i]) % q, t.data()[i]);
+    }
+    EXPECT_EQ(t1.data()[2], 0u);
+    EXPECT_EQ(t1.data()[3], 1u);
+
+    std::vector<uint8_t> packed(clwe::t1_packed_size(3, 256));
+    EXPECT_EQ(packed.size(), 3u * 256 * 10 / 8);
+    EXPECT_EQ(clwe::pack_polynomial_vector_t1(t1, packed.data()), packed.size());
+    clwe::PolyVec shifted(3, 256);
+    clwe::unpack_polynomial_vector_t1(packed.data(), packed.size(), shifted);
+    for (size_t i = 0; i < t.coeff_count(); ++i) {
+        ASSERT_EQ(shifted.data()[i], t1.data()[i] << 13);
+    }
+    EXPECT_THROW(clwe::unpack_polynomial_vector_t1(packed.data(), packed.size() - 1, shifted), std::invalid_argument);
+}
+
+TEST_F(UtilsTest, EtaPackingIsExact) {
+    const uint32_t q = 8380417;
+    std::mt19937 rng(7);
+    // 2 and 4 use the 3- and 4-bit kernels, 3 the runtime width
+    for (uint32_t eta : {2u, 4u, 3u}) {
+        for (uint32_t n : {37u, 256u}) {
+            clwe::PolyVec polys(5, n);
+            std::uniform_int_distribution<int32_t> coefficient(-static_cast<int32_t>(eta), static_cast<int32_t>(eta));
+            for (size_t i = 0; i < polys.coeff_count(); ++i) {
+                int32_t v = coefficient(rng);
+                polys.data()[i] = v < 0 ? static_cast<uint32_t>(v + static_cast<int32_t>(q)) : static_cast<uint32_t>(v);
+            }
+            polys.data()[0] = eta;
+            polys.data()[1] = q - eta;
+
+            std::vector<uint8_t> packed(clwe::eta_packed_size(5, n, eta));
+            EXPECT_EQ(clwe::pack_polynomial_vector_eta(polys, q, eta, packed.data()), packed.size());
+            clwe::PolyVec unpacked(5, n);
+            clwe::unpack_polynomial_vector_eta(packed.data(), packed.size(), q, eta, unpacked);
+            ASSERT_TRUE(std::equal(polys.data(), polys.data() + polys.coeff_count(), unpacked.data()))
+                << "eta = " << eta << ", n = " << n;
+
+            EXPECT_THROW(clwe::unpack_polynomial_vector_eta(packed.data(), packed.size() + 1, q, eta, unpacked),
+                         std::invalid_argument);
+        }
+    }
+    EXPECT_EQ(clwe::eta_packed_size(4, 256, 2), 4u * 256 * 3 / 8);
+    EXPECT_EQ(clwe::eta_packed_size(4, 256, 4), 4u * 256 * 4 / 8);
+    EXPECT_THROW(clwe::eta_packed_size(4, 256, 0), std::invalid_argument);
+}
+
 } // namespace
\ No newline at end of file
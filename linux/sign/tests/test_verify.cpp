@@ -2,7 +2,9 @@
 #include "verify.hpp"
 #include "sign.hpp"
 #include "keygen.hpp"
+#include "utils.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace {
 
@@ -154,6 +156,70 @@ TEST_F(VerifyTest, VerifySignatureTamperedCHash) {
     EXPECT_FALSE(verifier->verify_signature(public_key, signature, message));
 }
 
+TEST_F(VerifyTest, VerifyFips204SignatureMalformedHints) {
+    std::vector<uint8_t> message = {'h', 'i', 'n', 't', 's'};
+    signer->set_signature_format(clwe::SignatureFormat::FIPS204);
+    clwe::ColorSignature signature = signer->sign_message(message, private_key, public_key);
+    ASSERT_EQ(signature.h_data.size(), params.omega + params.module_rank);
+
+    // The signer's hint list decodes; each malformed variant is rejected by the decoder itself
+    uint32_t omega = params.omega;
+    uint32_t k = params.module_rank;
+    clwe::PolyVec w_prime(k, params.degree);
+    clwe::PolyVec w(k, params.degree);
+    auto decodes = [&](const std::vector<uint8_t>& h) {
+        return clwe::apply_hint_indices(h.data(), h.size(), omega, params.modulus, w_prime, w);
+    };
+    ASSERT_TRUE(decodes(signature.h_data));
+
+    // Two hints in polynomial 0 (indices 3 and 7), none elsewhere
+    std::vector<uint8_t> hints(omega + k, 0);
+    hints[0] = 3;
+    hints[1] = 7;
+    for (uint32_t i = 0; i < k; ++i) {
+        hints[omega + i] = 2;
+    }
+    w_prime[0][3] = 5;
+    ASSERT_TRUE(decodes(hints));
+    EXPECT_EQ(w[0][3], 5 + params.modulus - (1u << 13));
+    EXPECT_EQ(w[0][7], params.modulus - (1u << 13));
+    EXPECT_EQ(w[1][3], 0u);
+
+    std::vector<uint8_t> decreasing_indices = hints;
+    std::swap(decreasing_indices[0], decreasing_indices[1]);
+    EXPECT_FALSE(decodes(decreasing_indices));
+
+    std::vector<uint8_t> repeated_index = hints;
+    repeated_index[1] = 3;
+    EXPECT_FALSE(decodes(repeated_index));
+
+    std::vector<uint8_t> nonzero_padding = hints;
+    nonzero_padding[omega - 1] = 1;
+    EXPECT_FALSE(decodes(nonzero_padding));
+
+    std::vector<uint8_t> decreasing_count = hints;
+    decreasing_count[omega + 1] = 1;
+    EXPECT_FALSE(decodes(decreasing_count));
+
+    std::vector<uint8_t> count_too_large = hints;
+    count_too_large[omega + k - 1] = static_cast<uint8_t>(omega + 1);
+    EXPECT_FALSE(decodes(count_too_large));
+
+    std::vector<uint8_t> truncated = hints;
+    truncated.pop_back();
+    EXPECT_FALSE(decodes(truncated));
+
+    // In a signature, a malformed list makes verification fail rather than throw
+    clwe::ColorSignature malformed = signature;
+    malformed.h_data[omega - 1] = 0xFF;
+    EXPECT_FALSE(verifier->verify_signature(public_key, malformed, message));
+
+    // A FIPS 204 signature of the wrong component sizes is invalid input
+    clwe::ColorSignature short_challenge = signature;
+    short_challenge.c_data.pop_back();
+    EXPECT_THROW(verifier->verify_signature(public_key, short_challenge, message), std::invalid_argument);
+}
+
 TEST_F(VerifyTest, ErrorMessageUtility) {
     EXPECT_EQ(clwe::get_colorsign_verify_error_message(clwe::ColorSignVerifyError::SUCCESS), "Success");
     EXPECT_EQ(clwe::get_colorsign_verify_error_message(clwe::ColorSignVerifyError::INVALID_PARAMETERS), "Invalid parameters");
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include "cose.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Test fixture for span entry points and in-place key/signature views
+class ViewTest : public ::testing::TestWithParam<uint32_t> {
+protected:
+    void SetUp() override {
+        params = clwe::CLWEParameters(GetParam());
+        clwe::ColorSignKeyGen keygen(params);
+        std::array<uint8_t, 32> seed;
+        seed.fill(0x42);
+        auto [pub, priv] = keygen.generate_keypair_deterministic(seed);
+        public_key = pub;
+        private_key = priv;
+        message = {'v', 'i', 'e', 'w', ' ', 'm', 'e', 's', 's', 'a', 'g', 'e'};
+        context = {'c', 't', 'x'};
+    }
+
+    clwe::CLWEParameters params;
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    std::vector<uint8_t> message;
+    std::vector<uint8_t> context;
+};
+
+TEST_P(ViewTest, SignatureViewPointsIntoBuffer) {
+    clwe::ColorSign signer(params);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+    std::vector<uint8_t> buffer = signature.serialize();
+
+    clwe::SignatureView view = clwe::SignatureView::parse(buffer.data(), buffer.size(), params);
+    EXPECT_EQ(view.z_data.data(), buffer.data());
+    EXPECT_EQ(view.h_data.data(), buffer.data() + signature.z_data.size());
+    EXPECT_EQ(view.c_data.data(), buffer.data() + signature.z_data.size() + signature.h_data.size());
+    EXPECT_EQ(view.c_data.end(), buffer.data() + buffer.size());
+
+    EXPECT_EQ(view.to_signature().serialize(), buffer);
+    EXPECT_EQ(clwe::ColorSignature::deserialize(buffer.data(), buffer.size(), params).serialize(), buffer);
+
+    EXPECT_THROW(clwe::SignatureView::parse(buffer.data(), buffer.size() - 1, params), std::invalid_argument);
+    EXPECT_THROW(clwe::ColorSignature::deserialize(buffer.data(), buffer.size(), clwe::CLWEParameters(
+                     GetParam() == 44 ? 65 : 44)), std::invalid_argument);
+}
+
+TEST_P(ViewTest, PublicKeyViewPointsIntoBuffer) {
+    std::vector<uint8_t> buffer = public_key.serialize();
+
+    clwe::PublicKeyView view = clwe::PublicKeyView::parse(buffer.data(), buffer.size(), params);
+    EXPECT_EQ(view.format_version, public_key.format_version);
+    EXPECT_EQ(view.use_compression, public_key.use_compression);
+    EXPECT_EQ(view.seed_rho, buffer.data() + 2);
+    EXPECT_EQ(view.seed_K, buffer.data() + 34);
+    EXPECT_EQ(view.hash_tr, buffer.data() + 66);
+    EXPECT_EQ(view.public_data.data(), buffer.data() + 130);
+    EXPECT_EQ(view.public_data.size(), public_key.public_data.size());
+
+    EXPECT_EQ(view.to_public_key().serialize(), buffer);
+    EXPECT_EQ(clwe::ColorSignPublicKey::deserialize(buffer.data(), buffer.size(), params).serialize(), buffer);
+
+    EXPECT_THROW(clwe::PublicKeyView::parse(buffer.data(), 129, params), std::invalid_argument);
+}
+
+TEST_P(ViewTest, SpanSigningMatchesVectorSigning) {
+    clwe::ColorSign signer(params);
+    clwe::ColorSignature expected = signer.sign_message(message, private_key, public_key, context);
+
+    clwe::ColorSignature signature = signer.sign_message(message.data(), message.size(), private_key, public_key,
+                                                         context.data(), context.size());
+    EXPECT_EQ(signature.serialize(), expected.serialize());
+
+    clwe::SignWorkspace workspace(params);
+    signer.sign_message(message.data(), message.size(), private_key, public_key, workspace, signature,
+                        context.data(), context.size());
+    EXPECT_EQ(signature.serialize(), expected.serialize());
+
+    EXPECT_THROW(signer.sign_message(message.data(), 0, private_key, public_key), std::invalid_argument);
+}
+
+TEST_P(ViewTest, VerifyFromReceiveBufferMatchesVectorVerify) {
+    clwe::ColorSign signer(params);
+    clwe::ColorSignVerify verifier(params);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key, context);
+
+    // One contiguous "receive buffer": public key || signature || message
+    std::vector<uint8_t> key_bytes = public_key.serialize();
+    std::vector<uint8_t> sig_bytes = signature.serialize();
+    std::vector<uint8_t> buffer = key_bytes;
+    buffer.insert(buffer.end(), sig_bytes.begin(), sig_bytes.end());
+    buffer.insert(buffer.end(), message.begin(), message.end());
+
+    auto key_view = clwe::PublicKeyView::parse(buffer.data(), key_bytes.size(), params);
+    auto sig_view = clwe::SignatureView::parse(buffer.data() + key_bytes.size(), sig_bytes.size(), params);
+    const uint8_t* msg = buffer.data() + key_bytes.size() + sig_bytes.size();
+
+    bool expected = verifier.verify_signature(public_key, signature, message, context);
+    EXPECT_EQ(verifier.verify_signature(key_view, sig_view, msg, message.size(), context.data(), context.size()),
+              expected);
+
+    clwe::VerifyWorkspace workspace(params);
+    EXPECT_EQ(verifier.verify_signature(key_view, sig_view, msg, message.size(), workspace,
+                                        context.data(), context.size()), expected);
+
+    EXPECT_THROW(verifier.verify_signature(key_view, sig_view, msg, 0), std::invalid_argument);
+}
+
+TEST_P(ViewTest, CoseSpanOverloadsMatchVectorForms) {
+    clwe::ColorSign signer(params);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+
+    clwe::COSE_Sign1 from_vector = clwe::create_cose_sign1_from_colorsign(message, signature);
+    clwe::COSE_Sign1 from_span = clwe::create_cose_sign1_from_colorsign(message.data(), message.size(), signature);
+    EXPECT_EQ(from_span.payload, from_vector.payload);
+    EXPECT_EQ(from_span.signature, from_vector.signature);
+    EXPECT_EQ(from_span.protected_header, from_vector.protected_header);
+
+    std::vector<uint8_t> encoded = clwe::encode_cose_sign1(from_vector);
+    clwe::COSE_Sign1 decoded = clwe::decode_cose_sign1(encoded.data(), encoded.size());
+    EXPECT_EQ(decoded.payload, message);
+    EXPECT_EQ(decoded.signature, from_vector.signature);
+    EXPECT_EQ(decoded.protected_header, from_vector.protected_header);
+    EXPECT_THROW(clwe::decode_cose_sign1(encoded.data(), encoded.size() - 1), std::invalid_argument);
+}
+
+TEST_P(ViewTest, CoseViewPointsIntoBuffer) {
+    clwe::ColorSign signer(params);
+    clwe::ColorSignVerify verifier(params);
+
+    // Payloads with 1, 2 and 4-byte CBOR lengths
+    for (size_t size : {200u, 4000u, 70000u}) {
+        std::vector<uint8_t> payload(size, static_cast<uint8_t>(size));
+        clwe::COSE_Sign1 cose = signer.sign_message_cose(payload, private_key, public_key);
+        std::vector<uint8_t> encoded = clwe::encode_cose_sign1(cose);
+        clwe::COSE_Sign1View source(cose);
+        ASSERT_EQ(encoded.size(), source.encoded_size());
+
+        std::vector<uint8_t> frame(encoded.size());
+        EXPECT_EQ(source.encode_into(frame.data(), frame.size()), encoded.size());
+        EXPECT_EQ(frame, encoded);
+        EXPECT_THROW(source.encode_into(frame.data(), frame.size() - 1), std::invalid_argument);
+
+        clwe::COSE_Sign1View view = clwe::COSE_Sign1View::parse(encoded.data(), encoded.size());
+        EXPECT_EQ(view.signature.data() + view.signature.size(), encoded.data() + encoded.size());
+        EXPECT_EQ(view.payload.data() + view.payload.size(), view.signature.data() - clwe::cbor::head_size(view.signature.size()));
+        EXPECT_EQ(std::vector<uint8_t>(view.payload.begin(), view.payload.end()), payload);
+        EXPECT_EQ(view.to_cose_sign1().signature, cose.signature);
+        EXPECT_EQ(verifier.verify_signature_cose(public_key, view), verifier.verify_signature_cose(public_key, cose));
+
+        encoded.push_back(0x00);
+        EXPECT_THROW(clwe::COSE_Sign1View::parse(encoded.data(), encoded.size()), std::invalid_argument);
+    }
+}
+
+TEST(CborTest, HeadsUseShortestArgument) {
+    const std::pair<uint64_t, std::vector<uint8_t>> cases[] = {
+        {23, {0x17}},
+        {24, {0x18, 0x18}},
+        {0x1234, {0x19, 0x12, 0x34}},
+        {0x12345678, {0x1A, 0x12, 0x34, 0x56, 0x78}},
+        {0x123456789AULL, {0x1B, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78, 0x9A}},
+    };
+    for (const auto& [value, expected] : cases) {
+        EXPECT_EQ(clwe::cbor::encode_uint(value), expected);
+        size_t offset = 0;
+        EXPECT_EQ(clwe::cbor::decode_uint(expected, offset), value);
+        EXPECT_EQ(offset, expected.size());
+
+        std::vector<uint8_t> truncated(expected.begin(), expected.end() - 1);
+        offset = 0;
+        if (!truncated.empty()) {
+            EXPECT_THROW(clwe::cbor::decode_uint(truncated, offset), std::invalid_argument);
+        }
+    }
+
+    // Indefinite lengths, other major types and lengths past the end are rejected
+    size_t offset = 0;
+    EXPECT_THROW(clwe::cbor::decode_bstr(std::vector<uint8_t>{0x5F, 0xFF}, offset), std::invalid_argument);
+    offset = 0;
+    EXPECT_THROW(clwe::cbor::decode_bstr(std::vector<uint8_t>{0x01}, offset), std::invalid_argument);
+    offset = 0;
+    EXPECT_THROW(clwe::cbor::decode_bstr(std::vector<uint8_t>{0x5B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00},
+                                         offset), std::invalid_argument);
+
+    std::vector<uint8_t> large(300, 0xAB);
+    std::vector<uint8_t> encoded = clwe::cbor::encode_bstr(large);
+    offset = 0;
+    clwe::ByteSpan contents = clwe::cbor::decode_bstr_view(encoded.data(), encoded.size(), offset);
+    EXPECT_EQ(contents.data(), encoded.data() + 3);
+    EXPECT_EQ(contents.size(), large.size());
+    EXPECT_EQ(offset, encoded.size());
+}
+
+TEST_P(ViewTest, SerializeIntoMatchesSerialize) {
+    static_assert(clwe::ColorSignature::serialized_size<44>(clwe::SignatureFormat::FIPS204) == 2 + 2420,
+                  "ML-DSA-44 FIPS 204 signature with header");
+    static_assert(clwe::ColorSignPublicKey::serialized_size<65>(clwe::KEY_FORMAT_POWER2ROUND) ==
+                  clwe::KEY_HEADER_BYTES + 1920, "ML-DSA-65 t1 public key");
+    static_assert(clwe::ColorSignPrivateKey::serialized_size<87>(clwe::KEY_FORMAT_SEED) ==
+                  clwe::SEED_KEY_SERIALIZED_BYTES, "Seed-only private key");
+
+    clwe::ColorSign signer(params);
+    signer.set_signature_format(clwe::SignatureFormat::FIPS204);
+    clwe::ColorSignature signature = signer.sign_message(message, private_key, public_key);
+    clwe::ColorSignKeyGen keygen(params);
+    keygen.set_key_format_version(clwe::KEY_FORMAT_PACKED_SECRET);
+    std::array<uint8_t, 32> seed;
+    seed.fill(0x42);
+    auto [packed_public, packed_private] = keygen.generate_keypair_deterministic(seed);
+    clwe::ColorSignPrivateKey seed_key = clwe::ColorSignPrivateKey::from_seed(seed, packed_public);
+
+    EXPECT_EQ(signature.serialized_size(), clwe::ColorSignature::serialized_size(params, signature.format));
+    EXPECT_EQ(packed_public.serialized_size(),
+              clwe::ColorSignPublicKey::serialized_size(params, clwe::KEY_FORMAT_PACKED_SECRET));
+    EXPECT_EQ(packed_private.serialized_size(),
+              clwe::ColorSignPrivateKey::serialized_size(params, clwe::KEY_FORMAT_PACKED_SECRET));
+    EXPECT_EQ(private_key.serialized_size(),
+              clwe::ColorSignPrivateKey::serialized_size(params, clwe::KEY_FORMAT_ORIGINAL));
+    EXPECT_THROW(clwe::ColorSignPublicKey::serialized_size(params, clwe::KEY_FORMAT_ORIGINAL), std::invalid_argument);
+
+    auto check = [](const auto& object) {
+        std::vector<uint8_t> expected = object.serialize();
+        std::vector<uint8_t> buffer(expected.size() + 1, 0xEE);
+        EXPECT_EQ(object.serialize_into(buffer.data(), buffer.size()), expected.size());
+        EXPECT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.end() - 1), expected);
+        EXPECT_EQ(buffer.back(), 0xEE);
+        EXPECT_THROW(object.serialize_into(buffer.data(), expected.size() - 1), std::invalid_argument);
+    };
+    check(signature);
+    check(public_key);
+    check(private_key);
+    check(packed_public);
+    check(packed_private);
+    check(seed_key);
+}
+
+INSTANTIATE_TEST_SUITE_P(SecurityLevels, ViewTest, ::testing::Values(44u, 65u, 87u));
+
+} // namespace
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "worker_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(WorkerPoolTest, RunsEveryIndexOncePerBatch) {
+    clwe::WorkerPool pool(3);
+    EXPECT_EQ(pool.workers(), 3u);
+
+    std::vector<std::atomic<int>> calls(4);
+    std::vector<std::thread::id> threads(4);
+    auto task = [&](size_t i) {
+        calls[i].fetch_add(1);
+        threads[i] = std::this_thread::get_id();
+    };
+
+    // Full and partial batches reuse the same threads
+    for (size_t count : {4u, 2u, 1u, 4u, 3u}) {
+        for (auto& c : calls) c = 0;
+        pool.run(count, task);
+        for (size_t i = 0; i < calls.size(); ++i) {
+            EXPECT_EQ(calls[i].load(), i < count ? 1 : 0) << "count " << count << " index " << i;
+        }
+        EXPECT_EQ(threads[0], std::this_thread::get_id());
+        for (size_t i = 1; i < count; ++i) {
+            EXPECT_NE(threads[i], std::this_thread::get_id());
+        }
+    }
+
+    EXPECT_THROW(pool.run(5, task), std::invalid_argument);
+}
+
+TEST(WorkerPoolTest, CallerTaskFailureWaitsForWorkers) {
+    clwe::WorkerPool pool(2);
+    std::atomic<int> finished{0};
+    auto task = [&](size_t i) {
+        if (i == 0) {
+            throw std::runtime_error("attempt 0");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        finished.fetch_add(1);
+    };
+
+    EXPECT_THROW(pool.run(3, task), std::runtime_error);
+    EXPECT_EQ(finished.load(), 2);
+}
+
+} // namespace
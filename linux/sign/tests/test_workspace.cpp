@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "sign.hpp"
+#include "verify.hpp"
+#include "keygen.hpp"
+#include "allocation_profiler.hpp"
+
+// Linked with the allocation hooks, which count this thread's heap allocations
+
+namespace {
+
+// Monitor that records nothing, so only the signing path itself is measured
+class NullSecurityMonitor : public clwe::SecurityMonitor {
+public:
+    void log_event(const clwe::AuditEntry&) override {}
+    void report_security_violation(clwe::SecurityError, const std::string&) override {}
+    bool detect_timing_anomaly(const std::string&, uint64_t) override { return false; }
+};
+
+// Test fixture for sign/verify workspaces
+class WorkspaceTest : public ::testing::TestWithParam<uint32_t> {
+protected:
+    void SetUp() override {
+        params = clwe::CLWEParameters(GetParam());
+        clwe::ColorSignKeyGen keygen(params);
+        std::array<uint8_t, 32> seed = {0};
+        auto [pub, priv] = keygen.generate_keypair_deterministic(seed);
+        public_key = pub;
+        private_key = priv;
+        signer = std::make_unique<clwe::ColorSign>(params, std::make_unique<NullSecurityMonitor>());
+        verifier = std::make_unique<clwe::ColorSignVerify>(params);
+    }
+
+    clwe::CLWEParameters params;
+    clwe::ColorSignPublicKey public_key;
+    clwe::ColorSignPrivateKey private_key;
+    std::unique_ptr<clwe::ColorSign> signer;
+    std::unique_ptr<clwe::ColorSignVerify> verifier;
+};
+
+TEST_P(WorkspaceTest, WorkspaceSignatureMatchesDefaultPath) {
+    std::vector<uint8_t> message = {'w', 'o', 'r', 'k', 's', 'p', 'a', 'c', 'e'};
+    clwe::SignWorkspace workspace(params);
+    clwe::ColorSignature signature;
+
+    for (int i = 0; i < 3; ++i) {
+        message.push_back(static_cast<uint8_t>(i));
+        signer->sign_message(message, private_key, public_key, workspace, signature);
+        clwe::ColorSignature expected = signer->sign_message(message, private_key, public_key);
+        EXPECT_EQ(signature.serialize(), expected.serialize());
+    }
+}
+
+TEST_P(WorkspaceTest, SteadyStateSigningDoesNotAllocate) {
+    std::vector<uint8_t> message(64, 0x5A);
+    std::vector<uint8_t> context = {'c', 't', 'x'};
+    clwe::SignWorkspace workspace(params);
+    clwe::ColorSignature signature;
+
+    // Warm up: first calls size the output and the timing history
+    for (int i = 0; i < 2; ++i) {
+        signer->sign_message(message, private_key, public_key, workspace, signature, context);
+    }
+
+    // The default path builds a fresh workspace, so the counter must see it
+    {
+        clwe::AllocationScope scope;
+        signer->sign_message(message, private_key, public_key, context);
+        EXPECT_GT(scope.stats().allocations, 0u);
+    }
+
+    clwe::AllocationScope scope;
+    for (int i = 0; i < 5; ++i) {
+        message[0] = static_cast<uint8_t>(i);
+        signer->sign_message(message, private_key, public_key, workspace, signature, context);
+    }
+    EXPECT_EQ(scope.stats().allocations, 0u);
+}
+
+TEST_P(WorkspaceTest, SteadyStateVerificationDoesNotAllocate) {
+    std::vector<uint8_t> message(64, 0xA5);
+    clwe::ColorSignature signature = signer->sign_message(message, private_key, public_key);
+    clwe::VerifyWorkspace workspace(params);
+
+    bool expected = verifier->verify_signature(public_key, signature, message);
+    EXPECT_EQ(verifier->verify_signature(public_key, signature, message, workspace), expected);
+
+    clwe::AllocationScope scope;
+    for (int i = 0; i < 5; ++i) {
+        verifier->verify_signature(public_key, signature, message, workspace);
+    }
+    EXPECT_EQ(scope.stats().allocations, 0u);
+}
+
+TEST_P(WorkspaceTest, VerifyingFromBufferDoesNotAllocate) {
+    std::vector<uint8_t> message(64, 0x3C);
+    std::vector<uint8_t> key_bytes = public_key.serialize();
+    std::vector<uint8_t> sig_bytes = signer->sign_message(message, private_key, public_key).serialize();
+    clwe::VerifyWorkspace workspace(params);
+
+    // Warm up: the first call expands A into the workspace
+    auto key_view = clwe::PublicKeyView::parse(key_bytes.data(), key_bytes.size(), params);
+    auto sig_view = clwe::SignatureView::parse(sig_bytes.data(), sig_bytes.size(), params);
+    verifier->verify_signature(key_view, sig_view, message.data(), message.size(), workspace);
+
+    clwe::AllocationScope scope;
+    for (int i = 0; i < 5; ++i) {
+        key_view = clwe::PublicKeyView::parse(key_bytes.data(), key_bytes.size(), params);
+        sig_view = clwe::SignatureView::parse(sig_bytes.data(), sig_bytes.size(), params);
+        verifier->verify_signature(key_view, sig_view, message.data(), message.size(), workspace);
+    }
+    EXPECT_EQ(scope.stats().allocations, 0u);
+}
+
+TEST_P(WorkspaceTest, SignIntoWritesSerializedSignature) {
+    std::vector<uint8_t> message(64, 0x6B);
+    clwe::SignWorkspace workspace(params);
+
+    for (auto format : {clwe::SignatureFormat::LEGACY, clwe::SignatureFormat::FIPS204}) {
+        signer->set_signature_format(format);
+        size_t size = clwe::ColorSignature::serialized_size(params, format);
+        std::vector<uint8_t> frame(size + 16, 0xEE);
+
+        // Warm up, then the buffer path must not touch the heap
+        signer->sign_into(message, private_key, public_key, workspace, frame.data(), frame.size());
+        size_t written;
+        {
+            clwe::AllocationScope scope;
+            written = signer->sign_into(message.data(), message.size(), private_key, public_key, workspace,
+                                        frame.data() + 8, size);
+            EXPECT_EQ(scope.stats().allocations, 0u);
+        }
+
+        std::vector<uint8_t> expected = signer->sign_message(message, private_key, public_key).serialize();
+        ASSERT_EQ(written, size);
+        EXPECT_EQ(std::vector<uint8_t>(frame.begin() + 8, frame.begin() + 8 + size), expected);
+        EXPECT_EQ(frame[8 + size], 0xEE);
+
+        EXPECT_THROW(signer->sign_into(message, private_key, public_key, workspace, frame.data(), size - 1),
+                     std::invalid_argument);
+    }
+}
+
+TEST_P(WorkspaceTest, MismatchedWorkspaceRejected) {
+    uint32_t other_level = GetParam() == 44 ? 65 : 44;
+    clwe::CLWEParameters other_params(other_level);
+    clwe::SignWorkspace sign_workspace(other_params);
+    clwe::VerifyWorkspace verify_workspace(other_params);
+    clwe::ColorSignature signature;
+    std::vector<uint8_t> message = {'m'};
+
+    EXPECT_THROW(signer->sign_message(message, private_key, public_key, sign_workspace, signature), std::invalid_argument);
+    EXPECT_THROW(verifier->verify_signature(public_key, signature, message, verify_workspace), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(SecurityLevels, WorkspaceTest, ::testing::Values(44u, 65u, 87u));
+
+} // namespace